@@ -5,11 +5,13 @@
 
 #include <azure/core/azure_assert.hpp>
 
-#include <atomic>
-#include <list>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace _detail {
 
@@ -23,6 +25,14 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
    *
    */
 
+  /**
+   * How long a polling thread waits between polls when its pollables have no work. The wait
+   * doubles after each poll that finds no work, so that a connection which just had activity is
+   * polled again quickly while an idle one is barely polled at all.
+   */
+  constexpr std::chrono::milliseconds MinPollingInterval{1};
+  constexpr std::chrono::milliseconds MaxPollingInterval{100};
+
   class Pollable {
   public:
     Pollable() = default;
@@ -32,17 +42,48 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
     Pollable& operator=(Pollable&&) = delete;
 
     virtual void Poll() = 0;
+
+    /**
+     * @brief Pollables with the same key are polled by the same polling thread.
+     *
+     * Pollables that share a lock, like a connection and its links, should return the same key so
+     * that they don't contend for the lock from different polling threads.
+     */
+    virtual void const* GetPollingKey() const { return this; }
+
     virtual ~Pollable() = default;
   };
   class GlobalStateHolder final {
     GlobalStateHolder();
     ~GlobalStateHolder();
 
-    std::list<std::shared_ptr<Pollable>> m_pollables;
-    std::mutex m_pollablesMutex;
-    std::thread m_pollingThread;
-    std::atomic<bool> m_activelyPolling;
-    bool m_stopped{false};
+    /**
+     * A polling thread and the pollables it polls.
+     *
+     * The thread polls its pollables again as soon as there is work for them. When there is none,
+     * it waits longer and longer between polls, up to MaxPollingInterval, so that idle
+     * connections don't use CPU.
+     */
+    struct PollingThread final
+    {
+      std::mutex Mutex;
+      std::condition_variable StateChanged;
+      // Replaced rather than modified, so the thread can poll a snapshot without holding Mutex.
+      std::shared_ptr<std::vector<std::shared_ptr<Pollable>> const> Pollables;
+      bool IsPolling{false};
+      // Incremented every time the thread starts polling its pollables.
+      uint64_t PollCount{0};
+      bool WorkPending{false};
+      bool Stopped{false};
+      std::chrono::milliseconds MinInterval{MinPollingInterval};
+      std::chrono::milliseconds MaxInterval{MaxPollingInterval};
+      std::thread Thread;
+    };
+
+    void PollingLoop(PollingThread& pollingThread);
+    PollingThread& GetPollingThread(Pollable const& pollable);
+
+    std::vector<std::unique_ptr<PollingThread>> m_pollingThreads;
 
   public:
     static GlobalStateHolder* GlobalStateInstance();
@@ -57,13 +98,34 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
 
     void RemovePollable(std::shared_ptr<Pollable> pollable);
 
+    /**
+     * @brief Wakes up the thread polling \p pollable, because the pollable has work to do.
+     *
+     * Call this after queuing an operation on a pollable, and when a pollable receives an event,
+     * so that the operation is processed without waiting for the next poll.
+     */
+    void NotifyPollable(Pollable const& pollable);
+
+    /**
+     * @brief Sets how long the polling threads wait between polls when there is no work.
+     *
+     * Tests use long intervals to make sure that a pollable is polled because it was notified
+     * and not because the idle wait expired.
+     */
+    void SetPollingIntervals(
+        std::chrono::milliseconds minInterval,
+        std::chrono::milliseconds maxInterval);
+
     void AssertIdle()
     {
-      std::lock_guard<std::mutex> lock(m_pollablesMutex);
-      AZURE_ASSERT(m_pollables.empty());
-      if (!m_pollables.empty())
+      for (auto const& pollingThread : m_pollingThreads)
       {
-        Azure::Core::_internal::AzureNoReturnPath("Global state is not idle.");
+        std::lock_guard<std::mutex> lock(pollingThread->Mutex);
+        AZURE_ASSERT(pollingThread->Pollables->empty());
+        if (!pollingThread->Pollables->empty())
+        {
+          Azure::Core::_internal::AzureNoReturnPath("Global state is not idle.");
+        }
       }
     }
   };
@@ -15,7 +15,10 @@
 
 #include <azure/core/nullable.hpp>
 
+#include <cstdint>
+#include <functional>
 #include <tuple>
+#include <vector>
 
 #if defined(_azure_TESTING_BUILD)
 // Define the test classes dependant on this class here.
@@ -119,6 +122,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
      */
     Nullable<uint32_t> InitialDeliveryCount;
 
+    /** @brief The maximum number of messages sent whose delivery has not been settled yet.
+     *
+     * Messages are transferred as the link credit granted by the peer allows, without waiting for
+     * the disposition of the previous messages. When this many messages are in flight, Send and
+     * SendAsync block until one of them is settled. 0 means no limit.
+     *
+     */
+    std::uint32_t MaxUnsettledDeliveries{128};
+
     /** @brief If true, the message sender will log trace events. */
     bool EnableTrace{false};
 
@@ -131,6 +143,12 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
     using MessageSendCompleteCallback
         = std::function<void(MessageSendStatus sendResult, Models::AmqpValue const& deliveryState)>;
 
+    /** @brief Called when the delivery of a message sent with SendAsync is settled, with the
+     * status of the send and the error the peer returned, if any.
+     */
+    using MessageSendResultCallback = std::function<
+        void(MessageSendStatus sendResult, Models::_internal::AmqpError const& error)>;
+
     ~MessageSender() noexcept;
 
     MessageSender(MessageSender const&) = default;
@@ -177,6 +195,53 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
         Models::AmqpMessage const& message,
         Context const& context = {});
 
+    /** @brief Send a message asynchronously to the target of the message sender.
+     *
+     * The message is queued on the link, and this returns without waiting for its disposition.
+     * If #MessageSenderOptions::MaxUnsettledDeliveries messages are in flight, this first waits
+     * until one of them is settled.
+     *
+     * @param message The message to send.
+     * @param onSendComplete Called once the delivery is settled. It is called from the thread
+     * polling the connection, so it must not block, and must not call Send. If the context is
+     * cancelled before the message is queued, it is called right away with
+     * MessageSendStatus::Cancelled.
+     * @param context The context to use for the operation.
+     */
+    void SendAsync(
+        Models::AmqpMessage const& message,
+        MessageSendResultCallback onSendComplete,
+        Context const& context = {});
+
+    /** @brief Send a message whose body has already been encoded, synchronously.
+     *
+     * The body is written to the transfer as is, which avoids copying and re-encoding each of its
+     * data sections.
+     *
+     * @param envelope The message to send. Its body is ignored.
+     * @param encodedBody The body of the message, one or more encoded AMQP data sections.
+     * @param context The context to use for the operation.
+     *
+     * @return A tuple containing the status of the send operation and the send disposition.
+     */
+    _azure_NODISCARD std::tuple<MessageSendStatus, Models::_internal::AmqpError> Send(
+        Models::AmqpMessage const& envelope,
+        std::vector<std::uint8_t> const& encodedBody,
+        Context const& context = {});
+
+    /** @brief Send a message whose body has already been encoded, asynchronously.
+     *
+     * @param envelope The message to send. Its body is ignored.
+     * @param encodedBody The body of the message, one or more encoded AMQP data sections.
+     * @param onSendComplete Called once the delivery is settled, as for SendAsync above.
+     * @param context The context to use for the operation.
+     */
+    void SendAsync(
+        Models::AmqpMessage const& envelope,
+        std::vector<std::uint8_t> const& encodedBody,
+        MessageSendResultCallback onSendComplete,
+        Context const& context = {});
+
   private:
     // Half-open the message sender (does not block waiting on the Open to complete).
     _azure_NODISCARD Models::_internal::AmqpError HalfOpen(Context const& context = {});
@@ -271,6 +271,21 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
      */
     static std::vector<uint8_t> Serialize(AmqpMessage const& message);
 
+    /** @brief Serialize the message, appending it to the end of a buffer.
+     *
+     * @remarks This API will fail if BodyType is not set.
+     */
+    static void Serialize(AmqpMessage const& message, std::vector<uint8_t>& buffer);
+
+    /** @brief Serialize the message as the payload of an AMQP data section, appending the data
+     * section to the end of a buffer.
+     *
+     * @remarks This is how a message is encoded within the body of a batched message.
+     *
+     * @returns The offset in the buffer of the serialized message, after the data section header.
+     */
+    static size_t SerializeAsDataSection(AmqpMessage const& message, std::vector<uint8_t>& buffer);
+
     /** @brief Deserialize the message from a buffer.
      *
      * @remarks This API will fail if BodyType is not set.
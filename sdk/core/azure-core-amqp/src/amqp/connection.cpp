@@ -372,6 +372,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       CONNECTION_STATE oldState)
   {
     ConnectionImpl* connection = static_cast<ConnectionImpl*>(context);
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*connection);
 
     if (connection->m_options.EnableTrace)
     {
@@ -446,6 +447,11 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         }
         Common::_detail::GlobalStateHolder::GlobalStateInstance()->AddPollable(shared_from_this());
       }
+      else
+      {
+        // A session or link was started on the connection, send its frames now.
+        Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*this);
+      }
     }
     else
     {
@@ -466,6 +472,10 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         Common::_detail::GlobalStateHolder::GlobalStateInstance()->RemovePollable(
             shared_from_this());
       }
+      else
+      {
+        Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*this);
+      }
     }
   }
 
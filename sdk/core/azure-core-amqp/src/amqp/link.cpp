@@ -491,6 +491,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   void LinkImpl::OnLinkFlowOnFn(void* context)
   {
     LinkImpl* link = static_cast<LinkImpl*>(context);
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*link);
     if (link->m_eventHandler)
     {
       link->m_eventHandler->OnLinkFlowOn(link->shared_from_this());
@@ -520,6 +521,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   void LinkImpl::OnLinkStateChangedFn(void* context, LINK_STATE newState, LINK_STATE oldState)
   {
     LinkImpl* link = static_cast<LinkImpl*>(context);
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*link);
     if (link->m_eventHandler)
     {
       link->m_eventHandler->OnLinkStateChanged(
@@ -536,6 +538,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       const unsigned char* payload_bytes)
   {
     LinkImpl* link = static_cast<LinkImpl*>(context);
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*link);
     if (link->m_eventHandler)
     {
 
@@ -555,12 +558,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     link_dowork(m_link);
   }
 
+  void const* LinkImpl::GetPollingKey() const { return m_session->GetConnection().get(); }
+
   void LinkImpl::ResetLinkCredit(std::uint32_t linkCredit, bool drain)
   {
     if (link_reset_link_credit(m_link, linkCredit, drain))
     {
       throw std::runtime_error("Could not reset link credit.");
     }
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*this);
   }
 
   void LinkImpl::Attach()
@@ -677,6 +683,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         throw std::runtime_error(ss.str());
       }
     }
+    Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*this);
 
     auto result = m_transferCompleteQueue.WaitForResult(context);
     if (result)
@@ -69,6 +69,31 @@ namespace Azure { namespace Core { namespace Amqp { namespace _internal {
     return m_impl->Send(message, context);
   }
 
+  void MessageSender::SendAsync(
+      Models::AmqpMessage const& message,
+      MessageSendResultCallback onSendComplete,
+      Context const& context)
+  {
+    m_impl->SendAsync(message, std::move(onSendComplete), context);
+  }
+
+  std::tuple<MessageSendStatus, Models::_internal::AmqpError> MessageSender::Send(
+      Models::AmqpMessage const& envelope,
+      std::vector<std::uint8_t> const& encodedBody,
+      Context const& context)
+  {
+    return m_impl->Send(envelope, encodedBody, context);
+  }
+
+  void MessageSender::SendAsync(
+      Models::AmqpMessage const& envelope,
+      std::vector<std::uint8_t> const& encodedBody,
+      MessageSendResultCallback onSendComplete,
+      Context const& context)
+  {
+    m_impl->SendAsync(envelope, encodedBody, std::move(onSendComplete), context);
+  }
+
   std::uint64_t MessageSender::GetMaxMessageSize() const { return m_impl->GetMaxMessageSize(); }
   std::string MessageSender::GetLinkName() const { return m_impl->GetLinkName(); }
   MessageSender::~MessageSender() noexcept {}
@@ -312,8 +337,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         }
         else
         {
-          sender->m_sendCompleteQueue.CompleteOperation(
-              _internal::MessageSendStatus::Error,
+          sender->FailUnsettledSends(
               {Azure::Core::Amqp::Models::_internal::AmqpErrorCondition::InternalError,
                "Message Sender unexpectedly entered the Error State.",
                {}});
@@ -565,8 +589,8 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     }
   };
 
-  void MessageSenderImpl::QueueSendInternal(
-      Models::AmqpMessage const& message,
+  bool MessageSenderImpl::QueueSendInternal(
+      MESSAGE_HANDLE message,
       Azure::Core::Amqp::_internal::MessageSender::MessageSendCompleteCallback onSendComplete,
       Context const& context)
   {
@@ -581,7 +605,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
                          RewriteSendComplete<decltype(onSendComplete)>>>(onSendComplete));
       auto result = messagesender_send_async(
           m_messageSender.get(),
-          Models::_detail::AmqpMessageFactory::ToUamqp(message).get(),
+          message,
           std::remove_pointer<decltype(operation)::element_type>::type::OnOperationFn,
           operation.release(),
           0 /*timeout*/);
@@ -589,66 +613,224 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
       {
         throw std::runtime_error("Could not send message");
       }
+      // Send the message now rather than on the next poll.
+      Common::_detail::GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*m_link);
+      return true;
+    }
+    return false;
+  }
+
+  Models::_internal::AmqpError MessageSenderImpl::GetSendError(
+      _internal::MessageSendStatus sendResult,
+      Models::AmqpValue const& deliveryStatus)
+  {
+    Models::_internal::AmqpError error;
+
+    // If the send failed. then we need to return the error. If the send completed because
+    // of an error, it's possible that the deliveryStatus provided is null. In that case,
+    // we use the cached saved error because it is highly likely to be better than
+    // nothing.
+    if (sendResult != _internal::MessageSendStatus::Ok)
+    {
+      if (deliveryStatus.IsNull())
+      {
+        error = m_savedMessageError;
+      }
+      else
+      {
+        if (deliveryStatus.GetType() != Models::AmqpValueType::List)
+        {
+          throw std::runtime_error("Delivery status is not a list");
+        }
+        auto deliveryStatusAsList{deliveryStatus.AsList()};
+        if (deliveryStatusAsList.size() != 1)
+        {
+          throw std::runtime_error("Delivery Status list is not of size 1");
+        }
+        Models::AmqpValue firstState{deliveryStatusAsList[0]};
+        ERROR_HANDLE errorHandle;
+        if (!amqpvalue_get_error(
+                Models::_detail::AmqpValueFactory::ToUamqp(firstState), &errorHandle))
+        {
+          Models::_detail::UniqueAmqpErrorHandle uniqueError{
+              errorHandle}; // This will free the error handle when it goes out of scope.
+          error = Models::_detail::AmqpErrorFactory::FromUamqp(errorHandle);
+        }
+      }
+    }
+    else
+    {
+      // If we successfully sent the message, then whatever saved error should be cleared,
+      // it's no longer valid.
+      m_savedMessageError = Models::_internal::AmqpError();
+    }
+    return error;
+  }
+
+  void MessageSenderImpl::CompleteSend(
+      std::uint64_t sendId,
+      _internal::MessageSendStatus sendResult,
+      Models::_internal::AmqpError const& error)
+  {
+    _internal::MessageSender::MessageSendResultCallback onSendComplete;
+    {
+      std::lock_guard<std::mutex> lock(m_unsettledSendsMutex);
+      auto unsettledSend = m_unsettledSends.find(sendId);
+      if (unsettledSend == m_unsettledSends.end())
+      {
+        // The send was already failed by FailUnsettledSends.
+        return;
+      }
+      onSendComplete = std::move(unsettledSend->second);
+      m_unsettledSends.erase(unsettledSend);
+    }
+    m_unsettledSendsCondition.notify_all();
+    onSendComplete(sendResult, error);
+  }
+
+  void MessageSenderImpl::FailUnsettledSends(Models::_internal::AmqpError const& error)
+  {
+    std::map<std::uint64_t, _internal::MessageSender::MessageSendResultCallback> unsettledSends;
+    {
+      std::lock_guard<std::mutex> lock(m_unsettledSendsMutex);
+      unsettledSends.swap(m_unsettledSends);
+    }
+    m_unsettledSendsCondition.notify_all();
+    for (auto& unsettledSend : unsettledSends)
+    {
+      unsettledSend.second(_internal::MessageSendStatus::Error, error);
+    }
+  }
+
+  namespace {
+    // Converts the envelope to a uAMQP message whose body is the already encoded data sections.
+    Models::_detail::UniqueMessageHandle CreateEncodedBodyMessage(
+        Models::AmqpMessage const& envelope,
+        std::vector<std::uint8_t> const& encodedBody)
+    {
+      if (envelope.BodyType != Models::MessageBodyType::None)
+      {
+        throw std::runtime_error("The envelope of an encoded message must not have a body.");
+      }
+      auto message{Models::_detail::AmqpMessageFactory::ToUamqp(envelope)};
+      BINARY_DATA encodedData{};
+      encodedData.bytes = encodedBody.data();
+      encodedData.length = encodedBody.size();
+      if (message_set_body_amqp_data_encoded(message.get(), encodedData))
+      {
+        throw std::runtime_error("Could not set encoded message body.");
+      }
+      return message;
     }
+  } // namespace
+
+  void MessageSenderImpl::SendAsync(
+      Models::AmqpMessage const& message,
+      _internal::MessageSender::MessageSendResultCallback onSendComplete,
+      Context const& context)
+  {
+    SendAsync(
+        Models::_detail::AmqpMessageFactory::ToUamqp(message), std::move(onSendComplete), context);
+  }
+
+  void MessageSenderImpl::SendAsync(
+      Models::AmqpMessage const& envelope,
+      std::vector<std::uint8_t> const& encodedBody,
+      _internal::MessageSender::MessageSendResultCallback onSendComplete,
+      Context const& context)
+  {
+    SendAsync(
+        CreateEncodedBodyMessage(envelope, encodedBody), std::move(onSendComplete), context);
   }
 
   std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> MessageSenderImpl::Send(
       Models::AmqpMessage const& message,
       Context const& context)
   {
+    return Send(Models::_detail::AmqpMessageFactory::ToUamqp(message), context);
+  }
+
+  std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> MessageSenderImpl::Send(
+      Models::AmqpMessage const& envelope,
+      std::vector<std::uint8_t> const& encodedBody,
+      Context const& context)
+  {
+    return Send(CreateEncodedBodyMessage(envelope, encodedBody), context);
+  }
+
+  void MessageSenderImpl::SendAsync(
+      Models::_detail::UniqueMessageHandle message,
+      _internal::MessageSender::MessageSendResultCallback onSendComplete,
+      Context const& context)
+  {
+    const Models::_internal::AmqpError cancelledError{
+        Models::_internal::AmqpErrorCondition::OperationCancelled,
+        "Message send operation cancelled.",
+        {}};
+    std::uint64_t sendId{};
     {
-      auto lock{m_session->GetConnection()->Lock()};
+      // Wait until there is room in the window of unsettled deliveries.
+      std::unique_lock<std::mutex> lock(m_unsettledSendsMutex);
+      while (m_options.MaxUnsettledDeliveries != 0
+             && m_unsettledSends.size() >= m_options.MaxUnsettledDeliveries
+             && !context.IsCancelled())
+      {
+        m_unsettledSendsCondition.wait_for(lock, std::chrono::milliseconds(100));
+      }
+      if (context.IsCancelled())
+      {
+        lock.unlock();
+        onSendComplete(_internal::MessageSendStatus::Cancelled, cancelledError);
+        return;
+      }
+      sendId = ++m_lastSendId;
+      m_unsettledSends.emplace(sendId, std::move(onSendComplete));
+    }
 
-      QueueSendInternal(
-          message,
-          [this](
+    bool queued{false};
+    try
+    {
+      auto lock{m_session->GetConnection()->Lock()};
+      queued = QueueSendInternal(
+          message.get(),
+          [this, sendId](
               Azure::Core::Amqp::_internal::MessageSendStatus sendResult,
               Models::AmqpValue deliveryStatus) {
-            Models::_internal::AmqpError error;
-
-            // If the send failed. then we need to return the error. If the send completed because
-            // of an error, it's possible that the deliveryStatus provided is null. In that case,
-            // we use the cached saved error because it is highly likely to be better than
-            // nothing.
-            if (sendResult != _internal::MessageSendStatus::Ok)
-            {
-              if (deliveryStatus.IsNull())
-              {
-                error = m_savedMessageError;
-              }
-              else
-              {
-                if (deliveryStatus.GetType() != Models::AmqpValueType::List)
-                {
-                  throw std::runtime_error("Delivery status is not a list");
-                }
-                auto deliveryStatusAsList{deliveryStatus.AsList()};
-                if (deliveryStatusAsList.size() != 1)
-                {
-                  throw std::runtime_error("Delivery Status list is not of size 1");
-                }
-                Models::AmqpValue firstState{deliveryStatusAsList[0]};
-                ERROR_HANDLE errorHandle;
-                if (!amqpvalue_get_error(
-                        Models::_detail::AmqpValueFactory::ToUamqp(firstState), &errorHandle))
-                {
-                  Models::_detail::UniqueAmqpErrorHandle uniqueError{
-                      errorHandle}; // This will free the error handle when it goes out of scope.
-                  error = Models::_detail::AmqpErrorFactory::FromUamqp(errorHandle);
-                }
-              }
-            }
-            else
-            {
-              // If we successfully sent the message, then whatever saved error should be cleared,
-              // it's no longer valid.
-              m_savedMessageError = Models::_internal::AmqpError();
-            }
-            m_sendCompleteQueue.CompleteOperation(sendResult, error);
+            CompleteSend(sendId, sendResult, GetSendError(sendResult, deliveryStatus));
           },
           context);
     }
-    auto result = m_sendCompleteQueue.WaitForResult(context);
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_unsettledSendsMutex);
+        m_unsettledSends.erase(sendId);
+      }
+      m_unsettledSendsCondition.notify_all();
+      throw;
+    }
+    if (!queued)
+    {
+      CompleteSend(sendId, _internal::MessageSendStatus::Cancelled, cancelledError);
+    }
+  }
+
+  std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> MessageSenderImpl::Send(
+      Models::_detail::UniqueMessageHandle message,
+      Context const& context)
+  {
+    // Each send has its own queue, so that concurrent sends get their own result.
+    auto sendCompleteQueue = std::make_shared<Common::_internal::AsyncOperationQueue<
+        _internal::MessageSendStatus,
+        Models::_internal::AmqpError>>();
+    SendAsync(
+        std::move(message),
+        [sendCompleteQueue](
+            _internal::MessageSendStatus sendResult, Models::_internal::AmqpError const& error) {
+          sendCompleteQueue->CompleteOperation(sendResult, error);
+        },
+        context);
+    auto result = sendCompleteQueue->WaitForResult(context);
     if (result)
     {
       return std::move(*result);
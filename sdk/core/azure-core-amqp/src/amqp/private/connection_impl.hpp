@@ -99,6 +99,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
         Models::AmqpValue info = {});
 
     void Poll() override;
+    void const* GetPollingKey() const override { return this; }
 
     std::string GetHost() const { return m_hostName; }
     uint16_t GetPort() const { return m_port; }
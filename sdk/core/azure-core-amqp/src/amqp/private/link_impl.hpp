@@ -137,5 +137,7 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
 
     // Inherited via Pollable
     void Poll() override;
+    // Links are polled with their connection, they share its lock.
+    void const* GetPollingKey() const override;
   };
 }}}} // namespace Azure::Core::Amqp::_detail
@@ -3,12 +3,19 @@
 
 #pragma once
 
+#include "../../models/private/message_impl.hpp"
 #include "azure/core/amqp/internal/message_sender.hpp"
 #include "link_impl.hpp"
 #include "unique_handle.hpp"
 
 #include <azure_uamqp_c/message_sender.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   template <> struct UniqueHandleHelper<MESSAGE_SENDER_INSTANCE_TAG>
   {
@@ -55,6 +62,19 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> Send(
         Models::AmqpMessage const& message,
         Context const& context);
+    void SendAsync(
+        Models::AmqpMessage const& message,
+        _internal::MessageSender::MessageSendResultCallback onSendComplete,
+        Context const& context);
+    std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> Send(
+        Models::AmqpMessage const& envelope,
+        std::vector<std::uint8_t> const& encodedBody,
+        Context const& context);
+    void SendAsync(
+        Models::AmqpMessage const& envelope,
+        std::vector<std::uint8_t> const& encodedBody,
+        _internal::MessageSender::MessageSendResultCallback onSendComplete,
+        Context const& context);
 
     std::uint64_t GetMaxMessageSize() const;
 
@@ -69,22 +89,40 @@ namespace Azure { namespace Core { namespace Amqp { namespace _detail {
     void CreateLink();
     void CreateLink(_internal::LinkEndpoint& endpoint);
     void PopulateLinkProperties();
-    void QueueSendInternal(
-        Models::AmqpMessage const& message,
+    std::tuple<_internal::MessageSendStatus, Models::_internal::AmqpError> Send(
+        Models::_detail::UniqueMessageHandle message,
+        Context const& context);
+    void SendAsync(
+        Models::_detail::UniqueMessageHandle message,
+        _internal::MessageSender::MessageSendResultCallback onSendComplete,
+        Context const& context);
+    bool QueueSendInternal(
+        MESSAGE_HANDLE message,
         Azure::Core::Amqp::_internal::MessageSender::MessageSendCompleteCallback onSendComplete,
         Context const& context);
 
     void OnLinkDetached(Models::_internal::AmqpError const& error);
+    Models::_internal::AmqpError GetSendError(
+        _internal::MessageSendStatus sendResult,
+        Models::AmqpValue const& deliveryStatus);
+    void CompleteSend(
+        std::uint64_t sendId,
+        _internal::MessageSendStatus sendResult,
+        Models::_internal::AmqpError const& error);
+    void FailUnsettledSends(Models::_internal::AmqpError const& error);
 
     bool m_senderOpen{false};
     UniqueMessageSender m_messageSender{};
     std::shared_ptr<_detail::LinkImpl> m_link;
     _internal::MessageSenderEvents* m_events;
     Models::_internal::AmqpError m_savedMessageError;
-    Azure::Core::Amqp::Common::_internal::AsyncOperationQueue<
-        Azure::Core::Amqp::_internal::MessageSendStatus,
-        Models::_internal::AmqpError>
-        m_sendCompleteQueue;
+
+    // The sends whose delivery has not been settled yet, by send id. A send is completed once,
+    // either by uAMQP or when the sender fails.
+    std::mutex m_unsettledSendsMutex;
+    std::condition_variable m_unsettledSendsCondition;
+    std::map<std::uint64_t, _internal::MessageSender::MessageSendResultCallback> m_unsettledSends;
+    std::uint64_t m_lastSendId{0};
 
     Azure::Core::Amqp::Common::_internal::AsyncOperationQueue<Models::_internal::AmqpError>
         m_openQueue;
@@ -7,6 +7,7 @@
 
 #include <azure/core/diagnostics/logger.hpp>
 #include <azure/core/internal/diagnostics/log.hpp>
+#include <azure/core/internal/environment.hpp>
 
 #include <azure_c_shared_utility/gballoc.h>
 #include <azure_c_shared_utility/platform.h>
@@ -14,12 +15,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <functional>
 #include <iomanip>
-#include <list>
 #include <mutex>
 #include <sstream>
 #include <stdarg.h>
 #include <stdexcept>
+#include <string>
 
 using namespace Azure::Core::Diagnostics::_internal;
 using namespace Azure::Core::Diagnostics;
@@ -87,6 +90,35 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
     va_end(args);
   }
 
+  namespace {
+    constexpr size_t MaxPollingThreads = 64;
+
+    // Processes with many connections can spread them across more polling threads by setting
+    // AZURE_AMQP_POLLING_THREADS.
+    size_t GetPollingThreadCount()
+    {
+      auto const value = Azure::Core::_internal::Environment::GetVariable(
+          "AZURE_AMQP_POLLING_THREADS");
+      if (!value.empty())
+      {
+        try
+        {
+          auto const count = std::stoul(value);
+          if (count > 0)
+          {
+            return (std::min)(static_cast<size_t>(count), MaxPollingThreads);
+          }
+        }
+        catch (std::exception const&)
+        {
+        }
+        Log::Stream(Logger::Level::Warning)
+            << "Ignoring invalid AZURE_AMQP_POLLING_THREADS value: " << value;
+      }
+      return 1;
+    }
+  } // namespace
+
   GlobalStateHolder::GlobalStateHolder()
   {
 #if defined(GB_DEBUG_ALLOC)
@@ -100,40 +132,32 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
     // Integrate AMQP logging with Azure Core logging.
     xlogging_set_log_function(AmqpLogFunction);
 
-    m_pollingThread = std::thread([this]() {
-      do
-      {
-        {
-          std::list<std::shared_ptr<Pollable>> capturedList;
-          {
-            std::unique_lock<std::mutex> lock{m_pollablesMutex};
-            // If there are no pollables, there's no point in doing any work.
-            if (m_pollables.empty())
-            {
-              continue;
-            }
-            capturedList = m_pollables;
-            m_activelyPolling = true;
-          }
-
-          for (auto const& pollable : capturedList)
-          {
-            pollable->Poll();
-          }
-        }
-        m_activelyPolling = false;
-        //        std::this_thread::yield();
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      } while (!m_stopped);
-    });
+    auto const pollingThreadCount = GetPollingThreadCount();
+    for (size_t i = 0; i < pollingThreadCount; i += 1)
+    {
+      m_pollingThreads.push_back(std::make_unique<PollingThread>());
+      auto& pollingThread = *m_pollingThreads.back();
+      pollingThread.Pollables = std::make_shared<std::vector<std::shared_ptr<Pollable>>>();
+      pollingThread.Thread = std::thread([this, &pollingThread]() { PollingLoop(pollingThread); });
+    }
   }
 
   GlobalStateHolder::~GlobalStateHolder()
   {
-    m_stopped = true;
-    if (m_pollingThread.joinable())
+    for (auto& pollingThread : m_pollingThreads)
     {
-      m_pollingThread.join();
+      {
+        std::lock_guard<std::mutex> lock(pollingThread->Mutex);
+        pollingThread->Stopped = true;
+      }
+      pollingThread->StateChanged.notify_all();
+    }
+    for (auto& pollingThread : m_pollingThreads)
+    {
+      if (pollingThread->Thread.joinable())
+      {
+        pollingThread->Thread.join();
+      }
     }
     platform_deinit();
 #if defined(GB_DEBUG_ALLOC)
@@ -141,6 +165,58 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
 #endif
   }
 
+  void GlobalStateHolder::PollingLoop(PollingThread& pollingThread)
+  {
+    std::unique_lock<std::mutex> lock(pollingThread.Mutex);
+    auto pollingInterval = pollingThread.MinInterval;
+    while (!pollingThread.Stopped)
+    {
+      // If there are no pollables, there's no point in doing any work.
+      if (pollingThread.Pollables->empty())
+      {
+        pollingThread.StateChanged.wait(lock, [&pollingThread]() {
+          return pollingThread.Stopped || !pollingThread.Pollables->empty();
+        });
+        continue;
+      }
+
+      // Poll a snapshot of the pollables without holding the lock, so that pollables can be
+      // added and notified while polling.
+      auto pollables = pollingThread.Pollables;
+      pollingThread.WorkPending = false;
+      pollingThread.IsPolling = true;
+      pollingThread.PollCount += 1;
+      lock.unlock();
+      for (auto const& pollable : *pollables)
+      {
+        pollable->Poll();
+      }
+      pollables.reset();
+      lock.lock();
+      pollingThread.IsPolling = false;
+      pollingThread.StateChanged.notify_all();
+
+      // Anything that happened while polling, like a frame being received or a message being
+      // queued, is likely to be followed by more work, so poll again right away.
+      if (!pollingThread.WorkPending)
+      {
+        pollingInterval = (std::min)(
+            (std::max)(pollingInterval, pollingThread.MinInterval), pollingThread.MaxInterval);
+        pollingThread.StateChanged.wait_for(lock, pollingInterval, [&pollingThread]() {
+          return pollingThread.Stopped || pollingThread.WorkPending;
+        });
+      }
+      pollingInterval = pollingThread.WorkPending ? pollingThread.MinInterval : pollingInterval * 2;
+    }
+  }
+
+  GlobalStateHolder::PollingThread& GlobalStateHolder::GetPollingThread(Pollable const& pollable)
+  {
+    auto const index
+        = std::hash<void const*>{}(pollable.GetPollingKey()) % m_pollingThreads.size();
+    return *m_pollingThreads[index];
+  }
+
   /**
    * @brief Adds a pollable object to the list of objects to be polled.
    *
@@ -156,40 +232,73 @@ namespace Azure { namespace Core { namespace Amqp { namespace Common { namespace
    */
   void GlobalStateHolder::AddPollable(std::shared_ptr<Pollable> pollable)
   {
-    std::lock_guard<std::mutex> lock(m_pollablesMutex);
-    if (std::find(m_pollables.begin(), m_pollables.end(), pollable) == m_pollables.end())
+    auto& pollingThread = GetPollingThread(*pollable);
     {
-      m_pollables.push_back(pollable);
+      std::lock_guard<std::mutex> lock(pollingThread.Mutex);
+      auto const& pollables = *pollingThread.Pollables;
+      if (std::find(pollables.begin(), pollables.end(), pollable) != pollables.end())
+      {
+        return;
+      }
+      auto newPollables = std::make_shared<std::vector<std::shared_ptr<Pollable>>>(pollables);
+      newPollables->push_back(std::move(pollable));
+      pollingThread.Pollables = std::move(newPollables);
+      // Poll the new pollable right away, it was added because it has work to do.
+      pollingThread.WorkPending = true;
     }
+    pollingThread.StateChanged.notify_all();
   }
 
   void GlobalStateHolder::RemovePollable(std::shared_ptr<Pollable> pollable)
   {
-    // There is a bit of a complicated lock-free dance happening here.
-    // The m_pollables list is accessed by the polling thread, and the list is modified by the user
-    // thread. To ensure integrity of the list, the polling thread takes the lock, copies the
-    // pollable from the list, releases the lock and then iterates over the pollables at the
-    // snapshot.
-    //
-    // Because the pollable is a shared_ptr, the user thread can remove a pollable while the
-    // background thread is polling.
-    //
-    // But we want to make sure that the thread has finished polling (and thus has removed the copy
-    // of the pollables list). For that, we have the m_activelyPolling variable. It is set under the
-    // pollables lock, and cleared after the polling thread has finished polling (outside the lock).
-    //
-    // This means that we can spin on the m_activelyPolling variable *under* the pollables lock safe
-    // in the knowledge that IF the variable is set to true, it means that we acquired the
-    // pollablesMutex during the interval when the captured list is being interated over. And that
-    // the m_activelyPolling variable will only be cleared AFTER the captured list is freed.
+    // The polling thread polls a snapshot of the pollables list without holding the lock, and
+    // the snapshot is replaced rather than modified. So a poll that started before the pollable
+    // was removed can still be polling it.
     //
+    // Callers expect that the pollable is not polled anymore once this returns, so wait for such
+    // a poll to complete. A new poll can't see the pollable, so there is no need to wait for it.
+    // And the polling thread itself, which can end up here from a callback, can't be polling.
+    auto& pollingThread = GetPollingThread(*pollable);
+    std::unique_lock<std::mutex> lock(pollingThread.Mutex);
+    auto newPollables
+        = std::make_shared<std::vector<std::shared_ptr<Pollable>>>(*pollingThread.Pollables);
+    newPollables->erase(
+        std::remove(newPollables->begin(), newPollables->end(), pollable), newPollables->end());
+    pollingThread.Pollables = std::move(newPollables);
 
-    std::lock_guard<std::mutex> lock(m_pollablesMutex);
-    m_pollables.remove(pollable);
-    // Spin until m_activelyPolling is false, this ensures that the polling thread is not using the
-    // capturedList copy of m_pollables.
-    while (m_activelyPolling.load())
-      ;
+    if (pollingThread.IsPolling && std::this_thread::get_id() != pollingThread.Thread.get_id())
+    {
+      auto const pollCount = pollingThread.PollCount;
+      pollingThread.StateChanged.wait(lock, [&pollingThread, pollCount]() {
+        return !pollingThread.IsPolling || pollingThread.PollCount != pollCount;
+      });
+    }
+  }
+
+  void GlobalStateHolder::NotifyPollable(Pollable const& pollable)
+  {
+    auto& pollingThread = GetPollingThread(pollable);
+    {
+      std::lock_guard<std::mutex> lock(pollingThread.Mutex);
+      if (pollingThread.WorkPending)
+      {
+        return;
+      }
+      pollingThread.WorkPending = true;
+    }
+    pollingThread.StateChanged.notify_all();
+  }
+
+  void GlobalStateHolder::SetPollingIntervals(
+      std::chrono::milliseconds minInterval,
+      std::chrono::milliseconds maxInterval)
+  {
+    for (auto& pollingThread : m_pollingThreads)
+    {
+      std::lock_guard<std::mutex> lock(pollingThread->Mutex);
+      pollingThread->MinInterval = minInterval;
+      pollingThread->MaxInterval = maxInterval;
+    }
   }
 
   GlobalStateHolder* GlobalStateHolder::GlobalStateInstance()
@@ -0,0 +1,496 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/amqp_codec.hpp"
+
+#include "private/value_impl.hpp"
+
+#include <azure/core/uuid.hpp>
+
+#include <azure_uamqp_c/amqpvalue.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
+
+  namespace {
+    // Values nested deeper than this are rejected rather than risk exhausting the stack.
+    constexpr int MaxNestingDepth = 64;
+
+    // AMQP format codes, from section 1.6 of the AMQP 1.0 core types specification.
+    constexpr std::uint8_t DescribedCode = 0x00;
+    constexpr std::uint8_t NullCode = 0x40;
+    constexpr std::uint8_t TrueCode = 0x41;
+    constexpr std::uint8_t FalseCode = 0x42;
+    constexpr std::uint8_t Uint0Code = 0x43;
+    constexpr std::uint8_t Ulong0Code = 0x44;
+    constexpr std::uint8_t List0Code = 0x45;
+    constexpr std::uint8_t UbyteCode = 0x50;
+    constexpr std::uint8_t ByteCode = 0x51;
+    constexpr std::uint8_t SmallUintCode = 0x52;
+    constexpr std::uint8_t SmallUlongCode = 0x53;
+    constexpr std::uint8_t SmallIntCode = 0x54;
+    constexpr std::uint8_t SmallLongCode = 0x55;
+    constexpr std::uint8_t BoolCode = 0x56;
+    constexpr std::uint8_t UshortCode = 0x60;
+    constexpr std::uint8_t ShortCode = 0x61;
+    constexpr std::uint8_t UintCode = 0x70;
+    constexpr std::uint8_t IntCode = 0x71;
+    constexpr std::uint8_t FloatCode = 0x72;
+    constexpr std::uint8_t CharCode = 0x73;
+    constexpr std::uint8_t Decimal32Code = 0x74;
+    constexpr std::uint8_t UlongCode = 0x80;
+    constexpr std::uint8_t LongCode = 0x81;
+    constexpr std::uint8_t DoubleCode = 0x82;
+    constexpr std::uint8_t TimestampCode = 0x83;
+    constexpr std::uint8_t Decimal64Code = 0x84;
+    constexpr std::uint8_t Decimal128Code = 0x94;
+    constexpr std::uint8_t UuidCode = 0x98;
+    constexpr std::uint8_t Binary8Code = 0xa0;
+    constexpr std::uint8_t String8Code = 0xa1;
+    constexpr std::uint8_t Symbol8Code = 0xa3;
+    constexpr std::uint8_t Binary32Code = 0xb0;
+    constexpr std::uint8_t String32Code = 0xb1;
+    constexpr std::uint8_t Symbol32Code = 0xb3;
+    constexpr std::uint8_t List8Code = 0xc0;
+    constexpr std::uint8_t Map8Code = 0xc1;
+    constexpr std::uint8_t List32Code = 0xd0;
+    constexpr std::uint8_t Map32Code = 0xd1;
+    constexpr std::uint8_t Array8Code = 0xe0;
+    constexpr std::uint8_t Array32Code = 0xf0;
+
+    constexpr size_t UuidSize = 16;
+  } // namespace
+
+  AmqpArena::AmqpArena(size_t blockSize) : m_blockSize{(std::max)(blockSize, size_t{64})} {}
+
+  void AmqpArena::AddBlock(size_t minimumSize)
+  {
+    auto const size = (std::max)(m_blockSize, minimumSize);
+    m_blocks.push_back(Block{std::unique_ptr<std::uint8_t[]>(new std::uint8_t[size]), size});
+    m_offset = 0;
+  }
+
+  void* AmqpArena::Allocate(size_t size, size_t alignment)
+  {
+    if (!m_blocks.empty())
+    {
+      auto& block = m_blocks.back();
+      auto const base = reinterpret_cast<std::uintptr_t>(block.Data.get());
+      auto const aligned = ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+      if (aligned <= block.Size && size <= block.Size - aligned)
+      {
+        m_offset = aligned + size;
+        return block.Data.get() + aligned;
+      }
+    }
+
+    // new[] returns memory suitably aligned for any fundamental type, so the start of a fresh
+    // block never needs padding.
+    AddBlock(size);
+    m_offset = size;
+    return m_blocks.back().Data.get();
+  }
+
+  void AmqpArena::Reset()
+  {
+    if (m_blocks.size() > 1)
+    {
+      auto const capacity = GetCapacity();
+      m_blocks.clear();
+      AddBlock(capacity);
+    }
+    m_offset = 0;
+  }
+
+  size_t AmqpArena::GetCapacity() const noexcept
+  {
+    size_t capacity = 0;
+    for (auto const& block : m_blocks)
+    {
+      capacity += block.Size;
+    }
+    return capacity;
+  }
+
+  std::string AmqpDecodedValue::AsString() const
+  {
+    if (Type != AmqpValueType::String && Type != AmqpValueType::Symbol)
+    {
+      throw std::runtime_error("AMQP value is not a string or symbol.");
+    }
+    return std::string(reinterpret_cast<char const*>(Bytes), Count);
+  }
+
+  AmqpValue AmqpDecodedValue::ToAmqpValue() const
+  {
+    switch (Type)
+    {
+      case AmqpValueType::Null:
+        return AmqpValue{};
+      case AmqpValueType::Bool:
+        return AmqpValue{Bool};
+      case AmqpValueType::Ubyte:
+        return AmqpValue{static_cast<std::uint8_t>(Unsigned)};
+      case AmqpValueType::Ushort:
+        return AmqpValue{static_cast<std::uint16_t>(Unsigned)};
+      case AmqpValueType::Uint:
+        return AmqpValue{static_cast<std::uint32_t>(Unsigned)};
+      case AmqpValueType::Ulong:
+        return AmqpValue{Unsigned};
+      case AmqpValueType::Byte:
+        return AmqpValue{static_cast<std::int8_t>(Signed)};
+      case AmqpValueType::Short:
+        return AmqpValue{static_cast<std::int16_t>(Signed)};
+      case AmqpValueType::Int:
+        return AmqpValue{static_cast<std::int32_t>(Signed)};
+      case AmqpValueType::Long:
+        return AmqpValue{Signed};
+      case AmqpValueType::Float:
+        return AmqpValue{Float};
+      case AmqpValueType::Double:
+        return AmqpValue{Double};
+      case AmqpValueType::Char:
+        return AmqpValue{Char};
+      case AmqpValueType::Timestamp:
+        return AmqpTimestamp{std::chrono::milliseconds{Signed}}.AsAmqpValue();
+      case AmqpValueType::Uuid: {
+        std::array<std::uint8_t, UuidSize> uuid;
+        std::memcpy(uuid.data(), Bytes, uuid.size());
+        return AmqpValue{Azure::Core::Uuid::CreateFromArray(uuid)};
+      }
+      case AmqpValueType::Binary:
+        return AmqpBinaryData{std::vector<std::uint8_t>(Bytes, Bytes + Count)}.AsAmqpValue();
+      case AmqpValueType::String:
+        return AmqpValue{AsString()};
+      case AmqpValueType::Symbol:
+        return AmqpSymbol{AsString()}.AsAmqpValue();
+      case AmqpValueType::List: {
+        AmqpList list;
+        for (std::uint32_t i = 0; i < Count; i += 1)
+        {
+          list.push_back(Items[i].ToAmqpValue());
+        }
+        return list.AsAmqpValue();
+      }
+      case AmqpValueType::Array: {
+        AmqpArray array;
+        for (std::uint32_t i = 0; i < Count; i += 1)
+        {
+          array.push_back(Items[i].ToAmqpValue());
+        }
+        return array.AsAmqpValue();
+      }
+      case AmqpValueType::Map: {
+        AmqpMap map;
+        for (std::uint32_t i = 0; i < Count; i += 2)
+        {
+          map.emplace(Items[i].ToAmqpValue(), Items[i + 1].ToAmqpValue());
+        }
+        return map.AsAmqpValue();
+      }
+      case AmqpValueType::Described: {
+        // AmqpDescribed only accepts ulong and symbol descriptors, so build the value directly.
+        auto descriptor{Items[0].ToAmqpValue()};
+        auto value{Items[1].ToAmqpValue()};
+        return AmqpValueFactory::FromUamqp(UniqueAmqpValueHandle{amqpvalue_create_described(
+            amqpvalue_clone(AmqpValueFactory::ToUamqp(descriptor)),
+            amqpvalue_clone(AmqpValueFactory::ToUamqp(value)))});
+      }
+      default:
+        throw std::runtime_error("Unsupported AMQP value type.");
+    }
+  }
+
+  std::uint8_t const* AmqpDecoder::Take(size_t size)
+  {
+    if (size > GetRemaining())
+    {
+      throw std::runtime_error("Unexpected end of AMQP encoded data.");
+    }
+    auto const rv = m_position;
+    m_position += size;
+    return rv;
+  }
+
+  std::uint64_t AmqpDecoder::ReadBigEndian(size_t width)
+  {
+    auto const bytes = Take(width);
+    std::uint64_t value = 0;
+    for (size_t i = 0; i < width; i += 1)
+    {
+      value = (value << 8) | bytes[i];
+    }
+    return value;
+  }
+
+  AmqpDecodedValue const& AmqpDecoder::DecodeNext()
+  {
+    auto value = m_arena.AllocateArray<AmqpDecodedValue>(1);
+    Decode(*value, 0);
+    return *value;
+  }
+
+  void AmqpDecoder::Decode(AmqpDecodedValue& value, int depth)
+  {
+    DecodePayload(value, *Take(1), depth);
+  }
+
+  void AmqpDecoder::DecodeVariable(AmqpDecodedValue& value, size_t sizeWidth)
+  {
+    auto const size = ReadBigEndian(sizeWidth);
+    value.Bytes = Take(static_cast<size_t>(size));
+    value.Count = static_cast<std::uint32_t>(size);
+  }
+
+  void AmqpDecoder::DecodeCompound(AmqpDecodedValue& value, size_t sizeWidth, int depth)
+  {
+    auto const size = static_cast<size_t>(ReadBigEndian(sizeWidth));
+    if (size < sizeWidth || size > GetRemaining())
+    {
+      throw std::runtime_error("Invalid size for AMQP compound value.");
+    }
+
+    // Decode the items against the end of this value so that an item cannot run past it.
+    auto const outerEnd = m_end;
+    m_end = m_position + size;
+    auto const count = ReadBigEndian(sizeWidth);
+    // Every encoded item occupies at least one byte, which bounds the count before anything is
+    // allocated for it.
+    if (count > GetRemaining())
+    {
+      throw std::runtime_error("Invalid count for AMQP compound value.");
+    }
+    value.Count = static_cast<std::uint32_t>(count);
+    if (value.Type == AmqpValueType::Map && (count % 2) != 0)
+    {
+      throw std::runtime_error("AMQP map must have an even number of items.");
+    }
+
+    if (value.Type == AmqpValueType::Array)
+    {
+      DecodeArrayElements(value, depth);
+    }
+    else
+    {
+      auto items = m_arena.AllocateArray<AmqpDecodedValue>(value.Count);
+      for (std::uint32_t i = 0; i < value.Count; i += 1)
+      {
+        Decode(items[i], depth + 1);
+      }
+      value.Items = items;
+    }
+
+    if (!IsAtEnd())
+    {
+      throw std::runtime_error("AMQP compound value size does not match its contents.");
+    }
+    m_end = outerEnd;
+  }
+
+  void AmqpDecoder::DecodeArrayElements(AmqpDecodedValue& value, int depth)
+  {
+    value.Items = nullptr;
+    if (value.Count == 0 && IsAtEnd())
+    {
+      // uAMQP omits the element constructor of an empty array.
+      return;
+    }
+
+    AmqpDecodedValue* descriptor = nullptr;
+    auto constructor = *Take(1);
+    if (constructor == DescribedCode)
+    {
+      descriptor = m_arena.AllocateArray<AmqpDecodedValue>(1);
+      Decode(*descriptor, depth + 1);
+      constructor = *Take(1);
+      if (constructor == DescribedCode)
+      {
+        throw std::runtime_error("Nested descriptors are not supported for AMQP array elements.");
+      }
+    }
+
+    auto items = m_arena.AllocateArray<AmqpDecodedValue>(value.Count);
+    for (std::uint32_t i = 0; i < value.Count; i += 1)
+    {
+      if (descriptor != nullptr)
+      {
+        auto described = m_arena.AllocateArray<AmqpDecodedValue>(2);
+        described[0] = *descriptor;
+        DecodePayload(described[1], constructor, depth + 1);
+        items[i].Type = AmqpValueType::Described;
+        items[i].Count = 2;
+        items[i].Items = described;
+      }
+      else
+      {
+        DecodePayload(items[i], constructor, depth + 1);
+      }
+    }
+    value.Items = items;
+  }
+
+  void AmqpDecoder::DecodePayload(AmqpDecodedValue& value, std::uint8_t constructor, int depth)
+  {
+    if (depth > MaxNestingDepth)
+    {
+      throw std::runtime_error("AMQP value is nested too deeply.");
+    }
+
+    value.Count = 0;
+    switch (constructor)
+    {
+      case DescribedCode: {
+        auto items = m_arena.AllocateArray<AmqpDecodedValue>(2);
+        Decode(items[0], depth + 1);
+        Decode(items[1], depth + 1);
+        value.Type = AmqpValueType::Described;
+        value.Count = 2;
+        value.Items = items;
+        break;
+      }
+      case NullCode:
+        value.Type = AmqpValueType::Null;
+        value.Unsigned = 0;
+        break;
+      case TrueCode:
+      case FalseCode:
+        value.Type = AmqpValueType::Bool;
+        value.Bool = (constructor == TrueCode);
+        break;
+      case BoolCode: {
+        auto const byte = *Take(1);
+        if (byte > 1)
+        {
+          throw std::runtime_error("Invalid AMQP boolean value.");
+        }
+        value.Type = AmqpValueType::Bool;
+        value.Bool = (byte == 1);
+        break;
+      }
+      case UbyteCode:
+        value.Type = AmqpValueType::Ubyte;
+        value.Unsigned = ReadBigEndian(1);
+        break;
+      case UshortCode:
+        value.Type = AmqpValueType::Ushort;
+        value.Unsigned = ReadBigEndian(2);
+        break;
+      case Uint0Code:
+        value.Type = AmqpValueType::Uint;
+        value.Unsigned = 0;
+        break;
+      case SmallUintCode:
+        value.Type = AmqpValueType::Uint;
+        value.Unsigned = ReadBigEndian(1);
+        break;
+      case UintCode:
+        value.Type = AmqpValueType::Uint;
+        value.Unsigned = ReadBigEndian(4);
+        break;
+      case Ulong0Code:
+        value.Type = AmqpValueType::Ulong;
+        value.Unsigned = 0;
+        break;
+      case SmallUlongCode:
+        value.Type = AmqpValueType::Ulong;
+        value.Unsigned = ReadBigEndian(1);
+        break;
+      case UlongCode:
+        value.Type = AmqpValueType::Ulong;
+        value.Unsigned = ReadBigEndian(8);
+        break;
+      case ByteCode:
+        value.Type = AmqpValueType::Byte;
+        value.Signed = static_cast<std::int8_t>(ReadBigEndian(1));
+        break;
+      case ShortCode:
+        value.Type = AmqpValueType::Short;
+        value.Signed = static_cast<std::int16_t>(ReadBigEndian(2));
+        break;
+      case SmallIntCode:
+        value.Type = AmqpValueType::Int;
+        value.Signed = static_cast<std::int8_t>(ReadBigEndian(1));
+        break;
+      case IntCode:
+        value.Type = AmqpValueType::Int;
+        value.Signed = static_cast<std::int32_t>(ReadBigEndian(4));
+        break;
+      case SmallLongCode:
+        value.Type = AmqpValueType::Long;
+        value.Signed = static_cast<std::int8_t>(ReadBigEndian(1));
+        break;
+      case LongCode:
+        value.Type = AmqpValueType::Long;
+        value.Signed = static_cast<std::int64_t>(ReadBigEndian(8));
+        break;
+      case FloatCode: {
+        auto const bits = static_cast<std::uint32_t>(ReadBigEndian(4));
+        value.Type = AmqpValueType::Float;
+        std::memcpy(&value.Float, &bits, sizeof(value.Float));
+        break;
+      }
+      case DoubleCode: {
+        auto const bits = ReadBigEndian(8);
+        value.Type = AmqpValueType::Double;
+        std::memcpy(&value.Double, &bits, sizeof(value.Double));
+        break;
+      }
+      case CharCode:
+        value.Type = AmqpValueType::Char;
+        value.Char = static_cast<char32_t>(ReadBigEndian(4));
+        break;
+      case TimestampCode:
+        value.Type = AmqpValueType::Timestamp;
+        value.Signed = static_cast<std::int64_t>(ReadBigEndian(8));
+        break;
+      case UuidCode:
+        value.Type = AmqpValueType::Uuid;
+        value.Bytes = Take(UuidSize);
+        break;
+      case Binary8Code:
+      case Binary32Code:
+        value.Type = AmqpValueType::Binary;
+        DecodeVariable(value, constructor == Binary8Code ? 1 : 4);
+        break;
+      case String8Code:
+      case String32Code:
+        value.Type = AmqpValueType::String;
+        DecodeVariable(value, constructor == String8Code ? 1 : 4);
+        break;
+      case Symbol8Code:
+      case Symbol32Code:
+        value.Type = AmqpValueType::Symbol;
+        DecodeVariable(value, constructor == Symbol8Code ? 1 : 4);
+        break;
+      case List0Code:
+        value.Type = AmqpValueType::List;
+        value.Items = nullptr;
+        break;
+      case List8Code:
+      case List32Code:
+        value.Type = AmqpValueType::List;
+        DecodeCompound(value, constructor == List8Code ? 1 : 4, depth);
+        break;
+      case Map8Code:
+      case Map32Code:
+        value.Type = AmqpValueType::Map;
+        DecodeCompound(value, constructor == Map8Code ? 1 : 4, depth);
+        break;
+      case Array8Code:
+      case Array32Code:
+        value.Type = AmqpValueType::Array;
+        DecodeCompound(value, constructor == Array8Code ? 1 : 4, depth);
+        break;
+      case Decimal32Code:
+      case Decimal64Code:
+      case Decimal128Code:
+        throw std::runtime_error("AMQP decimal values are not supported.");
+      default:
+        throw std::runtime_error("Unknown AMQP format code.");
+    }
+  }
+}}}}} // namespace Azure::Core::Amqp::Models::_detail
@@ -4,6 +4,7 @@
 #include "azure/core/amqp/models/amqp_message.hpp"
 
 #include "../amqp/private/unique_handle.hpp"
+#include "../models/private/amqp_codec.hpp"
 #include "../models/private/header_impl.hpp"
 #include "../models/private/message_impl.hpp"
 #include "../models/private/properties_impl.hpp"
@@ -17,8 +18,9 @@
 #include <azure_uamqp_c/amqp_definitions_footer.h>
 #include <azure_uamqp_c/message.h>
 
+#include <cstring>
 #include <iostream>
-#include <set>
+#include <limits>
 
 namespace Azure { namespace Core { namespace Amqp { namespace _detail {
   // @cond
@@ -249,11 +251,16 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
       throw std::runtime_error("Could not set destination message format.");
     }
 
-    if (message_set_header(rv.get(), _detail::MessageHeaderFactory::ToUamqp(message.Header).get()))
+    // Only set the header and properties when Serialize would write them, so the encoded size of
+    // a message matches its serialized size.
+    if (message.Header.ShouldSerialize()
+        && message_set_header(
+            rv.get(), _detail::MessageHeaderFactory::ToUamqp(message.Header).get()))
     {
       throw std::runtime_error("Could not set message header.");
     }
-    if (message_set_properties(
+    if (message.Properties.ShouldSerialize()
+        && message_set_properties(
             rv.get(), _detail::MessagePropertiesFactory::ToUamqp(message.Properties).get()))
     {
       throw std::runtime_error("Could not set message properties.");
@@ -420,38 +427,98 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
         && (m_binaryDataBody == that.m_binaryDataBody);
   }
 
+  namespace {
+    // Appends the bytes produced by amqpvalue_encode to the buffer passed as the context.
+    int AppendEncodedBytes(void* context, unsigned char const* bytes, size_t length)
+    {
+      auto buffer = static_cast<std::vector<uint8_t>*>(context);
+      buffer->insert(buffer->end(), bytes, bytes + length);
+      return 0;
+    }
+
+    void AppendEncodedValue(AMQP_VALUE value, std::vector<uint8_t>& buffer)
+    {
+      if (amqpvalue_encode(value, AppendEncodedBytes, &buffer))
+      {
+        throw std::runtime_error("Could not encode object");
+      }
+    }
+
+    // The header of an AMQP data section: the described type constructor and the descriptor,
+    // followed by the vbin8 or vbin32 constructor and the length of the binary value.
+    constexpr size_t DataSectionVbin8HeaderSize = 5;
+    constexpr size_t DataSectionVbin32HeaderSize = 8;
+
+    void WriteDataSectionHeader(std::uint8_t* header, size_t dataSize)
+    {
+      header[0] = 0x00; // Described type.
+      header[1] = 0x53; // smallulong descriptor.
+      header[2] = static_cast<std::uint8_t>(AmqpDescriptors::DataBinary);
+      if (dataSize <= 0xff)
+      {
+        header[3] = 0xa0; // vbin8
+        header[4] = static_cast<std::uint8_t>(dataSize);
+      }
+      else
+      {
+        header[3] = 0xb0; // vbin32
+        header[4] = static_cast<std::uint8_t>((dataSize >> 24) & 0xff);
+        header[5] = static_cast<std::uint8_t>((dataSize >> 16) & 0xff);
+        header[6] = static_cast<std::uint8_t>((dataSize >> 8) & 0xff);
+        header[7] = static_cast<std::uint8_t>(dataSize & 0xff);
+      }
+    }
+
+    void AppendDataSection(
+        std::uint8_t const* data,
+        size_t dataSize,
+        std::vector<uint8_t>& buffer)
+    {
+      std::uint8_t header[DataSectionVbin32HeaderSize];
+      WriteDataSectionHeader(header, dataSize);
+      buffer.insert(
+          buffer.end(),
+          header,
+          header
+              + (dataSize <= 0xff ? DataSectionVbin8HeaderSize : DataSectionVbin32HeaderSize));
+      buffer.insert(buffer.end(), data, data + dataSize);
+    }
+  } // namespace
+
   std::vector<uint8_t> AmqpMessage::Serialize(AmqpMessage const& message)
   {
     std::vector<uint8_t> rv;
+    Serialize(message, rv);
+    return rv;
+  }
 
-    // Append the message Header to the serialized message.
+  void AmqpMessage::Serialize(AmqpMessage const& message, std::vector<uint8_t>& buffer)
+  {
+    // Each section is encoded directly at the end of the buffer.
     if (message.Header.ShouldSerialize())
     {
-      auto serializedHeader = MessageHeader::Serialize(message.Header);
-      rv.insert(rv.end(), serializedHeader.begin(), serializedHeader.end());
+      auto header = _detail::MessageHeaderFactory::ToUamqp(message.Header);
+      _detail::UniqueAmqpValueHandle headerValue{amqpvalue_create_header(header.get())};
+      AppendEncodedValue(headerValue.get(), buffer);
     }
     if (!message.DeliveryAnnotations.empty())
     {
-      AmqpValue deliveryAnnotations{_detail::AmqpValueFactory::FromUamqp(
-          _detail::UniqueAmqpValueHandle{amqpvalue_create_delivery_annotations(
-              _detail::AmqpValueFactory::ToUamqp(message.DeliveryAnnotations.AsAmqpValue()))})};
-      auto serializedDeliveryAnnotations = AmqpValue::Serialize(deliveryAnnotations);
-      rv.insert(
-          rv.end(), serializedDeliveryAnnotations.begin(), serializedDeliveryAnnotations.end());
+      _detail::UniqueAmqpValueHandle deliveryAnnotations{amqpvalue_create_delivery_annotations(
+          _detail::AmqpValueFactory::ToUamqp(message.DeliveryAnnotations.AsAmqpValue()))};
+      AppendEncodedValue(deliveryAnnotations.get(), buffer);
     }
     if (!message.MessageAnnotations.empty())
     {
-      AmqpValue messageAnnotations{_detail::AmqpValueFactory::FromUamqp(
-          _detail::UniqueAmqpValueHandle{amqpvalue_create_message_annotations(
-              _detail::AmqpValueFactory::ToUamqp(message.MessageAnnotations.AsAmqpValue()))})};
-      auto serializedAnnotations = AmqpValue::Serialize(messageAnnotations);
-      rv.insert(rv.end(), serializedAnnotations.begin(), serializedAnnotations.end());
+      _detail::UniqueAmqpValueHandle messageAnnotations{amqpvalue_create_message_annotations(
+          _detail::AmqpValueFactory::ToUamqp(message.MessageAnnotations.AsAmqpValue()))};
+      AppendEncodedValue(messageAnnotations.get(), buffer);
     }
 
     if (message.Properties.ShouldSerialize())
     {
-      auto serializedMessageProperties = MessageProperties::Serialize(message.Properties);
-      rv.insert(rv.end(), serializedMessageProperties.begin(), serializedMessageProperties.end());
+      auto properties = _detail::MessagePropertiesFactory::ToUamqp(message.Properties);
+      _detail::UniqueAmqpValueHandle propertiesValue{amqpvalue_create_properties(properties.get())};
+      AppendEncodedValue(propertiesValue.get(), buffer);
     }
 
     if (!message.ApplicationProperties.empty())
@@ -469,12 +536,9 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
         }
         appProperties.emplace(val);
       }
-      AmqpValue propertiesValue{Models::_detail::AmqpValueFactory::FromUamqp(
-          Models::_detail::UniqueAmqpValueHandle{amqpvalue_create_application_properties(
-              Models::_detail::AmqpValueFactory::ToUamqp(appProperties.AsAmqpValue()))})};
-      auto serializedApplicationProperties = AmqpValue::Serialize(propertiesValue);
-      rv.insert(
-          rv.end(), serializedApplicationProperties.begin(), serializedApplicationProperties.end());
+      _detail::UniqueAmqpValueHandle propertiesValue{amqpvalue_create_application_properties(
+          _detail::AmqpValueFactory::ToUamqp(appProperties.AsAmqpValue()))};
+      AppendEncodedValue(propertiesValue.get(), buffer);
     }
 
     switch (message.BodyType)
@@ -488,17 +552,15 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
         // described body.
         AmqpDescribed describedBody(
             static_cast<std::uint64_t>(AmqpDescriptors::DataAmqpValue), message.m_amqpValueBody);
-        auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-        rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
+        AppendEncodedValue(
+            _detail::AmqpValueFactory::ToUamqp(describedBody.AsAmqpValue()), buffer);
       }
       break;
       case MessageBodyType::Data:
+        // Data sections are written directly, rather than copying each one into an AMQP value.
         for (auto const& val : message.m_binaryDataBody)
         {
-          AmqpDescribed describedBody(
-              static_cast<std::uint64_t>(AmqpDescriptors::DataBinary), val.AsAmqpValue());
-          auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-          rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
+          AppendDataSection(val.data(), val.size(), buffer);
         }
         break;
       case MessageBodyType::Sequence: {
@@ -506,234 +568,321 @@ namespace Azure { namespace Core { namespace Amqp { namespace Models {
         {
           AmqpDescribed describedBody(
               static_cast<std::uint64_t>(AmqpDescriptors::DataAmqpSequence), val.AsAmqpValue());
-          auto serializedBodyValue = AmqpValue::Serialize(describedBody.AsAmqpValue());
-          rv.insert(rv.end(), serializedBodyValue.begin(), serializedBodyValue.end());
+          AppendEncodedValue(
+              _detail::AmqpValueFactory::ToUamqp(describedBody.AsAmqpValue()), buffer);
         }
       }
     }
     if (!message.Footer.empty())
     {
-      AmqpValue footer{Models::_detail::AmqpValueFactory::FromUamqp(
-          Models::_detail::UniqueAmqpValueHandle{amqpvalue_create_footer(
-              Models::_detail::AmqpValueFactory::ToUamqp(message.Footer.AsAmqpValue()))})};
-      auto serializedFooter = AmqpValue::Serialize(footer);
-      rv.insert(rv.end(), serializedFooter.begin(), serializedFooter.end());
+      _detail::UniqueAmqpValueHandle footer{amqpvalue_create_footer(
+          _detail::AmqpValueFactory::ToUamqp(message.Footer.AsAmqpValue()))};
+      AppendEncodedValue(footer.get(), buffer);
     }
+  }
 
-    return rv;
+  size_t AmqpMessage::SerializeAsDataSection(
+      AmqpMessage const& message,
+      std::vector<uint8_t>& buffer)
+  {
+    // The size of the message isn't known until it has been serialized, so leave room for the
+    // larger data section header and move the message down if the smaller one is enough.
+    const size_t sectionOffset = buffer.size();
+    buffer.resize(sectionOffset + DataSectionVbin32HeaderSize);
+    try
+    {
+      Serialize(message, buffer);
+    }
+    catch (...)
+    {
+      buffer.resize(sectionOffset);
+      throw;
+    }
+    const size_t dataSize = buffer.size() - sectionOffset - DataSectionVbin32HeaderSize;
+    if (dataSize > (std::numeric_limits<std::uint32_t>::max)())
+    {
+      buffer.resize(sectionOffset);
+      throw std::runtime_error("Message is too large to be serialized as a data section.");
+    }
+    WriteDataSectionHeader(buffer.data() + sectionOffset, dataSize);
+    if (dataSize <= 0xff)
+    {
+      const size_t headerDelta = DataSectionVbin32HeaderSize - DataSectionVbin8HeaderSize;
+      std::memmove(
+          buffer.data() + sectionOffset + DataSectionVbin8HeaderSize,
+          buffer.data() + sectionOffset + DataSectionVbin32HeaderSize,
+          dataSize);
+      buffer.resize(buffer.size() - headerDelta);
+      return sectionOffset + DataSectionVbin8HeaderSize;
+    }
+    return sectionOffset + DataSectionVbin32HeaderSize;
   }
 
   namespace {
-    class AmqpMessageDeserializer final {
-    public:
-      AmqpMessageDeserializer()
-          : m_decoder{amqpvalue_decoder_create(OnAmqpMessageFieldDecodedFn, this)}
+    // Position of each message section in the order required by the AMQP specification; the
+    // body sections share a position.
+    int GetSectionOrder(AmqpDescriptors descriptor)
+    {
+      switch (descriptor)
       {
+        case AmqpDescriptors::Header:
+          return 0;
+        case AmqpDescriptors::DeliveryAnnotations:
+          return 1;
+        case AmqpDescriptors::MessageAnnotations:
+          return 2;
+        case AmqpDescriptors::Properties:
+          return 3;
+        case AmqpDescriptors::ApplicationProperties:
+          return 4;
+        case AmqpDescriptors::DataBinary:
+        case AmqpDescriptors::DataAmqpSequence:
+        case AmqpDescriptors::DataAmqpValue:
+          return 5;
+        case AmqpDescriptors::Footer:
+          return 6;
+        default:
+          throw std::runtime_error("Found message field is not in the set of expected fields.");
       }
+    }
 
-      AmqpMessage operator()(std::uint8_t const* data, size_t size) const
+    // Returns the field at index of a decoded list, or nullptr if the field is absent, null, or
+    // not of the expected type. This matches the uAMQP accessors, which ignore such fields.
+    AmqpDecodedValue const* GetListField(
+        AmqpDecodedValue const& list,
+        std::uint32_t index,
+        AmqpValueType expectedType)
+    {
+      if (index >= list.Count || list.Items[index].Type != expectedType)
       {
-        if (amqpvalue_decode_bytes(m_decoder.get(), data, size))
-        {
-          throw std::runtime_error("Could not decode object");
-        }
-        return m_decodedValue;
+        return nullptr;
       }
+      return &list.Items[index];
+    }
 
-    private:
-      UniqueAmqpDecoderHandle m_decoder;
-      AmqpMessage m_decodedValue;
-      // The message fields, in their expected order.
-      std::set<Amqp::_detail::AmqpDescriptors> m_expectedMessageFields{
-          AmqpDescriptors::Header,
-          AmqpDescriptors::DeliveryAnnotations,
-          AmqpDescriptors::MessageAnnotations,
-          AmqpDescriptors::Properties,
-          AmqpDescriptors::ApplicationProperties,
-          AmqpDescriptors::DataAmqpSequence,
-          AmqpDescriptors::DataAmqpValue,
-          AmqpDescriptors::DataBinary,
-          AmqpDescriptors::Footer};
+    Nullable<AmqpValue> GetListFieldValue(AmqpDecodedValue const& list, std::uint32_t index)
+    {
+      if (index >= list.Count || list.Items[index].Type == AmqpValueType::Null)
+      {
+        return {};
+      }
+      return list.Items[index].ToAmqpValue();
+    }
+
+    std::chrono::system_clock::time_point ToTimePoint(AmqpDecodedValue const& timestamp)
+    {
+      return std::chrono::system_clock::time_point{
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::milliseconds{timestamp.Signed})};
+    }
+
+    AmqpDecodedValue const& GetSectionValue(AmqpDecodedValue const& section, AmqpValueType type)
+    {
+      if (section.Items[1].Type != type)
+      {
+        throw std::runtime_error("Message field does not have the expected type.");
+      }
+      return section.Items[1];
+    }
 
-      // Invoked on each descriptor encountered while decrypting the message.
-      static void OnAmqpMessageFieldDecodedFn(void* context, AMQP_VALUE value)
+    AmqpMap ToAmqpMap(AmqpDecodedValue const& map)
+    {
+      AmqpMap rv;
+      for (std::uint32_t i = 0; i < map.Count; i += 2)
       {
-        auto deserializer = static_cast<AmqpMessageDeserializer*>(context);
+        rv.emplace(map.Items[i].ToAmqpValue(), map.Items[i + 1].ToAmqpValue());
+      }
+      return rv;
+    }
 
-        deserializer->OnAmqpMessageFieldDecoded(Models::_detail::AmqpValueFactory::FromUamqp(
-            _detail::UniqueAmqpValueHandle{amqpvalue_clone(value)}));
+    MessageHeader ToMessageHeader(AmqpDecodedValue const& header)
+    {
+      MessageHeader rv;
+      if (auto durable = GetListField(header, 0, AmqpValueType::Bool))
+      {
+        rv.Durable = durable->Bool;
+      }
+      if (auto priority = GetListField(header, 1, AmqpValueType::Ubyte))
+      {
+        rv.Priority = static_cast<std::uint8_t>(priority->Unsigned);
       }
+      if (auto ttl = GetListField(header, 2, AmqpValueType::Uint))
+      {
+        rv.TimeToLive = std::chrono::milliseconds(ttl->Unsigned);
+      }
+      if (auto firstAcquirer = GetListField(header, 3, AmqpValueType::Bool))
+      {
+        rv.IsFirstAcquirer = firstAcquirer->Bool;
+      }
+      if (auto deliveryCount = GetListField(header, 4, AmqpValueType::Uint))
+      {
+        rv.DeliveryCount = static_cast<std::uint32_t>(deliveryCount->Unsigned);
+      }
+      return rv;
+    }
 
-      // Invoked when a message field
-      void OnAmqpMessageFieldDecoded(AmqpValue value)
+    MessageProperties ToMessageProperties(AmqpDecodedValue const& properties)
+    {
+      MessageProperties rv;
+      rv.MessageId = GetListFieldValue(properties, 0);
+      if (auto userId = GetListField(properties, 1, AmqpValueType::Binary))
       {
-        if (value.GetType() != AmqpValueType::Described)
+        rv.UserId = std::vector<uint8_t>(userId->Bytes, userId->Bytes + userId->Count);
+      }
+      rv.To = GetListFieldValue(properties, 2);
+      if (auto subject = GetListField(properties, 3, AmqpValueType::String))
+      {
+        rv.Subject = subject->AsString();
+      }
+      rv.ReplyTo = GetListFieldValue(properties, 4);
+      rv.CorrelationId = GetListFieldValue(properties, 5);
+      if (auto contentType = GetListField(properties, 6, AmqpValueType::Symbol))
+      {
+        rv.ContentType = contentType->AsString();
+      }
+      if (auto contentEncoding = GetListField(properties, 7, AmqpValueType::Symbol))
+      {
+        rv.ContentEncoding = contentEncoding->AsString();
+      }
+      if (auto expiryTime = GetListField(properties, 8, AmqpValueType::Timestamp))
+      {
+        rv.AbsoluteExpiryTime = ToTimePoint(*expiryTime);
+      }
+      if (auto creationTime = GetListField(properties, 9, AmqpValueType::Timestamp))
+      {
+        rv.CreationTime = ToTimePoint(*creationTime);
+      }
+      if (auto groupId = GetListField(properties, 10, AmqpValueType::String))
+      {
+        rv.GroupId = groupId->AsString();
+      }
+      if (auto groupSequence = GetListField(properties, 11, AmqpValueType::Uint))
+      {
+        rv.GroupSequence = static_cast<std::uint32_t>(groupSequence->Unsigned);
+      }
+      if (auto replyToGroupId = GetListField(properties, 12, AmqpValueType::String))
+      {
+        rv.ReplyToGroupId = replyToGroupId->AsString();
+      }
+      return rv;
+    }
+
+    /*
+     * Builds an AmqpMessage from its encoded sections.
+     *
+     * The sections are decoded natively into an arena, so only the values which end up in the
+     * message model (annotations, application properties and the like) are allocated
+     * individually. Binary bodies are copied straight out of the input buffer.
+     */
+    class AmqpMessageDeserializer final {
+    public:
+      AmqpMessage operator()(std::uint8_t const* data, size_t size)
+      {
+        AmqpArena arena;
+        AmqpDecoder decoder(data, size, arena);
+        while (!decoder.IsAtEnd())
+        {
+          OnAmqpMessageFieldDecoded(decoder.DecodeNext());
+        }
+        return std::move(m_decodedValue);
+      }
+
+    private:
+      AmqpMessage m_decodedValue;
+      // Order of the most recently decoded section, see GetSectionOrder.
+      int m_lastSectionOrder{-1};
+      AmqpDescriptors m_lastSection{};
+
+      // Invoked on each message field decoded from the buffer.
+      void OnAmqpMessageFieldDecoded(AmqpDecodedValue const& field)
+      {
+        if (field.Type != AmqpValueType::Described)
         {
           throw std::runtime_error("Decoded message field whose type is NOT described.");
         }
-        AmqpDescribed describedType(value.AsDescribed());
-        if (describedType.GetDescriptor().GetType() != AmqpValueType::Ulong)
+        if (field.Items[0].Type != AmqpValueType::Ulong)
         {
           throw std::runtime_error("Decoded message field MUST be a LONG type.");
         }
 
-        AmqpDescriptors fieldDescriptor(
-            static_cast<AmqpDescriptors>(static_cast<uint64_t>(describedType.GetDescriptor())));
-        if (m_expectedMessageFields.find(fieldDescriptor) == m_expectedMessageFields.end())
+        auto const fieldDescriptor = static_cast<AmqpDescriptors>(field.Items[0].Unsigned);
+        auto const order = GetSectionOrder(fieldDescriptor);
+
+        // Sections must appear in order, and only once. The exceptions are the DataBinary and
+        // DataAmqpSequence sections, which can have more than one instance, but which cannot be
+        // mixed with each other or with an DataAmqpValue.
+        if (order < m_lastSectionOrder
+            || (order == m_lastSectionOrder
+                && (fieldDescriptor != m_lastSection
+                    || (fieldDescriptor != AmqpDescriptors::DataBinary
+                        && fieldDescriptor != AmqpDescriptors::DataAmqpSequence))))
         {
           throw std::runtime_error("Found message field is not in the set of expected fields.");
         }
-        else
-        {
-          // Once we've seen a field, we can remove that field from the set of expected fields,
-          // and also the fields which must come before it.
-          //
-          // The two exceptions are the DataBinary and DataAmqpSequence  fields, which can have
-          // more than one instance.
-          switch (fieldDescriptor)
-          {
-            case AmqpDescriptors::Header:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              break;
-            case AmqpDescriptors::DeliveryAnnotations:
-              // Once we've seen a DeliveryAnnotations, we no longer expect to see a Header or
-              // another DeliveryAnnotations.
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              break;
-            case AmqpDescriptors::MessageAnnotations:
-              // Once we've seen a MessageAnnotations, we no longer expect to see a Header,
-              // DeliveryAnnotations, or a MessageAnnotations.
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              break;
-            case AmqpDescriptors::Properties:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              break;
-            case AmqpDescriptors::ApplicationProperties:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              break;
-            case AmqpDescriptors::DataAmqpSequence:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataAmqpSequence, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              break;
-            case AmqpDescriptors::DataAmqpValue:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataAmqpValue, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              break;
-            case AmqpDescriptors::DataBinary:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataBinary, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              break;
-            case AmqpDescriptors::Footer:
-              m_expectedMessageFields.erase(AmqpDescriptors::Header);
-              m_expectedMessageFields.erase(AmqpDescriptors::DeliveryAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::MessageAnnotations);
-              m_expectedMessageFields.erase(AmqpDescriptors::Properties);
-              m_expectedMessageFields.erase(AmqpDescriptors::ApplicationProperties);
-              // When we see an DataBinary, we no longer expect to see any other data type.
-              m_expectedMessageFields.erase(AmqpDescriptors::DataBinary);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpValue);
-              m_expectedMessageFields.erase(AmqpDescriptors::DataAmqpSequence);
-              m_expectedMessageFields.erase(AmqpDescriptors::Footer);
-              break;
-            default:
-              throw std::runtime_error("Unknown message descriptor.");
-          }
-        }
+        m_lastSectionOrder = order;
+        m_lastSection = fieldDescriptor;
 
         switch (fieldDescriptor)
         {
-          case AmqpDescriptors::Header: {
-            UniqueMessageHeaderHandle messageHeader;
-            HEADER_HANDLE h;
-            if (amqpvalue_get_header(_detail::AmqpValueFactory::ToUamqp(value), &h))
-            {
-              throw std::runtime_error("Could not convert field to header.");
-            }
-            messageHeader.reset(h);
-            h = nullptr;
-            m_decodedValue.Header = _detail::MessageHeaderFactory::FromUamqp(messageHeader);
+          case AmqpDescriptors::Header:
+            m_decodedValue.Header
+                = ToMessageHeader(GetSectionValue(field, AmqpValueType::List));
             break;
-          }
           case AmqpDescriptors::DeliveryAnnotations:
-            m_decodedValue.DeliveryAnnotations = describedType.GetValue().AsMap();
+            m_decodedValue.DeliveryAnnotations
+                = ToAmqpMap(GetSectionValue(field, AmqpValueType::Map));
             break;
           case AmqpDescriptors::MessageAnnotations:
-            m_decodedValue.MessageAnnotations = describedType.GetValue().AsMap();
+            m_decodedValue.MessageAnnotations
+                = ToAmqpMap(GetSectionValue(field, AmqpValueType::Map));
             break;
-          case AmqpDescriptors::Properties: {
-            UniquePropertiesHandle properties;
-            PROPERTIES_HANDLE h;
-            if (amqpvalue_get_properties(_detail::AmqpValueFactory::ToUamqp(value), &h))
-            {
-              throw std::runtime_error("Could not convert field to header.");
-            }
-            properties.reset(h);
-            h = nullptr;
-            m_decodedValue.Properties = _detail::MessagePropertiesFactory::FromUamqp(properties);
+          case AmqpDescriptors::Properties:
+            m_decodedValue.Properties
+                = ToMessageProperties(GetSectionValue(field, AmqpValueType::List));
             break;
-          }
           case AmqpDescriptors::ApplicationProperties: {
-            auto propertyMap = describedType.GetValue().AsMap();
-            for (auto const& val : propertyMap)
+            auto const& propertyMap = GetSectionValue(field, AmqpValueType::Map);
+            for (std::uint32_t i = 0; i < propertyMap.Count; i += 2)
             {
-              if (val.first.GetType() != AmqpValueType::String)
+              auto const& key = propertyMap.Items[i];
+              auto const& value = propertyMap.Items[i + 1];
+              if (key.Type != AmqpValueType::String)
               {
                 throw std::runtime_error("Key of applications properties must be a string.");
               }
-              if ((val.second.GetType() == AmqpValueType::List)
-                  || (val.second.GetType() == AmqpValueType::Map)
-                  || (val.second.GetType() == AmqpValueType::Composite)
-                  || (val.second.GetType() == AmqpValueType::Described))
+              if ((value.Type == AmqpValueType::List) || (value.Type == AmqpValueType::Map)
+                  || (value.Type == AmqpValueType::Composite)
+                  || (value.Type == AmqpValueType::Described))
               {
                 throw std::runtime_error(
                     "Message Application Property values must be simple value types");
               }
-              m_decodedValue.ApplicationProperties.emplace(
-                  static_cast<std::string>(val.first), val.second);
+              m_decodedValue.ApplicationProperties.emplace(key.AsString(), value.ToAmqpValue());
             }
             break;
           }
           case AmqpDescriptors::DataAmqpValue:
-            m_decodedValue.SetBody(describedType.GetValue());
+            m_decodedValue.SetBody(field.Items[1].ToAmqpValue());
             break;
-          case AmqpDescriptors::DataAmqpSequence:
-            m_decodedValue.SetBody(describedType.GetValue().AsList());
+          case AmqpDescriptors::DataAmqpSequence: {
+            auto const& sequence = GetSectionValue(field, AmqpValueType::List);
+            AmqpList list;
+            for (std::uint32_t i = 0; i < sequence.Count; i += 1)
+            {
+              list.push_back(sequence.Items[i].ToAmqpValue());
+            }
+            m_decodedValue.SetBody(list);
             break;
-          case AmqpDescriptors::DataBinary:
+          }
+          case AmqpDescriptors::DataBinary: {
             // Each call to SetBody will append the binary value to the vector of binary bodies.
-            m_decodedValue.SetBody(describedType.GetValue().AsBinary());
+            auto const& data = GetSectionValue(field, AmqpValueType::Binary);
+            m_decodedValue.SetBody(
+                AmqpBinaryData{std::vector<std::uint8_t>(data.Bytes, data.Bytes + data.Count)});
             break;
+          }
           case AmqpDescriptors::Footer:
-            m_decodedValue.Footer = describedType.GetValue().AsMap();
+            m_decodedValue.Footer = ToAmqpMap(GetSectionValue(field, AmqpValueType::Map));
             break;
           default:
             throw std::runtime_error("Unknown message descriptor.");
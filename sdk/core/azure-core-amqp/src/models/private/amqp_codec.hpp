@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/amqp/models/amqp_value.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Models { namespace _detail {
+
+  /**
+   * @brief Monotonic allocator used to hold decoded AMQP values.
+   *
+   * Memory is handed out from large blocks and is only released when the arena is reset or
+   * destroyed, so decoding a value tree costs a handful of allocations instead of one per
+   * value. Reset keeps a single block large enough for everything allocated since the previous
+   * reset, so an arena reused for similarly sized payloads stops allocating altogether.
+   *
+   * @remarks Only trivially destructible objects may be placed in the arena; their destructors
+   * are never run.
+   */
+  class AmqpArena final {
+  public:
+    explicit AmqpArena(size_t blockSize = 4096);
+
+    AmqpArena(AmqpArena const&) = delete;
+    AmqpArena& operator=(AmqpArena const&) = delete;
+
+    /** @brief Allocate size bytes aligned to alignment, which must be a power of two. */
+    void* Allocate(size_t size, size_t alignment);
+
+    /** @brief Allocate uninitialized storage for count objects of type T. */
+    template <typename T> T* AllocateArray(size_t count)
+    {
+      static_assert(
+          std::is_trivially_destructible<T>::value,
+          "Only trivially destructible types can be allocated from an AmqpArena.");
+      if (count > (static_cast<size_t>(-1) / sizeof(T)))
+      {
+        throw std::length_error("AmqpArena allocation is too large.");
+      }
+      return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /** @brief Release everything allocated from the arena. */
+    void Reset();
+
+    /** @brief The number of bytes the arena has obtained from the heap. */
+    size_t GetCapacity() const noexcept;
+
+  private:
+    struct Block
+    {
+      std::unique_ptr<std::uint8_t[]> Data;
+      size_t Size;
+    };
+
+    void AddBlock(size_t minimumSize);
+
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    // Offset of the first free byte in the last block.
+    size_t m_offset{};
+  };
+
+  /**
+   * @brief An AMQP value decoded into an AmqpArena.
+   *
+   * Variable width values (binary, string, symbol and uuid) refer directly to the bytes of the
+   * buffer they were decoded from, so that buffer must outlive the decoded value.
+   */
+  struct AmqpDecodedValue final
+  {
+    AmqpValueType Type;
+
+    /**
+     * Number of bytes for Binary, String and Symbol values; number of entries in Items for
+     * List, Array, Map (keys and values interleaved) and Described (descriptor then value).
+     */
+    std::uint32_t Count;
+
+    union
+    {
+      bool Bool;
+      // Ubyte, Ushort, Uint and Ulong.
+      std::uint64_t Unsigned;
+      // Byte, Short, Int, Long and Timestamp (milliseconds since the Unix epoch).
+      std::int64_t Signed;
+      float Float;
+      double Double;
+      char32_t Char;
+      // Binary, String, Symbol and Uuid (always 16 bytes).
+      std::uint8_t const* Bytes;
+      AmqpDecodedValue const* Items;
+    };
+
+    /** @brief The characters of a String or Symbol value. */
+    std::string AsString() const;
+
+    /** @brief Copy this value into the uAMQP backed AmqpValue model. */
+    AmqpValue ToAmqpValue() const;
+  };
+
+  /**
+   * @brief Decodes a sequence of AMQP encoded values from a contiguous buffer.
+   *
+   * @remarks Malformed or truncated input results in a std::runtime_error.
+   */
+  class AmqpDecoder final {
+  public:
+    AmqpDecoder(std::uint8_t const* data, size_t size, AmqpArena& arena) noexcept
+        : m_position{data}, m_end{data + size}, m_arena(arena)
+    {
+    }
+
+    /** @brief True if every byte of the buffer has been decoded. */
+    bool IsAtEnd() const noexcept { return m_position == m_end; }
+
+    /** @brief The number of bytes which have not yet been decoded. */
+    size_t GetRemaining() const noexcept { return static_cast<size_t>(m_end - m_position); }
+
+    /** @brief Decode the next value in the buffer. */
+    AmqpDecodedValue const& DecodeNext();
+
+  private:
+    void Decode(AmqpDecodedValue& value, int depth);
+    void DecodePayload(AmqpDecodedValue& value, std::uint8_t constructor, int depth);
+    void DecodeCompound(AmqpDecodedValue& value, size_t sizeWidth, int depth);
+    void DecodeArrayElements(AmqpDecodedValue& value, int depth);
+    void DecodeVariable(AmqpDecodedValue& value, size_t sizeWidth);
+    std::uint64_t ReadBigEndian(size_t width);
+    std::uint8_t const* Take(size_t size);
+
+    std::uint8_t const* m_position;
+    std::uint8_t const* m_end;
+    AmqpArena& m_arena;
+  };
+}}}}} // namespace Azure::Core::Amqp::Models::_detail
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the AMQP decoder performance.
+ *
+ */
+
+#pragma once
+
+#include "models/private/amqp_codec.hpp"
+
+#include <azure/core.hpp>
+#include <azure/core/amqp/models/amqp_value.hpp>
+#include <azure/perf.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Test {
+
+  /**
+   * @brief Measure decoding a batch of AMQP encoded events with the native codec and with uAMQP.
+   */
+  class DecodeTest : public Azure::Perf::PerfTest {
+    enum class Codec
+    {
+      Native,
+      NativeModel,
+      Uamqp
+    };
+
+    Codec m_codec;
+    std::vector<std::uint8_t> m_encoded;
+    Azure::Core::Amqp::Models::_detail::AmqpArena m_arena;
+
+  public:
+    /**
+     * @brief Construct a new DecodeTest test.
+     *
+     * @param options The test options.
+     */
+    DecodeTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      using namespace Azure::Core::Amqp::Models;
+
+      auto const codec = m_options.GetOptionOrDefault<std::string>("Codec", "native");
+      m_codec = codec == "uamqp" ? Codec::Uamqp
+          : codec == "native-model" ? Codec::NativeModel
+                                    : Codec::Native;
+
+      auto const count = m_options.GetOptionOrDefault<size_t>("Count", 1000);
+      auto const bodySize = m_options.GetOptionOrDefault<size_t>("BodySize", 64);
+
+      // Each event is an application-properties section followed by a data section.
+      AmqpList batch;
+      for (size_t i = 0; i < count; i += 1)
+      {
+        batch.push_back(AmqpDescribed{
+            0x74,
+            AmqpMap{
+                {AmqpValue{"id"}, AmqpValue{static_cast<std::uint64_t>(i)}},
+                {AmqpValue{"source"}, AmqpValue{"perf"}}}
+                .AsAmqpValue()}
+                            .AsAmqpValue());
+        batch.push_back(
+            AmqpDescribed{
+                0x75, AmqpBinaryData{std::vector<std::uint8_t>(bodySize, 0x5a)}.AsAmqpValue()}
+                .AsAmqpValue());
+      }
+      m_encoded = AmqpValue::Serialize(batch.AsAmqpValue());
+    }
+
+    /**
+     * @brief Decode the batch.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      using namespace Azure::Core::Amqp::Models;
+
+      switch (m_codec)
+      {
+        case Codec::Native: {
+          _detail::AmqpDecoder decoder(m_encoded.data(), m_encoded.size(), m_arena);
+          decoder.DecodeNext();
+          m_arena.Reset();
+          break;
+        }
+        case Codec::NativeModel: {
+          _detail::AmqpDecoder decoder(m_encoded.data(), m_encoded.size(), m_arena);
+          decoder.DecodeNext().ToAmqpValue();
+          m_arena.Reset();
+          break;
+        }
+        case Codec::Uamqp: {
+          AmqpValue::Deserialize(m_encoded.data(), m_encoded.size());
+          break;
+        }
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Codec",
+           {"--codec"},
+           "native (decode only), native-model (decode and build AmqpValue) or uamqp. Default "
+           "native.",
+           1,
+           false},
+          {"Count", {"--count"}, "Number of events in the batch. Default 1000.", 1, false},
+          {"BodySize", {"--bodySize"}, "Size of each event body in bytes. Default 64.", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "decode",
+          "Measures decoding a batch of AMQP encoded events",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Amqp::Test::DecodeTest>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Core::Amqp::Test
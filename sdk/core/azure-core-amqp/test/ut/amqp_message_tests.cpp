@@ -254,6 +254,43 @@ TEST_F(MessageSerialization, SerializeMessageBodyBinary)
     EXPECT_EQ(deserialized.GetBodyAsBinary().size(), 2);
     EXPECT_EQ(message, deserialized);
   }
+  // Large binary bodies are encoded as vbin32.
+  {
+    std::vector<uint8_t> buffer;
+    AmqpMessage message;
+    message.SetBody(AmqpBinaryData(std::vector<uint8_t>(300, 'a')));
+    message.SetBody(AmqpBinaryData{});
+    buffer = AmqpMessage::Serialize(message);
+    AmqpMessage deserialized = AmqpMessage::Deserialize(buffer.data(), buffer.size());
+    EXPECT_EQ(message, deserialized);
+  }
+}
+
+// Messages serialized as the data sections of a batched message.
+TEST_F(MessageSerialization, SerializeAsDataSection)
+{
+  std::vector<uint8_t> buffer{1, 2, 3};
+  std::vector<size_t> offsets;
+  std::vector<uint8_t> expected{buffer};
+  for (size_t bodySize : {0, 10, 240, 260, 70000})
+  {
+    AmqpMessage message;
+    message.Properties.MessageId = "12345";
+    message.MessageAnnotations["x-opt-partition-key"] = "key";
+    message.SetBody(AmqpBinaryData(std::vector<uint8_t>(bodySize, 'a')));
+    auto serialized = AmqpMessage::Serialize(message);
+
+    // The data section matches the one encoded for an AMQP described binary value.
+    auto section = AmqpValue::Serialize(
+        AmqpDescribed{0x75, AmqpBinaryData(serialized).AsAmqpValue()}.AsAmqpValue());
+    expected.insert(expected.end(), section.begin(), section.end());
+
+    auto offset = AmqpMessage::SerializeAsDataSection(message, buffer);
+    EXPECT_EQ(buffer, expected);
+    EXPECT_EQ(offset, buffer.size() - serialized.size());
+    AmqpMessage deserialized = AmqpMessage::Deserialize(buffer.data() + offset, serialized.size());
+    EXPECT_EQ(message, deserialized);
+  }
 }
 
 TEST_F(MessageSerialization, SerializeMessageBodySequence)
@@ -385,3 +422,52 @@ TEST_F(MessageSerialization, SerializeMessageWithFooter)
     EXPECT_EQ(message, deserialized);
   }
 }
+
+TEST_F(MessageSerialization, DeserializeSectionOrder)
+{
+  auto section = [](std::uint64_t descriptor, AmqpValue const& value) {
+    return AmqpValue::Serialize(AmqpDescribed{descriptor, value}.AsAmqpValue());
+  };
+  auto concatenate = [](std::initializer_list<std::vector<uint8_t>> sections) {
+    std::vector<uint8_t> buffer;
+    for (auto const& section : sections)
+    {
+      buffer.insert(buffer.end(), section.begin(), section.end());
+    }
+    return buffer;
+  };
+  auto const header = section(0x70, AmqpList{AmqpValue{true}}.AsAmqpValue());
+  auto const annotations
+      = section(0x72, AmqpMap{{AmqpSymbol{"x-opt-key"}.AsAmqpValue(), AmqpValue{1}}}.AsAmqpValue());
+  auto const data = section(0x75, AmqpBinaryData{1, 2, 3}.AsAmqpValue());
+  auto const value = section(0x77, AmqpValue{"value"});
+  auto const footer = section(0x78, AmqpMap{}.AsAmqpValue());
+
+  {
+    auto buffer = concatenate({header, annotations, data, data, footer});
+    AmqpMessage message = AmqpMessage::Deserialize(buffer.data(), buffer.size());
+    EXPECT_TRUE(message.Header.Durable);
+    EXPECT_EQ(1u, message.MessageAnnotations.size());
+    EXPECT_EQ(MessageBodyType::Data, message.BodyType);
+    EXPECT_EQ(2u, message.GetBodyAsBinary().size());
+  }
+
+  // Out of order, repeated, and mixed body sections are rejected.
+  for (auto const& buffer :
+       {concatenate({annotations, header}),
+        concatenate({header, header}),
+        concatenate({data, value}),
+        concatenate({value, value}),
+        concatenate({footer, data}),
+        section(0x79, AmqpList{}.AsAmqpValue()),
+        section(0x70, AmqpMap{}.AsAmqpValue())})
+  {
+    EXPECT_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size()), std::runtime_error);
+  }
+
+  // Truncated sections are rejected.
+  {
+    auto buffer = concatenate({header, data});
+    EXPECT_THROW(AmqpMessage::Deserialize(buffer.data(), buffer.size() - 1), std::runtime_error);
+  }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/amqp/internal/common/global_state.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core::Amqp::Common::_detail;
+
+namespace {
+class CountingPollable final : public Pollable {
+public:
+  void Poll() override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pollCount += 1;
+    m_polled.notify_all();
+  }
+
+  int PollCount()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pollCount;
+  }
+
+  // Waits for the pollable to be polled more than `count` times. The timeout only keeps a broken
+  // polling thread from hanging the test, it is not the latency being tested.
+  bool WaitForPoll(int count)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_polled.wait_for(
+        lock, std::chrono::seconds(30), [this, count]() { return m_pollCount > count; });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_polled;
+  int m_pollCount{0};
+};
+} // namespace
+
+TEST(GlobalStateTests, PollsAddedPollable)
+{
+  auto pollable = std::make_shared<CountingPollable>();
+  GlobalStateHolder::GlobalStateInstance()->AddPollable(pollable);
+  EXPECT_TRUE(pollable->WaitForPoll(0));
+  GlobalStateHolder::GlobalStateInstance()->RemovePollable(pollable);
+
+  // Once removed, the pollable is not polled anymore.
+  auto const pollCount = pollable->PollCount();
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  EXPECT_EQ(pollable->PollCount(), pollCount);
+  GlobalStateHolder::GlobalStateInstance()->AssertIdle();
+}
+
+TEST(GlobalStateTests, NotifiedPollableIsPolledRightAway)
+{
+  // With idle waits this long, a pollable can only be polled again because it was notified.
+  GlobalStateHolder::GlobalStateInstance()->SetPollingIntervals(
+      std::chrono::hours(1), std::chrono::hours(1));
+
+  auto pollable = std::make_shared<CountingPollable>();
+  GlobalStateHolder::GlobalStateInstance()->AddPollable(pollable);
+  EXPECT_TRUE(pollable->WaitForPoll(0));
+  for (int i = 0; i < 10; i += 1)
+  {
+    auto const pollCount = pollable->PollCount();
+    GlobalStateHolder::GlobalStateInstance()->NotifyPollable(*pollable);
+    EXPECT_TRUE(pollable->WaitForPoll(pollCount));
+    // A notification is followed by a single poll, then the thread waits for the next one.
+    EXPECT_EQ(pollable->PollCount(), pollCount + 1);
+  }
+  GlobalStateHolder::GlobalStateInstance()->RemovePollable(pollable);
+
+  GlobalStateHolder::GlobalStateInstance()->SetPollingIntervals(
+      MinPollingInterval, MaxPollingInterval);
+}
@@ -16,8 +16,13 @@
 
 #include <azure/core/platform.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <future>
+#include <mutex>
 #include <random>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -357,10 +362,164 @@ namespace Azure { namespace Core { namespace Amqp { namespace Tests {
 
       sender.Close();
     }
+    {
+      // Pipeline more messages than the unsettled delivery window allows; SendAsync should block
+      // at the window and every message should still complete.
+      MessageSenderOptions options;
+      options.Name = "sender-link-pipelined";
+      options.MessageSource = "ingress";
+      options.SettleMode = SenderSettleMode::Settled;
+      options.MaxMessageSize = 65536;
+      options.MaxUnsettledDeliveries = 8;
+      MessageSender sender(session.CreateMessageSender("localhost/ingress", options, nullptr));
+      EXPECT_FALSE(sender.Open());
+
+      Azure::Core::Amqp::Models::AmqpMessage message;
+      message.SetBody(Azure::Core::Amqp::Models::AmqpBinaryData{'h', 'e', 'l', 'l', 'o'});
+
+      constexpr int messageCount = 50;
+      Common::_internal::AsyncOperationQueue<MessageSendStatus> sendResults;
+      for (int i = 0; i < messageCount; i += 1)
+      {
+        sender.SendAsync(
+            message,
+            [&sendResults](MessageSendStatus status, Models::_internal::AmqpError const&) {
+              sendResults.CompleteOperation(status);
+            },
+            receiveContext);
+      }
+      for (int i = 0; i < messageCount; i += 1)
+      {
+        auto result = sendResults.WaitForResult(receiveContext);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<0>(*result), MessageSendStatus::Ok);
+      }
+
+      sender.Close();
+    }
+    receiveContext.Cancel();
+    mockServer.StopListening();
+  }
+  TEST_F(TestMessageSendReceive, SenderSendAsyncWaitsForSettlement)
+  {
+    // Holds the disposition of the messages it receives until the test releases them. This blocks
+    // the polling thread, which is fine here: nothing the test waits for needs it until then.
+    class HoldSettlementEndpoint : public MessageTests::MockServiceEndpoint {
+    public:
+      HoldSettlementEndpoint(
+          std::string const& name,
+          MessageTests::MockServiceEndpointOptions const& options)
+          : MockServiceEndpoint(name, options)
+      {
+      }
+      virtual ~HoldSettlementEndpoint() = default;
+
+      void ReleaseSettlement()
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_released = true;
+        }
+        m_releasedCondition.notify_all();
+      }
+
+      Azure::Core::Amqp::Models::AmqpValue OnMessageReceived(
+          MessageReceiver const& receiver,
+          std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const& message) override
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_releasedCondition.wait_for(
+              lock, std::chrono::seconds(15), [this]() { return m_released; });
+        }
+        return MockServiceEndpoint::OnMessageReceived(receiver, message);
+      }
+
+    private:
+      std::mutex m_mutex;
+      std::condition_variable m_releasedCondition;
+      bool m_released{false};
+
+      void MessageReceived(
+          std::string const& linkName,
+          std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage> const& message) override
+      {
+        GTEST_LOG_(INFO) << "Message received on link " << linkName << ": " << *message;
+      }
+    };
+
+    MessageTests::MockServiceEndpointOptions mockServiceEndpointOptions{};
+    auto senderEndpoint = std::make_shared<HoldSettlementEndpoint>(
+        "localhost/ingress", mockServiceEndpointOptions);
+    MessageTests::AmqpServerMock mockServer{};
+    mockServer.AddServiceEndpoint(senderEndpoint);
+
+    ConnectionOptions connectionOptions;
+    connectionOptions.ContainerId = "some";
+    connectionOptions.Port = mockServer.GetPort();
+    Connection connection("localhost", nullptr, connectionOptions);
+    Session session{connection.CreateSession()};
+
+    Azure::Core::Context receiveContext = Azure::Core::Context::ApplicationContext.WithDeadline(
+        Azure::DateTime::clock::now() + std::chrono::seconds(15));
+
+    mockServer.StartListening();
+
+    {
+      MessageSenderOptions options;
+      options.Name = "sender-link-unsettled";
+      options.MessageSource = "ingress";
+      options.SettleMode = SenderSettleMode::Unsettled;
+      options.MaxMessageSize = 65536;
+      options.MaxUnsettledDeliveries = 2;
+      MessageSender sender(session.CreateMessageSender("localhost/ingress", options, nullptr));
+      EXPECT_FALSE(sender.Open());
+
+      Azure::Core::Amqp::Models::AmqpMessage message;
+      message.SetBody(Azure::Core::Amqp::Models::AmqpBinaryData{'h', 'e', 'l', 'l', 'o'});
+
+      Common::_internal::AsyncOperationQueue<MessageSendStatus> sendResults;
+      auto onSendComplete
+          = [&sendResults](MessageSendStatus status, Models::_internal::AmqpError const&) {
+              sendResults.CompleteOperation(status);
+            };
+
+      // Fill the window. The service doesn't settle either delivery yet.
+      sender.SendAsync(message, onSendComplete, receiveContext);
+      sender.SendAsync(message, onSendComplete, receiveContext);
+
+      std::promise<void> thirdSendQueued;
+      auto thirdSendQueuedFuture = thirdSendQueued.get_future();
+      std::thread thirdSend([&]() {
+        sender.SendAsync(message, onSendComplete, receiveContext);
+        thirdSendQueued.set_value();
+      });
+
+      // The next send waits for room in the window...
+      EXPECT_EQ(
+          thirdSendQueuedFuture.wait_for(std::chrono::milliseconds(500)),
+          std::future_status::timeout);
+
+      // ... until the service settles a delivery.
+      senderEndpoint->ReleaseSettlement();
+      EXPECT_EQ(
+          thirdSendQueuedFuture.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+      thirdSend.join();
+
+      for (int i = 0; i < 3; i += 1)
+      {
+        auto result = sendResults.WaitForResult(receiveContext);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<0>(*result), MessageSendStatus::Ok);
+      }
+
+      sender.Close();
+    }
     receiveContext.Cancel();
     mockServer.StopListening();
   }
 
+
   TEST_F(TestMessageSendReceive, SenderSendSync)
   {
     class SenderLinkEndpoint final : public MessageTests::MockServiceEndpoint {
@@ -0,0 +1,479 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "amqp_encoder.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using Azure::Core::Amqp::Models::AmqpValueType;
+using Azure::Core::Amqp::Models::_detail::AmqpDecodedValue;
+
+namespace Azure { namespace Core { namespace Amqp { namespace Tests {
+
+  namespace {
+    // AMQP format codes, from section 1.6 of the AMQP 1.0 core types specification.
+    constexpr std::uint8_t DescribedCode = 0x00;
+    constexpr std::uint8_t NullCode = 0x40;
+    constexpr std::uint8_t TrueCode = 0x41;
+    constexpr std::uint8_t FalseCode = 0x42;
+    constexpr std::uint8_t Uint0Code = 0x43;
+    constexpr std::uint8_t Ulong0Code = 0x44;
+    constexpr std::uint8_t List0Code = 0x45;
+    constexpr std::uint8_t UbyteCode = 0x50;
+    constexpr std::uint8_t ByteCode = 0x51;
+    constexpr std::uint8_t SmallUintCode = 0x52;
+    constexpr std::uint8_t SmallUlongCode = 0x53;
+    constexpr std::uint8_t SmallIntCode = 0x54;
+    constexpr std::uint8_t SmallLongCode = 0x55;
+    constexpr std::uint8_t BoolCode = 0x56;
+    constexpr std::uint8_t UshortCode = 0x60;
+    constexpr std::uint8_t ShortCode = 0x61;
+    constexpr std::uint8_t UintCode = 0x70;
+    constexpr std::uint8_t IntCode = 0x71;
+    constexpr std::uint8_t FloatCode = 0x72;
+    constexpr std::uint8_t CharCode = 0x73;
+    constexpr std::uint8_t UlongCode = 0x80;
+    constexpr std::uint8_t LongCode = 0x81;
+    constexpr std::uint8_t DoubleCode = 0x82;
+    constexpr std::uint8_t TimestampCode = 0x83;
+    constexpr std::uint8_t UuidCode = 0x98;
+    constexpr std::uint8_t Binary8Code = 0xa0;
+    constexpr std::uint8_t String8Code = 0xa1;
+    constexpr std::uint8_t Symbol8Code = 0xa3;
+    constexpr std::uint8_t Binary32Code = 0xb0;
+    constexpr std::uint8_t String32Code = 0xb1;
+    constexpr std::uint8_t Symbol32Code = 0xb3;
+    constexpr std::uint8_t List8Code = 0xc0;
+    constexpr std::uint8_t Map8Code = 0xc1;
+    constexpr std::uint8_t List32Code = 0xd0;
+    constexpr std::uint8_t Map32Code = 0xd1;
+    constexpr std::uint8_t Array8Code = 0xe0;
+    constexpr std::uint8_t Array32Code = 0xf0;
+
+    // The 32 bit form of a compound or variable width encoding is 0x10 above the 8 bit form.
+    constexpr std::uint8_t Wide = 0x10;
+
+    constexpr size_t UuidSize = 16;
+
+    size_t CheckedAdd(size_t left, size_t right)
+    {
+      if (right > (std::numeric_limits<std::uint32_t>::max)() - left)
+      {
+        throw std::runtime_error("AMQP value is too large to encode.");
+      }
+      return left + right;
+    }
+
+    size_t ItemsSize(AmqpDecodedValue const& value);
+    size_t ElementSize(AmqpDecodedValue const& value);
+
+    // Size of the constructor shared by the elements of an array, starting with element.
+    size_t ElementConstructorSize(AmqpDecodedValue const& element)
+    {
+      if (element.Type == AmqpValueType::Described)
+      {
+        return 1 + AmqpEncoder::GetEncodedSize(element.Items[0])
+            + ElementConstructorSize(element.Items[1]);
+      }
+      return 1;
+    }
+
+    // Size of an array body following its count: the element constructor and the elements.
+    size_t ArrayContentSize(AmqpDecodedValue const& value)
+    {
+      if (value.Count == 0)
+      {
+        return 0;
+      }
+      size_t size = ElementConstructorSize(value.Items[0]);
+      for (std::uint32_t i = 0; i < value.Count; i += 1)
+      {
+        if (value.Items[i].Type != value.Items[0].Type)
+        {
+          throw std::runtime_error("All elements of an AMQP array must have the same type.");
+        }
+        size = CheckedAdd(size, ElementSize(value.Items[i]));
+      }
+      return size;
+    }
+
+    // Size of every item of a list or map, each with its own constructor.
+    size_t ItemsSize(AmqpDecodedValue const& value)
+    {
+      size_t size = 0;
+      for (std::uint32_t i = 0; i < value.Count; i += 1)
+      {
+        size = CheckedAdd(size, AmqpEncoder::GetEncodedSize(value.Items[i]));
+      }
+      return size;
+    }
+
+    // Size of a compound value with an 8 or 32 bit size and count, given the size of its items.
+    size_t CompoundSize(size_t itemsSize, size_t count)
+    {
+      return (count <= 255 && itemsSize < 255) ? 3 + itemsSize : CheckedAdd(9, itemsSize);
+    }
+
+    // Size of an array element, which is encoded without a constructor.
+    size_t ElementSize(AmqpDecodedValue const& value)
+    {
+      switch (value.Type)
+      {
+        case AmqpValueType::Null:
+          return 0;
+        case AmqpValueType::Bool:
+        case AmqpValueType::Ubyte:
+        case AmqpValueType::Byte:
+          return 1;
+        case AmqpValueType::Ushort:
+        case AmqpValueType::Short:
+          return 2;
+        case AmqpValueType::Uint:
+        case AmqpValueType::Int:
+        case AmqpValueType::Float:
+        case AmqpValueType::Char:
+          return 4;
+        case AmqpValueType::Ulong:
+        case AmqpValueType::Long:
+        case AmqpValueType::Double:
+        case AmqpValueType::Timestamp:
+          return 8;
+        case AmqpValueType::Uuid:
+          return UuidSize;
+        case AmqpValueType::Binary:
+        case AmqpValueType::String:
+        case AmqpValueType::Symbol:
+          return CheckedAdd(4, value.Count);
+        case AmqpValueType::List:
+        case AmqpValueType::Map:
+          return CheckedAdd(8, ItemsSize(value));
+        case AmqpValueType::Array:
+          return CheckedAdd(8, ArrayContentSize(value));
+        case AmqpValueType::Described:
+          return ElementSize(value.Items[1]);
+        default:
+          throw std::runtime_error("Unsupported AMQP value type.");
+      }
+    }
+  } // namespace
+
+  size_t AmqpEncoder::GetEncodedSize(AmqpDecodedValue const& value)
+  {
+    switch (value.Type)
+    {
+      case AmqpValueType::Null:
+      case AmqpValueType::Bool:
+        return 1;
+      case AmqpValueType::Uint:
+      case AmqpValueType::Ulong:
+        if (value.Unsigned == 0)
+        {
+          return 1;
+        }
+        return (value.Unsigned <= 255) ? 2 : 1 + ElementSize(value);
+      case AmqpValueType::Int:
+      case AmqpValueType::Long:
+        return (value.Signed >= -128 && value.Signed <= 127) ? 2 : 1 + ElementSize(value);
+      case AmqpValueType::Binary:
+      case AmqpValueType::String:
+      case AmqpValueType::Symbol:
+        return (value.Count <= 255) ? 2 + value.Count : CheckedAdd(5, value.Count);
+      case AmqpValueType::List:
+        return (value.Count == 0) ? 1 : CompoundSize(ItemsSize(value), value.Count);
+      case AmqpValueType::Map:
+        return CompoundSize(ItemsSize(value), value.Count);
+      case AmqpValueType::Array:
+        return CompoundSize(ArrayContentSize(value), value.Count);
+      case AmqpValueType::Described:
+        return CheckedAdd(1 + GetEncodedSize(value.Items[0]), GetEncodedSize(value.Items[1]));
+      default:
+        return 1 + ElementSize(value);
+    }
+  }
+
+  void AmqpEncoder::Append(std::uint8_t const* bytes, size_t size)
+  {
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+  }
+
+  void AmqpEncoder::AppendBigEndian(std::uint64_t value, size_t width)
+  {
+    for (size_t i = width; i > 0; i -= 1)
+    {
+      Append(static_cast<std::uint8_t>(value >> ((i - 1) * 8)));
+    }
+  }
+
+  void AmqpEncoder::EncodeCompoundHeader(std::uint8_t constructor8, size_t size, size_t count)
+  {
+    // The encoded size covers the count as well as the items.
+    if (count <= 255 && size < 255)
+    {
+      Append(constructor8);
+      Append(static_cast<std::uint8_t>(size + 1));
+      Append(static_cast<std::uint8_t>(count));
+    }
+    else
+    {
+      Append(static_cast<std::uint8_t>(constructor8 + Wide));
+      AppendBigEndian(CheckedAdd(size, 4), 4);
+      AppendBigEndian(count, 4);
+    }
+  }
+
+  void AmqpEncoder::Encode(AmqpDecodedValue const& value)
+  {
+    switch (value.Type)
+    {
+      case AmqpValueType::Null:
+        Append(NullCode);
+        break;
+      case AmqpValueType::Bool:
+        Append(value.Bool ? TrueCode : FalseCode);
+        break;
+      case AmqpValueType::Uint:
+      case AmqpValueType::Ulong: {
+        bool const isUint = (value.Type == AmqpValueType::Uint);
+        if (value.Unsigned == 0)
+        {
+          Append(isUint ? Uint0Code : Ulong0Code);
+        }
+        else if (value.Unsigned <= 255)
+        {
+          Append(isUint ? SmallUintCode : SmallUlongCode);
+          Append(static_cast<std::uint8_t>(value.Unsigned));
+        }
+        else
+        {
+          EncodeElementConstructor(value);
+          EncodeArrayElement(value);
+        }
+        break;
+      }
+      case AmqpValueType::Int:
+      case AmqpValueType::Long:
+        if (value.Signed >= -128 && value.Signed <= 127)
+        {
+          Append(value.Type == AmqpValueType::Int ? SmallIntCode : SmallLongCode);
+          Append(static_cast<std::uint8_t>(value.Signed));
+        }
+        else
+        {
+          EncodeElementConstructor(value);
+          EncodeArrayElement(value);
+        }
+        break;
+      case AmqpValueType::Binary:
+      case AmqpValueType::String:
+      case AmqpValueType::Symbol:
+        if (value.Count <= 255)
+        {
+          Append(
+              value.Type == AmqpValueType::Binary
+                  ? Binary8Code
+                  : (value.Type == AmqpValueType::String ? String8Code : Symbol8Code));
+          Append(static_cast<std::uint8_t>(value.Count));
+          Append(value.Bytes, value.Count);
+        }
+        else
+        {
+          EncodeElementConstructor(value);
+          EncodeArrayElement(value);
+        }
+        break;
+      case AmqpValueType::List:
+        if (value.Count == 0)
+        {
+          Append(List0Code);
+          break;
+        }
+        EncodeCompoundHeader(List8Code, ItemsSize(value), value.Count);
+        for (std::uint32_t i = 0; i < value.Count; i += 1)
+        {
+          Encode(value.Items[i]);
+        }
+        break;
+      case AmqpValueType::Map:
+        EncodeCompoundHeader(Map8Code, ItemsSize(value), value.Count);
+        for (std::uint32_t i = 0; i < value.Count; i += 1)
+        {
+          Encode(value.Items[i]);
+        }
+        break;
+      case AmqpValueType::Array:
+        EncodeCompoundHeader(Array8Code, ArrayContentSize(value), value.Count);
+        EncodeArrayContent(value);
+        break;
+      case AmqpValueType::Described:
+        Append(DescribedCode);
+        Encode(value.Items[0]);
+        Encode(value.Items[1]);
+        break;
+      default:
+        // Fixed width values have a single encoding, which is the one used for array elements.
+        EncodeElementConstructor(value);
+        EncodeArrayElement(value);
+        break;
+    }
+  }
+
+  void AmqpEncoder::EncodeArrayContent(AmqpDecodedValue const& value)
+  {
+    if (value.Count == 0)
+    {
+      return;
+    }
+    EncodeElementConstructor(value.Items[0]);
+    for (std::uint32_t i = 0; i < value.Count; i += 1)
+    {
+      EncodeArrayElement(value.Items[i]);
+    }
+  }
+
+  void AmqpEncoder::EncodeElementConstructor(AmqpDecodedValue const& value)
+  {
+    switch (value.Type)
+    {
+      case AmqpValueType::Null:
+        Append(NullCode);
+        break;
+      case AmqpValueType::Bool:
+        Append(BoolCode);
+        break;
+      case AmqpValueType::Ubyte:
+        Append(UbyteCode);
+        break;
+      case AmqpValueType::Ushort:
+        Append(UshortCode);
+        break;
+      case AmqpValueType::Uint:
+        Append(UintCode);
+        break;
+      case AmqpValueType::Ulong:
+        Append(UlongCode);
+        break;
+      case AmqpValueType::Byte:
+        Append(ByteCode);
+        break;
+      case AmqpValueType::Short:
+        Append(ShortCode);
+        break;
+      case AmqpValueType::Int:
+        Append(IntCode);
+        break;
+      case AmqpValueType::Long:
+        Append(LongCode);
+        break;
+      case AmqpValueType::Float:
+        Append(FloatCode);
+        break;
+      case AmqpValueType::Double:
+        Append(DoubleCode);
+        break;
+      case AmqpValueType::Char:
+        Append(CharCode);
+        break;
+      case AmqpValueType::Timestamp:
+        Append(TimestampCode);
+        break;
+      case AmqpValueType::Uuid:
+        Append(UuidCode);
+        break;
+      case AmqpValueType::Binary:
+        Append(Binary32Code);
+        break;
+      case AmqpValueType::String:
+        Append(String32Code);
+        break;
+      case AmqpValueType::Symbol:
+        Append(Symbol32Code);
+        break;
+      case AmqpValueType::List:
+        Append(List32Code);
+        break;
+      case AmqpValueType::Map:
+        Append(Map32Code);
+        break;
+      case AmqpValueType::Array:
+        Append(Array32Code);
+        break;
+      case AmqpValueType::Described:
+        Append(DescribedCode);
+        Encode(value.Items[0]);
+        EncodeElementConstructor(value.Items[1]);
+        break;
+      default:
+        throw std::runtime_error("Unsupported AMQP value type.");
+    }
+  }
+
+  void AmqpEncoder::EncodeArrayElement(AmqpDecodedValue const& value)
+  {
+    switch (value.Type)
+    {
+      case AmqpValueType::Null:
+        break;
+      case AmqpValueType::Bool:
+        Append(static_cast<std::uint8_t>(value.Bool ? 1 : 0));
+        break;
+      case AmqpValueType::Ubyte:
+      case AmqpValueType::Ushort:
+      case AmqpValueType::Uint:
+      case AmqpValueType::Ulong:
+        AppendBigEndian(value.Unsigned, ElementSize(value));
+        break;
+      case AmqpValueType::Byte:
+      case AmqpValueType::Short:
+      case AmqpValueType::Int:
+      case AmqpValueType::Long:
+      case AmqpValueType::Timestamp:
+        AppendBigEndian(static_cast<std::uint64_t>(value.Signed), ElementSize(value));
+        break;
+      case AmqpValueType::Float: {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value.Float, sizeof(bits));
+        AppendBigEndian(bits, sizeof(bits));
+        break;
+      }
+      case AmqpValueType::Double: {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value.Double, sizeof(bits));
+        AppendBigEndian(bits, sizeof(bits));
+        break;
+      }
+      case AmqpValueType::Char:
+        AppendBigEndian(value.Char, 4);
+        break;
+      case AmqpValueType::Uuid:
+        Append(value.Bytes, UuidSize);
+        break;
+      case AmqpValueType::Binary:
+      case AmqpValueType::String:
+      case AmqpValueType::Symbol:
+        AppendBigEndian(value.Count, 4);
+        Append(value.Bytes, value.Count);
+        break;
+      case AmqpValueType::List:
+      case AmqpValueType::Map:
+        AppendBigEndian(CheckedAdd(ItemsSize(value), 4), 4);
+        AppendBigEndian(value.Count, 4);
+        for (std::uint32_t i = 0; i < value.Count; i += 1)
+        {
+          Encode(value.Items[i]);
+        }
+        break;
+      case AmqpValueType::Array:
+        AppendBigEndian(CheckedAdd(ArrayContentSize(value), 4), 4);
+        AppendBigEndian(value.Count, 4);
+        EncodeArrayContent(value);
+        break;
+      case AmqpValueType::Described:
+        EncodeArrayElement(value.Items[1]);
+        break;
+      default:
+        throw std::runtime_error("Unsupported AMQP value type.");
+    }
+  }
+}}}} // namespace Azure::Core::Amqp::Tests
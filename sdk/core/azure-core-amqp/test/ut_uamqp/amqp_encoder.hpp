@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "../src/models/private/amqp_codec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Amqp { namespace Tests {
+
+  /**
+   * @brief Appends the AMQP encoding of decoded values to a buffer.
+   *
+   * The encoder picks the same encodings as uAMQP does, so a value decoded from uAMQP output is
+   * re-encoded to identical bytes. It is only used to check the native decoder against uAMQP:
+   * messages are still encoded by uAMQP.
+   */
+  class AmqpEncoder final {
+  public:
+    explicit AmqpEncoder(std::vector<std::uint8_t>& buffer) noexcept : m_buffer(buffer) {}
+
+    /** @brief Append the encoding of value to the buffer. */
+    void Encode(Models::_detail::AmqpDecodedValue const& value);
+
+    /** @brief The number of bytes Encode would append for value. */
+    static size_t GetEncodedSize(Models::_detail::AmqpDecodedValue const& value);
+
+  private:
+    void EncodeArrayElement(Models::_detail::AmqpDecodedValue const& value);
+    void EncodeElementConstructor(Models::_detail::AmqpDecodedValue const& value);
+    void EncodeArrayContent(Models::_detail::AmqpDecodedValue const& value);
+    void EncodeCompoundHeader(std::uint8_t constructor8, size_t size, size_t count);
+    void Append(std::uint8_t byte) { m_buffer.push_back(byte); }
+    void Append(std::uint8_t const* bytes, size_t size);
+    void AppendBigEndian(std::uint64_t value, size_t width);
+
+    std::vector<std::uint8_t>& m_buffer;
+  };
+}}}} // namespace Azure::Core::Amqp::Tests
@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../src/models/private/amqp_codec.hpp"
+#include "amqp_encoder.hpp"
+#include "azure/core/amqp/models/amqp_message.hpp"
+#include "azure/core/amqp/models/amqp_value.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core::Amqp::Models;
+using namespace Azure::Core::Amqp::Models::_detail;
+using Azure::Core::Amqp::Tests::AmqpEncoder;
+
+class TestCodec : public testing::Test {
+protected:
+  // Encode value with uAMQP, then check that the native decoder reads back the same value and
+  // that the native encoder reproduces the uAMQP encoding byte for byte.
+  static void ValidateRoundTrip(AmqpValue const& value)
+  {
+    auto const encoded = AmqpValue::Serialize(value);
+
+    AmqpArena arena;
+    AmqpDecoder decoder(encoded.data(), encoded.size(), arena);
+    auto const& decoded = decoder.DecodeNext();
+    EXPECT_TRUE(decoder.IsAtEnd());
+    EXPECT_EQ(value.GetType(), decoded.Type);
+    EXPECT_EQ(value, decoded.ToAmqpValue());
+
+    EXPECT_EQ(encoded.size(), AmqpEncoder::GetEncodedSize(decoded));
+    std::vector<std::uint8_t> reencoded;
+    AmqpEncoder{reencoded}.Encode(decoded);
+    EXPECT_EQ(encoded, reencoded);
+  }
+
+  static void ExpectDecodeFailure(std::vector<std::uint8_t> const& encoded)
+  {
+    AmqpArena arena;
+    AmqpDecoder decoder(encoded.data(), encoded.size(), arena);
+    EXPECT_THROW(decoder.DecodeNext(), std::runtime_error);
+  }
+};
+
+TEST_F(TestCodec, ScalarValues)
+{
+  ValidateRoundTrip(AmqpValue{});
+  ValidateRoundTrip(AmqpValue{true});
+  ValidateRoundTrip(AmqpValue{false});
+
+  for (std::uint8_t value : {std::uint8_t{0}, std::uint8_t{0x7f}, std::uint8_t{0xff}})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::uint16_t value : {std::uint16_t{0}, std::uint16_t{0x1234}, std::uint16_t{0xffff}})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::uint32_t value : {0u, 1u, 255u, 256u, 0xfedcba98u})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::uint64_t value :
+       {std::uint64_t{0},
+        std::uint64_t{255},
+        std::uint64_t{256},
+        std::uint64_t{0xfedcba9876543210}})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::int8_t value : {std::int8_t{-128}, std::int8_t{0}, std::int8_t{127}})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::int16_t value : {std::int16_t{-32768}, std::int16_t{-1}, std::int16_t{32767}})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::int32_t value : {-2147483647 - 1, -129, -128, 0, 127, 128, 2147483647})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+  for (std::int64_t value :
+       {std::numeric_limits<std::int64_t>::min(),
+        std::int64_t{-129},
+        std::int64_t{-128},
+        std::int64_t{127},
+        std::int64_t{128},
+        std::numeric_limits<std::int64_t>::max()})
+  {
+    ValidateRoundTrip(AmqpValue{value});
+  }
+
+  ValidateRoundTrip(AmqpValue{3.25f});
+  ValidateRoundTrip(AmqpValue{-1.0e300});
+  ValidateRoundTrip(AmqpTimestamp{std::chrono::milliseconds{1718000000123}}.AsAmqpValue());
+  ValidateRoundTrip(AmqpTimestamp{std::chrono::milliseconds{-1}}.AsAmqpValue());
+  ValidateRoundTrip(AmqpValue{Azure::Core::Uuid::CreateUuid()});
+}
+
+TEST_F(TestCodec, VariableWidthValues)
+{
+  for (size_t size : {0, 1, 255, 256, 70000})
+  {
+    std::string text(size, 'a');
+    ValidateRoundTrip(AmqpValue{text});
+    ValidateRoundTrip(AmqpSymbol{text}.AsAmqpValue());
+
+    std::vector<std::uint8_t> bytes(size);
+    for (size_t i = 0; i < bytes.size(); i += 1)
+    {
+      bytes[i] = static_cast<std::uint8_t>(i * 31);
+    }
+    ValidateRoundTrip(AmqpBinaryData{bytes}.AsAmqpValue());
+  }
+}
+
+TEST_F(TestCodec, CompoundValues)
+{
+  ValidateRoundTrip(AmqpList{}.AsAmqpValue());
+  ValidateRoundTrip(AmqpMap{}.AsAmqpValue());
+  ValidateRoundTrip(AmqpArray{}.AsAmqpValue());
+
+  AmqpList list{
+      AmqpValue{},
+      AmqpValue{true},
+      AmqpValue{std::uint32_t{1000}},
+      AmqpValue{"string"},
+      AmqpSymbol{"symbol"}.AsAmqpValue(),
+      AmqpList{AmqpValue{1}, AmqpList{}.AsAmqpValue()}.AsAmqpValue(),
+      AmqpMap{{AmqpValue{"key"}, AmqpValue{std::uint64_t{12}}}}.AsAmqpValue(),
+      AmqpArray{AmqpValue{1}, AmqpValue{2}, AmqpValue{3}}.AsAmqpValue()};
+  ValidateRoundTrip(list.AsAmqpValue());
+
+  ValidateRoundTrip(AmqpMap{
+      {AmqpValue{"a"}, AmqpValue{1}},
+      {AmqpSymbol{"b"}.AsAmqpValue(), list.AsAmqpValue()},
+      {AmqpValue{std::uint64_t{3}}, AmqpBinaryData{1, 2, 3}.AsAmqpValue()}}
+                        .AsAmqpValue());
+
+  ValidateRoundTrip(AmqpArray{AmqpValue{"one"}, AmqpValue{"two"}}.AsAmqpValue());
+  ValidateRoundTrip(AmqpArray{
+      AmqpList{AmqpValue{1}}.AsAmqpValue(),
+      AmqpList{AmqpValue{2}, AmqpValue{"two"}}.AsAmqpValue()}
+                        .AsAmqpValue());
+
+  // Lists, maps and arrays whose size or count does not fit in a byte.
+  {
+    AmqpList bigList;
+    AmqpArray bigArray;
+    AmqpMap bigMap;
+    for (std::uint32_t i = 0; i < 300; i += 1)
+    {
+      bigList.push_back(AmqpValue{i});
+      bigArray.push_back(AmqpValue{i});
+      bigMap.emplace(AmqpValue{i}, AmqpValue{"value"});
+    }
+    ValidateRoundTrip(bigList.AsAmqpValue());
+    ValidateRoundTrip(bigArray.AsAmqpValue());
+    ValidateRoundTrip(bigMap.AsAmqpValue());
+    ValidateRoundTrip(
+        AmqpList{AmqpBinaryData{std::vector<std::uint8_t>(300)}.AsAmqpValue()}.AsAmqpValue());
+  }
+
+  ValidateRoundTrip(AmqpDescribed{0x75, AmqpBinaryData{1, 2, 3}.AsAmqpValue()}.AsAmqpValue());
+  ValidateRoundTrip(AmqpDescribed{AmqpSymbol{"com.microsoft:test"}, list.AsAmqpValue()}
+                        .AsAmqpValue());
+}
+
+// A serialized message is a sequence of described sections which can be decoded one at a time.
+TEST_F(TestCodec, MessageSections)
+{
+  AmqpMessage message;
+  message.Header.Durable = true;
+  message.Header.DeliveryCount = 3;
+  message.Properties.MessageId = AmqpValue{"message-id"};
+  message.Properties.ContentType = "application/octet-stream";
+  message.Properties.CreationTime = std::chrono::system_clock::time_point{
+      std::chrono::milliseconds{1718000000123}};
+  message.MessageAnnotations["x-opt-partition-key"] = "key";
+  message.ApplicationProperties.emplace("count", AmqpValue{42});
+  message.SetBody(AmqpBinaryData{std::vector<std::uint8_t>(300, 0x5a)});
+  message.SetBody(AmqpBinaryData{1, 2, 3});
+
+  auto const serialized = AmqpMessage::Serialize(message);
+
+  AmqpArena arena;
+  AmqpDecoder decoder(serialized.data(), serialized.size(), arena);
+  std::vector<std::uint8_t> reencoded;
+  AmqpEncoder encoder{reencoded};
+  std::vector<std::uint64_t> descriptors;
+  while (!decoder.IsAtEnd())
+  {
+    auto const& section = decoder.DecodeNext();
+    ASSERT_EQ(AmqpValueType::Described, section.Type);
+    ASSERT_EQ(AmqpValueType::Ulong, section.Items[0].Type);
+    descriptors.push_back(section.Items[0].Unsigned);
+    encoder.Encode(section);
+  }
+  EXPECT_EQ(serialized, reencoded);
+  EXPECT_EQ(
+      (std::vector<std::uint64_t>{0x70, 0x72, 0x73, 0x74, 0x75, 0x75}), descriptors);
+}
+
+TEST_F(TestCodec, MalformedInput)
+{
+  // Every truncation of a value is detected.
+  auto const encoded = AmqpValue::Serialize(
+      AmqpList{
+          AmqpValue{"string"},
+          AmqpValue{std::uint64_t{0x123456789}},
+          AmqpMap{{AmqpValue{1}, AmqpBinaryData{1, 2, 3}.AsAmqpValue()}}.AsAmqpValue()}
+          .AsAmqpValue());
+  for (size_t size = 0; size < encoded.size(); size += 1)
+  {
+    ExpectDecodeFailure(std::vector<std::uint8_t>(encoded.begin(), encoded.begin() + size));
+  }
+
+  // Unknown and unsupported format codes.
+  ExpectDecodeFailure({0xff});
+  ExpectDecodeFailure({0x74, 0x00, 0x00, 0x00, 0x00});
+  // Boolean which is neither true nor false.
+  ExpectDecodeFailure({0x56, 0x02});
+  // List whose size covers more than its items.
+  ExpectDecodeFailure({0xc0, 0x03, 0x01, 0x40, 0x40});
+  // List whose count exceeds its size.
+  ExpectDecodeFailure({0xc0, 0x01, 0x05});
+  // Map with a key but no value.
+  ExpectDecodeFailure({0xc1, 0x02, 0x01, 0x40});
+  // Descriptors nested beyond the supported depth.
+  ExpectDecodeFailure(std::vector<std::uint8_t>(100, 0x00));
+}
+
+TEST_F(TestCodec, ArenaReuse)
+{
+  AmqpArena arena(256);
+  for (int i = 0; i < 100; i += 1)
+  {
+    auto values = arena.AllocateArray<AmqpDecodedValue>(4);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values) % alignof(AmqpDecodedValue));
+  }
+  auto const capacity = arena.GetCapacity();
+  EXPECT_GE(capacity, 400 * sizeof(AmqpDecodedValue));
+
+  // After a reset the same allocations fit in the memory the arena already holds.
+  arena.Reset();
+  EXPECT_EQ(capacity, arena.GetCapacity());
+  for (int i = 0; i < 100; i += 1)
+  {
+    arena.AllocateArray<AmqpDecodedValue>(4);
+  }
+  EXPECT_EQ(capacity, arena.GetCapacity());
+
+  // Allocations larger than a block get a block of their own.
+  arena.Allocate(10000, 1);
+  EXPECT_GE(arena.GetCapacity(), capacity + 10000);
+}
@@ -13,6 +13,7 @@
 #include "azure/core/nullable.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -26,6 +27,12 @@ namespace Azure { namespace Core { namespace Http {
      *
      */
     constexpr std::chrono::milliseconds DefaultConnectionTimeout = std::chrono::minutes(5);
+
+    /**
+     * @brief Default maximum number of idle connections kept in the connection pool for each host.
+     *
+     */
+    constexpr size_t DefaultMaxIdleConnectionsPerHost = 1024;
   } // namespace _detail
 
   /**
@@ -194,6 +201,102 @@ namespace Azure { namespace Core { namespace Http {
      * @brief If set, integrates libcurl's internal tracing with Azure logging.
      */
     bool EnableCurlTracing = false;
+
+    /**
+     * @brief If set, the requests are performed by a single, process-wide thread driving the
+     * libcurl multi interface instead of each request reading and writing its own socket.
+     *
+     * @details Use this option when many requests are in flight at the same time. The event loop
+     * thread sends the requests and receives the responses of every transfer at once. The response
+     * body is buffered by the event loop and the thread reading it only copies it out of the
+     * buffer. Connections are kept by the libcurl multi handle instead of the transport connection
+     * pool.
+     *
+     * @remark The `Send` method is still synchronous and blocks the calling thread until the
+     * response headers are received.
+     *
+     * @remark The option is ignored on Linux when
+     * #CurlTransportSslOptions::EnableCertificateRevocationListCheck is set.
+     *
+     * @warning Requires libcurl >= 7.68.0. The option is ignored with older versions.
+     */
+    bool EnableSharedEventLoop = false;
+
+    /**
+     * @brief If set, the transport negotiates HTTP/2 with the server and sends concurrent requests
+     * to the same host as streams multiplexed over a single connection.
+     *
+     * @details The requests are sent with the libcurl multi interface instead of going through
+     * the HTTP/1.1 connection pool. This saves a TCP and TLS handshake, and a socket, for each
+     * concurrent request to the same host. HTTP/1.1 is used when the server doesn't support
+     * HTTP/2.
+     *
+     * @remark The option is ignored when libcurl was built without HTTP/2 support and, on Linux,
+     * when #CurlTransportSslOptions::EnableCertificateRevocationListCheck is set.
+     *
+     * @warning Requires libcurl >= 8.1.0. The option is ignored with older versions, where
+     * multiplexed streams can stall.
+     */
+    bool EnableHttp2 = false;
+
+    /**
+     * @brief Maximum number of idle connections the connection pool keeps for each host.
+     *
+     * @details When a connection is returned to the pool and the limit has been reached, the least
+     * recently used connection for the host is closed.
+     *
+     * @remark The limit is applied to connections created with the same options. The default value
+     * is 1024.
+     */
+    size_t MaxIdleConnectionsPerHost = _detail::DefaultMaxIdleConnectionsPerHost;
+
+    /**
+     * @brief Number of idle connections for each host that are kept open by the connection pool
+     * even after they are not used for a while.
+     *
+     * @remark The default value is 0, which means any connection that is not re-used for 60
+     * seconds is closed.
+     */
+    size_t MinIdleConnectionsPerHost = 0;
+  };
+
+  /**
+   * @brief Counters for the connection pool shared by all the #CurlTransport instances.
+   *
+   */
+  struct CurlConnectionPoolStatistics final
+  {
+    /**
+     * @brief Number of requests that re-used an idle connection from the pool.
+     *
+     */
+    uint64_t Hits = 0;
+
+    /**
+     * @brief Number of requests that had to open a new connection because there was no idle
+     * connection in the pool.
+     *
+     */
+    uint64_t Misses = 0;
+
+    /**
+     * @brief Number of idle connections closed by the pool, either because the maximum number of
+     * idle connections was reached, because they expired or because the pool was reset.
+     *
+     */
+    uint64_t Evictions = 0;
+
+    /**
+     * @brief Total time spent by requests waiting to access the connection pool.
+     *
+     */
+    std::chrono::nanoseconds WaitTime{0};
+
+    /**
+     * @brief Number of idle connections currently in the pool.
+     *
+     */
+    size_t IdleConnections = 0;
   };
 
   /**
@@ -245,6 +348,14 @@ namespace Azure { namespace Core { namespace Http {
      * @return unique ptr to an HTTP RawResponse.
      */
     std::unique_ptr<RawResponse> Send(Request& request, Context const& context) override;
+
+    /**
+     * @brief Gets the current counters of the connection pool shared by all the #CurlTransport
+     * instances in the application.
+     *
+     * @return A snapshot of the connection pool counters.
+     */
+    static CurlConnectionPoolStatistics GetConnectionPoolStatistics();
   };
 
 }}} // namespace Azure::Core::Http
@@ -27,6 +27,7 @@
 #include <set>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -132,6 +133,31 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
     CaseInsensitiveSet AllowedHttpHeaders = _detail::g_defaultAllowedHttpHeaders;
   };
 
+  /**
+   * @brief Options for renewing the access tokens used to authenticate requests.
+   *
+   * @details By default, a token is renewed by the first request that finds it within
+   * #Azure::Core::Credentials::TokenRequestContext::MinimumExpiration of expiring, and the other
+   * requests wait for the renewal.
+   */
+  struct TokenRefreshOptions final
+  {
+    /**
+     * @brief Renew the token on a background thread when it is within this duration of needing
+     * a renewal, so that no request waits for it. Requests keep using the current token while the
+     * renewal runs.
+     *
+     * @remark Zero, the default, disables background renewal.
+     */
+    DateTime::duration BackgroundRefreshMargin{};
+
+    /**
+     * @brief When the token needs a renewal but hasn't expired yet, keep using it for the other
+     * requests while one request renews it, instead of making them wait for the renewal.
+     */
+    bool ServeStaleTokenWhileRefreshing = false;
+  };
+
   /**
    * @brief HTTP transport options parameterize the HTTP transport adapter being used.
    */
@@ -546,12 +572,26 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      */
     class BearerTokenAuthenticationPolicy : public HttpPolicy {
     private:
+      // Shared with the background renewal thread.
+      struct AccessTokenState final
+      {
+        Credentials::AccessToken AccessToken;
+        Credentials::TokenRequestContext AccessTokenContext;
+        std::shared_timed_mutex Mutex;
+        bool IsRefreshing = false;
+        // Cancelled when the policy is destroyed, so that a renewal in progress stops early.
+        Context RefreshContext;
+        std::thread RefreshThread;
+      };
+
       std::shared_ptr<Credentials::TokenCredential const> const m_credential;
       Credentials::TokenRequestContext m_tokenRequestContext;
+      TokenRefreshOptions m_tokenRefreshOptions;
+
+      std::shared_ptr<AccessTokenState> const m_accessTokenState;
 
-      mutable Credentials::AccessToken m_accessToken;
-      mutable std::shared_timed_mutex m_accessTokenMutex;
-      mutable Credentials::TokenRequestContext m_accessTokenContext;
+      void RefreshTokenInBackground(
+          Credentials::TokenRequestContext const& tokenRequestContext) const;
 
     public:
       /**
@@ -559,15 +599,25 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
        *
        * @param credential An #Azure::Core::TokenCredential to use with this policy.
        * @param tokenRequestContext A context to get the token in.
+       * @param tokenRefreshOptions How the token is renewed.
        */
       explicit BearerTokenAuthenticationPolicy(
           std::shared_ptr<Credentials::TokenCredential const> credential,
-          Credentials::TokenRequestContext tokenRequestContext)
+          Credentials::TokenRequestContext tokenRequestContext,
+          TokenRefreshOptions tokenRefreshOptions = {})
           : m_credential(std::move(credential)),
-            m_tokenRequestContext(std::move(tokenRequestContext))
+            m_tokenRequestContext(std::move(tokenRequestContext)),
+            m_tokenRefreshOptions(std::move(tokenRefreshOptions)),
+            m_accessTokenState(std::make_shared<AccessTokenState>())
       {
       }
 
+      /**
+       * @brief Cancels the background token renewal, if any, and waits for it to complete.
+       *
+       */
+      ~BearerTokenAuthenticationPolicy() override;
+
       std::unique_ptr<HttpPolicy> Clone() const override
       {
         // Can't use std::make_shared here because copy constructor is not public.
@@ -581,11 +631,14 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
 
     protected:
       BearerTokenAuthenticationPolicy(BearerTokenAuthenticationPolicy const& other)
-          : BearerTokenAuthenticationPolicy(other.m_credential, other.m_tokenRequestContext)
+          : BearerTokenAuthenticationPolicy(
+              other.m_credential,
+              other.m_tokenRequestContext,
+              other.m_tokenRefreshOptions)
       {
-        std::shared_lock<std::shared_timed_mutex> readLock(other.m_accessTokenMutex);
-        m_accessToken = other.m_accessToken;
-        m_accessTokenContext = other.m_accessTokenContext;
+        std::shared_lock<std::shared_timed_mutex> readLock(other.m_accessTokenState->Mutex);
+        m_accessTokenState->AccessToken = other.m_accessTokenState->AccessToken;
+        m_accessTokenState->AccessTokenContext = other.m_accessTokenState->AccessTokenContext;
       }
 
       void operator=(BearerTokenAuthenticationPolicy const&) = delete;
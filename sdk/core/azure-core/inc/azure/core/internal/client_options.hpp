@@ -71,6 +71,7 @@ namespace Azure { namespace Core { namespace _internal {
       this->Transport = other.Transport;
       this->Telemetry = other.Telemetry;
       this->Log = other.Log;
+      this->TokenRefresh = other.TokenRefresh;
       this->PerOperationPolicies.reserve(other.PerOperationPolicies.size());
       for (auto& policy : other.PerOperationPolicies)
       {
@@ -107,6 +108,12 @@ namespace Azure { namespace Core { namespace _internal {
      *
      */
     Azure::Core::Http::Policies::LogOptions Log;
+
+    /**
+     * @brief Define the options for renewing the access tokens used to authenticate requests.
+     *
+     */
+    Azure::Core::Http::Policies::TokenRefreshOptions TokenRefresh;
   };
 
 }}} // namespace Azure::Core::_internal
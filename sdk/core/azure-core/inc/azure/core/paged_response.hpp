@@ -12,11 +12,139 @@
 #include "azure/core/http/raw_response.hpp"
 #include "azure/core/nullable.hpp"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace Azure { namespace Core {
 
+  namespace _detail {
+    /**
+     * @brief Fetches the pages that follow the current page of a paged response on a background
+     * thread.
+     *
+     * @tparam T The paged response type.
+     */
+    template <class T> class PagePrefetcher final {
+    public:
+      using PageFetcher = std::function<std::unique_ptr<T>(const Azure::Core::Context&)>;
+
+      PagePrefetcher(
+          PageFetcher fetchNextPage,
+          size_t maxPages,
+          const Azure::Core::Context& context)
+          : m_fetchNextPage(std::move(fetchNextPage)), m_maxPages(maxPages),
+            m_context(context.WithDeadline((Azure::DateTime::max)()))
+      {
+        m_worker = std::thread([this]() { Run(); });
+      }
+
+      PagePrefetcher(const PagePrefetcher&) = delete;
+      PagePrefetcher& operator=(const PagePrefetcher&) = delete;
+
+      ~PagePrefetcher()
+      {
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          m_stopped = true;
+        }
+        m_stateChanged.notify_all();
+        // Abandons the request in progress, if any.
+        m_context.Cancel();
+        m_worker.join();
+      }
+
+      /**
+       * @brief Waits for the next page.
+       *
+       * @return The next page, or null if fetching it failed.
+       */
+      std::unique_ptr<T> TakeNextPage(const Azure::Core::Context& context)
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stateChanged.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+          return !m_pages.empty() || m_failed;
+        }))
+        {
+          context.ThrowIfCancelled();
+        }
+        if (m_pages.empty())
+        {
+          return nullptr;
+        }
+        auto page = std::move(m_pages.front());
+        m_pages.pop_front();
+        lock.unlock();
+        m_stateChanged.notify_all();
+        return page;
+      }
+
+    private:
+      void Run()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+          m_stateChanged.wait(lock, [this]() {
+            return m_stopped || (m_fetchNextPage && !m_failed && m_pages.size() < m_maxPages);
+          });
+          if (m_stopped)
+          {
+            return;
+          }
+          auto fetchNextPage = std::move(m_fetchNextPage);
+          m_fetchNextPage = nullptr;
+          lock.unlock();
+
+          std::unique_ptr<T> page;
+          PageFetcher fetchFollowingPage;
+          try
+          {
+            page = fetchNextPage(m_context);
+            fetchFollowingPage = page->GetNextPageFetcher();
+          }
+          catch (...)
+          {
+            // The error is reported by fetching the page again in the foreground.
+            page.reset();
+          }
+
+          lock.lock();
+          if (page)
+          {
+            m_pages.push_back(std::move(page));
+            m_fetchNextPage = std::move(fetchFollowingPage);
+          }
+          else
+          {
+            m_failed = true;
+          }
+          m_stateChanged.notify_all();
+        }
+      }
+
+      std::mutex m_mutex;
+      std::condition_variable m_stateChanged;
+      // The function fetching the page after the last one in m_pages.
+      PageFetcher m_fetchNextPage;
+      std::deque<std::unique_ptr<T>> m_pages;
+      size_t m_maxPages;
+      bool m_failed = false;
+      bool m_stopped = false;
+      Azure::Core::Context m_context;
+      std::thread m_worker;
+    };
+  } // namespace _detail
+
   /**
    * @brief The base type and behavior for a paged response.
    *
@@ -34,7 +162,42 @@ namespace Azure { namespace Core {
     // `m_hasPage` is then turned to `false` once `MoveToNextPage` is called on the last page.
     bool m_hasPage = true;
 
+    std::shared_ptr<_detail::PagePrefetcher<T>> m_prefetcher;
+
+    friend class _detail::PagePrefetcher<T>;
+
+    // Returns the function fetching the next page, or an empty function if there is none or the
+    // paged response doesn't support prefetching.
+    std::function<std::unique_ptr<T>(const Azure::Core::Context&)> GetNextPageFetcher() const
+    {
+      if (!NextPageToken.HasValue() || NextPageToken.Value().empty())
+      {
+        return nullptr;
+      }
+      return OnGetNextPageFetcher();
+    }
+
+    /**
+     * @brief Returns a function that fetches the page after this one, for #Prefetch().
+     *
+     * @remark The function runs on another thread, so it must not refer to this instance.
+     * Paged responses that don't support prefetching don't override it, and the default returns
+     * an empty function.
+     *
+     */
+    virtual std::function<std::unique_ptr<T>(const Azure::Core::Context&)> OnGetNextPageFetcher()
+        const
+    {
+      return nullptr;
+    }
+
   protected:
+    /**
+     * @brief A function that fetches a page, returned by #OnGetNextPageFetcher().
+     *
+     */
+    using PageFetcher = std::function<std::unique_ptr<T>(const Azure::Core::Context&)>;
+
     /**
      * @brief Constructs a default instance of `%PagedResponse`.
      *
@@ -108,13 +271,56 @@ namespace Azure { namespace Core {
       if (!NextPageToken.HasValue() || NextPageToken.Value().empty())
       {
         m_hasPage = false;
+        m_prefetcher.reset();
         return;
       }
 
+      if (m_prefetcher)
+      {
+        auto page = m_prefetcher->TakeNextPage(context);
+        if (page)
+        {
+          auto prefetcher = std::move(m_prefetcher);
+          *static_cast<T*>(this) = std::move(*page);
+          m_prefetcher = std::move(prefetcher);
+          return;
+        }
+        // Fetch the page again to report the error.
+        m_prefetcher.reset();
+      }
+
       // Developer must make sure current page is kept unchanged if OnNextPage()
       // throws exception.
       static_cast<T*>(this)->OnNextPage(context);
     }
+
+    /**
+     * @brief Fetches the next pages in the background while the current page is processed, so
+     * that #MoveToNextPage() doesn't have to wait for them.
+     *
+     * @note At most \p maxPages pages are fetched ahead of the current page, which bounds the
+     * memory used. When fetching a page in the background fails, #MoveToNextPage() fetches it
+     * again and reports the error. Paged responses that don't support prefetching ignore this
+     * call.
+     *
+     * @param maxPages The number of pages to fetch ahead of the current page. `0` stops
+     * prefetching.
+     * @param context A context to control the lifetime of the background requests.
+     */
+    void Prefetch(size_t maxPages, const Azure::Core::Context& context = Azure::Core::Context())
+    {
+      m_prefetcher.reset();
+      if (maxPages == 0)
+      {
+        return;
+      }
+      auto fetchNextPage = GetNextPageFetcher();
+      if (fetchNextPage)
+      {
+        m_prefetcher = std::make_shared<_detail::PagePrefetcher<T>>(
+            std::move(fetchNextPage), maxPages, context);
+      }
+    }
   };
 
 }} // namespace Azure::Core
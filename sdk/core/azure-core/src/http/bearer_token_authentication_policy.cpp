@@ -4,15 +4,22 @@
 #include "azure/core/credentials/credentials.hpp"
 #include "azure/core/http/policies/policy.hpp"
 #include "azure/core/internal/credentials/authorization_challenge_parser.hpp"
+#include "azure/core/internal/diagnostics/log.hpp"
 
 #include <chrono>
+#include <exception>
+#include <string>
+#include <thread>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
 
 using Azure::Core::Context;
+using Azure::Core::Credentials::AccessToken;
 using Azure::Core::Credentials::AuthenticationException;
 using Azure::Core::Credentials::TokenRequestContext;
 using Azure::Core::Credentials::_detail::AuthorizationChallengeHelper;
+using Azure::Core::Diagnostics::Logger;
+using Azure::Core::Diagnostics::_internal::Log;
 using Azure::Core::Http::RawResponse;
 using Azure::Core::Http::Request;
 using Azure::Core::Http::Policies::NextHttpPolicy;
@@ -63,15 +70,42 @@ bool BearerTokenAuthenticationPolicy::AuthorizeRequestOnChallenge(
 }
 
 namespace {
-bool TokenNeedsRefresh(
+enum class TokenStatus
+{
+  // The token can be used.
+  Fresh,
+  // The token can be used, and should be renewed in the background.
+  RefreshSoon,
+  // The token must be renewed, but it can be used until it is.
+  Stale,
+  // The token can't be used: there is none, it is for another context, or it has expired.
+  Invalid,
+};
+
+TokenStatus GetTokenStatus(
     Azure::Core::Credentials::AccessToken const& cachedToken,
     Azure::Core::Credentials::TokenRequestContext const& cachedTokenRequestContext,
     Azure::DateTime const& currentTime,
-    Azure::Core::Credentials::TokenRequestContext const& newTokenRequestContext)
+    Azure::Core::Credentials::TokenRequestContext const& newTokenRequestContext,
+    Azure::DateTime::duration backgroundRefreshMargin)
 {
-  return newTokenRequestContext.TenantId != cachedTokenRequestContext.TenantId
+  if (newTokenRequestContext.TenantId != cachedTokenRequestContext.TenantId
       || newTokenRequestContext.Scopes != cachedTokenRequestContext.Scopes
-      || currentTime > (cachedToken.ExpiresOn - newTokenRequestContext.MinimumExpiration);
+      || currentTime >= cachedToken.ExpiresOn)
+  {
+    return TokenStatus::Invalid;
+  }
+  auto const refreshTime = cachedToken.ExpiresOn - newTokenRequestContext.MinimumExpiration;
+  if (currentTime > refreshTime)
+  {
+    return TokenStatus::Stale;
+  }
+  if (backgroundRefreshMargin > Azure::DateTime::duration::zero()
+      && currentTime > refreshTime - backgroundRefreshMargin)
+  {
+    return TokenStatus::RefreshSoon;
+  }
+  return TokenStatus::Fresh;
 }
 
 void ApplyBearerToken(
@@ -82,29 +116,136 @@ void ApplyBearerToken(
 }
 } // namespace
 
+BearerTokenAuthenticationPolicy::~BearerTokenAuthenticationPolicy()
+{
+  std::thread refreshThread;
+  {
+    std::unique_lock<std::shared_timed_mutex> writeLock(m_accessTokenState->Mutex);
+    m_accessTokenState->RefreshContext.Cancel();
+    refreshThread = std::move(m_accessTokenState->RefreshThread);
+  }
+  if (refreshThread.joinable())
+  {
+    refreshThread.join();
+  }
+}
+
+void BearerTokenAuthenticationPolicy::RefreshTokenInBackground(
+    TokenRequestContext const& tokenRequestContext) const
+{
+  // The caller holds the write lock and has set IsRefreshing. The previous renewal, if any, has
+  // cleared IsRefreshing and released the lock, so it has completed or is about to.
+  auto& state = *m_accessTokenState;
+  if (state.RefreshThread.joinable())
+  {
+    state.RefreshThread.join();
+  }
+
+  state.RefreshThread = std::thread([state = m_accessTokenState,
+                                     credential = m_credential,
+                                     context = m_accessTokenState->RefreshContext,
+                                     tokenRequestContext]() {
+    try
+    {
+      auto const newToken = credential->GetToken(tokenRequestContext, context);
+      std::unique_lock<std::shared_timed_mutex> writeLock(state->Mutex);
+      state->AccessToken = newToken;
+      state->AccessTokenContext = tokenRequestContext;
+      state->IsRefreshing = false;
+    }
+    catch (std::exception const& e)
+    {
+      // Requests keep using the current token, and the next one retries the renewal.
+      if (!context.IsCancelled())
+      {
+        Log::Write(
+            Logger::Level::Warning,
+            std::string("Background access token renewal failed: ") + e.what());
+      }
+      std::unique_lock<std::shared_timed_mutex> writeLock(state->Mutex);
+      state->IsRefreshing = false;
+    }
+    catch (...)
+    {
+      Log::Write(Logger::Level::Warning, "Background access token renewal failed.");
+      std::unique_lock<std::shared_timed_mutex> writeLock(state->Mutex);
+      state->IsRefreshing = false;
+    }
+  });
+}
+
 void BearerTokenAuthenticationPolicy::AuthenticateAndAuthorizeRequest(
     Request& request,
     TokenRequestContext const& tokenRequestContext,
     Context const& context) const
 {
   DateTime const currentTime = std::chrono::system_clock::now();
+  auto const backgroundRefreshMargin = m_tokenRefreshOptions.BackgroundRefreshMargin;
+  auto const serveStaleToken = m_tokenRefreshOptions.ServeStaleTokenWhileRefreshing;
+  auto& state = *m_accessTokenState;
 
   {
-    std::shared_lock<std::shared_timed_mutex> readLock(m_accessTokenMutex);
-    if (!TokenNeedsRefresh(m_accessToken, m_accessTokenContext, currentTime, tokenRequestContext))
+    std::shared_lock<std::shared_timed_mutex> readLock(state.Mutex);
+    auto const status = GetTokenStatus(
+        state.AccessToken,
+        state.AccessTokenContext,
+        currentTime,
+        tokenRequestContext,
+        backgroundRefreshMargin);
+    if (status == TokenStatus::Fresh
+        || (status == TokenStatus::RefreshSoon && state.IsRefreshing)
+        || (status == TokenStatus::Stale && serveStaleToken && state.IsRefreshing))
     {
-      ApplyBearerToken(request, m_accessToken);
+      ApplyBearerToken(request, state.AccessToken);
       return;
     }
   }
 
-  std::unique_lock<std::shared_timed_mutex> writeLock(m_accessTokenMutex);
-  // Check if token needs refresh for the second time in case another thread has just updated it.
-  if (TokenNeedsRefresh(m_accessToken, m_accessTokenContext, currentTime, tokenRequestContext))
+  std::unique_lock<std::shared_timed_mutex> writeLock(state.Mutex);
+  // Check the token for the second time in case another thread has just updated it.
+  auto const status = GetTokenStatus(
+      state.AccessToken,
+      state.AccessTokenContext,
+      currentTime,
+      tokenRequestContext,
+      backgroundRefreshMargin);
+
+  if (status == TokenStatus::RefreshSoon
+      || (status == TokenStatus::Stale && serveStaleToken && state.IsRefreshing))
+  {
+    if (!state.IsRefreshing)
+    {
+      state.IsRefreshing = true;
+      RefreshTokenInBackground(tokenRequestContext);
+    }
+  }
+  else if (status == TokenStatus::Stale && serveStaleToken)
+  {
+    // Renew the token on this thread, without holding the lock, so that the other requests keep
+    // using the current token in the meantime.
+    state.IsRefreshing = true;
+    writeLock.unlock();
+    AccessToken newToken;
+    try
+    {
+      newToken = m_credential->GetToken(tokenRequestContext, context);
+    }
+    catch (...)
+    {
+      writeLock.lock();
+      state.IsRefreshing = false;
+      throw;
+    }
+    writeLock.lock();
+    state.AccessToken = std::move(newToken);
+    state.AccessTokenContext = tokenRequestContext;
+    state.IsRefreshing = false;
+  }
+  else if (status != TokenStatus::Fresh)
   {
-    m_accessToken = m_credential->GetToken(tokenRequestContext, context);
-    m_accessTokenContext = tokenRequestContext;
+    state.AccessToken = m_credential->GetToken(tokenRequestContext, context);
+    state.AccessTokenContext = tokenRequestContext;
   }
 
-  ApplyBearerToken(request, m_accessToken);
+  ApplyBearerToken(request, state.AccessToken);
 }
@@ -35,6 +35,7 @@
 // Private include
 #include "curl_connection_pool_private.hpp"
 #include "curl_connection_private.hpp"
+#include "curl_multiplexed_session_private.hpp"
 #include "curl_session_private.hpp"
 
 #if defined(AZ_PLATFORM_POSIX)
@@ -71,10 +72,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <exception>
 #include <iomanip>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace {
 std::string const LogMsgPrefix = "[CURL Transport Adapter]: ";
@@ -207,72 +210,32 @@ static void CleanupThread()
   // This method can wake up in de-attached mode after the application has been terminated.
   // If that happens, trying to use `Log` would cause `abort` as it was previously deallocated.
   using namespace Azure::Core::Http::_detail;
+  auto& pool = CurlConnectionPool::g_curlConnectionPool;
   for (;;)
   {
-    // Won't continue until the ConnectionPoolMutex is released from MoveConnectionBackToPool
-    std::unique_lock<std::mutex> lockForPoolCleaning(
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-
-    // Wait for the default time OR to the signal from the conditional variable.
-    // wait_for releases the mutex lock when it goes to sleep and it takes the lock again when it
-    // wakes up (or it's cancelled).
-    if (CurlConnectionPool::g_curlConnectionPool.ConditionalVariableForCleanThread.wait_for(
-            lockForPoolCleaning,
-            std::chrono::milliseconds(DefaultCleanerIntervalMilliseconds),
-            []() {
-              return CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size() == 0;
-            }))
-    {
-      // Cancelled by another thread or no connections on wakeup
-      CurlConnectionPool::g_curlConnectionPool.IsCleanThreadRunning = false;
-      break;
-    }
-
-    decltype(CurlConnectionPool::g_curlConnectionPool
-                 .ConnectionPoolIndex)::mapped_type connectionsToBeCleaned;
-
-    // loop the connection pool index - Note: lock is re-taken for the mutex
-    // Notes: The size of each host-index is always expected to be greater than 0 because the
-    // host-index is removed anytime it becomes empty.
-    for (auto index = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.begin();
-         index != CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.end();)
     {
-      // Each pool index behaves as a Last-in-First-out (connections are added to the pool with
-      // push_front). The last connection moved to the pool will be the first to be re-used. Because
-      // of this, the oldest connection in the pool can be found at the end of the list. Looping the
-      // connection pool backwards until a connection that is not expired is found or until all
-      // connections are removed.
-      auto& connectionList = index->second;
-      auto connectionIter = connectionList.end();
-      while (connectionIter != connectionList.begin())
-      {
-        --connectionIter;
-        if ((*connectionIter)->IsExpired())
-        {
-          // remove connection from the pool and update the connection to the next one
-          // which is going to be list.end()
-          connectionsToBeCleaned.emplace_back(std::move(*connectionIter));
-          connectionIter = connectionList.erase(connectionIter);
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      if (connectionList.empty())
-      {
-        index = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.erase(index);
-      }
-      else
+      std::unique_lock<std::mutex> lockForCleanThread(pool.CleanThreadMutex);
+
+      // Wait for the default time OR to the signal from the conditional variable.
+      // wait_for releases the mutex lock when it goes to sleep and it takes the lock again when it
+      // wakes up (or it's cancelled).
+      if (pool.ConditionalVariableForCleanThread.wait_for(
+              lockForCleanThread,
+              std::chrono::milliseconds(DefaultCleanerIntervalMilliseconds),
+              [&pool]() { return pool.IdleConnections.load() == 0; }))
       {
-        ++index;
+        // Cancelled by another thread or no connections on wakeup
+        pool.IsCleanThreadRunning = false;
+        break;
       }
     }
 
-    lockForPoolCleaning.unlock();
-    // Do actual connections release work here, without holding the mutex.
+    pool.CleanExpiredConnections();
   }
+
+  // Nothing prunes the host pools until the thread is started again, so remove the ones left
+  // empty by the last requests.
+  pool.PruneHostPools();
 }
 
 std::string PemEncodeFromBase64(std::string const& base64, std::string const& pemType)
@@ -332,10 +295,17 @@ using Azure::Core::Http::RawResponse;
 using Azure::Core::Http::Request;
 using Azure::Core::Http::TransportException;
 using Azure::Core::Http::_detail::CurlConnectionPool;
+using Azure::Core::Http::_detail::CurlHostConnectionPool;
 
 Azure::Core::Http::_detail::CurlConnectionPool
     Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool;
 
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+// Defined after the connection pool so it is destroyed first, before `curl_global_cleanup()`.
+Azure::Core::Http::_detail::CurlMultiplexer
+    Azure::Core::Http::_detail::CurlMultiplexer::g_curlMultiplexer;
+#endif
+
 CurlTransport::CurlTransport(Azure::Core::Http::Policies::TransportOptions const& options)
     : CurlTransport(CurlTransportOptionsFromTransportOptions(options))
 {
@@ -343,6 +313,28 @@ CurlTransport::CurlTransport(Azure::Core::Http::Policies::TransportOptions const
 
 std::unique_ptr<RawResponse> CurlTransport::Send(Request& request, Context const& context)
 {
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  // Web sockets need the connection of the session, so they always go through the pool.
+  bool useMultiplexedSession = !HasWebSocketSupport()
+      && (m_options.EnableSharedEventLoop
+          || (m_options.EnableHttp2 && _detail::CurlMultiplexer::IsHttp2Supported()));
+#if !defined(AZ_PLATFORM_WINDOWS) && !defined(AZ_PLATFORM_MAC)
+  // The CRL validation callback is only installed on the connections from the connection pool.
+  useMultiplexedSession
+      = useMultiplexedSession && !m_options.SslOptions.EnableCertificateRevocationListCheck;
+#endif
+  if (useMultiplexedSession)
+  {
+    Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Creating a new multiplexed session.");
+
+    auto session = std::make_unique<CurlMultiplexedSession>(request, m_options);
+    auto response = session->Perform(context);
+    // Move the ownership of the session (bodyStream) to the response
+    response->SetBodyStream(std::move(session));
+    return response;
+  }
+#endif
+
   // Create CurlSession to perform request
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Creating a new session.");
 
@@ -1426,6 +1418,14 @@ inline std::string GetConnectionKey(std::string const& host, CurlTransportOption
        || options.ConnectionTimeout == std::chrono::milliseconds(0))
           ? "0"
           : std::to_string(options.ConnectionTimeout.count()));
+  key.append(",");
+  key.append(
+      (options.MaxIdleConnectionsPerHost
+           == Azure::Core::Http::_detail::DefaultMaxIdleConnectionsPerHost
+       && options.MinIdleConnectionsPerHost == 0)
+          ? "0"
+          : std::to_string(options.MaxIdleConnectionsPerHost) + "-"
+              + std::to_string(options.MinIdleConnectionsPerHost));
 
   return key;
 }
@@ -2172,64 +2172,249 @@ int CurlConnection::SslCtxCallback(CURL*, void* sslctx)
 }
 #endif
 
-std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlConnection(
-    Request& request,
-    CurlTransportOptions const& options,
-    bool resetPool)
+namespace {
+// Picks the stripe used by the calling thread. A thread always returns its connections to the same
+// stripe and looks there first, so threads rarely contend for the same stripe mutex.
+inline size_t GetStripeIndexForThisThread()
 {
-  uint16_t port = request.GetUrl().GetPort();
-  // Generate a display name for the host being connected to
-  std::string const& hostDisplayName = request.GetUrl().GetScheme() + "://"
-      + request.GetUrl().GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
-  std::string const connectionKey = GetConnectionKey(hostDisplayName, options);
+  return std::hash<std::thread::id>{}(std::this_thread::get_id())
+      % Azure::Core::Http::_detail::ConnectionPoolStripeCount;
+}
+
+// Must be called while holding the exclusive lock of the index. Host pools are only copied from
+// the index while holding its lock, so a host pool that nobody else holds can't get new idle
+// connections until the lock is released.
+inline bool IsUnusedHostPool(std::shared_ptr<CurlHostConnectionPool> const& hostPool)
+{
+  return hostPool.use_count() == 1 && hostPool->IdleConnections.load() == 0;
+}
+} // namespace
+
+std::shared_ptr<CurlHostConnectionPool> CurlConnectionPool::FindHostPool(
+    std::string const& connectionKey)
+{
+  std::shared_lock<std::shared_timed_mutex> indexReadLock(ConnectionPoolMutex);
+  auto const found = ConnectionPoolIndex.find(connectionKey);
+  return found != ConnectionPoolIndex.end() ? found->second : nullptr;
+}
 
+std::shared_ptr<CurlHostConnectionPool> CurlConnectionPool::GetHostPool(
+    std::string const& connectionKey,
+    size_t maxIdleConnections,
+    size_t minIdleConnections)
+{
+  auto hostPool = FindHostPool(connectionKey);
+  if (hostPool)
+  {
+    return hostPool;
+  }
+
+  std::unique_lock<std::shared_timed_mutex> indexWriteLock(ConnectionPoolMutex);
+  // Search the index for the second time, in case the host pool was inserted between releasing the
+  // read lock and acquiring the write lock.
+  auto& entry = ConnectionPoolIndex[connectionKey];
+  if (!entry)
   {
-    decltype(CurlConnectionPool::g_curlConnectionPool
-                 .ConnectionPoolIndex)::mapped_type connectionsToBeReset;
+    entry = std::make_shared<CurlHostConnectionPool>(maxIdleConnections, minIdleConnections);
+  }
+  return entry;
+}
 
-    // Critical section. Needs to own ConnectionPoolMutex before executing
-    // Lock mutex to access connection pool. mutex is unlock as soon as lock is out of scope
-    std::unique_lock<std::mutex> lock(CurlConnectionPool::ConnectionPoolMutex);
+void CurlConnectionPool::PruneHostPool(std::string const& connectionKey)
+{
+  std::unique_lock<std::shared_timed_mutex> indexWriteLock(ConnectionPoolMutex);
+  auto const found = ConnectionPoolIndex.find(connectionKey);
+  if (found != ConnectionPoolIndex.end() && IsUnusedHostPool(found->second))
+  {
+    ConnectionPoolIndex.erase(found);
+  }
+}
 
-    // get a ref to the pool from the map of pools
-    auto hostPoolIndex = g_curlConnectionPool.ConnectionPoolIndex.find(connectionKey);
+void CurlConnectionPool::PruneHostPools()
+{
+  std::unique_lock<std::shared_timed_mutex> indexWriteLock(ConnectionPoolMutex);
+  for (auto index = ConnectionPoolIndex.begin(); index != ConnectionPoolIndex.end();)
+  {
+    index = IsUnusedHostPool(index->second) ? ConnectionPoolIndex.erase(index) : std::next(index);
+  }
+}
 
-    if (hostPoolIndex != g_curlConnectionPool.ConnectionPoolIndex.end()
-        && hostPoolIndex->second.size() > 0)
+void CurlConnectionPool::CleanExpiredConnections()
+{
+  std::list<std::unique_ptr<CurlNetworkConnection>> connectionsToBeCleaned;
+  {
+    std::vector<std::shared_ptr<CurlHostConnectionPool>> hostPools;
     {
-      if (resetPool)
+      std::shared_lock<std::shared_timed_mutex> indexReadLock(ConnectionPoolMutex);
+      for (auto const& index : ConnectionPoolIndex)
       {
-        connectionsToBeReset = std::move(hostPoolIndex->second);
-        // clean the pool-index as requested in the call. Typically to force a new connection to be
-        // created and to discard all current connections in the pool for the host-index. A caller
-        // might request this after getting broken/closed connections multiple-times.
-        hostPoolIndex->second.clear();
-        Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Reset connection pool requested.");
+        hostPools.emplace_back(index.second);
       }
-      else
+    }
+
+    for (auto const& hostPool : hostPools)
+    {
+      for (auto& stripe : hostPool->Stripes)
       {
-        // get ref to first connection
-        auto fistConnectionIterator = hostPoolIndex->second.begin();
-        // move the connection ref to temp ref
-        auto connection = std::move(*fistConnectionIterator);
-        // Remove the connection ref from list
-        hostPoolIndex->second.erase(fistConnectionIterator);
-
-        // Remove index if there are no more connections
-        if (hostPoolIndex->second.size() == 0)
+        std::unique_lock<std::mutex> stripeLock(stripe.Mutex);
+        // Each stripe behaves as a Last-in-First-out (connections are added to the pool with
+        // push_front). The last connection moved to the pool will be the first to be re-used.
+        // Because of this, the oldest connection in the stripe can be found at the end of the
+        // list. Looping the stripe backwards until a connection that is not expired is found,
+        // until all connections are removed or until only the minimum idle connections for the
+        // host are left.
+        auto& connectionList = stripe.Connections;
+        auto connectionIter = connectionList.end();
+        while (connectionIter != connectionList.begin()
+               && hostPool->IdleConnections.load() > hostPool->MinIdleConnections)
         {
-          g_curlConnectionPool.ConnectionPoolIndex.erase(hostPoolIndex);
+          --connectionIter;
+          if ((*connectionIter)->IsExpired())
+          {
+            // remove connection from the pool and update the connection to the next one
+            // which is going to be list.end()
+            connectionsToBeCleaned.emplace_back(std::move(*connectionIter));
+            connectionIter = connectionList.erase(connectionIter);
+            --hostPool->IdleConnections;
+            --IdleConnections;
+          }
+          else
+          {
+            break;
+          }
         }
-
-        Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Re-using connection from the pool.");
-        // return connection ref
-        return connection;
       }
     }
   }
 
+  // The references to the host pools were released above, so the ones left empty can be removed.
+  PruneHostPools();
+
+  RecordEvictions(connectionsToBeCleaned.size());
+  // Do actual connections release work here, without holding any mutex.
+  connectionsToBeCleaned.clear();
+}
+
+std::unique_lock<std::mutex> CurlConnectionPool::LockStripe(CurlHostConnectionPool::Stripe& stripe)
+{
+  std::unique_lock<std::mutex> lock(stripe.Mutex, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    // Only measure the time when the mutex is contended, to keep the uncontended path cheap.
+    auto const waitStart = std::chrono::steady_clock::now();
+    lock.lock();
+    m_waitTimeNanoseconds += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - waitStart)
+            .count());
+  }
+  return lock;
+}
+
+std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::TakeConnection(
+    CurlHostConnectionPool& hostPool)
+{
+  auto const firstStripe = GetStripeIndexForThisThread();
+  for (size_t offset = 0; offset < ConnectionPoolStripeCount; offset++)
+  {
+    // Stop looking as soon as there are no idle connections left for the host.
+    if (hostPool.IdleConnections.load() == 0)
+    {
+      break;
+    }
+
+    auto& stripe = hostPool.Stripes[(firstStripe + offset) % ConnectionPoolStripeCount];
+    auto lock = LockStripe(stripe);
+    if (!stripe.Connections.empty())
+    {
+      // Take the most recently used connection.
+      auto connection = std::move(stripe.Connections.front());
+      stripe.Connections.pop_front();
+      --hostPool.IdleConnections;
+      --IdleConnections;
+      return connection;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::EvictConnection(
+    CurlHostConnectionPool& hostPool)
+{
+  // The stripe of the calling thread holds the connection it just returned, so look at the other
+  // stripes first.
+  auto const lastStripe = GetStripeIndexForThisThread();
+  for (size_t offset = 1; offset <= ConnectionPoolStripeCount; offset++)
+  {
+    auto& stripe = hostPool.Stripes[(lastStripe + offset) % ConnectionPoolStripeCount];
+    auto lock = LockStripe(stripe);
+    if (!stripe.Connections.empty())
+    {
+      // Take the least recently used connection.
+      auto connection = std::move(stripe.Connections.back());
+      stripe.Connections.pop_back();
+      --hostPool.IdleConnections;
+      --IdleConnections;
+      return connection;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlConnection(
+    Request& request,
+    CurlTransportOptions const& options,
+    bool resetPool)
+{
+  uint16_t port = request.GetUrl().GetPort();
+  // Generate a display name for the host being connected to
+  std::string const& hostDisplayName = request.GetUrl().GetScheme() + "://"
+      + request.GetUrl().GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
+  std::string const connectionKey = GetConnectionKey(hostDisplayName, options);
+
+  // Host pools are created when a connection is moved back to the pool, so there is nothing to
+  // take or reset if the connection key is not in the index.
+  auto hostPool = FindHostPool(connectionKey);
+  std::unique_ptr<CurlNetworkConnection> connection;
+  if (hostPool && resetPool)
+  {
+    // clean the pool-index as requested in the call. Typically to force a new connection to be
+    // created and to discard all current connections in the pool for the host-index. A caller
+    // might request this after getting broken/closed connections multiple-times.
+    std::list<std::unique_ptr<CurlNetworkConnection>> connectionsToBeReset;
+    for (auto& stripe : hostPool->Stripes)
+    {
+      auto lock = LockStripe(stripe);
+      auto const removed = stripe.Connections.size();
+      connectionsToBeReset.splice(connectionsToBeReset.end(), stripe.Connections);
+      hostPool->IdleConnections -= removed;
+      IdleConnections -= removed;
+    }
+    RecordEvictions(connectionsToBeReset.size());
+    Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Reset connection pool requested.");
+  }
+  else if (hostPool)
+  {
+    connection = TakeConnection(*hostPool);
+  }
+
+  if (hostPool && hostPool->IdleConnections.load() == 0)
+  {
+    // Remove the host pool from the index once its last idle connection is gone.
+    hostPool.reset();
+    PruneHostPool(connectionKey);
+  }
+
+  if (connection)
+  {
+    ++m_hits;
+    Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Re-using connection from the pool.");
+    return connection;
+  }
+
   // Creating a new connection is thread safe. No need to lock mutex here.
   // No available connection for the pool for the required host. Create one
+  ++m_misses;
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Spawn new connection.");
 
   return std::make_unique<CurlConnection>(request, options, hostDisplayName, connectionKey);
@@ -2254,26 +2439,45 @@ void CurlConnectionPool::MoveConnectionBackToPool(
 
   Log::Write(Logger::Level::Verbose, "Moving connection to pool...");
 
-  decltype(CurlConnectionPool::g_curlConnectionPool
-               .ConnectionPoolIndex)::mapped_type::value_type connectionToBeRemoved;
-
-  // Lock mutex to access connection pool. mutex is unlock as soon as lock is out of scope
-  std::unique_lock<std::mutex> lock(CurlConnectionPool::ConnectionPoolMutex);
-  auto& poolId = connection->GetConnectionKey();
-  auto& hostPool = g_curlConnectionPool.ConnectionPoolIndex[poolId];
+  auto hostPool = GetHostPool(
+      connection->GetConnectionKey(),
+      connection->GetMaxIdleConnections(),
+      connection->GetMinIdleConnections());
+  if (hostPool->MaxIdleConnections == 0)
+  {
+    RecordEvictions(1);
+    return;
+  }
 
-  if (hostPool.size() >= _detail::MaxConnectionsPerIndex && !hostPool.empty())
   {
-    // Remove the last connection from the pool to insert this one.
-    auto lastConnection = --hostPool.end();
-    connectionToBeRemoved = std::move(*lastConnection);
-    hostPool.erase(lastConnection);
+    auto& stripe = hostPool->Stripes[GetStripeIndexForThisThread()];
+    auto lock = LockStripe(stripe);
+
+    // update the time when connection was moved back to pool
+    connection->UpdateLastUsageTime();
+    stripe.Connections.push_front(std::move(connection));
+    ++hostPool->IdleConnections;
+    ++IdleConnections;
   }
 
-  // update the time when connection was moved back to pool
-  connection->UpdateLastUsageTime();
-  hostPool.push_front(std::move(connection));
+  // The limit is for the whole host, so the connections removed to make room for this one can
+  // come from any stripe. The counter is updated under the lock of the stripe that changed, so
+  // an empty pass means other threads already took the extra connections.
+  std::list<std::unique_ptr<CurlNetworkConnection>> connectionsToBeRemoved;
+  while (hostPool->IdleConnections.load() > hostPool->MaxIdleConnections)
+  {
+    auto connectionToBeRemoved = EvictConnection(*hostPool);
+    if (!connectionToBeRemoved)
+    {
+      break;
+    }
+    connectionsToBeRemoved.emplace_back(std::move(connectionToBeRemoved));
+  }
+  RecordEvictions(connectionsToBeRemoved.size());
+  // Connections are closed here, without holding any mutex.
+  connectionsToBeRemoved.clear();
 
+  std::unique_lock<std::mutex> lockForCleanThread(CleanThreadMutex);
   if (m_cleanThread.joinable() && !IsCleanThreadRunning)
   {
     // Clean thread was running before but it's finished, join it to finalize
@@ -2295,33 +2499,81 @@ void CurlConnectionPool::MoveConnectionBackToPool(
   }
 }
 
-CurlConnection::CurlConnection(
-    Request& request,
-    CurlTransportOptions const& options,
-    std::string const& hostDisplayName,
-    std::string const& connectionPropertiesKey)
-    : m_connectionKey(connectionPropertiesKey)
+void CurlConnectionPool::Clear()
 {
-  m_handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
-  if (!m_handle)
+  std::vector<std::shared_ptr<CurlHostConnectionPool>> hostPools;
   {
-    throw Azure::Core::Http::TransportException(
-        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-        + std::string("curl_easy_init returned Null"));
+    std::shared_lock<std::shared_timed_mutex> indexReadLock(ConnectionPoolMutex);
+    for (auto const& index : ConnectionPoolIndex)
+    {
+      hostPools.emplace_back(index.second);
+    }
   }
+
+  std::list<std::unique_ptr<CurlNetworkConnection>> connectionsToBeRemoved;
+  for (auto const& hostPool : hostPools)
+  {
+    for (auto& stripe : hostPool->Stripes)
+    {
+      std::unique_lock<std::mutex> lock(stripe.Mutex);
+      auto const removed = stripe.Connections.size();
+      connectionsToBeRemoved.splice(connectionsToBeRemoved.end(), stripe.Connections);
+      hostPool->IdleConnections -= removed;
+      IdleConnections -= removed;
+    }
+  }
+  hostPools.clear();
+  PruneHostPools();
+  RecordEvictions(connectionsToBeRemoved.size());
+  // Connections are closed here, without holding any mutex.
+}
+
+size_t CurlConnectionPool::ConnectionsOnPool(std::string const& host)
+{
+  auto hostPool = FindHostPool(host);
+  return hostPool ? hostPool->IdleConnections.load() : 0;
+}
+
+size_t CurlConnectionPool::ConnectionPoolIndexCount()
+{
+  std::shared_lock<std::shared_timed_mutex> indexReadLock(ConnectionPoolMutex);
+  return ConnectionPoolIndex.size();
+}
+
+Azure::Core::Http::CurlConnectionPoolStatistics CurlConnectionPool::GetStatistics()
+{
+  Azure::Core::Http::CurlConnectionPoolStatistics statistics;
+  statistics.Hits = m_hits.load();
+  statistics.Misses = m_misses.load();
+  statistics.Evictions = m_evictions.load();
+  statistics.WaitTime = std::chrono::nanoseconds(m_waitTimeNanoseconds.load());
+  statistics.IdleConnections = IdleConnections.load();
+  return statistics;
+}
+
+Azure::Core::Http::CurlConnectionPoolStatistics CurlTransport::GetConnectionPoolStatistics()
+{
+  return CurlConnectionPool::g_curlConnectionPool.GetStatistics();
+}
+
+void CurlConnection::SetCommonOptions(
+    Azure::Core::_internal::UniqueHandle<CURL> const& handle,
+    CurlTransportOptions const& options,
+    std::string const& hostDisplayName)
+{
   CURLcode result;
 
   if (options.EnableCurlTracing)
   {
     if (!SetLibcurlOption(
-            m_handle, CURLOPT_DEBUGFUNCTION, CurlConnection::CurlLoggingCallback, &result))
+            handle, CURLOPT_DEBUGFUNCTION, CurlConnection::CurlLoggingCallback, &result))
     {
       throw TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate
           + std::string(". Could not enable logging callback.")
           + std::string(curl_easy_strerror(result)));
     }
-    if (!SetLibcurlOption(m_handle, CURLOPT_VERBOSE, 1, &result))
+    if (!SetLibcurlOption(handle, CURLOPT_VERBOSE, 1, &result))
     {
       throw TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate
@@ -2330,33 +2582,10 @@ CurlConnection::CurlConnection(
     }
   }
 
-  // Libcurl setup before open connection (url, connect_only, timeout)
-  if (!SetLibcurlOption(m_handle, CURLOPT_URL, request.GetUrl().GetAbsoluteUrl().data(), &result))
-  {
-    throw Azure::Core::Http::TransportException(
-        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-        + std::string(curl_easy_strerror(result)));
-  }
-
-  if (request.GetUrl().GetPort() != 0
-      && !SetLibcurlOption(m_handle, CURLOPT_PORT, request.GetUrl().GetPort(), &result))
-  {
-    throw Azure::Core::Http::TransportException(
-        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-        + std::string(curl_easy_strerror(result)));
-  }
-
-  if (!SetLibcurlOption(m_handle, CURLOPT_CONNECT_ONLY, 1L, &result))
-  {
-    throw Azure::Core::Http::TransportException(
-        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-        + std::string(curl_easy_strerror(result)));
-  }
-
   //   Set timeout to 24h. Libcurl will fail uploading on windows if timeout is:
   // timeout >= 25 days. Fails as soon as trying to upload any data
   // 25 days < timeout > 1 days. Fail on huge uploads ( > 1GB)
-  if (!SetLibcurlOption(m_handle, CURLOPT_TIMEOUT, 60L * 60L * 24L, &result))
+  if (!SetLibcurlOption(handle, CURLOPT_TIMEOUT, 60L * 60L * 24L, &result))
   {
     throw Azure::Core::Http::TransportException(
         _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
@@ -2365,7 +2594,7 @@ CurlConnection::CurlConnection(
 
   if (options.ConnectionTimeout != Azure::Core::Http::_detail::DefaultConnectionTimeout)
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_CONNECTTIMEOUT_MS, options.ConnectionTimeout, &result))
+    if (!SetLibcurlOption(handle, CURLOPT_CONNECTTIMEOUT_MS, options.ConnectionTimeout, &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2380,7 +2609,7 @@ CurlConnection::CurlConnection(
    */
   if (options.Proxy)
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_PROXY, options.Proxy->c_str(), &result))
+    if (!SetLibcurlOption(handle, CURLOPT_PROXY, options.Proxy->c_str(), &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2392,7 +2621,7 @@ CurlConnection::CurlConnection(
   if (options.ProxyUsername.HasValue())
   {
     if (!SetLibcurlOption(
-            m_handle, CURLOPT_PROXYUSERNAME, options.ProxyUsername.Value().c_str(), &result))
+            handle, CURLOPT_PROXYUSERNAME, options.ProxyUsername.Value().c_str(), &result))
     {
       throw TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2403,7 +2632,7 @@ CurlConnection::CurlConnection(
   if (options.ProxyPassword.HasValue())
   {
     if (!SetLibcurlOption(
-            m_handle, CURLOPT_PROXYPASSWORD, options.ProxyPassword.Value().c_str(), &result))
+            handle, CURLOPT_PROXYPASSWORD, options.ProxyPassword.Value().c_str(), &result))
     {
       throw TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2414,7 +2643,7 @@ CurlConnection::CurlConnection(
 
   if (!options.CAInfo.empty())
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_CAINFO, options.CAInfo.c_str(), &result))
+    if (!SetLibcurlOption(handle, CURLOPT_CAINFO, options.CAInfo.c_str(), &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2425,7 +2654,7 @@ CurlConnection::CurlConnection(
 
   if (!options.CAPath.empty())
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_CAPATH, options.CAPath.c_str(), &result))
+    if (!SetLibcurlOption(handle, CURLOPT_CAPATH, options.CAPath.c_str(), &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2442,7 +2671,7 @@ CurlConnection::CurlConnection(
                options.SslOptions.PemEncodedExpectedRootCertificates.c_str())),
            options.SslOptions.PemEncodedExpectedRootCertificates.size(),
            CURL_BLOB_COPY};
-    if (!SetLibcurlOption(m_handle, CURLOPT_CAINFO_BLOB, &rootCertBlob, &result))
+    if (!SetLibcurlOption(handle, CURLOPT_CAINFO_BLOB, &rootCertBlob, &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2459,45 +2688,18 @@ CurlConnection::CurlConnection(
     sslOption |= CURLSSLOPT_NO_REVOKE;
   }
 
-  if (!SetLibcurlOption(m_handle, CURLOPT_SSL_OPTIONS, sslOption, &result))
+  if (!SetLibcurlOption(handle, CURLOPT_SSL_OPTIONS, sslOption, &result))
   {
     throw Azure::Core::Http::TransportException(
         _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
         + ". Failed to set ssl options to long bitmask:" + std::to_string(sslOption) + ". "
         + std::string(curl_easy_strerror(result)));
   }
-#elif !defined(AZ_PLATFORM_MAC)
-  if (options.SslOptions.EnableCertificateRevocationListCheck)
-  {
-    if (!SetLibcurlOption(
-            m_handle, CURLOPT_SSL_CTX_FUNCTION, CurlConnection::CurlSslCtxCallback, &result))
-    {
-      throw TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
-          + ". Failed to set SSL context callback. " + std::string(curl_easy_strerror(result)));
-    }
-    if (!SetLibcurlOption(m_handle, CURLOPT_SSL_CTX_DATA, this, &result))
-    {
-      throw TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
-          + ". Failed to set SSL context callback data. "
-          + std::string(curl_easy_strerror(result)));
-    }
-    //          if (!SetLibcurlOption(m_handle, CURLOPT_SSL_VERIFYSTATUS, 1, &result))
-    //          {
-    //            throw TransportException(
-    //                _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
-    //                + ". Failed to enable OCSP chaining. " +
-    //                std::string(curl_easy_strerror(result)));
-    //          }
-  }
-  m_allowFailedCrlRetrieval = options.SslOptions.AllowFailedCrlRetrieval;
 #endif
-  m_enableCrlValidation = options.SslOptions.EnableCertificateRevocationListCheck;
 
   if (!options.SslVerifyPeer)
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_SSL_VERIFYPEER, 0L, &result))
+    if (!SetLibcurlOption(handle, CURLOPT_SSL_VERIFYPEER, 0L, &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2507,7 +2709,7 @@ CurlConnection::CurlConnection(
 
   if (options.NoSignal)
   {
-    if (!SetLibcurlOption(m_handle, CURLOPT_NOSIGNAL, 1L, &result))
+    if (!SetLibcurlOption(handle, CURLOPT_NOSIGNAL, 1L, &result))
     {
       throw Azure::Core::Http::TransportException(
           _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
@@ -2516,41 +2718,113 @@ CurlConnection::CurlConnection(
     }
   }
 
-  // curl-transport adapter supports only HTTP/1.1
-  // https://github.com/Azure/azure-sdk-for-cpp/issues/2848
-  // The libcurl uses HTTP/2 by default, if it can be negotiated with a server on handshake.
-  if (!SetLibcurlOption(m_handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1, &result))
+  //   Make libcurl to support only TLS v1.2 or later
+  if (!SetLibcurlOption(handle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2, &result))
   {
     throw Azure::Core::Http::TransportException(
         _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
-        + ". Failed to set libcurl HTTP/1.1" + ". " + std::string(curl_easy_strerror(result)));
+        + ". Failed enforcing TLS v1.2 or greater. " + std::string(curl_easy_strerror(result)));
   }
+}
 
-  //   Make libcurl to support only TLS v1.2 or later
-  if (!SetLibcurlOption(m_handle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2, &result))
+CurlConnection::CurlConnection(
+    Request& request,
+    CurlTransportOptions const& options,
+    std::string const& hostDisplayName,
+    std::string const& connectionPropertiesKey)
+    : m_connectionKey(connectionPropertiesKey)
+{
+  SetIdleConnectionLimits(options.MaxIdleConnectionsPerHost, options.MinIdleConnectionsPerHost);
+  m_handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
+  if (!m_handle)
   {
     throw Azure::Core::Http::TransportException(
-        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
-        + ". Failed enforcing TLS v1.2 or greater. " + std::string(curl_easy_strerror(result)));
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string("curl_easy_init returned Null"));
   }
+  CURLcode result;
 
-  auto performResult = curl_easy_perform(m_handle.get());
-  if (performResult != CURLE_OK)
+  // Libcurl setup before open connection (url, connect_only, timeout)
+  if (!SetLibcurlOption(m_handle, CURLOPT_URL, request.GetUrl().GetAbsoluteUrl().data(), &result))
   {
-#if defined(AZ_PLATFORM_LINUX)
-    if (performResult == CURLE_PEER_FAILED_VERIFICATION)
-    {
-      curl_easy_getinfo(m_handle.get(), CURLINFO_SSL_VERIFYRESULT, &result);
-      throw Http::TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-          + std::string(curl_easy_strerror(performResult))
-          + ". Underlying error: " + X509_verify_cert_error_string(result));
-    }
-    else
-#endif
-    {
-      throw Http::TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+
+  if (request.GetUrl().GetPort() != 0
+      && !SetLibcurlOption(m_handle, CURLOPT_PORT, request.GetUrl().GetPort(), &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+
+  if (!SetLibcurlOption(m_handle, CURLOPT_CONNECT_ONLY, 1L, &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+
+  SetCommonOptions(m_handle, options, hostDisplayName);
+
+#if !defined(AZ_PLATFORM_WINDOWS) && !defined(AZ_PLATFORM_MAC)
+  if (options.SslOptions.EnableCertificateRevocationListCheck)
+  {
+    if (!SetLibcurlOption(
+            m_handle, CURLOPT_SSL_CTX_FUNCTION, CurlConnection::CurlSslCtxCallback, &result))
+    {
+      throw TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
+          + ". Failed to set SSL context callback. " + std::string(curl_easy_strerror(result)));
+    }
+    if (!SetLibcurlOption(m_handle, CURLOPT_SSL_CTX_DATA, this, &result))
+    {
+      throw TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
+          + ". Failed to set SSL context callback data. "
+          + std::string(curl_easy_strerror(result)));
+    }
+    //          if (!SetLibcurlOption(m_handle, CURLOPT_SSL_VERIFYSTATUS, 1, &result))
+    //          {
+    //            throw TransportException(
+    //                _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
+    //                + ". Failed to enable OCSP chaining. " +
+    //                std::string(curl_easy_strerror(result)));
+    //          }
+  }
+  m_allowFailedCrlRetrieval = options.SslOptions.AllowFailedCrlRetrieval;
+#endif
+  m_enableCrlValidation = options.SslOptions.EnableCertificateRevocationListCheck;
+
+  // curl-transport adapter supports only HTTP/1.1
+  // https://github.com/Azure/azure-sdk-for-cpp/issues/2848
+  // The libcurl uses HTTP/2 by default, if it can be negotiated with a server on handshake.
+  if (!SetLibcurlOption(m_handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1, &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
+        + ". Failed to set libcurl HTTP/1.1" + ". " + std::string(curl_easy_strerror(result)));
+  }
+
+  auto performResult = curl_easy_perform(m_handle.get());
+  if (performResult != CURLE_OK)
+  {
+#if defined(AZ_PLATFORM_LINUX)
+    if (performResult == CURLE_PEER_FAILED_VERIFICATION)
+    {
+      curl_easy_getinfo(m_handle.get(), CURLINFO_SSL_VERIFYRESULT, &result);
+      throw Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+          + std::string(curl_easy_strerror(performResult))
+          + ". Underlying error: " + X509_verify_cert_error_string(result));
+    }
+    else
+#endif
+    {
+      throw Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
           + std::string(curl_easy_strerror(performResult)));
     }
   }
@@ -2574,3 +2848,666 @@ CurlConnection::CurlConnection(
         + std::string(curl_easy_strerror(result)));
   }
 }
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+using Azure::Core::Http::CurlMultiplexedSession;
+using Azure::Core::Http::_detail::CurlMultiplexedTransfer;
+using Azure::Core::Http::_detail::CurlMultiplexer;
+using Azure::Core::Http::_detail::MaxMultiplexedResponseBufferSize;
+
+namespace {
+// Upper bound for how long a thread waits on a multiplexed transfer without checking its context
+// for cancellation. It matches the interval used by pollSocketUntilEventOrTimeout.
+constexpr std::chrono::milliseconds MultiplexedTransferPollInterval(1000);
+
+// Waits until `isReady` returns true, throwing if the context is cancelled while waiting.
+template <typename Predicate>
+void WaitForTransfer(
+    CurlMultiplexedTransfer& transfer,
+    std::unique_lock<std::mutex>& lock,
+    Context const& context,
+    Predicate isReady)
+{
+  while (!transfer.StateChanged.wait_for(lock, MultiplexedTransferPollInterval, isReady))
+  {
+    context.ThrowIfCancelled();
+  }
+}
+
+// Creates an HTTP Response from a status line like `HTTP/1.1 200 OK` or `HTTP/2 200`. libcurl
+// delivers the status line of an HTTP/2 response without minor version and reason phrase.
+std::unique_ptr<RawResponse> CreateMultiplexedResponse(std::string const& statusLine)
+{
+  auto const versionEnd = statusLine.find(' ');
+  if (versionEnd == std::string::npos)
+  {
+    throw std::invalid_argument("Invalid status line.");
+  }
+  auto const version = statusLine.substr(5, versionEnd - 5); // HTTP/ = 5
+  auto const minorVersionStart = version.find('.');
+  auto const majorVersion = std::stoi(version.substr(0, minorVersionStart));
+  auto const minorVersion = minorVersionStart == std::string::npos
+      ? 0
+      : std::stoi(version.substr(minorVersionStart + 1));
+
+  auto const statusCodeStart = versionEnd + 1;
+  auto const statusCodeEnd = statusLine.find_first_of(" \r\n", statusCodeStart);
+  auto const statusCode
+      = std::stoi(statusLine.substr(statusCodeStart, statusCodeEnd - statusCodeStart));
+
+  std::string reasonPhrase;
+  if (statusCodeEnd != std::string::npos && statusLine[statusCodeEnd] == ' ')
+  {
+    auto const reasonPhraseEnd = statusLine.find_first_of("\r\n", statusCodeEnd + 1);
+    reasonPhrase = statusLine.substr(statusCodeEnd + 1, reasonPhraseEnd - statusCodeEnd - 1);
+  }
+
+  return std::make_unique<RawResponse>(
+      static_cast<uint16_t>(majorVersion),
+      static_cast<uint16_t>(minorVersion),
+      HttpStatusCode(statusCode),
+      reasonPhrase);
+}
+} // namespace
+
+size_t CurlMultiplexedTransfer::ReadCallback(
+    char* buffer,
+    size_t size,
+    size_t count,
+    void* userData)
+{
+  auto transfer = static_cast<CurlMultiplexedTransfer*>(userData);
+  // The mutex is held while reading so the session can't release the request body meanwhile.
+  std::unique_lock<std::mutex> lock(transfer->Mutex);
+  if (transfer->RequestBody == nullptr)
+  {
+    return CURL_READFUNC_ABORT;
+  }
+  try
+  {
+    auto const bytesRead = transfer->RequestBody->Read(
+        reinterpret_cast<uint8_t*>(buffer), size * count, transfer->UploadContext);
+    transfer->RequestBodyRemaining -= static_cast<int64_t>(bytesRead);
+    // libcurl stops reading once it sent the content-length, it doesn't read again to get 0.
+    if (bytesRead == 0 || transfer->RequestBodyRemaining <= 0)
+    {
+      transfer->UploadCompleted = true;
+      transfer->StateChanged.notify_all();
+    }
+    return bytesRead;
+  }
+  catch (...)
+  {
+    // Exceptions can't go through libcurl. The session re-throws it after the transfer completes.
+    transfer->Error = std::current_exception();
+    transfer->UploadCompleted = true;
+    transfer->StateChanged.notify_all();
+    return CURL_READFUNC_ABORT;
+  }
+}
+
+size_t CurlMultiplexedTransfer::WriteCallback(
+    char* data,
+    size_t size,
+    size_t count,
+    void* userData)
+{
+  auto transfer = static_cast<CurlMultiplexedTransfer*>(userData);
+  auto const dataSize = size * count;
+
+  std::unique_lock<std::mutex> lock(transfer->Mutex);
+  if (transfer->ResponseBuffer.size() - transfer->ResponseBufferOffset
+      >= MaxMultiplexedResponseBufferSize)
+  {
+    // libcurl delivers the same data again once the session resumes the transfer.
+    transfer->Paused = true;
+    return CURL_WRITEFUNC_PAUSE;
+  }
+  transfer->ResponseBuffer.insert(transfer->ResponseBuffer.end(), data, data + dataSize);
+  transfer->StateChanged.notify_all();
+  return dataSize;
+}
+
+size_t CurlMultiplexedTransfer::HeaderCallback(
+    char* data,
+    size_t size,
+    size_t count,
+    void* userData)
+{
+  auto transfer = static_cast<CurlMultiplexedTransfer*>(userData);
+  auto const dataSize = size * count;
+
+  std::unique_lock<std::mutex> lock(transfer->Mutex);
+  if (transfer->HeadersReceived)
+  {
+    // Trailers are not part of the response.
+    return dataSize;
+  }
+  try
+  {
+    std::string const header(data, dataSize);
+    if (header.compare(0, 5, "HTTP/") == 0)
+    {
+      // Interim responses (1xx) are followed by the final response, which replaces them.
+      transfer->Response = CreateMultiplexedResponse(header);
+    }
+    else if (header == "\r\n" || header == "\n")
+    {
+      if (transfer->Response
+          && static_cast<int>(transfer->Response->GetStatusCode()) >= 200)
+      {
+        transfer->HeadersReceived = true;
+        transfer->StateChanged.notify_all();
+      }
+    }
+    else if (transfer->Response)
+    {
+      Azure::Core::Http::_detail::RawResponseHelpers::SetHeader(
+          *transfer->Response,
+          reinterpret_cast<uint8_t const*>(header.data()),
+          reinterpret_cast<uint8_t const*>(header.data() + header.size()));
+    }
+  }
+  catch (std::exception const& e)
+  {
+    Log::Write(
+        Logger::Level::Error, LogMsgPrefix + "Failed to parse response header. " + e.what());
+    // Returning a different size makes libcurl abort the transfer.
+    return 0;
+  }
+  return dataSize;
+}
+
+CurlMultiplexer::~CurlMultiplexer()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    if (m_isPerforming)
+    {
+      curl_multi_wakeup(m_multiHandle);
+    }
+  }
+  m_commandQueued.notify_one();
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+  if (m_multiHandle != nullptr)
+  {
+    curl_multi_cleanup(m_multiHandle);
+  }
+}
+
+bool CurlMultiplexer::IsHttp2Supported()
+{
+  // Check the library loaded at runtime, which can be different from the headers used to build.
+  // Multiplexed HTTP/2 streams can stall forever with libcurl versions older than 8.1.0.
+  static bool const isHttp2Supported = []() {
+    auto const versionInfo = curl_version_info(CURLVERSION_NOW);
+    return versionInfo->version_num >= 0x080100
+        && (versionInfo->features & CURL_VERSION_HTTP2) != 0;
+  }();
+  return isHttp2Supported;
+}
+
+void CurlMultiplexer::Add(std::shared_ptr<CurlMultiplexedTransfer> transfer)
+{
+  Enqueue(CommandType::Add, std::move(transfer));
+}
+
+void CurlMultiplexer::Remove(std::shared_ptr<CurlMultiplexedTransfer> transfer)
+{
+  Enqueue(CommandType::Remove, std::move(transfer));
+}
+
+void CurlMultiplexer::Resume(std::shared_ptr<CurlMultiplexedTransfer> transfer)
+{
+  Enqueue(CommandType::Resume, std::move(transfer));
+}
+
+void CurlMultiplexer::Enqueue(CommandType type, std::shared_ptr<CurlMultiplexedTransfer> transfer)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_stop)
+  {
+    if (type == CommandType::Add)
+    {
+      throw TransportException("Error while sending request. The application is terminating.");
+    }
+    return;
+  }
+
+  // The multiplexer thread and the multi handle are created by the first request and live until
+  // the application terminates.
+  if (m_multiHandle == nullptr)
+  {
+    m_multiHandle = curl_multi_init();
+    if (m_multiHandle == nullptr)
+    {
+      throw TransportException("Error while sending request. curl_multi_init returned Null");
+    }
+    curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  }
+  if (!m_thread.joinable())
+  {
+    Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Start multiplexer thread");
+    m_thread = std::thread([this]() { Run(); });
+  }
+
+  m_commands.emplace_back(Command{type, std::move(transfer)});
+  if (m_isPerforming)
+  {
+    // Make the multiplexer thread return from curl_multi_poll() to run the command.
+    curl_multi_wakeup(m_multiHandle);
+  }
+  m_commandQueued.notify_one();
+}
+
+void CurlMultiplexer::Complete(CurlMultiplexedTransfer& transfer, CURLcode result)
+{
+  curl_multi_remove_handle(m_multiHandle, transfer.Handle.get());
+  // Keep the transfer alive until it is marked as completed.
+  auto const self = *transfer.Position;
+  m_transfers.erase(transfer.Position);
+  transfer.IsActive = false;
+
+  std::unique_lock<std::mutex> lock(transfer.Mutex);
+  transfer.Result = result;
+  transfer.Completed = true;
+  transfer.StateChanged.notify_all();
+}
+
+void CurlMultiplexer::Fail(
+    CurlMultiplexedTransfer& transfer,
+    CURLcode result,
+    std::exception_ptr error)
+{
+  std::unique_lock<std::mutex> lock(transfer.Mutex);
+  transfer.Result = result;
+  if (!transfer.Error)
+  {
+    transfer.Error = std::move(error);
+  }
+  transfer.Completed = true;
+  transfer.StateChanged.notify_all();
+}
+
+void CurlMultiplexer::RunCommand(Command const& command)
+{
+  auto& transfer = *command.Transfer;
+  switch (command.Type)
+  {
+    case CommandType::Add: {
+      if (curl_multi_add_handle(m_multiHandle, transfer.Handle.get()) != CURLM_OK)
+      {
+        Fail(transfer, CURLE_FAILED_INIT, nullptr);
+        break;
+      }
+      transfer.Position = m_transfers.insert(m_transfers.end(), command.Transfer);
+      transfer.IsActive = true;
+      break;
+    }
+    case CommandType::Remove: {
+      if (transfer.IsActive)
+      {
+        curl_multi_remove_handle(m_multiHandle, transfer.Handle.get());
+        m_transfers.erase(transfer.Position);
+        transfer.IsActive = false;
+      }
+      break;
+    }
+    case CommandType::Resume: {
+      if (transfer.IsActive)
+      {
+        curl_easy_pause(transfer.Handle.get(), CURLPAUSE_CONT);
+      }
+      break;
+    }
+  }
+}
+
+void CurlMultiplexer::Run()
+{
+  std::vector<Command> commands;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop)
+  {
+    if (m_transfers.empty() && m_commands.empty())
+    {
+      m_commandQueued.wait(lock, [this]() { return m_stop || !m_commands.empty(); });
+      continue;
+    }
+
+    commands.swap(m_commands);
+    m_isPerforming = true;
+    lock.unlock();
+
+    for (auto const& command : commands)
+    {
+      RunCommand(command);
+    }
+    commands.clear();
+
+    int runningTransfers = 0;
+    auto performResult = curl_multi_perform(m_multiHandle, &runningTransfers);
+    if (performResult != CURLM_OK)
+    {
+      Log::Write(
+          Logger::Level::Error,
+          LogMsgPrefix + "Multiplexer failed. " + curl_multi_strerror(performResult));
+      while (!m_transfers.empty())
+      {
+        Complete(*m_transfers.front(), CURLE_FAILED_INIT);
+      }
+    }
+
+    CURLMsg* message = nullptr;
+    int messagesLeft = 0;
+    while ((message = curl_multi_info_read(m_multiHandle, &messagesLeft)) != nullptr)
+    {
+      if (message->msg == CURLMSG_DONE)
+      {
+        char* transfer = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+        Complete(*reinterpret_cast<CurlMultiplexedTransfer*>(transfer), message->data.result);
+      }
+    }
+
+    if (!m_transfers.empty())
+    {
+      curl_multi_poll(
+          m_multiHandle,
+          nullptr,
+          0,
+          static_cast<int>(MultiplexedTransferPollInterval.count()),
+          nullptr);
+    }
+
+    lock.lock();
+    m_isPerforming = false;
+  }
+
+  // Release every session that is still waiting, including the ones whose transfer was queued but
+  // not added to the multi handle yet.
+  commands.swap(m_commands);
+  lock.unlock();
+  auto const terminating = std::make_exception_ptr(
+      TransportException("Error while sending request. The application is terminating."));
+  for (auto const& command : commands)
+  {
+    if (command.Type == CommandType::Add)
+    {
+      Fail(*command.Transfer, CURLE_ABORTED_BY_CALLBACK, terminating);
+    }
+  }
+  while (!m_transfers.empty())
+  {
+    Complete(*m_transfers.front(), CURLE_ABORTED_BY_CALLBACK);
+  }
+}
+
+CurlMultiplexedSession::CurlMultiplexedSession(
+    Request& request,
+    CurlTransportOptions const& curlOptions)
+    : m_transfer(std::make_shared<CurlMultiplexedTransfer>()), m_request(request)
+{
+  auto const& url = request.GetUrl();
+  std::string hostDisplayName = url.GetScheme() + "://" + url.GetHost();
+  if (url.GetPort() != 0)
+  {
+    hostDisplayName += ":" + std::to_string(url.GetPort());
+  }
+
+  auto& handle = m_transfer->Handle;
+  handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
+  if (!handle)
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string("curl_easy_init returned Null"));
+  }
+
+  CurlConnection::SetCommonOptions(handle, curlOptions, hostDisplayName);
+
+  // With HTTP/2, let libcurl negotiate it with ALPN and wait for a connection that is being
+  // established to the same host, instead of opening a new one, so the requests are multiplexed on
+  // it. Otherwise, the request uses HTTP/1.1 like the sessions from the connection pool.
+  bool const useHttp2 = curlOptions.EnableHttp2 && CurlMultiplexer::IsHttp2Supported();
+  CURLcode result;
+  CurlMultiplexedTransfer* transfer = m_transfer.get();
+  if (!SetLibcurlOption(handle, CURLOPT_URL, url.GetAbsoluteUrl().data(), &result)
+      || (url.GetPort() != 0
+          && !SetLibcurlOption(handle, CURLOPT_PORT, static_cast<long>(url.GetPort()), &result))
+      || !SetLibcurlOption(
+          handle,
+          CURLOPT_HTTP_VERSION,
+          useHttp2 ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_1_1,
+          &result)
+      || (useHttp2 && !SetLibcurlOption(handle, CURLOPT_PIPEWAIT, 1L, &result))
+      || !SetLibcurlOption(handle, CURLOPT_PRIVATE, transfer, &result)
+      || !SetLibcurlOption(
+          handle, CURLOPT_HEADERFUNCTION, CurlMultiplexedTransfer::HeaderCallback, &result)
+      || !SetLibcurlOption(handle, CURLOPT_HEADERDATA, transfer, &result)
+      || !SetLibcurlOption(
+          handle, CURLOPT_WRITEFUNCTION, CurlMultiplexedTransfer::WriteCallback, &result)
+      || !SetLibcurlOption(handle, CURLOPT_WRITEDATA, transfer, &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+
+  auto const& method = request.GetMethod();
+  if (method == HttpMethod::Head)
+  {
+    if (!SetLibcurlOption(handle, CURLOPT_NOBODY, 1L, &result))
+    {
+      throw Azure::Core::Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+          + std::string(curl_easy_strerror(result)));
+    }
+  }
+  else if (method != HttpMethod::Get)
+  {
+    auto body = request.GetBodyStream();
+    if (!SetLibcurlOption(handle, CURLOPT_CUSTOMREQUEST, method.ToString().c_str(), &result))
+    {
+      throw Azure::Core::Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+          + std::string(curl_easy_strerror(result)));
+    }
+    // Same as the HTTP/1.1 session, requests which are not GET, HEAD or DELETE always send a
+    // content-length, even when the body is empty.
+    if (method != HttpMethod::Delete || body->Length() > 0)
+    {
+      if (!SetLibcurlOption(handle, CURLOPT_UPLOAD, 1L, &result)
+          || !SetLibcurlOption(
+              handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(body->Length()), &result)
+          || !SetLibcurlOption(
+              handle, CURLOPT_READFUNCTION, CurlMultiplexedTransfer::ReadCallback, &result)
+          || !SetLibcurlOption(handle, CURLOPT_READDATA, transfer, &result))
+      {
+        throw Azure::Core::Http::TransportException(
+            _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+            + std::string(curl_easy_strerror(result)));
+      }
+      m_transfer->RequestBody = body;
+      m_transfer->RequestBodyRemaining = body->Length();
+      // libcurl doesn't call the read callback at all for an empty body.
+      m_transfer->UploadCompleted = body->Length() == 0;
+    }
+  }
+
+  std::vector<std::string> headerLines;
+  bool hasExpectHeader = false;
+  for (auto const& header : request.GetHeaders())
+  {
+    // libcurl sends a header with an empty value only when it ends with a semicolon.
+    headerLines.emplace_back(
+        header.first + (header.second.empty() ? std::string(";") : ": " + header.second));
+    hasExpectHeader = hasExpectHeader || header.first == "expect";
+  }
+  if (!hasExpectHeader)
+  {
+    // Like the sessions from the connection pool, upload the body without waiting for a
+    // `100 Continue` response. An empty value removes the header added by libcurl.
+    headerLines.emplace_back("Expect:");
+  }
+  for (auto const& headerLine : headerLines)
+  {
+    auto headers = curl_slist_append(m_transfer->RequestHeaders.get(), headerLine.c_str());
+    if (headers == nullptr)
+    {
+      throw Azure::Core::Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+          + std::string("curl_slist_append returned Null"));
+    }
+    // The head of the list changes only when the first header is added.
+    static_cast<void>(m_transfer->RequestHeaders.release());
+    m_transfer->RequestHeaders.reset(headers);
+  }
+  if (m_transfer->RequestHeaders
+      && !SetLibcurlOption(
+          handle, CURLOPT_HTTPHEADER, m_transfer->RequestHeaders.get(), &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+}
+
+CurlMultiplexedSession::~CurlMultiplexedSession()
+{
+  {
+    // Make sure the read callback doesn't use the request body after this point.
+    std::unique_lock<std::mutex> lock(m_transfer->Mutex);
+    m_transfer->RequestBody = nullptr;
+  }
+  if (m_isAdded)
+  {
+    // Stops the transfer if the response was not read completely.
+    CurlMultiplexer::g_curlMultiplexer.Remove(m_transfer);
+  }
+}
+
+std::unique_ptr<RawResponse> CurlMultiplexedSession::Perform(Context const& context)
+{
+  // Before doing any work, check to make sure that the context hasn't already been cancelled.
+  context.ThrowIfCancelled();
+
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Send multiplexed request");
+  m_transfer->UploadContext = context;
+  CurlMultiplexer::g_curlMultiplexer.Add(m_transfer);
+  m_isAdded = true;
+
+  auto& transfer = *m_transfer;
+  std::unique_lock<std::mutex> lock(transfer.Mutex);
+  // The request body can't be used after returning, so also wait for the upload to finish.
+  WaitForTransfer(transfer, lock, context, [&transfer]() {
+    return transfer.Completed
+        || (transfer.HeadersReceived
+            && (transfer.RequestBody == nullptr || transfer.UploadCompleted));
+  });
+  transfer.RequestBody = nullptr;
+
+  if (transfer.Error)
+  {
+    std::rethrow_exception(transfer.Error);
+  }
+  if (!transfer.HeadersReceived)
+  {
+    throw TransportException(
+        "Error while sending request. " + std::string(curl_easy_strerror(transfer.Result)));
+  }
+  auto response = std::move(transfer.Response);
+  lock.unlock();
+
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Multiplexed response headers received");
+
+  // For Head request, set the length of body response to 0.
+  // For NoContent status code, also need to set contentLength to 0.
+  auto const statusCode = response->GetStatusCode();
+  if (m_request.GetMethod() == HttpMethod::Head || statusCode == HttpStatusCode::NoContent
+      || statusCode == HttpStatusCode::NotModified)
+  {
+    m_contentLength = 0;
+  }
+  else
+  {
+    auto const& headers = response->GetHeaders();
+    auto const contentLength = headers.find("content-length");
+    if (contentLength != headers.end())
+    {
+      m_contentLength = static_cast<int64_t>(std::stoull(contentLength->second));
+    }
+  }
+  return response;
+}
+
+size_t CurlMultiplexedSession::OnRead(uint8_t* buffer, size_t count, Context const& context)
+{
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  auto& transfer = *m_transfer;
+  size_t bytesRead = 0;
+  bool resume = false;
+  {
+    std::unique_lock<std::mutex> lock(transfer.Mutex);
+    WaitForTransfer(transfer, lock, context, [&transfer]() {
+      return transfer.Completed
+          || transfer.ResponseBufferOffset < transfer.ResponseBuffer.size();
+    });
+
+    auto const bytesAvailable = transfer.ResponseBuffer.size() - transfer.ResponseBufferOffset;
+    if (bytesAvailable == 0)
+    {
+      if (transfer.Result != CURLE_OK)
+      {
+        throw TransportException(
+            "Error while reading response body. "
+            + std::string(curl_easy_strerror(transfer.Result)));
+      }
+      return 0;
+    }
+
+    bytesRead = (std::min)(count, bytesAvailable);
+    auto const begin = transfer.ResponseBuffer.begin()
+        + static_cast<std::ptrdiff_t>(transfer.ResponseBufferOffset);
+    std::copy(begin, begin + static_cast<std::ptrdiff_t>(bytesRead), buffer);
+    transfer.ResponseBufferOffset += bytesRead;
+
+    if (transfer.ResponseBufferOffset == transfer.ResponseBuffer.size())
+    {
+      transfer.ResponseBuffer.clear();
+      transfer.ResponseBufferOffset = 0;
+    }
+    else if (transfer.ResponseBufferOffset >= MaxMultiplexedResponseBufferSize)
+    {
+      transfer.ResponseBuffer.erase(
+          transfer.ResponseBuffer.begin(),
+          transfer.ResponseBuffer.begin()
+              + static_cast<std::ptrdiff_t>(transfer.ResponseBufferOffset));
+      transfer.ResponseBufferOffset = 0;
+    }
+
+    if (transfer.Paused
+        && transfer.ResponseBuffer.size() - transfer.ResponseBufferOffset
+            < MaxMultiplexedResponseBufferSize / 2)
+    {
+      transfer.Paused = false;
+      resume = true;
+    }
+  }
+
+  if (resume)
+  {
+    CurlMultiplexer::g_curlMultiplexer.Resume(m_transfer);
+  }
+  return bytesRead;
+}
+#endif
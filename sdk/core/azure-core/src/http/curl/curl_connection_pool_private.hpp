@@ -15,11 +15,13 @@
 
 #include <azure/core/http/curl_transport.hpp>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -29,12 +31,68 @@ namespace Azure { namespace Core { namespace Test {
   class CurlConnectionPool_connectionPoolTest_Test;
   class CurlConnectionPool_uniquePort_Test;
   class CurlConnectionPool_connectionClose_Test;
+  class CurlConnectionPool_maxIdleConnectionsPerHost_Test;
+  class CurlConnectionPool_maxIdleConnectionsAcrossThreads_Test;
+  class CurlConnectionPool_minIdleConnectionsPerHost_Test;
   class SdkWithLibcurl_globalCleanUp_Test;
 }}} // namespace Azure::Core::Test
 #endif
 
 namespace Azure { namespace Core { namespace Http { namespace _detail {
 
+  /**
+   * @brief The idle connections kept by the pool for one connection key.
+   *
+   * @details The connections are split in #ConnectionPoolStripeCount stripes, each one with its own
+   * mutex. Threads move connections back to the stripe picked by their thread id and look first in
+   * that same stripe when they need a connection, so concurrent requests to the same host rarely
+   * contend for the same mutex.
+   */
+  struct CurlHostConnectionPool final
+  {
+    /**
+     * @brief Construct a new host pool with the idle connection limits of its connection key.
+     *
+     */
+    CurlHostConnectionPool(size_t maxIdleConnections, size_t minIdleConnections)
+        : MaxIdleConnections(maxIdleConnections), MinIdleConnections(minIdleConnections)
+    {
+    }
+
+    /**
+     * @brief A group of idle connections protected by its own mutex.
+     *
+     * @remark Each stripe behaves as a Last-in-First-out list. Connections are added with
+     * `push_front()`, so the oldest connection can be found at the end of the list.
+     */
+    struct Stripe final
+    {
+      std::mutex Mutex;
+      std::list<std::unique_ptr<CurlNetworkConnection>> Connections;
+    };
+
+    std::array<Stripe, ConnectionPoolStripeCount> Stripes;
+
+    /**
+     * @brief The number of idle connections across all the stripes.
+     *
+     */
+    std::atomic<size_t> IdleConnections{0};
+
+    /**
+     * @brief Maximum number of idle connections kept for this connection key, across all the
+     * stripes.
+     *
+     */
+    size_t const MaxIdleConnections;
+
+    /**
+     * @brief Number of idle connections that the clean routine won't close even if they are expired.
+     *
+     */
+    size_t const MinIdleConnections;
+  };
+
   /**
    * @brief CURL HTTP connection pool makes it possible to re-use one curl connection to perform
    * more than one request. Use this component when connections are not re-used by default.
@@ -48,6 +106,9 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     friend class Azure::Core::Test::CurlConnectionPool_connectionPoolTest_Test;
     friend class Azure::Core::Test::CurlConnectionPool_uniquePort_Test;
     friend class Azure::Core::Test::CurlConnectionPool_connectionClose_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_maxIdleConnectionsPerHost_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_maxIdleConnectionsAcrossThreads_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_minIdleConnectionsPerHost_Test;
     friend class Azure::Core::Test::SdkWithLibcurl_globalCleanUp_Test;
 #endif
 
@@ -57,13 +118,13 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
       using namespace Azure::Core::Http::_detail;
       if (m_cleanThread.joinable())
       {
+        // Remove all connections
+        Clear();
+        // Signal clean thread to wake up
         {
-          std::unique_lock<std::mutex> lock(ConnectionPoolMutex);
-          // Remove all connections
-          g_curlConnectionPool.ConnectionPoolIndex.clear();
+          std::unique_lock<std::mutex> lock(CleanThreadMutex);
+          ConditionalVariableForCleanThread.notify_one();
         }
-        // Signal clean thread to wake up
-        ConditionalVariableForCleanThread.notify_one();
         // join thread
         m_cleanThread.join();
       }
@@ -98,34 +159,137 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
         std::unique_ptr<CurlNetworkConnection> connection,
         bool httpKeepAlive);
 
+    /**
+     * @brief Removes all the idle connections from the pool.
+     *
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the number of connection keys in the index of the pool.
+     *
+     */
+    size_t ConnectionPoolIndexCount();
+
+    /**
+     * @brief Closes the expired idle connections, keeping the minimum idle connections of each
+     * host, and removes the host pools left without idle connections.
+     *
+     * @remark This is the routine run periodically by the clean thread.
+     */
+    void CleanExpiredConnections();
+
+    /**
+     * @brief Removes from the index the host pools without idle connections which are not being
+     * used by another thread.
+     *
+     */
+    void PruneHostPools();
+
+    /**
+     * @brief Gets a snapshot of the connection pool counters.
+     *
+     */
+    CurlConnectionPoolStatistics GetStatistics();
+
+    /**
+     * @brief Adds \p count connections closed by the pool to the evictions counter.
+     *
+     */
+    void RecordEvictions(size_t count) { m_evictions += count; }
+
     /**
      * @brief Keeps a unique key for each host and creates a connection pool for each key.
      *
      * @details This way getting a connection for a specific host can be done in O(1) instead of
      * looping a single connection list to find the first connection for the required host.
      *
-     * @remark There might be multiple connections for each host.
+     * @remark An entry is removed when it has no idle connections left and no other thread holds
+     * it. Host pools are only copied from the index while holding #ConnectionPoolMutex, so a
+     * thread can keep using its copy after releasing the mutex.
      */
-    std::unordered_map<std::string, std::list<std::unique_ptr<CurlNetworkConnection>>>
-        ConnectionPoolIndex;
+    std::unordered_map<std::string, std::shared_ptr<CurlHostConnectionPool>> ConnectionPoolIndex;
 
-    std::mutex ConnectionPoolMutex;
+    /**
+     * @brief Protects #ConnectionPoolIndex. Looking up a host pool only takes a shared lock, the
+     * exclusive lock is taken to add or remove a connection key.
+     *
+     */
+    std::shared_timed_mutex ConnectionPoolMutex;
 
     // This is used to put the cleaning pool thread to sleep and yet to be able to wake it if the
     // application finishes.
+    std::mutex CleanThreadMutex;
     std::condition_variable ConditionalVariableForCleanThread;
 
     AZ_CORE_DLLEXPORT static Azure::Core::Http::_detail::CurlConnectionPool g_curlConnectionPool;
 
     bool IsCleanThreadRunning = false;
 
+    /**
+     * @brief The number of idle connections in the pool, for all the connection keys.
+     *
+     */
+    std::atomic<size_t> IdleConnections{0};
+
   private:
     // private constructor to keep this as singleton.
     CurlConnectionPool() { curl_global_init(CURL_GLOBAL_ALL); }
 
     // Makes possible to know the number of current connections in the connection pool for an
     // index
-    size_t ConnectionsOnPool(std::string const& host) { return ConnectionPoolIndex[host].size(); }
+    size_t ConnectionsOnPool(std::string const& host);
+
+    /**
+     * @brief Gets the host pool for a connection key, creating it if it does not exist yet.
+     *
+     * @remark The idle connection limits are only used when the host pool is created. They are
+     * part of the connection key, so every caller passes the same limits for the same key.
+     */
+    std::shared_ptr<CurlHostConnectionPool> GetHostPool(
+        std::string const& connectionKey,
+        size_t maxIdleConnections = DefaultMaxIdleConnectionsPerHost,
+        size_t minIdleConnections = 0);
+
+    /**
+     * @brief Gets the host pool for a connection key or `nullptr` if it does not exist.
+     *
+     */
+    std::shared_ptr<CurlHostConnectionPool> FindHostPool(std::string const& connectionKey);
+
+    /**
+     * @brief Removes the host pool of a connection key from the index if it has no idle
+     * connections and no other thread holds it.
+     *
+     * @remark The caller must release its own reference to the host pool first.
+     */
+    void PruneHostPool(std::string const& connectionKey);
+
+    /**
+     * @brief Removes a connection from \p hostPool, trying first the stripe used by the calling
+     * thread.
+     *
+     */
+    std::unique_ptr<CurlNetworkConnection> TakeConnection(CurlHostConnectionPool& hostPool);
+
+    /**
+     * @brief Removes the oldest connection of a stripe from \p hostPool, trying the stripe used by
+     * the calling thread last.
+     *
+     * @return The removed connection or `nullptr` if every stripe is empty.
+     */
+    std::unique_ptr<CurlNetworkConnection> EvictConnection(CurlHostConnectionPool& hostPool);
+
+    /**
+     * @brief Locks the stripe mutex and accumulates the time spent waiting for it.
+     *
+     */
+    std::unique_lock<std::mutex> LockStripe(CurlHostConnectionPool::Stripe& stripe);
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<uint64_t> m_waitTimeNanoseconds{0};
 
     std::thread m_cleanThread;
   };
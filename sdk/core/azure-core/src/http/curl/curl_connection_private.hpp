@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "azure/core/http/curl_transport.hpp"
 #include "azure/core/http/http.hpp"
 #include "azure/core/internal/unique_handle.hpp"
 
@@ -62,10 +63,8 @@ namespace Azure { namespace Core {
       constexpr static int32_t DefaultCleanerIntervalMilliseconds = 1000 * 90;
       // 60 sec -> expired connection is when it waits for 60 sec or more and it's not re-used
       constexpr static int32_t DefaultConnectionExpiredMilliseconds = 1000 * 60;
-      // Define the maximun allowed connections per host-index in the pool. If this number is
-      // reached for the host-index, next connections trying to be added to the pool will be
-      // ignored.
-      constexpr static int32_t MaxConnectionsPerIndex = 1024;
+      // Number of independently locked lists the idle connections of each host-index are split in.
+      constexpr static size_t ConnectionPoolStripeCount = 16;
 
     } // namespace _detail
 
@@ -79,6 +78,8 @@ namespace Azure { namespace Core {
     class CurlNetworkConnection {
     private:
       bool m_isShutDown = false;
+      size_t m_maxIdleConnections = _detail::DefaultMaxIdleConnectionsPerHost;
+      size_t m_minIdleConnections = 0;
 
     public:
       /**
@@ -134,6 +135,31 @@ namespace Azure { namespace Core {
        * @return `true` is the connection was shut it down; otherwise, `false`.
        */
       bool IsShutdown() const { return m_isShutDown; }
+
+      /**
+       * @brief Set the idle connection limits of the host pool the connection is moved back to.
+       *
+       * @remark The host pool is removed from the connection pool while it has no idle
+       * connections, so the connection keeps the limits to create it again.
+       */
+      void SetIdleConnectionLimits(size_t maxIdleConnections, size_t minIdleConnections)
+      {
+        m_maxIdleConnections = maxIdleConnections;
+        m_minIdleConnections = minIdleConnections;
+      }
+
+      /**
+       * @brief Get the maximum number of idle connections kept for the connection key.
+       *
+       */
+      size_t GetMaxIdleConnections() const { return m_maxIdleConnections; }
+
+      /**
+       * @brief Get the number of idle connections for the connection key that are not closed when
+       * they expire.
+       *
+       */
+      size_t GetMinIdleConnections() const { return m_minIdleConnections; }
     };
 
     /**
@@ -178,6 +204,21 @@ namespace Azure { namespace Core {
           std::string const& hostDisplayName,
           std::string const& connectionPropertiesKey);
 
+      /**
+       * @brief Applies the transport options which are common to every libcurl handle created by
+       * the transport adapter, like the proxy, the certificate authorities or the timeouts.
+       *
+       * @param handle The libcurl handle to configure.
+       * @param options Connection options.
+       * @param hostDisplayName Display name for remote host, used for diagnostics.
+       *
+       * @throw Azure::Core::Http::TransportException if any option can't be set.
+       */
+      static void SetCommonOptions(
+          Azure::Core::_internal::UniqueHandle<CURL> const& handle,
+          Azure::Core::Http::CurlTransportOptions const& options,
+          std::string const& hostDisplayName);
+
       /**
        * @brief Destructor.
        * @details Cleans up CURL (invokes `curl_easy_cleanup()`).
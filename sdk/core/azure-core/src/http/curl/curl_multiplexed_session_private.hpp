@@ -0,0 +1,227 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief The curl multiplexed session sends a request with the libcurl multi interface so that
+ * a single thread performs every transfer and concurrent requests to the same host can share one
+ * HTTP/2 connection.
+ *
+ * @remark The curl multiplexed session is a body stream derived class.
+ */
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/dll_import_export.hpp"
+#include "azure/core/http/curl_transport.hpp"
+#include "azure/core/http/http.hpp"
+#include "azure/core/http/raw_response.hpp"
+#include "azure/core/io/body_stream.hpp"
+#include "curl_connection_private.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Core {
+  namespace _detail {
+    /**
+     * @brief Unique handle for libcurl header lists.
+     *
+     */
+    template <> struct UniqueHandleHelper<curl_slist>
+    {
+      using type = _internal::BasicUniqueHandle<curl_slist, curl_slist_free_all>;
+    };
+  } // namespace _detail
+}} // namespace Azure::Core
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+namespace Azure { namespace Core { namespace Http {
+  namespace _detail {
+    /**
+     * @brief Maximum number of response bytes buffered for a multiplexed request before the
+     * stream is paused until the application reads from the response body.
+     *
+     */
+    constexpr static size_t MaxMultiplexedResponseBufferSize = 1024 * 1024;
+
+    /**
+     * @brief A request in flight on the #CurlMultiplexer.
+     *
+     * @details The libcurl callbacks run on the multiplexer thread and publish the response to the
+     * thread that sent the request through this state, protected by `Mutex`.
+     *
+     */
+    struct CurlMultiplexedTransfer final
+    {
+      Azure::Core::_internal::UniqueHandle<CURL> Handle;
+      Azure::Core::_internal::UniqueHandle<curl_slist> RequestHeaders;
+
+      // Used only by the read callback, while the request is being uploaded.
+      Azure::Core::IO::BodyStream* RequestBody = nullptr;
+      int64_t RequestBodyRemaining = 0;
+      Context UploadContext;
+
+      std::mutex Mutex;
+      std::condition_variable StateChanged;
+      std::unique_ptr<RawResponse> Response;
+      std::vector<uint8_t> ResponseBuffer;
+      size_t ResponseBufferOffset = 0;
+      // Raised by the read callback or by the multiplexer, re-thrown by the session.
+      std::exception_ptr Error;
+      CURLcode Result = CURLE_OK;
+      bool HeadersReceived = false;
+      bool UploadCompleted = false;
+      bool Paused = false;
+      bool Completed = false;
+
+      // Used only by the multiplexer thread.
+      std::list<std::shared_ptr<CurlMultiplexedTransfer>>::iterator Position;
+      bool IsActive = false;
+
+      static size_t ReadCallback(char* buffer, size_t size, size_t count, void* userData);
+      static size_t WriteCallback(char* data, size_t size, size_t count, void* userData);
+      static size_t HeaderCallback(char* data, size_t size, size_t count, void* userData);
+    };
+
+    /**
+     * @brief Drives every request sent by the CURL transport adapter when
+     * #Azure::Core::Http::CurlTransportOptions::EnableSharedEventLoop or
+     * #Azure::Core::Http::CurlTransportOptions::EnableHttp2 is set.
+     *
+     * @details The requests are added to a single libcurl multi handle with multiplexing enabled,
+     * so with HTTP/2 libcurl opens one connection per host and runs concurrent requests as streams
+     * on it. With HTTP/1.1, the multi handle keeps the connections to re-use them. A single thread
+     * performs every transfer. Other threads never call libcurl on the multi handle directly, they
+     * queue a command and wake the thread up with `curl_multi_wakeup()`.
+     *
+     * This multiplexer is allocated statically and there can be only one per application.
+     */
+    class CurlMultiplexer final {
+    public:
+      ~CurlMultiplexer();
+
+      /**
+       * @brief Starts performing \p transfer.
+       *
+       */
+      void Add(std::shared_ptr<CurlMultiplexedTransfer> transfer);
+
+      /**
+       * @brief Stops \p transfer, if it is still running, and releases it.
+       *
+       */
+      void Remove(std::shared_ptr<CurlMultiplexedTransfer> transfer);
+
+      /**
+       * @brief Resumes receiving the response for a \p transfer paused because its response buffer
+       * was full.
+       *
+       */
+      void Resume(std::shared_ptr<CurlMultiplexedTransfer> transfer);
+
+      /**
+       * @brief Checks if the libcurl library loaded by the application can negotiate HTTP/2.
+       *
+       */
+      static bool IsHttp2Supported();
+
+      AZ_CORE_DLLEXPORT static Azure::Core::Http::_detail::CurlMultiplexer g_curlMultiplexer;
+
+    private:
+      // Private constructor to keep this as singleton.
+      CurlMultiplexer() = default;
+
+      enum class CommandType
+      {
+        Add,
+        Remove,
+        Resume,
+      };
+
+      struct Command final
+      {
+        CommandType Type;
+        std::shared_ptr<CurlMultiplexedTransfer> Transfer;
+      };
+
+      void Enqueue(CommandType type, std::shared_ptr<CurlMultiplexedTransfer> transfer);
+      void Run();
+      // Must be called by the multiplexer thread only.
+      void RunCommand(Command const& command);
+      void Complete(CurlMultiplexedTransfer& transfer, CURLcode result);
+      // Completes a transfer that is not added to the multi handle with an error.
+      static void Fail(
+          CurlMultiplexedTransfer& transfer,
+          CURLcode result,
+          std::exception_ptr error);
+
+      std::mutex m_mutex;
+      // Wakes the multiplexer thread up when it is idle and a command is queued.
+      std::condition_variable m_commandQueued;
+      std::vector<Command> m_commands;
+      CURLM* m_multiHandle = nullptr;
+      bool m_isPerforming = false;
+      bool m_stop = false;
+      std::thread m_thread;
+
+      // Transfers added to the multi handle. Used only by the multiplexer thread.
+      std::list<std::shared_ptr<CurlMultiplexedTransfer>> m_transfers;
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Sends an HTTP request on the #Azure::Core::Http::_detail::CurlMultiplexer and streams
+   * its response.
+   *
+   * @remark Unlike #Azure::Core::Http::CurlSession, this component uses the classic libcurl
+   * callbacks, so libcurl writes the request and parses the response with the HTTP version
+   * negotiated with the server.
+   */
+  class CurlMultiplexedSession final : public Azure::Core::IO::BodyStream {
+  public:
+    /**
+     * @brief Construct a new Curl Multiplexed Session object and its libcurl handle.
+     *
+     * @param request reference to an HTTP Request.
+     * @param curlOptions Transport adapter options.
+     */
+    CurlMultiplexedSession(Request& request, CurlTransportOptions const& curlOptions);
+
+    ~CurlMultiplexedSession() override;
+
+    /**
+     * @brief Sends the request and waits until the response status line and headers are
+     * received.
+     *
+     * @param context A context to control the request lifetime.
+     * @return The HTTP RawResponse, without body stream.
+     *
+     * @throw Azure::Core::Http::TransportException if the request can't be sent.
+     */
+    std::unique_ptr<RawResponse> Perform(Context const& context);
+
+    /**
+     * @brief Implement #Azure::Core::IO::BodyStream length.
+     *
+     * @return The size of the payload or `-1` if it is not known.
+     */
+    int64_t Length() const override { return m_contentLength; }
+
+  private:
+    size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
+
+    std::shared_ptr<_detail::CurlMultiplexedTransfer> m_transfer;
+    Request& m_request;
+    int64_t m_contentLength = -1;
+    bool m_isAdded = false;
+  };
+}}} // namespace Azure::Core::Http
+#endif
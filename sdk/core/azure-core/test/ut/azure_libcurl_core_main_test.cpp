@@ -81,15 +81,14 @@ namespace Azure { namespace Core { namespace Test {
     {
       // if the destructor execution took less than the cleanup thread sleep the size should be 1
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
           1);
 
       std::uint16_t waitRepeats{0};
       // wait for the cleanup thread to wake up and run. since this is a timing matter based on when
       // the thread is scheduled we should let it run to completion max 2 minutes (12*10s)
       while (Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                     .ConnectionPoolIndex.size()
+                     .ConnectionPoolIndexCount()
                  == 1
              && waitRepeats < 12)
       {
@@ -99,8 +98,7 @@ namespace Azure { namespace Core { namespace Test {
 
       // Check that after the connection is gone and cleaned up, the pool is empty
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
           0);
     }
     else
@@ -108,8 +106,7 @@ namespace Azure { namespace Core { namespace Test {
       // we got back from the destructor and thread creation after the cleanup thread hit thus it
       // will be empty
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
           0);
     }
   }
@@ -5,6 +5,13 @@
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
@@ -22,6 +29,7 @@ using Azure::Core::Http::Request;
 using Azure::Core::Http::_internal::HttpPipeline;
 using Azure::Core::Http::Policies::HttpPolicy;
 using Azure::Core::Http::Policies::NextHttpPolicy;
+using Azure::Core::Http::Policies::TokenRefreshOptions;
 
 namespace {
 class TestTokenCredential final : public TokenCredential {
@@ -40,6 +48,76 @@ public:
   }
 };
 
+// Returns ACCESSTOKEN1, ACCESSTOKEN2, ..., and blocks the calls after the first one until
+// Unblock() is called.
+class BlockingTokenCredential final : public TokenCredential {
+private:
+  std::chrono::system_clock::duration m_firstTokenLifetime;
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_stateChanged;
+  mutable int m_calls = 0;
+  mutable int m_cancelledCalls = 0;
+  bool m_blocked = true;
+
+public:
+  explicit BlockingTokenCredential(std::chrono::system_clock::duration firstTokenLifetime)
+      : TokenCredential("BlockingTokenCredential"), m_firstTokenLifetime(firstTokenLifetime)
+  {
+  }
+
+  AccessToken GetToken(TokenRequestContext const&, Context const& context) const override
+  {
+    using namespace std::chrono_literals;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto const call = ++m_calls;
+    m_stateChanged.notify_all();
+    if (call > 1)
+    {
+      while (!m_stateChanged.wait_for(lock, 10ms, [this]() { return !m_blocked; }))
+      {
+        if (context.IsCancelled())
+        {
+          ++m_cancelledCalls;
+          m_stateChanged.notify_all();
+          context.ThrowIfCancelled();
+        }
+      }
+    }
+    return {
+        "ACCESSTOKEN" + std::to_string(call),
+        std::chrono::system_clock::now() + (call == 1 ? m_firstTokenLifetime : 1h)};
+  }
+
+  void WaitForCalls(int calls) const
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stateChanged.wait(lock, [this, calls]() { return m_calls >= calls; });
+  }
+
+  int CancelledCalls() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cancelledCalls;
+  }
+
+  void Unblock()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blocked = false;
+    m_stateChanged.notify_all();
+  }
+};
+
+std::string SendAndGetAuthorization(HttpPipeline& pipeline)
+{
+  Request request(HttpMethod::Get, Url("https://www.azure.com"));
+  pipeline.Send(request, Context());
+  auto const headers = request.GetHeaders();
+  auto const authHeader = headers.find("authorization");
+  EXPECT_NE(authHeader, headers.end());
+  return authHeader == headers.end() ? std::string() : authHeader->second;
+}
+
 class TestTransportPolicy final : public HttpPolicy {
 public:
   std::unique_ptr<RawResponse> Send(Request&, NextHttpPolicy, Context const&) const override
@@ -458,3 +536,99 @@ TEST(BearerTokenAuthenticationPolicy, ChallengeBasedFailure)
   EXPECT_NE(authHeader, headers.end());
   EXPECT_EQ(authHeader->second, "Bearer ACCESSTOKEN1");
 }
+
+TEST(BearerTokenAuthenticationPolicy, ServeStaleTokenWhileRefreshing)
+{
+  using namespace std::chrono_literals;
+  // The token is valid for a minute, which is less than the default MinimumExpiration.
+  auto credential = std::make_shared<BlockingTokenCredential>(1min);
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+  TokenRefreshOptions tokenRefreshOptions;
+  tokenRefreshOptions.ServeStaleTokenWhileRefreshing = true;
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  policies.emplace_back(std::make_unique<BearerTokenAuthenticationPolicy>(
+      credential, tokenRequestContext, tokenRefreshOptions));
+  policies.emplace_back(std::make_unique<TestTransportPolicy>());
+  HttpPipeline pipeline(policies);
+
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+
+  // This request renews the token, and is blocked until the renewal completes.
+  auto refreshingRequest
+      = std::async(std::launch::async, [&pipeline]() { return SendAndGetAuthorization(pipeline); });
+  credential->WaitForCalls(2);
+
+  // The other requests don't wait for the renewal.
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+
+  credential->Unblock();
+  EXPECT_EQ(refreshingRequest.get(), "Bearer ACCESSTOKEN2");
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN2");
+}
+
+TEST(BearerTokenAuthenticationPolicy, BackgroundRefresh)
+{
+  using namespace std::chrono_literals;
+  // The token needs a renewal in 3 minutes, which is within the background refresh margin.
+  auto credential = std::make_shared<BlockingTokenCredential>(5min);
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+  TokenRefreshOptions tokenRefreshOptions;
+  tokenRefreshOptions.BackgroundRefreshMargin = 10min;
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  policies.emplace_back(std::make_unique<BearerTokenAuthenticationPolicy>(
+      credential, tokenRequestContext, tokenRefreshOptions));
+  policies.emplace_back(std::make_unique<TestTransportPolicy>());
+  HttpPipeline pipeline(policies);
+
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+
+  // The renewal starts in the background, and no request waits for it.
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+  credential->WaitForCalls(2);
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+
+  credential->Unblock();
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (SendAndGetAuthorization(pipeline) == "Bearer ACCESSTOKEN2")
+    {
+      break;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN2");
+}
+
+TEST(BearerTokenAuthenticationPolicy, BackgroundRefreshCancelledOnDestruction)
+{
+  using namespace std::chrono_literals;
+  auto credential = std::make_shared<BlockingTokenCredential>(5min);
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+  TokenRefreshOptions tokenRefreshOptions;
+  tokenRefreshOptions.BackgroundRefreshMargin = 10min;
+
+  {
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.emplace_back(std::make_unique<BearerTokenAuthenticationPolicy>(
+        credential, tokenRequestContext, tokenRefreshOptions));
+    policies.emplace_back(std::make_unique<TestTransportPolicy>());
+    HttpPipeline pipeline(policies);
+
+    EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+    EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+    credential->WaitForCalls(2);
+  }
+
+  // Destroying the policy cancels the renewal that is still waiting for the credential, and waits
+  // for it to complete.
+  EXPECT_EQ(credential->CancelledCalls(), 1);
+}
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 
 // The next includes are from Azure Core private headers.
 // They are included to test the connection pool from the libcurl transport adapter implementation.
@@ -45,11 +46,9 @@ namespace Azure { namespace Core { namespace Test {
     TEST(CurlConnectionPool, connectionPoolTest)
     {
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.Clear();
         // Make sure there are nothing in the pool
-        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size(), 0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 0);
       }
 
       // Use the same request for all connections.
@@ -58,7 +57,7 @@ namespace Azure { namespace Core { namespace Test {
       std::string const expectedConnectionKey(CreateConnectionKey(
           AzureSdkHttpbinServer::Schema(),
           AzureSdkHttpbinServer::Host(),
-          ",0,0,0,0,0,1,1,0,0,0,0"));
+          ",0,0,0,0,0,1,1,0,0,0,0,0"));
 
       {
         // Creating a new connection with default options
@@ -77,18 +76,13 @@ namespace Azure { namespace Core { namespace Test {
       }
       // Check that after the connection is gone, it is moved back to the pool
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
+            1);
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
             1);
-        auto connectionFromPool
-            = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.begin()
-                  ->second.begin()
-                  ->get();
-        EXPECT_EQ(connectionFromPool->GetConnectionKey(), expectedConnectionKey);
       }
 
       // Test that asking a connection with same config will re-use the same connection
@@ -100,8 +94,7 @@ namespace Azure { namespace Core { namespace Test {
 
         // There was just one connection in the pool, it should be empty now
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             0);
         // And the connection key for the connection we got is the expected
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
@@ -114,22 +107,19 @@ namespace Azure { namespace Core { namespace Test {
         session->m_httpKeepAlive = true;
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Check that after the connection is gone, it is moved back to the pool
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
+            1);
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
             1);
-        auto values = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                          .ConnectionPoolIndex.begin();
-        EXPECT_EQ(values->second.size(), 1);
-        EXPECT_EQ(values->second.begin()->get()->GetConnectionKey(), expectedConnectionKey);
       }
 
       // Now test that using a different connection config won't re-use the same connection
       std::string const secondExpectedKey = AzureSdkHttpbinServer::Schema() + "://"
-          + AzureSdkHttpbinServer::Host() + ",0,0,0,0,0,1,0,0,0,0,200000";
+          + AzureSdkHttpbinServer::Host() + ",0,0,0,0,0,1,0,0,0,0,200000,0";
       {
         // Creating a new connection with options
         Azure::Core::Http::CurlTransportOptions options;
@@ -141,16 +131,12 @@ namespace Azure { namespace Core { namespace Test {
         // One connection still in the pool after getting a new connection and with first expected
         // key
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .begin()
-                ->second.begin()
-                ->get()
-                ->GetConnectionKey(),
-            expectedConnectionKey);
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
+            1);
 
         auto session
             = std::make_unique<Azure::Core::Http::CurlSession>(req, std::move(connection), options);
@@ -162,28 +148,18 @@ namespace Azure { namespace Core { namespace Test {
 
       // Now there should be 2 index wit one connection each
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
           2);
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        for (auto& val : Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                             .ConnectionPoolIndex)
-        {
-          EXPECT_EQ(val.second.size(), 1);
-        }
         // The connection pool should have the two connections we added earlier.
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(expectedConnectionKey));
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(secondExpectedKey));
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
+            1);
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                secondExpectedKey),
+            1);
       }
 
       {
@@ -206,16 +182,12 @@ namespace Azure { namespace Core { namespace Test {
         // One connection still in the pool after getting a new connection and with first expected
         // key
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .begin()
-                ->second.begin()
-                ->get()
-                ->GetConnectionKey(),
-            secondExpectedKey);
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                secondExpectedKey),
+            1);
 
         auto session
             = std::make_unique<Azure::Core::Http::CurlSession>(req, std::move(connection), options);
@@ -226,45 +198,30 @@ namespace Azure { namespace Core { namespace Test {
       }
       // Now there should be 2 index wit one connection each
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
           2);
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        for (auto& val : Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                             .ConnectionPoolIndex)
-        {
-          EXPECT_EQ(val.second.size(), 1);
-        }
         // The connection pool should have the two connections we added earlier.
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(expectedConnectionKey));
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(secondExpectedKey));
-      }
-      {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
+            1);
+        EXPECT_EQ(
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                secondExpectedKey),
+            1);
+      }
+      {
         // clean the pool
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.Clear();
       }
 
 #ifdef RUN_LONG_UNIT_TESTS
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // clean the pool
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.Clear();
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             0);
       }
 
@@ -291,16 +248,12 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                .ConnectionPoolIndex[expectedConnectionKey]
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(
+                expectedConnectionKey),
             5);
       }
 
@@ -319,10 +272,8 @@ namespace Azure { namespace Core { namespace Test {
           std::this_thread::sleep_for(10ms);
           // If test wakes while clean pool is running, it will wait until lock is released by
           // the clean pool thread.
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           poolIsEmpty = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                            .ConnectionPoolIndex.size()
+                            .ConnectionPoolIndexCount()
               == 0;
         }
         EXPECT_TRUE(poolIsEmpty);
@@ -340,7 +291,7 @@ namespace Azure { namespace Core { namespace Test {
       //       std::lock_guard<std::mutex> lock(
       //           CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
       //       // clean the pool
-      //       CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      //       CurlConnectionPool::g_curlConnectionPool.Clear();
       //     }
 
       //     std::string hostKey("key");
@@ -366,7 +317,7 @@ namespace Azure { namespace Core { namespace Test {
       //         Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
       //             .ConnectionPoolIndex[hostKey]
       //             .size(),
-      //         Azure::Core::Http::_detail::MaxConnectionsPerIndex);
+      //         Azure::Core::Http::_detail::DefaultMaxIdleConnectionsPerHost);
       //     // Test the first and last connection. Each connection should remove the last and
       //     oldest auto connectionIt =
       //     Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
@@ -397,7 +348,7 @@ namespace Azure { namespace Core { namespace Test {
 
       //       EXPECT_EQ(
       //           Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-      //               .ConnectionPoolIndex.size(),
+      //               .ConnectionPoolIndexCount(),
       //           2);
       //       EXPECT_EQ(
       //           Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
@@ -409,13 +360,13 @@ namespace Azure { namespace Core { namespace Test {
       //           Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
       //               .ConnectionPoolIndex[hostKey]
       //               .size(),
-      //           Azure::Core::Http::_detail::MaxConnectionsPerIndex);
+      //           Azure::Core::Http::_detail::DefaultMaxIdleConnectionsPerHost);
       //     }
       //     {
       //       std::lock_guard<std::mutex> lock(
       //           CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
       //       // clean the pool
-      //       CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      //       CurlConnectionPool::g_curlConnectionPool.Clear();
       //     }
       //   }
     }
@@ -423,14 +374,10 @@ namespace Azure { namespace Core { namespace Test {
     TEST(CurlConnectionPool, uniquePort)
     {
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .clear();
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
         // Make sure there is nothing in the pool
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             0);
       }
 
@@ -442,18 +389,16 @@ namespace Azure { namespace Core { namespace Test {
         std::string const expectedConnectionKey(CreateConnectionKey(
             AzureSdkHttpbinServer::Schema(),
             AzureSdkHttpbinServer::Host(),
-            ",0,0,0,0,0,1,1,0,0,0,0"));
+            ",0,0,0,0,0,1,1,0,0,0,0,0"));
 
         // Creating a new connection with default options
         auto connection = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
                               .ExtractOrCreateCurlConnection(req, {});
 
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           EXPECT_EQ(
               Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
+                  .ConnectionPoolIndexCount(),
               0);
           EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         }
@@ -463,12 +408,9 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Test connection was moved to the pool
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             1);
       }
 
@@ -480,7 +422,7 @@ namespace Azure { namespace Core { namespace Test {
         std::string const expectedConnectionKey(CreateConnectionKey(
             AzureSdkHttpbinServer::Schema(),
             AzureSdkHttpbinServer::Host(),
-            ":443,0,0,0,0,0,1,1,0,0,0,0"));
+            ":443,0,0,0,0,0,1,1,0,0,0,0,0"));
 
         // Creating a new connection with default options
         auto connection = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
@@ -488,12 +430,10 @@ namespace Azure { namespace Core { namespace Test {
 
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           // Check connection in pool is not re-used because the port is different
           EXPECT_EQ(
               Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
+                  .ConnectionPoolIndexCount(),
               1);
         }
         // move connection back to the pool
@@ -501,12 +441,9 @@ namespace Azure { namespace Core { namespace Test {
             .MoveConnectionBackToPool(std::move(connection), true);
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Check 2 connections in the pool
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             2);
       }
 
@@ -519,18 +456,16 @@ namespace Azure { namespace Core { namespace Test {
         std::string const expectedConnectionKey(CreateConnectionKey(
             AzureSdkHttpbinServer::Schema(),
             AzureSdkHttpbinServer::Host(),
-            ",0,0,0,0,0,1,1,0,0,0,0"));
+            ",0,0,0,0,0,1,1,0,0,0,0,0"));
 
         // Creating a new connection with default options
         auto connection = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
                               .ExtractOrCreateCurlConnection(req, {});
 
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           EXPECT_EQ(
               Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
+                  .ConnectionPoolIndexCount(),
               1);
         }
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
@@ -541,11 +476,8 @@ namespace Azure { namespace Core { namespace Test {
 
       {
         // Make sure there is nothing in the pool
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             2);
       }
       {
@@ -556,7 +488,7 @@ namespace Azure { namespace Core { namespace Test {
         std::string const expectedConnectionKey(CreateConnectionKey(
             AzureSdkHttpbinServer::Schema(),
             AzureSdkHttpbinServer::Host(),
-            ":443,0,0,0,0,0,1,1,0,0,0,0"));
+            ":443,0,0,0,0,0,1,1,0,0,0,0,0"));
 
         // Creating a new connection with default options
         auto connection = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
@@ -564,12 +496,10 @@ namespace Azure { namespace Core { namespace Test {
 
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           // Check connection in pool is not re-used because the port is different
           EXPECT_EQ(
               Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
+                  .ConnectionPoolIndexCount(),
               1);
         }
         // move connection back to the pool
@@ -577,14 +507,10 @@ namespace Azure { namespace Core { namespace Test {
             .MoveConnectionBackToPool(std::move(connection), true);
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             2);
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .clear();
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
       }
     }
 
@@ -636,11 +562,9 @@ namespace Azure { namespace Core { namespace Test {
       /// When getting the header connection: close from an HTTP response, the connection should not
       /// be moved back to the pool.
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.Clear();
         // Make sure there are nothing in the pool
-        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size(), 0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 0);
       }
 
       // Use the same request for all connections.
@@ -663,13 +587,127 @@ namespace Azure { namespace Core { namespace Test {
 
       // Check that after the connection is gone, it is moved back to the pool
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
+            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
             0);
       }
     }
+
+    TEST(CurlConnectionPool, maxIdleConnectionsPerHost)
+    {
+      CurlConnectionPool::g_curlConnectionPool.Clear();
+      auto const statsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+
+      std::string const connectionKey("mock-connection-key-max-idle");
+
+      // Only the two most recently returned connections are kept, the oldest one is closed.
+      for (int count = 0; count < 3; count++)
+      {
+        auto connection = std::make_unique<MockCurlNetworkConnection>();
+        connection->SetIdleConnectionLimits(2, 0);
+        EXPECT_CALL(*connection, GetConnectionKey())
+            .WillRepeatedly(::testing::ReturnRef(connectionKey));
+        EXPECT_CALL(*connection, UpdateLastUsageTime()).Times(1);
+        EXPECT_CALL(*connection, DestructObj()).Times(1);
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            std::move(connection), true);
+      }
+
+      EXPECT_EQ(
+          CurlConnectionPool::g_curlConnectionPool.FindHostPool(connectionKey)->MaxIdleConnections,
+          2);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(connectionKey), 2);
+      auto stats = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(stats.Evictions - statsBefore.Evictions, 1);
+      EXPECT_EQ(stats.IdleConnections, 2);
+
+      // Clearing the pool closes the remaining connections.
+      CurlConnectionPool::g_curlConnectionPool.Clear();
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(connectionKey), 0);
+      stats = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(stats.Evictions - statsBefore.Evictions, 3);
+      EXPECT_EQ(stats.IdleConnections, 0);
+    }
+
+    TEST(CurlConnectionPool, maxIdleConnectionsAcrossThreads)
+    {
+      CurlConnectionPool::g_curlConnectionPool.Clear();
+      auto const statsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+
+      std::string const connectionKey("mock-connection-key-max-idle-threads");
+
+      // Each thread returns its connection to its own stripe, the limit is still for the host.
+      constexpr int threadCount = 16;
+      std::vector<std::thread> threads;
+      for (int count = 0; count < threadCount; count++)
+      {
+        threads.emplace_back([&connectionKey]() {
+          auto connection = std::make_unique<MockCurlNetworkConnection>();
+          connection->SetIdleConnectionLimits(2, 0);
+          EXPECT_CALL(*connection, GetConnectionKey())
+              .WillRepeatedly(::testing::ReturnRef(connectionKey));
+          EXPECT_CALL(*connection, UpdateLastUsageTime()).Times(1);
+          EXPECT_CALL(*connection, DestructObj()).Times(1);
+          CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+              std::move(connection), true);
+        });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(connectionKey), 2);
+      auto const stats = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(stats.Evictions - statsBefore.Evictions, threadCount - 2);
+      EXPECT_EQ(stats.IdleConnections, 2);
+
+      CurlConnectionPool::g_curlConnectionPool.Clear();
+    }
+
+    TEST(CurlConnectionPool, minIdleConnectionsPerHost)
+    {
+      CurlConnectionPool::g_curlConnectionPool.Clear();
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 0);
+      auto const statsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+
+      // Every connection has expired, but one connection is kept for the first key.
+      std::string const keepKey("mock-connection-key-min-idle");
+      std::string const expireKey("mock-connection-key-min-idle-expired");
+      auto moveExpiredConnectionToPool = [](std::string const& connectionKey, size_t minIdle) {
+        auto connection = std::make_unique<MockCurlNetworkConnection>();
+        connection->SetIdleConnectionLimits(DefaultMaxIdleConnectionsPerHost, minIdle);
+        EXPECT_CALL(*connection, GetConnectionKey())
+            .WillRepeatedly(::testing::ReturnRef(connectionKey));
+        EXPECT_CALL(*connection, UpdateLastUsageTime()).Times(1);
+        EXPECT_CALL(*connection, IsExpired()).WillRepeatedly(::testing::Return(true));
+        EXPECT_CALL(*connection, DestructObj()).Times(1);
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            std::move(connection), true);
+      };
+      for (int count = 0; count < 3; count++)
+      {
+        moveExpiredConnectionToPool(keepKey, 1);
+      }
+      moveExpiredConnectionToPool(expireKey, 0);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(keepKey), 3);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 2);
+
+      CurlConnectionPool::g_curlConnectionPool.CleanExpiredConnections();
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(keepKey), 1);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expireKey), 0);
+      auto stats = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(stats.Evictions - statsBefore.Evictions, 3);
+      EXPECT_EQ(stats.IdleConnections, 1);
+      // The host pool without idle connections is removed from the index.
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 1);
+
+      // Taking the last connection of a host removes its host pool too.
+      auto connection = CurlConnectionPool::g_curlConnectionPool.TakeConnection(
+          *CurlConnectionPool::g_curlConnectionPool.FindHostPool(keepKey));
+      ASSERT_TRUE(connection);
+      CurlConnectionPool::g_curlConnectionPool.PruneHostPool(keepKey);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(), 0);
+    }
 #endif
 }}} // namespace Azure::Core::Test
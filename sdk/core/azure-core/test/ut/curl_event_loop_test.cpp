@@ -0,0 +1,301 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/context.hpp>
+#include <azure/core/http/http.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/core/platform.hpp>
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+#include "azure/core/http/curl_transport.hpp"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// The next includes are from Azure Core private headers.
+// They are included to check how the shared event loop from the libcurl transport adapter
+// implementation performs the requests.
+#include <http/curl/curl_connection_pool_private.hpp>
+#include <http/curl/curl_multiplexed_session_private.hpp>
+
+#if defined(AZ_PLATFORM_POSIX)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace Azure::Core::Http::_detail;
+using namespace std::chrono_literals;
+
+namespace Azure { namespace Core { namespace Test {
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER) && LIBCURL_VERSION_NUM >= 0x074400
+#if defined(AZ_PLATFORM_POSIX)
+  namespace {
+    /**
+     * @brief Minimal HTTP/1.1 server listening on the loopback interface.
+     *
+     * @details `GET /size/<n>` returns `n` bytes, `PUT /echo` returns the request body and
+     * `GET /hang` doesn't respond until the server is destroyed.
+     */
+    class LocalHttpServer final {
+    public:
+      LocalHttpServer()
+      {
+        m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        EXPECT_EQ(bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+        EXPECT_EQ(listen(m_listenSocket, 64), 0);
+        socklen_t addressSize = sizeof(address);
+        getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressSize);
+        m_port = ntohs(address.sin_port);
+        m_acceptThread = std::thread([this]() { AcceptConnections(); });
+      }
+
+      ~LocalHttpServer()
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_stop = true;
+          for (auto connectionSocket : m_connectionSockets)
+          {
+            shutdown(connectionSocket, SHUT_RDWR);
+          }
+        }
+        m_stopped.notify_all();
+        m_acceptThread.join();
+        for (auto& connectionThread : m_connectionThreads)
+        {
+          connectionThread.join();
+        }
+        close(m_listenSocket);
+      }
+
+      std::string Url(std::string const& path) const
+      {
+        return "http://127.0.0.1:" + std::to_string(m_port) + path;
+      }
+
+      size_t AcceptedConnections() const { return m_acceptedConnections.load(); }
+
+    private:
+      int m_listenSocket;
+      uint16_t m_port;
+      std::thread m_acceptThread;
+      std::atomic<size_t> m_acceptedConnections{0};
+
+      std::mutex m_mutex;
+      std::condition_variable m_stopped;
+      bool m_stop = false;
+      std::list<int> m_connectionSockets;
+      std::list<std::thread> m_connectionThreads;
+
+      void AcceptConnections()
+      {
+        while (true)
+        {
+          pollfd listenPoll{m_listenSocket, POLLIN, 0};
+          auto const ready = poll(&listenPoll, 1, 50);
+          std::unique_lock<std::mutex> lock(m_mutex);
+          if (m_stop)
+          {
+            return;
+          }
+          if (ready <= 0)
+          {
+            continue;
+          }
+          auto const connectionSocket = accept(m_listenSocket, nullptr, nullptr);
+          if (connectionSocket < 0)
+          {
+            continue;
+          }
+          ++m_acceptedConnections;
+          m_connectionSockets.emplace_back(connectionSocket);
+          m_connectionThreads.emplace_back([this, connectionSocket]() {
+            ServeConnection(connectionSocket);
+            close(connectionSocket);
+          });
+        }
+      }
+
+      void ServeConnection(int connectionSocket)
+      {
+        std::string received;
+        char buffer[64 * 1024];
+        while (true)
+        {
+          auto const headersEnd = received.find("\r\n\r\n");
+          if (headersEnd == std::string::npos)
+          {
+            auto const bytesReceived = recv(connectionSocket, buffer, sizeof(buffer), 0);
+            if (bytesReceived <= 0)
+            {
+              return;
+            }
+            received.append(buffer, static_cast<size_t>(bytesReceived));
+            continue;
+          }
+
+          auto const headers = received.substr(0, headersEnd);
+          size_t contentLength = 0;
+          auto const contentLengthStart = headers.find("Content-Length: ");
+          if (contentLengthStart != std::string::npos)
+          {
+            contentLength = std::stoul(headers.substr(contentLengthStart + 16));
+          }
+          while (received.size() < headersEnd + 4 + contentLength)
+          {
+            auto const bytesReceived = recv(connectionSocket, buffer, sizeof(buffer), 0);
+            if (bytesReceived <= 0)
+            {
+              return;
+            }
+            received.append(buffer, static_cast<size_t>(bytesReceived));
+          }
+          auto const requestBody = received.substr(headersEnd + 4, contentLength);
+          received.erase(0, headersEnd + 4 + contentLength);
+
+          std::string responseBody;
+          if (headers.compare(0, 10, "GET /size/") == 0)
+          {
+            responseBody.assign(std::stoul(headers.substr(10)), 'x');
+          }
+          else if (headers.compare(0, 10, "PUT /echo ") == 0)
+          {
+            responseBody = requestBody;
+          }
+          else if (headers.compare(0, 10, "GET /hang ") == 0)
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stopped.wait(lock, [this]() { return m_stop; });
+            return;
+          }
+
+          auto const response = "HTTP/1.1 200 OK\r\nContent-Length: "
+              + std::to_string(responseBody.size()) + "\r\n\r\n" + responseBody;
+          size_t sent = 0;
+          while (sent < response.size())
+          {
+            auto const bytesSent
+                = send(connectionSocket, response.data() + sent, response.size() - sent, 0);
+            if (bytesSent <= 0)
+            {
+              return;
+            }
+            sent += static_cast<size_t>(bytesSent);
+          }
+        }
+      }
+    };
+
+    std::shared_ptr<Azure::Core::Http::CurlTransport> CreateSharedEventLoopTransport()
+    {
+      Azure::Core::Http::CurlTransportOptions curlOptions;
+      curlOptions.EnableSharedEventLoop = true;
+      return std::make_shared<Azure::Core::Http::CurlTransport>(curlOptions);
+    }
+  } // namespace
+
+  TEST(CurlSharedEventLoop, manyConcurrentRequests)
+  {
+    LocalHttpServer server;
+    auto transport = CreateSharedEventLoopTransport();
+
+    constexpr size_t requestCount = 32;
+    std::vector<size_t> bodySizes(requestCount, 0);
+    std::vector<std::thread> senders;
+    for (size_t index = 0; index < requestCount; index++)
+    {
+      senders.emplace_back([&, index]() {
+        Azure::Core::Http::Request request(
+            Azure::Core::Http::HttpMethod::Get,
+            Azure::Core::Url(server.Url("/size/" + std::to_string(1000 + index))));
+        auto response = transport->Send(request, Context::ApplicationContext);
+        EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+        bodySizes[index] = response->ExtractBodyStream()->ReadToEnd().size();
+      });
+    }
+    for (auto& sender : senders)
+    {
+      sender.join();
+    }
+    for (size_t index = 0; index < requestCount; index++)
+    {
+      EXPECT_EQ(bodySizes[index], 1000 + index);
+    }
+
+    // The requests are performed by the event loop, without connections from the pool.
+    std::shared_lock<std::shared_timed_mutex> lock(
+        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+    for (auto const& index : CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex)
+    {
+      EXPECT_EQ(index.first.find("127.0.0.1"), std::string::npos);
+    }
+  }
+
+  TEST(CurlSharedEventLoop, reuseConnection)
+  {
+    LocalHttpServer server;
+    auto transport = CreateSharedEventLoopTransport();
+
+    for (int count = 0; count < 3; count++)
+    {
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(server.Url("/size/10")));
+      auto response = transport->Send(request, Context::ApplicationContext);
+      EXPECT_EQ(response->ExtractBodyStream()->ReadToEnd().size(), 10);
+    }
+    EXPECT_EQ(server.AcceptedConnections(), 1);
+  }
+
+  TEST(CurlSharedEventLoop, uploadWithResponseBiggerThanBuffer)
+  {
+    LocalHttpServer server;
+    auto transport = CreateSharedEventLoopTransport();
+
+    // The response doesn't fit in the buffer of the transfer, so it is paused until it is read.
+    std::vector<uint8_t> requestBody(MaxMultiplexedResponseBufferSize * 2 + 1);
+    for (size_t index = 0; index < requestBody.size(); index++)
+    {
+      requestBody[index] = static_cast<uint8_t>(index);
+    }
+    Azure::Core::IO::MemoryBodyStream requestBodyStream(requestBody);
+    Azure::Core::Http::Request request(
+        Azure::Core::Http::HttpMethod::Put,
+        Azure::Core::Url(server.Url("/echo")),
+        &requestBodyStream);
+    auto response = transport->Send(request, Context::ApplicationContext);
+    EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+    EXPECT_EQ(response->ExtractBodyStream()->ReadToEnd(), requestBody);
+  }
+
+  TEST(CurlSharedEventLoop, cancelWhileWaitingForResponse)
+  {
+    LocalHttpServer server;
+    auto transport = CreateSharedEventLoopTransport();
+
+    Azure::Core::Http::Request request(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(server.Url("/hang")));
+    auto context = Context::ApplicationContext.WithDeadline(
+        std::chrono::system_clock::now() + std::chrono::milliseconds(100));
+    EXPECT_THROW(transport->Send(request, context), Azure::Core::OperationCancelledException);
+  }
+#endif // AZ_PLATFORM_POSIX
+#endif
+
+}}} // namespace Azure::Core::Test
@@ -22,6 +22,7 @@
 
 #include <http/curl/curl_connection_pool_private.hpp>
 #include <http/curl/curl_connection_private.hpp>
+#include <http/curl/curl_multiplexed_session_private.hpp>
 #include <http/curl/curl_session_private.hpp>
 
 namespace Azure { namespace Core { namespace Test {
@@ -94,7 +95,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .Clear());
   }
 
   class CurlDerived : public Azure::Core::Http::CurlTransport {
@@ -232,7 +233,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .Clear());
   }
 
   TEST(CurlTransportOptions, setCADirectory)
@@ -276,7 +277,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .Clear());
 #else
     EXPECT_THROW(
         pipeline.Send(request, Azure::Core::Context::ApplicationContext),
@@ -325,7 +326,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .Clear());
   }
 
   TEST(CurlTransportOptions, disableKeepAlive)
@@ -361,9 +362,46 @@ namespace Azure { namespace Core { namespace Test {
     }
     // Make sure there are no connections in the pool
     EXPECT_EQ(
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .size(),
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
         0);
   }
 
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  TEST(CurlTransportOptions, enableHttp2)
+  {
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    auto transport = std::make_shared<Azure::Core::Http::CurlTransport>(curlOptions);
+    // The option is ignored when the libcurl loaded at runtime can't multiplex HTTP/2 streams.
+    int32_t const expectedMajorVersion
+        = Azure::Core::Http::_detail::CurlMultiplexer::IsHttp2Supported() ? 2 : 1;
+
+    {
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(AzureSdkHttpbinServer::Get()));
+      auto response = transport->Send(request, Azure::Core::Context::ApplicationContext);
+      EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+      EXPECT_EQ(response->GetMajorVersion(), expectedMajorVersion);
+      auto body = response->ExtractBodyStream()->ReadToEnd(Azure::Core::Context::ApplicationContext);
+      EXPECT_FALSE(body.empty());
+    }
+    {
+      // The server echoes the request body, so the response is bigger than the buffer kept for a
+      // multiplexed stream and the stream is paused until the response is read.
+      std::vector<uint8_t> requestBody(
+          Azure::Core::Http::_detail::MaxMultiplexedResponseBufferSize * 2, 'x');
+      Azure::Core::IO::MemoryBodyStream requestBodyStream(requestBody);
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Put,
+          Azure::Core::Url(AzureSdkHttpbinServer::Put()),
+          &requestBodyStream);
+      auto response = transport->Send(request, Azure::Core::Context::ApplicationContext);
+      EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+      EXPECT_EQ(response->GetMajorVersion(), expectedMajorVersion);
+      auto body = response->ExtractBodyStream()->ReadToEnd(Azure::Core::Context::ApplicationContext);
+      EXPECT_GT(body.size(), requestBody.size());
+    }
+  }
+#endif
+
 }}} // namespace Azure::Core::Test
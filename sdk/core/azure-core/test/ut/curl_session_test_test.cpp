@@ -86,8 +86,7 @@ namespace Azure { namespace Core { namespace Test {
       EXPECT_NO_THROW(session->Perform(Azure::Core::Context::ApplicationContext));
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
   }
 
   TEST_F(CurlSession, chunkBadFormatResponse)
@@ -139,8 +138,7 @@ namespace Azure { namespace Core { namespace Test {
           Azure::Core::Http::TransportException);
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
   }
 
   TEST_F(CurlSession, invalidHeader)
@@ -319,14 +317,12 @@ namespace Azure { namespace Core { namespace Test {
       EXPECT_NO_THROW(bodyS->ReadToEnd(Azure::Core::Context::ApplicationContext));
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
   }
 
   TEST_F(CurlSession, DoNotReuseConnectionIfDownloadFail)
   {
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.Clear();
     // Can't mock the curlMock directly from a unique ptr, heap allocate it first and then make a
     // unique ptr for it
     MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
@@ -353,8 +349,7 @@ namespace Azure { namespace Core { namespace Test {
     }
     // Check connection pool is empty (connection was not moved to the pool)
     EXPECT_EQ(
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .size(),
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexCount(),
         0);
   }
 }}} // namespace Azure::Core::Test
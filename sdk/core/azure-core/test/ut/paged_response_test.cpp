@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/context.hpp>
+#include <azure/core/paged_response.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core;
+
+namespace {
+// A service returning pages 0 to PageCount - 1.
+struct PagedService final
+{
+  int PageCount = 10;
+  // The page that fails once when fetched, or -1.
+  std::atomic<int> FailingPage{-1};
+  // The page whose fetch waits until it is cancelled, or -1.
+  int BlockingPage = -1;
+  // Fetching a page after LastAllowedPage sets FetchedTooFarAhead.
+  std::atomic<int> LastAllowedPage{(std::numeric_limits<int>::max)()};
+  std::atomic<bool> FetchedTooFarAhead{false};
+  std::atomic<bool> BlockingFetchCancelled{false};
+
+  int Fetch(int page, Context const& context)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      ++m_requests;
+    }
+    m_requestReceived.notify_all();
+    if (page > LastAllowedPage)
+    {
+      FetchedTooFarAhead = true;
+    }
+    if (page == BlockingPage)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (!context.IsCancelled())
+      {
+        m_requestReceived.wait_for(lock, std::chrono::milliseconds(10));
+      }
+      BlockingFetchCancelled = true;
+      context.ThrowIfCancelled();
+    }
+    int failingPage = page;
+    if (FailingPage.compare_exchange_strong(failingPage, -1))
+    {
+      throw std::runtime_error("page " + std::to_string(page) + " failed");
+    }
+    return page;
+  }
+
+  int Requests()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_requests;
+  }
+
+  // Waits until the service has received count requests.
+  bool WaitForRequests(int count)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_requestReceived.wait_for(
+        lock, std::chrono::seconds(30), [this, count]() { return m_requests >= count; });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_requestReceived;
+  int m_requests = 0;
+};
+
+class TestPagedResponse final : public PagedResponse<TestPagedResponse> {
+public:
+  TestPagedResponse(
+      std::shared_ptr<PagedService> service,
+      int page,
+      const Context& context = Context())
+      : Page(service->Fetch(page, context)), m_service(std::move(service))
+  {
+    CurrentPageToken = std::to_string(page);
+    if (page + 1 < m_service->PageCount)
+    {
+      NextPageToken = std::to_string(page + 1);
+    }
+  }
+
+  int Page;
+
+private:
+  friend class PagedResponse<TestPagedResponse>;
+
+  void OnNextPage(const Context&) { *this = TestPagedResponse(m_service, Page + 1); }
+
+  std::function<std::unique_ptr<TestPagedResponse>(const Context&)> OnGetNextPageFetcher()
+      const override
+  {
+    auto service = m_service;
+    auto page = Page + 1;
+    return [service, page](const Context& context) {
+      return std::make_unique<TestPagedResponse>(service, page, context);
+    };
+  }
+
+  std::shared_ptr<PagedService> m_service;
+};
+
+// Doesn't support prefetching.
+class SimplePagedResponse final : public PagedResponse<SimplePagedResponse> {
+public:
+  explicit SimplePagedResponse(int page) : Page(page)
+  {
+    if (page < 2)
+    {
+      NextPageToken = std::to_string(page + 1);
+    }
+  }
+
+  int Page;
+
+private:
+  friend class PagedResponse<SimplePagedResponse>;
+
+  void OnNextPage(const Context&) { *this = SimplePagedResponse(Page + 1); }
+};
+} // namespace
+
+TEST(PagedResponse, Prefetch)
+{
+  auto service = std::make_shared<PagedService>();
+  TestPagedResponse pagedResponse(service, 0);
+  // Only two pages are fetched ahead of the current one.
+  service->LastAllowedPage = 2;
+  pagedResponse.Prefetch(2);
+  ASSERT_TRUE(service->WaitForRequests(3));
+
+  std::vector<int> pages;
+  for (; pagedResponse.HasPage(); pagedResponse.MoveToNextPage())
+  {
+    pages.push_back(pagedResponse.Page);
+    EXPECT_EQ(pagedResponse.CurrentPageToken, std::to_string(pagedResponse.Page));
+    service->LastAllowedPage = pagedResponse.Page + 3;
+  }
+  EXPECT_EQ(pages, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(service->Requests(), 10);
+  EXPECT_FALSE(service->FetchedTooFarAhead);
+}
+
+TEST(PagedResponse, PrefetchError)
+{
+  auto service = std::make_shared<PagedService>();
+  service->FailingPage = 3;
+  TestPagedResponse pagedResponse(service, 0);
+  pagedResponse.Prefetch(4);
+
+  // The page that failed in the background is fetched again.
+  std::vector<int> pages;
+  for (; pagedResponse.HasPage(); pagedResponse.MoveToNextPage())
+  {
+    pages.push_back(pagedResponse.Page);
+  }
+  EXPECT_EQ(pages, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  // The page that fails in the foreground is reported, and the current page is kept.
+  TestPagedResponse failingPagedResponse(service, 0);
+  failingPagedResponse.MoveToNextPage();
+  service->FailingPage = 2;
+  EXPECT_THROW(failingPagedResponse.MoveToNextPage(), std::runtime_error);
+  EXPECT_EQ(failingPagedResponse.Page, 1);
+  failingPagedResponse.MoveToNextPage();
+  EXPECT_EQ(failingPagedResponse.Page, 2);
+}
+
+TEST(PagedResponse, PrefetchStopsWithPagedResponse)
+{
+  auto service = std::make_shared<PagedService>();
+  service->BlockingPage = 2;
+  {
+    TestPagedResponse pagedResponse(service, 0);
+    pagedResponse.Prefetch(1);
+    pagedResponse.MoveToNextPage();
+    EXPECT_EQ(pagedResponse.Page, 1);
+    // Wait until page 2 is being fetched in the background.
+    ASSERT_TRUE(service->WaitForRequests(3));
+  }
+  // Destroying the paged response cancelled the request in progress and stopped prefetching.
+  EXPECT_TRUE(service->BlockingFetchCancelled);
+  EXPECT_EQ(service->Requests(), 3);
+}
+
+TEST(PagedResponse, PrefetchNotSupported)
+{
+  SimplePagedResponse pagedResponse(0);
+  pagedResponse.Prefetch(2);
+  std::vector<int> pages;
+  for (; pagedResponse.HasPage(); pagedResponse.MoveToNextPage())
+  {
+    pages.push_back(pagedResponse.Page);
+  }
+  EXPECT_EQ(pages, std::vector<int>({0, 1, 2}));
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Define the histogram used to track per-operation latency.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Azure { namespace Perf {
+  /**
+   * @brief A histogram of operation latencies with a bounded relative error.
+   *
+   * @details Values are recorded in nanoseconds into log-linear buckets, like an HDR histogram:
+   * every power of two is split into the same number of linear buckets, so the size of a bucket is
+   * proportional to the values it holds. Recording is constant time and the memory used doesn't
+   * depend on the number of recorded values. The values reported for a percentile are within 1% of
+   * the recorded ones.
+   *
+   */
+  class LatencyHistogram final {
+  public:
+    /**
+     * @brief Construct an empty histogram.
+     *
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Record the latency of one operation.
+     *
+     * @param latency The latency to record. Negative values are recorded as zero.
+     */
+    void Record(std::chrono::nanoseconds latency);
+
+    /**
+     * @brief Add the values recorded by another histogram to this one.
+     *
+     * @param other The histogram to add.
+     */
+    void Merge(LatencyHistogram const& other);
+
+    /**
+     * @brief The number of recorded values.
+     *
+     */
+    uint64_t Count() const { return m_count; }
+
+    /**
+     * @brief The smallest recorded value, or zero when the histogram is empty.
+     *
+     */
+    std::chrono::nanoseconds Min() const;
+
+    /**
+     * @brief The largest recorded value, or zero when the histogram is empty.
+     *
+     */
+    std::chrono::nanoseconds Max() const;
+
+    /**
+     * @brief The average of the recorded values, or zero when the histogram is empty.
+     *
+     */
+    std::chrono::nanoseconds Mean() const;
+
+    /**
+     * @brief The value that \p percentile percent of the recorded values are smaller than or equal
+     * to.
+     *
+     * @param percentile A percentile between 0 and 100, like 99.9.
+     * @return The value, or zero when the histogram is empty.
+     */
+    std::chrono::nanoseconds ValueAtPercentile(double percentile) const;
+
+  private:
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_min = 0;
+    uint64_t m_max = 0;
+    double m_sum = 0;
+  };
+}} // namespace Azure::Perf
@@ -89,6 +89,15 @@ namespace Azure { namespace Perf {
      */
     Azure::Nullable<int> Rate;
 
+    /**
+     * @brief Write the results of the test to this file, for automation.
+     *
+     * @details The results are written as CSV when the file name ends with `.csv`, and as JSON
+     * otherwise.
+     *
+     */
+    std::string ResultsFile;
+
     /**
      * @brief Duration of warmup in seconds.
      *
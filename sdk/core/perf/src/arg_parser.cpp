@@ -4,12 +4,31 @@
 #include "azure/perf/argagg.hpp"
 #include "azure/perf/program.hpp"
 
+#include <azure/core/internal/strings.hpp>
+
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 #define GET_ARG(Name, Is)
 
+namespace {
+// argagg converts booleans as integers, accept `true` and `false` too.
+inline bool ParseBoolean(argagg::option_results const& arg)
+{
+  auto const value = arg.as<std::string>();
+  if (Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(value, "true"))
+  {
+    return true;
+  }
+  if (Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(value, "false"))
+  {
+    return false;
+  }
+  return arg.as<bool>();
+}
+} // namespace
+
 argagg::parser_results Azure::Perf::Program::ArgParser::Parse(
     int argc,
     char** argv,
@@ -68,15 +87,15 @@ Azure::Perf::GlobalTestOptions Azure::Perf::Program::ArgParser::Parse(
   }
   if (parsedArgs["JobStatistics"])
   {
-    options.JobStatistics = parsedArgs["JobStatistics"].as<bool>();
+    options.JobStatistics = ParseBoolean(parsedArgs["JobStatistics"]);
   }
   if (parsedArgs["Latency"])
   {
-    options.Latency = parsedArgs["Latency"].as<bool>();
+    options.Latency = ParseBoolean(parsedArgs["Latency"]);
   }
   if (parsedArgs["NoCleanup"])
   {
-    options.NoCleanup = parsedArgs["NoCleanup"].as<bool>();
+    options.NoCleanup = ParseBoolean(parsedArgs["NoCleanup"]);
   }
   if (parsedArgs["Parallel"])
   {
@@ -89,6 +108,14 @@ Azure::Perf::GlobalTestOptions Azure::Perf::Program::ArgParser::Parse(
   if (parsedArgs["Rate"])
   {
     options.Rate = parsedArgs["Rate"];
+    if (options.Rate.Value() <= 0)
+    {
+      throw std::invalid_argument("Rate must be greater than zero.");
+    }
+  }
+  if (parsedArgs["ResultsFile"])
+  {
+    options.ResultsFile = parsedArgs["ResultsFile"].as<std::string>();
   }
   if (parsedArgs["Warmup"])
   {
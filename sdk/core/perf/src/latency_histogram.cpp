@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/perf/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Every power of two above 2 * SubBucketCount is split into SubBucketCount buckets, which bounds
+// the relative error to 1 / SubBucketCount. Smaller values get a bucket each.
+constexpr int SubBucketBits = 7;
+constexpr uint64_t SubBucketCount = uint64_t(1) << SubBucketBits;
+constexpr size_t BucketCount = SubBucketCount * (64 - SubBucketBits + 1);
+
+inline int HighestBit(uint64_t value)
+{
+  int bit = 0;
+  while (value >>= 1)
+  {
+    ++bit;
+  }
+  return bit;
+}
+
+inline size_t BucketIndex(uint64_t value)
+{
+  if (value < 2 * SubBucketCount)
+  {
+    return static_cast<size_t>(value);
+  }
+  int const shift = HighestBit(value) - SubBucketBits;
+  return static_cast<size_t>(
+      SubBucketCount * static_cast<uint64_t>(shift + 1) + (value >> shift) - SubBucketCount);
+}
+
+// The largest value that goes to the bucket.
+inline uint64_t BucketUpperBound(size_t index)
+{
+  if (index < 2 * SubBucketCount)
+  {
+    return index;
+  }
+  int const shift = static_cast<int>(index / SubBucketCount) - 1;
+  uint64_t const top = index % SubBucketCount + SubBucketCount;
+  return ((top + 1) << shift) - 1;
+}
+} // namespace
+
+Azure::Perf::LatencyHistogram::LatencyHistogram() : m_buckets(BucketCount) {}
+
+void Azure::Perf::LatencyHistogram::Record(std::chrono::nanoseconds latency)
+{
+  uint64_t const value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+  ++m_buckets[BucketIndex(value)];
+  m_min = m_count == 0 ? value : (std::min)(m_min, value);
+  m_max = (std::max)(m_max, value);
+  m_sum += static_cast<double>(value);
+  ++m_count;
+}
+
+void Azure::Perf::LatencyHistogram::Merge(LatencyHistogram const& other)
+{
+  if (other.m_count == 0)
+  {
+    return;
+  }
+  for (size_t index = 0; index != BucketCount; index++)
+  {
+    m_buckets[index] += other.m_buckets[index];
+  }
+  m_min = m_count == 0 ? other.m_min : (std::min)(m_min, other.m_min);
+  m_max = (std::max)(m_max, other.m_max);
+  m_sum += other.m_sum;
+  m_count += other.m_count;
+}
+
+std::chrono::nanoseconds Azure::Perf::LatencyHistogram::Min() const
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(m_min));
+}
+
+std::chrono::nanoseconds Azure::Perf::LatencyHistogram::Max() const
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(m_max));
+}
+
+std::chrono::nanoseconds Azure::Perf::LatencyHistogram::Mean() const
+{
+  if (m_count == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::nanoseconds(
+      static_cast<std::chrono::nanoseconds::rep>(m_sum / static_cast<double>(m_count)));
+}
+
+std::chrono::nanoseconds Azure::Perf::LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+  if (m_count == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+  percentile = (std::min)((std::max)(percentile, 0.0), 100.0);
+  // The rank of the value, counting from 1.
+  uint64_t const rank = (std::max)(
+      static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count))),
+      uint64_t(1));
+  uint64_t seen = 0;
+  for (size_t index = 0; index != BucketCount; index++)
+  {
+    seen += m_buckets[index];
+    if (seen >= rank)
+    {
+      uint64_t const value = (std::max)((std::min)(BucketUpperBound(index), m_max), m_min);
+      return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(value));
+    }
+  }
+  return Max();
+}
@@ -16,6 +16,7 @@ void Azure::Perf::to_json(Azure::Core::Json::_internal::json& j, const GlobalTes
       {"Latency", p.Latency},
       {"NoCleanup", p.NoCleanup},
       {"Parallel", p.Parallel},
+      {"ResultsFile", p.ResultsFile},
       {"Warmup", p.Warmup}};
   if (p.Port)
   {
@@ -56,6 +57,7 @@ std::vector<Azure::Perf::TestOption> Azure::Perf::GlobalTestOptions::GetOptionMe
     [Option('p', "parallel", Default = 1, HelpText = "Number of operations to execute in parallel")]
     [Option("port", HelpText = "Port to redirect HTTP requests")]
     [Option('r', "rate", HelpText = "Target throughput (ops/sec)")]
+    [Option("results-file", HelpText = "File to write the results to (.json or .csv)")]
     [Option("sync", HelpText = "Runs sync version of test")]  -- Not supported
     [Option('w', "warmup", Default = 5, HelpText = "Duration of warmup in seconds")]
     [Option('x', "proxy", Default = "", HelpText = "Proxy server")]
@@ -83,7 +85,16 @@ std::vector<Azure::Perf::TestOption> Azure::Perf::GlobalTestOptions::GetOptionMe
        "Number of operations to execute in parallel. Default to 1.",
        1},
       {"Port", {"--port"}, "Port to redirect HTTP requests. Default to no redirection.", 1},
-      {"Rate", {"-r", "--rate"}, "Target throughput (ops/sec). Default to no throughput.", 1},
+      {"Rate",
+       {"-r", "--rate"},
+       "Target throughput (ops/sec). Operations start on a fixed schedule and their latency is "
+       "measured from the time they were scheduled. Default to no throughput.",
+       1},
+      {"ResultsFile",
+       {"--results-file"},
+       "File to write the results to, as CSV when it ends with .csv and as JSON otherwise. No "
+       "file by default.",
+       1},
 
       {"Sync", {"-y", "--sync"}, "Runs sync version of test, not implemented", 0},
       {"TestProxies", {"-x", "--test-proxies"}, "URIs of TestProxy Servers (separated by ';')", 1},
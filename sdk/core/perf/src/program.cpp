@@ -4,15 +4,19 @@
 #include "azure/perf/program.hpp"
 
 #include "azure/perf/argagg.hpp"
+#include "azure/perf/latency_histogram.hpp"
 
 #include <azure/core/internal/diagnostics/global_exception.hpp>
 #include <azure/core/internal/json/json.hpp>
 #include <azure/core/internal/strings.hpp>
 #include <azure/core/platform.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <csignal>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <thread>
 
 namespace {
@@ -119,16 +123,39 @@ inline void RunLoop(
     Azure::Perf::PerfTest& test,
     uint64_t& completedOperations,
     std::chrono::nanoseconds& lastCompletionTimes,
-    bool latency,
-    bool& isCancelled)
+    Azure::Perf::LatencyHistogram* latency,
+    Azure::Nullable<std::chrono::nanoseconds> operationInterval,
+    std::atomic<bool> const& isCancelled)
 {
-  (void)latency;
-  auto start = std::chrono::system_clock::now();
+  auto start = std::chrono::steady_clock::now();
+  auto scheduledStart = start;
   while (!isCancelled)
   {
+    auto operationStart = scheduledStart;
+    if (operationInterval)
+    {
+      // Open loop: operations start on a fixed schedule no matter how long the previous ones took.
+      // An operation that starts late is measured from when it should have started, so a slow
+      // operation can't hide the latency of the ones queued behind it.
+      std::this_thread::sleep_until(scheduledStart);
+      if (isCancelled)
+      {
+        break;
+      }
+      scheduledStart += operationInterval.Value();
+    }
+    else
+    {
+      operationStart = std::chrono::steady_clock::now();
+    }
     test.Run(context);
+    auto const end = std::chrono::steady_clock::now();
     completedOperations += 1;
-    lastCompletionTimes = std::chrono::system_clock::now() - start;
+    lastCompletionTimes = end - start;
+    if (latency != nullptr)
+    {
+      latency->Record(end - operationStart);
+    }
   }
 }
 
@@ -188,21 +215,293 @@ inline std::vector<double> ZipAvg(
   return s;
 }
 
-inline void RunTests(
+struct TestRunResults final
+{
+  std::string Title;
+  std::vector<uint64_t> CompletedOperations;
+  std::vector<std::chrono::nanoseconds> LastCompletionTimes;
+  // One per parallel test. Empty when latency is not tracked.
+  std::vector<Azure::Perf::LatencyHistogram> Latencies;
+};
+
+struct ReportedPercentile final
+{
+  double Percentile;
+  char const* Name;
+};
+
+constexpr ReportedPercentile ReportedPercentiles[]
+    = {{50.0, "P50"}, {90.0, "P90"}, {99.0, "P99"}, {99.9, "P99.9"}};
+
+inline double ToMilliseconds(std::chrono::nanoseconds value)
+{
+  return std::chrono::duration<double, std::milli>(value).count();
+}
+
+inline double OperationsPerSecond(uint64_t operations, std::chrono::nanoseconds time)
+{
+  return time.count() > 0 ? operations / std::chrono::duration<double>(time).count() : 0.0;
+}
+
+inline Azure::Perf::LatencyHistogram MergeLatencies(
+    std::vector<Azure::Perf::LatencyHistogram> const& latencies)
+{
+  Azure::Perf::LatencyHistogram merged;
+  for (auto const& latency : latencies)
+  {
+    merged.Merge(latency);
+  }
+  return merged;
+}
+
+inline void PrintLatency(Azure::Perf::LatencyHistogram const& latency)
+{
+  std::cout << FormatNumber(latency.Count(), false) << "\t\t" << ToMilliseconds(latency.Min())
+            << "\t\t" << ToMilliseconds(latency.Mean());
+  for (auto const& percentile : ReportedPercentiles)
+  {
+    std::cout << "\t\t" << ToMilliseconds(latency.ValueAtPercentile(percentile.Percentile));
+  }
+  std::cout << "\t\t" << ToMilliseconds(latency.Max()) << std::endl;
+}
+
+inline void PrintLatencyHeader(std::string const& firstColumn)
+{
+  std::cout << firstColumn << "Count\t\tMin\t\tMean";
+  for (auto const& percentile : ReportedPercentiles)
+  {
+    std::cout << "\t\t" << percentile.Name;
+  }
+  std::cout << "\t\tMax" << std::endl;
+}
+
+inline void PrintResults(TestRunResults const& results, bool jobStatistics)
+{
+  std::cout << std::endl << "=== Results ===";
+
+  auto totalOperations = Sum(results.CompletedOperations);
+  auto operationsPerSecond
+      = Sum(ZipAvg(results.CompletedOperations, results.LastCompletionTimes));
+  auto secondsPerOperation = 1 / operationsPerSecond;
+  auto weightedAverageSeconds = totalOperations / operationsPerSecond;
+
+  std::cout << std::endl
+            << "Completed " << FormatNumber(totalOperations, false)
+            << " operations in a weighted-average of "
+            << FormatNumber(weightedAverageSeconds, false) << "s ("
+            << FormatNumber(operationsPerSecond) << " ops/s, " << secondsPerOperation << " s/op)"
+            << std::endl
+            << std::endl;
+
+  if (!results.Latencies.empty())
+  {
+    std::cout << "=== Latency (ms) ===" << std::endl;
+    PrintLatencyHeader("");
+    PrintLatency(MergeLatencies(results.Latencies));
+    std::cout << std::endl;
+  }
+
+  if (jobStatistics)
+  {
+    std::cout << "=== Job Statistics ===" << std::endl
+              << "Job\t\tOperations\t\tSeconds\t\tOps/s" << std::endl;
+    for (size_t index = 0; index != results.CompletedOperations.size(); index++)
+    {
+      std::cout << index << "\t\t" << FormatNumber(results.CompletedOperations[index], false)
+                << "\t\t"
+                << std::chrono::duration<double>(results.LastCompletionTimes[index]).count()
+                << "\t\t"
+                << FormatNumber(OperationsPerSecond(
+                       results.CompletedOperations[index], results.LastCompletionTimes[index]))
+                << std::endl;
+    }
+    std::cout << std::endl;
+    if (!results.Latencies.empty())
+    {
+      std::cout << "=== Job Latency (ms) ===" << std::endl;
+      PrintLatencyHeader("Job\t\t");
+      for (size_t index = 0; index != results.Latencies.size(); index++)
+      {
+        std::cout << index << "\t\t";
+        PrintLatency(results.Latencies[index]);
+      }
+      std::cout << std::endl;
+    }
+  }
+}
+
+inline Azure::Core::Json::_internal::json LatencyToJson(
+    Azure::Perf::LatencyHistogram const& latency)
+{
+  Azure::Core::Json::_internal::json j{
+      {"Count", latency.Count()},
+      {"MinMs", ToMilliseconds(latency.Min())},
+      {"MeanMs", ToMilliseconds(latency.Mean())},
+      {"MaxMs", ToMilliseconds(latency.Max())}};
+  for (auto const& percentile : ReportedPercentiles)
+  {
+    j[std::string(percentile.Name) + "Ms"]
+        = ToMilliseconds(latency.ValueAtPercentile(percentile.Percentile));
+  }
+  return j;
+}
+
+inline void WriteJsonResults(
+    std::ostream& output,
+    std::string const& testName,
+    Azure::Perf::GlobalTestOptions const& options,
+    std::vector<TestRunResults> const& allResults)
+{
+  Azure::Core::Json::_internal::json runs = Azure::Core::Json::_internal::json::array();
+  for (auto const& results : allResults)
+  {
+    Azure::Core::Json::_internal::json run{
+        {"Title", results.Title},
+        {"Operations", Sum(results.CompletedOperations)},
+        {"OperationsPerSecond",
+         Sum(ZipAvg(results.CompletedOperations, results.LastCompletionTimes))}};
+    if (!results.Latencies.empty())
+    {
+      run["Latency"] = LatencyToJson(MergeLatencies(results.Latencies));
+    }
+    Azure::Core::Json::_internal::json jobs = Azure::Core::Json::_internal::json::array();
+    for (size_t index = 0; index != results.CompletedOperations.size(); index++)
+    {
+      Azure::Core::Json::_internal::json job{
+          {"Operations", results.CompletedOperations[index]},
+          {"Seconds", std::chrono::duration<double>(results.LastCompletionTimes[index]).count()},
+          {"OperationsPerSecond",
+           OperationsPerSecond(
+               results.CompletedOperations[index], results.LastCompletionTimes[index])}};
+      if (!results.Latencies.empty())
+      {
+        job["Latency"] = LatencyToJson(results.Latencies[index]);
+      }
+      jobs.push_back(job);
+    }
+    run["Jobs"] = jobs;
+    runs.push_back(run);
+  }
+
+  Azure::Core::Json::_internal::json j{{"Test", testName}, {"Options", options}, {"Runs", runs}};
+  output << j.dump(2) << std::endl;
+}
+
+inline void WriteCsvLatency(std::ostream& output, Azure::Perf::LatencyHistogram const* latency)
+{
+  if (latency == nullptr)
+  {
+    // Count, Min, Mean, the percentiles and Max.
+    for (size_t index = 0; index != 4 + sizeof(ReportedPercentiles) / sizeof(*ReportedPercentiles);
+         index++)
+    {
+      output << ",";
+    }
+    return;
+  }
+  output << "," << latency->Count() << "," << ToMilliseconds(latency->Min()) << ","
+         << ToMilliseconds(latency->Mean());
+  for (auto const& percentile : ReportedPercentiles)
+  {
+    output << "," << ToMilliseconds(latency->ValueAtPercentile(percentile.Percentile));
+  }
+  output << "," << ToMilliseconds(latency->Max());
+}
+
+inline void WriteCsvResults(std::ostream& output, std::vector<TestRunResults> const& allResults)
+{
+  // One row for every job of every run, and one row with the totals of the run.
+  output << "Run,Job,Operations,Seconds,OperationsPerSecond,Count,MinMs,MeanMs";
+  for (auto const& percentile : ReportedPercentiles)
+  {
+    output << "," << percentile.Name << "Ms";
+  }
+  output << ",MaxMs" << std::endl;
+
+  for (auto const& results : allResults)
+  {
+    for (size_t index = 0; index != results.CompletedOperations.size(); index++)
+    {
+      output << results.Title << "," << index << "," << results.CompletedOperations[index] << ","
+             << std::chrono::duration<double>(results.LastCompletionTimes[index]).count() << ","
+             << OperationsPerSecond(
+                    results.CompletedOperations[index], results.LastCompletionTimes[index]);
+      WriteCsvLatency(output, results.Latencies.empty() ? nullptr : &results.Latencies[index]);
+      output << std::endl;
+    }
+
+    auto totalOperations = Sum(results.CompletedOperations);
+    auto operationsPerSecond
+        = Sum(ZipAvg(results.CompletedOperations, results.LastCompletionTimes));
+    output << results.Title << ",All," << totalOperations << ","
+           << totalOperations / operationsPerSecond << "," << operationsPerSecond;
+    if (results.Latencies.empty())
+    {
+      WriteCsvLatency(output, nullptr);
+    }
+    else
+    {
+      auto const latency = MergeLatencies(results.Latencies);
+      WriteCsvLatency(output, &latency);
+    }
+    output << std::endl;
+  }
+}
+
+inline void WriteResults(
+    std::string const& testName,
+    Azure::Perf::GlobalTestOptions const& options,
+    std::vector<TestRunResults> const& allResults)
+{
+  std::ofstream output(options.ResultsFile);
+  if (!output)
+  {
+    throw std::runtime_error("Failed to open the results file: " + options.ResultsFile);
+  }
+  auto const& fileName = options.ResultsFile;
+  if (fileName.size() >= 4
+      && Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(
+          fileName.substr(fileName.size() - 4), ".csv"))
+  {
+    WriteCsvResults(output, allResults);
+  }
+  else
+  {
+    WriteJsonResults(output, testName, options, allResults);
+  }
+  std::cout << std::endl << "Results written to " << fileName << std::endl;
+}
+
+inline TestRunResults RunTests(
     Azure::Core::Context const& context,
     std::vector<std::unique_ptr<Azure::Perf::PerfTest>> const& tests,
     Azure::Perf::GlobalTestOptions const& options,
     std::string const& title,
     bool warmup = false)
 {
-  (void)title;
   auto parallelTestsCount = options.Parallel;
   auto durationInSeconds = warmup ? options.Warmup : options.Duration;
-  // auto jobStatistics = warmup ? false : options.JobStatistics;
-  // auto latency = warmup ? false : options.Latency;
+  auto jobStatistics = warmup ? false : options.JobStatistics;
+  auto latency = warmup ? false : options.Latency;
+
+  TestRunResults results;
+  results.Title = title;
+  results.CompletedOperations.resize(parallelTestsCount);
+  results.LastCompletionTimes.resize(parallelTestsCount);
+  if (latency)
+  {
+    results.Latencies.resize(parallelTestsCount);
+  }
+  auto& completedOperations = results.CompletedOperations;
+  auto& lastCompletionTimes = results.LastCompletionTimes;
 
-  std::vector<uint64_t> completedOperations(parallelTestsCount);
-  std::vector<std::chrono::nanoseconds> lastCompletionTimes(parallelTestsCount);
+  // The target rate is shared by the parallel tests.
+  Azure::Nullable<std::chrono::nanoseconds> operationInterval;
+  if (options.Rate)
+  {
+    operationInterval = std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(
+        1e9 * parallelTestsCount / options.Rate.Value()));
+  }
 
   /********************* Progress Reporter ******************************/
   Azure::Core::Context progressToken;
@@ -229,25 +528,30 @@ inline void RunTests(
   auto deadLineSeconds = std::chrono::seconds(durationInSeconds);
   for (size_t index = 0; index != tests.size(); index++)
   {
-    tasks[index] = std::thread(
-        [index, &tests, &completedOperations, &lastCompletionTimes, &deadLineSeconds, &context]() {
-          bool isCancelled = false;
-          // Azure::Context is not good performer for checking cancellation inside the test loop
-          auto manualCancellation = std::thread([&deadLineSeconds, &isCancelled] {
-            std::this_thread::sleep_for(deadLineSeconds);
-            isCancelled = true;
-          });
-
-          RunLoop(
-              context,
-              *tests[index],
-              completedOperations[index],
-              lastCompletionTimes[index],
-              false,
-              isCancelled);
-
-          manualCancellation.join();
-        });
+    tasks[index] = std::thread([index,
+                                &tests,
+                                &results,
+                                &operationInterval,
+                                &deadLineSeconds,
+                                &context]() {
+      std::atomic<bool> isCancelled{false};
+      // Azure::Context is not good performer for checking cancellation inside the test loop
+      auto manualCancellation = std::thread([&deadLineSeconds, &isCancelled] {
+        std::this_thread::sleep_for(deadLineSeconds);
+        isCancelled = true;
+      });
+
+      RunLoop(
+          context,
+          *tests[index],
+          results.CompletedOperations[index],
+          results.LastCompletionTimes[index],
+          results.Latencies.empty() ? nullptr : &results.Latencies[index],
+          operationInterval,
+          isCancelled);
+
+      manualCancellation.join();
+    });
   }
   // Wait for all tests to complete setUp
   for (auto& t : tasks)
@@ -259,20 +563,8 @@ inline void RunTests(
   progressToken.Cancel();
   progressThread.join();
 
-  std::cout << std::endl << "=== Results ===";
-
-  auto totalOperations = Sum(completedOperations);
-  auto operationsPerSecond = Sum(ZipAvg(completedOperations, lastCompletionTimes));
-  auto secondsPerOperation = 1 / operationsPerSecond;
-  auto weightedAverageSeconds = totalOperations / operationsPerSecond;
-
-  std::cout << std::endl
-            << "Completed " << FormatNumber(totalOperations, false)
-            << " operations in a weighted-average of "
-            << FormatNumber(weightedAverageSeconds, false) << "s ("
-            << FormatNumber(operationsPerSecond) << " ops/s, " << secondsPerOperation << " s/op)"
-            << std::endl
-            << std::endl;
+  PrintResults(results, jobStatistics);
+  return results;
 }
 
 } // namespace
@@ -296,7 +588,6 @@ void Azure::Perf::Program::Run(
 
   // Parse args only to get the test name first
   auto testMetadata = GetTestMetadata(tests, argc, argv);
-  auto const& testGenerator = testMetadata->Factory;
   if (testMetadata == nullptr)
   {
     // Wrong input. Print what are the options.
@@ -304,6 +595,7 @@ void Azure::Perf::Program::Run(
 
     return;
   }
+  auto const& testGenerator = testMetadata->Factory;
 
   // Initial test to get it's options, we can use a dummy parser results
   argagg::parser_results argResults;
@@ -393,13 +685,18 @@ void Azure::Perf::Program::Run(
 
   /******************** Tests ******************************/
   std::string iterationInfo;
+  std::vector<TestRunResults> allResults;
   for (int iteration = 0; iteration < options.Iterations; iteration++)
   {
     if (iteration > 0)
     {
       iterationInfo.append(FormatNumber(iteration));
     }
-    RunTests(context, parallelTest, options, "Test" + iterationInfo);
+    allResults.push_back(RunTests(context, parallelTest, options, "Test" + iterationInfo));
+  }
+  if (!options.ResultsFile.empty())
+  {
+    WriteResults(testMetadata->Name, options, allResults);
   }
 
   std::cout << std::endl << "=== Pre-Cleanup ===" << std::endl;
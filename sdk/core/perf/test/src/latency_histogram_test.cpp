@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/perf/latency_histogram.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(latency_histogram, empty)
+{
+  Azure::Perf::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0U);
+  EXPECT_EQ(histogram.Min(), 0ns);
+  EXPECT_EQ(histogram.Max(), 0ns);
+  EXPECT_EQ(histogram.Mean(), 0ns);
+  EXPECT_EQ(histogram.ValueAtPercentile(99.0), 0ns);
+}
+
+TEST(latency_histogram, percentiles)
+{
+  // 1ms to 10s, 1ms apart.
+  Azure::Perf::LatencyHistogram histogram;
+  for (int64_t value = 1; value <= 10000; value++)
+  {
+    histogram.Record(std::chrono::milliseconds(value));
+  }
+  EXPECT_EQ(histogram.Count(), 10000U);
+  EXPECT_EQ(histogram.Min(), 1ms);
+  EXPECT_EQ(histogram.Max(), 10s);
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  EXPECT_NEAR(Milliseconds(histogram.Mean()).count(), 5000.5, 0.01);
+
+  auto const expectNear = [&histogram](double percentile, std::chrono::nanoseconds expected) {
+    auto const value = histogram.ValueAtPercentile(percentile);
+    EXPECT_GE(value, expected);
+    EXPECT_LE(value.count(), expected.count() + expected.count() / 100);
+  };
+  expectNear(50.0, 5000ms);
+  expectNear(90.0, 9000ms);
+  expectNear(99.0, 9900ms);
+  expectNear(99.9, 9990ms);
+  EXPECT_EQ(histogram.ValueAtPercentile(100.0), 10s);
+  expectNear(0.0, 1ms);
+}
+
+TEST(latency_histogram, small_values_are_exact)
+{
+  Azure::Perf::LatencyHistogram histogram;
+  for (int64_t value = 0; value < 256; value++)
+  {
+    histogram.Record(std::chrono::nanoseconds(value));
+  }
+  histogram.Record(std::chrono::nanoseconds(-5));
+  EXPECT_EQ(histogram.Min(), 0ns);
+  EXPECT_EQ(histogram.ValueAtPercentile(50.0), 127ns);
+  EXPECT_EQ(histogram.ValueAtPercentile(100.0), 255ns);
+}
+
+TEST(latency_histogram, merge)
+{
+  Azure::Perf::LatencyHistogram first;
+  Azure::Perf::LatencyHistogram second;
+  for (int i = 0; i < 99; i++)
+  {
+    first.Record(1ms);
+  }
+  second.Record(1s);
+  first.Merge(second);
+  first.Merge(Azure::Perf::LatencyHistogram());
+  EXPECT_EQ(first.Count(), 100U);
+  EXPECT_EQ(first.Min(), 1ms);
+  EXPECT_EQ(first.Max(), 1s);
+  EXPECT_LE(first.ValueAtPercentile(99.0), 1010us);
+  EXPECT_EQ(first.ValueAtPercentile(99.9), 1s);
+}
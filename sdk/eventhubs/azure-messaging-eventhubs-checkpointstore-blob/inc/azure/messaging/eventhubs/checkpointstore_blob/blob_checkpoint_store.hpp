@@ -10,17 +10,40 @@
 #include <azure/storage/blobs/blob_container_client.hpp>
 #include <azure/storage/blobs/block_blob_client.hpp>
 
+#include <chrono>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
 namespace Azure { namespace Messaging { namespace EventHubs {
+  namespace _detail {
+    class CheckpointFlusher;
+  } // namespace _detail
+
+  /** @brief Contains options for the BlobCheckpointStore creation.
+   */
+  struct BlobCheckpointStoreOptions final
+  {
+    /** @brief How often checkpoints are written to storage.
+     *
+     * When zero, the default, UpdateCheckpoint writes the checkpoint before returning. Otherwise
+     * UpdateCheckpoint only records the checkpoint, and the latest checkpoint of each partition is
+     * written in the background at this interval. Pending checkpoints are also written when
+     * FlushCheckpoints is called, and when the last copy of the store is destroyed. When a claim
+     * of a partition fails, its pending checkpoint is dropped so that it doesn't overwrite the
+     * checkpoints of the new owner, and its checkpoints are ignored until it is claimed again.
+     */
+    Azure::DateTime::duration CheckpointFlushInterval{};
+  };
 
   /** @brief BlobCheckpointStore is an implementation of a CheckpointStore backed by Azure Blob
    * Storage.
    */
   class BlobCheckpointStore final : public Azure::Messaging::EventHubs::CheckpointStore {
     Azure::Storage::Blobs::BlobContainerClient m_containerClient;
+    // Shared by the copies of the store, so they coalesce and flush the same checkpoints.
+    std::shared_ptr<_detail::CheckpointFlusher> m_checkpointFlusher;
 
     void UpdateCheckpointImpl(
         Azure::Storage::Metadata const& metadata,
@@ -50,12 +73,11 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     /**@brief  Construct a BlobCheckpointStore.
      *
      * @param containerClient An Azure Blob ContainerClient used to hold the checkpoints.
+     * @param options Optional configuration for the checkpoint store.
      */
-    BlobCheckpointStore(Azure::Storage::Blobs::BlobContainerClient const& containerClient)
-        : Azure::Messaging::EventHubs::CheckpointStore(), m_containerClient(containerClient)
-    {
-      m_containerClient.CreateIfNotExists();
-    }
+    BlobCheckpointStore(
+        Azure::Storage::Blobs::BlobContainerClient const& containerClient,
+        BlobCheckpointStoreOptions const& options = {});
 
     /**@brief  ClaimOwnership Claims ownership for a particular partition.
      *
@@ -68,6 +90,8 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
     /**@brief  List the checkpoints from storage.
      *
+     * @remark Checkpoints recorded by this store which have not been written yet take the place
+     * of the ones in storage.
      * @param fullyQualifiedNamespace - The fully qualified Event Hubs namespace.
      * @param eventHubName - The name of the specific Event Hub.
      * @param consumerGroup - The name of the specific consumer group.
@@ -97,8 +121,30 @@ namespace Azure { namespace Messaging { namespace EventHubs {
         Core::Context const& context = {}) override;
 
     /**@brief  UpdateCheckpoint updates a specific checkpoint with a sequence and offset.
+     *
+     * @remark If BlobCheckpointStoreOptions::CheckpointFlushInterval is set, the checkpoint is
+     * written later, replacing any checkpoint of the same partition which is still pending.
      */
     void UpdateCheckpoint(Models::Checkpoint const& checkpoint, Core::Context const& context = {})
         override;
+
+    /**@brief  Writes the pending checkpoints to storage.
+     *
+     * @param context - The context for cancelling long running operations.
+     *
+     * @remark The checkpoints which could not be written remain pending, and the first error is
+     * thrown once every checkpoint has been attempted.
+     */
+    void FlushCheckpoints(Core::Context const& context = {});
+
+    /**@brief  Gets the last checkpoint this store wrote to storage for a partition.
+     *
+     * @param checkpoint - Identifies the partition; its offset and sequence number are ignored.
+     *
+     * @return The last checkpoint written for the partition, or a null value if this store has not
+     * written one.
+     */
+    Azure::Nullable<Models::Checkpoint> GetDurableCheckpoint(
+        Models::Checkpoint const& checkpoint) const;
   };
 }}} // namespace Azure::Messaging::EventHubs
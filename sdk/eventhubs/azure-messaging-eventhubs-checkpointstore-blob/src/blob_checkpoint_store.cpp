@@ -3,6 +3,7 @@
 #include "azure/messaging/eventhubs/checkpointstore_blob/blob_checkpoint_store.hpp"
 
 #include "azure/messaging/eventhubs/checkpoint_store.hpp"
+#include "private/checkpoint_flusher.hpp"
 
 #include <azure/core/internal/diagnostics/log.hpp>
 
@@ -12,6 +13,35 @@
 
 using namespace Azure::Messaging::EventHubs::Models;
 
+namespace {
+std::string GetCheckpointBlobName(Ownership const& ownership)
+{
+  return Checkpoint{
+      ownership.ConsumerGroup,
+      ownership.EventHubName,
+      ownership.FullyQualifiedNamespace,
+      ownership.PartitionId}
+      .GetCheckpointBlobName();
+}
+} // namespace
+
+Azure::Messaging::EventHubs::BlobCheckpointStore::BlobCheckpointStore(
+    Azure::Storage::Blobs::BlobContainerClient const& containerClient,
+    BlobCheckpointStoreOptions const& options)
+    : Azure::Messaging::EventHubs::CheckpointStore(), m_containerClient(containerClient)
+{
+  m_containerClient.CreateIfNotExists();
+
+  // The checkpoints are written through a copy of this store without a flusher, which writes them
+  // right away.
+  BlobCheckpointStore writer{*this};
+  m_checkpointFlusher = std::make_shared<_detail::CheckpointFlusher>(
+      [writer](Checkpoint const& checkpoint, Core::Context const& context) mutable {
+        writer.UpdateCheckpoint(checkpoint, context);
+      },
+      options.CheckpointFlushInterval);
+}
+
 void Azure::Messaging::EventHubs::BlobCheckpointStore::UpdateCheckpointImpl(
     Azure::Storage::Metadata const& metadata,
     Checkpoint& checkpoint)
@@ -86,6 +116,10 @@ std::vector<Ownership> Azure::Messaging::EventHubs::BlobCheckpointStore::ClaimOw
         newOwnership.ETag = result.second;
         newOwnership.LastModifiedTime = result.first;
         newOwnerships.emplace_back(newOwnership);
+        if (m_checkpointFlusher)
+        {
+          m_checkpointFlusher->PartitionClaimed(GetCheckpointBlobName(ownership));
+        }
       }
     }
     catch (...)
@@ -93,6 +127,10 @@ std::vector<Ownership> Azure::Messaging::EventHubs::BlobCheckpointStore::ClaimOw
       // we can fail to claim ownership and that's okay - it's expected that clients will
       // attempt to claim with whatever state they hold locally. If they fail it just means
       // someone else claimed ownership before them.
+      if (m_checkpointFlusher)
+      {
+        m_checkpointFlusher->PartitionLost(GetCheckpointBlobName(ownership));
+      }
       continue;
     }
   }
@@ -124,6 +162,11 @@ std::vector<Checkpoint> Azure::Messaging::EventHubs::BlobCheckpointStore::ListCh
     }
   }
 
+  if (m_checkpointFlusher)
+  {
+    m_checkpointFlusher->MergePendingCheckpoints(checkpoints, prefix);
+  }
+
   return checkpoints;
 }
 
@@ -163,10 +206,27 @@ void Azure::Messaging::EventHubs::BlobCheckpointStore::UpdateCheckpoint(
     Checkpoint const& checkpoint,
     Core::Context const& context)
 {
+  if (m_checkpointFlusher)
+  {
+    m_checkpointFlusher->Update(checkpoint, context);
+    return;
+  }
   std::string blobName = checkpoint.GetCheckpointBlobName();
   SetMetadata(blobName, CreateCheckpointBlobMetadata(checkpoint), Azure::ETag(), context);
 }
 
+void Azure::Messaging::EventHubs::BlobCheckpointStore::FlushCheckpoints(
+    Core::Context const& context)
+{
+  m_checkpointFlusher->Flush(context);
+}
+
+Azure::Nullable<Checkpoint> Azure::Messaging::EventHubs::BlobCheckpointStore::GetDurableCheckpoint(
+    Checkpoint const& checkpoint) const
+{
+  return m_checkpointFlusher->GetDurableCheckpoint(checkpoint.GetCheckpointBlobName());
+}
+
 std::pair<Azure::DateTime, Azure::ETag>
 Azure::Messaging::EventHubs::BlobCheckpointStore::SetMetadata(
     std::string const& blobName,
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+#include <azure/core/context.hpp>
+#include <azure/core/datetime.hpp>
+#include <azure/core/internal/diagnostics/log.hpp>
+#include <azure/core/nullable.hpp>
+#include <azure/messaging/eventhubs/models/checkpoint_store_models.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
+
+  // Holds the latest checkpoint of each partition until it is written to storage.
+  class CheckpointFlusher final {
+  public:
+    using CheckpointWriter
+        = std::function<void(Models::Checkpoint const&, Core::Context const&)>;
+
+    CheckpointFlusher(CheckpointWriter writer, Azure::DateTime::duration flushInterval)
+        : m_writer{std::move(writer)}, m_flushInterval{flushInterval}
+    {
+      if (m_flushInterval > Azure::DateTime::duration::zero())
+      {
+        m_thread = std::thread([this]() { Run(); });
+      }
+    }
+
+    ~CheckpointFlusher()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+        m_changed.notify_all();
+      }
+      if (m_thread.joinable())
+      {
+        m_thread.join();
+      }
+      FlushBestEffort();
+    }
+
+    CheckpointFlusher(CheckpointFlusher const&) = delete;
+    CheckpointFlusher& operator=(CheckpointFlusher const&) = delete;
+
+    void Update(Models::Checkpoint const& checkpoint, Core::Context const& context)
+    {
+      if (m_flushInterval == Azure::DateTime::duration::zero())
+      {
+        // Nothing is pending, so the checkpoint doesn't need to wait for other flushes.
+        Write(checkpoint, context);
+        return;
+      }
+      std::lock_guard<std::mutex> lock(m_lock);
+      auto const blobName = checkpoint.GetCheckpointBlobName();
+      if (m_lost.find(blobName) != m_lost.end())
+      {
+        Azure::Core::Diagnostics::_internal::Log::Stream(
+            Azure::Core::Diagnostics::Logger::Level::Verbose)
+            << "Ignoring checkpoint " << blobName
+            << ", its partition is owned by another client.";
+        return;
+      }
+      m_pending[blobName] = checkpoint;
+    }
+
+    // Write the pending checkpoints.
+    void Flush(Core::Context const& context)
+    {
+      // Flushes are serialized, so an older checkpoint is never written after a newer one.
+      std::lock_guard<std::mutex> writeLock(m_writeLock);
+      std::map<std::string, Models::Checkpoint> pending;
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        pending.swap(m_pending);
+      }
+
+      std::exception_ptr firstError;
+      for (auto const& checkpoint : pending)
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_lock);
+          if (m_lost.find(checkpoint.first) != m_lost.end())
+          {
+            continue;
+          }
+        }
+        try
+        {
+          Write(checkpoint.second, context);
+        }
+        catch (std::exception const& ex)
+        {
+          Azure::Core::Diagnostics::_internal::Log::Stream(
+              Azure::Core::Diagnostics::Logger::Level::Warning)
+              << "Failed to write checkpoint " << checkpoint.first << ": " << ex.what();
+          if (!firstError)
+          {
+            firstError = std::current_exception();
+          }
+          // Keep the checkpoint for the next flush, unless a newer one was recorded meanwhile or
+          // the partition was lost.
+          std::lock_guard<std::mutex> lock(m_lock);
+          if (m_lost.find(checkpoint.first) == m_lost.end())
+          {
+            m_pending.emplace(checkpoint);
+          }
+        }
+      }
+      if (firstError)
+      {
+        std::rethrow_exception(firstError);
+      }
+    }
+
+    void FlushBestEffort()
+    {
+      try
+      {
+        Flush({});
+      }
+      catch (std::exception const&)
+      {
+        // The failure was logged, and the checkpoints are still pending.
+      }
+    }
+
+    // Called when another client owns the partition of blobName. Its pending checkpoint is
+    // dropped, as writing it could overwrite a newer checkpoint of the new owner, and its
+    // checkpoints are ignored until the partition is claimed again.
+    void PartitionLost(std::string const& blobName)
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_pending.erase(blobName);
+      m_lost.insert(blobName);
+    }
+
+    void PartitionClaimed(std::string const& blobName)
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_lost.erase(blobName);
+    }
+
+    // Replace the checkpoints listed from storage with the pending checkpoints of the same
+    // consumer group, and add the pending checkpoints of the partitions which weren't listed.
+    void MergePendingCheckpoints(
+        std::vector<Models::Checkpoint>& checkpoints,
+        std::string const& prefix)
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      for (auto const& pending : m_pending)
+      {
+        if (pending.second.GetCheckpointBlobPrefixName() != prefix)
+        {
+          continue;
+        }
+        auto checkpoint = std::find_if(
+            checkpoints.begin(), checkpoints.end(), [&pending](Models::Checkpoint const& listed) {
+              return listed.PartitionId == pending.second.PartitionId;
+            });
+        if (checkpoint == checkpoints.end())
+        {
+          checkpoints.push_back(pending.second);
+        }
+        else
+        {
+          *checkpoint = pending.second;
+        }
+      }
+    }
+
+    Azure::Nullable<Models::Checkpoint> GetDurableCheckpoint(std::string const& blobName)
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      auto checkpoint = m_durable.find(blobName);
+      if (checkpoint == m_durable.end())
+      {
+        return {};
+      }
+      return checkpoint->second;
+    }
+
+  private:
+    CheckpointWriter m_writer;
+    Azure::DateTime::duration m_flushInterval;
+
+    // Held while flushing the pending checkpoints.
+    std::mutex m_writeLock;
+
+    // Protects everything below up to m_thread.
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    bool m_stopping{false};
+    // The checkpoints waiting to be written and the last ones written, by blob name.
+    std::map<std::string, Models::Checkpoint> m_pending;
+    std::map<std::string, Models::Checkpoint> m_durable;
+    // The blob names of the checkpoints of the partitions owned by another client.
+    std::set<std::string> m_lost;
+
+    std::thread m_thread;
+
+    void Write(Models::Checkpoint const& checkpoint, Core::Context const& context)
+    {
+      m_writer(checkpoint, context);
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_durable[checkpoint.GetCheckpointBlobName()] = checkpoint;
+    }
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      while (!m_stopping)
+      {
+        m_changed.wait_for(lock, m_flushInterval);
+        if (m_stopping)
+        {
+          break;
+        }
+        lock.unlock();
+        FlushBestEffort();
+        lock.lock();
+      }
+    }
+  };
+}}}} // namespace Azure::Messaging::EventHubs::_detail
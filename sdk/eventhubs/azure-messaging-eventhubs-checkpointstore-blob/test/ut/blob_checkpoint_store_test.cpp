@@ -183,6 +183,92 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
     EXPECT_EQ("owner-id", ownerships[0].OwnerId);
   }
 
+  TEST_P(BlobCheckpointStoreTest, CoalescedCheckpoints_LIVEONLY_)
+  {
+    std::string const testName = GetRandomName();
+    std::string consumerGroup = GetEnv("EVENTHUB_CONSUMER_GROUP");
+
+    auto containerClient{CreateBlobContainerClient(testName)};
+    // Reads the checkpoints which were written to storage.
+    Azure::Messaging::EventHubs::BlobCheckpointStore storageReader{containerClient};
+
+    auto const makeCheckpoint = [&consumerGroup](int64_t offset, int64_t sequenceNumber) {
+      return Azure::Messaging::EventHubs::Models::Checkpoint{
+          consumerGroup,
+          "event-hub-name",
+          "ns.servicebus.windows.net",
+          "partition-id",
+          offset,
+          sequenceNumber,
+      };
+    };
+
+    {
+      Azure::Messaging::EventHubs::BlobCheckpointStoreOptions options;
+      options.CheckpointFlushInterval = std::chrono::hours(1);
+      Azure::Messaging::EventHubs::BlobCheckpointStore checkpointStore{containerClient, options};
+
+      checkpointStore.UpdateCheckpoint(makeCheckpoint(101, 202));
+      checkpointStore.UpdateCheckpoint(makeCheckpoint(102, 203));
+
+      // Nothing has been written yet, but the store lists its own pending checkpoint.
+      EXPECT_EQ(
+          0ul,
+          storageReader
+              .ListCheckpoints("ns.servicebus.windows.net", "event-hub-name", consumerGroup)
+              .size());
+      EXPECT_FALSE(checkpointStore.GetDurableCheckpoint(makeCheckpoint(0, 0)).HasValue());
+      auto checkpoints = checkpointStore.ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", consumerGroup);
+      ASSERT_EQ(1ul, checkpoints.size());
+      EXPECT_EQ(203, checkpoints[0].SequenceNumber.Value());
+
+      // Only the latest checkpoint of the partition is written.
+      checkpointStore.FlushCheckpoints();
+      auto durable = checkpointStore.GetDurableCheckpoint(makeCheckpoint(0, 0));
+      ASSERT_TRUE(durable.HasValue());
+      EXPECT_EQ(203, durable.Value().SequenceNumber.Value());
+      EXPECT_EQ(102, durable.Value().Offset.Value());
+      checkpoints = storageReader.ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", consumerGroup);
+      ASSERT_EQ(1ul, checkpoints.size());
+      EXPECT_EQ(203, checkpoints[0].SequenceNumber.Value());
+
+      // A pending checkpoint is dropped when the store fails to claim its partition.
+      Azure::Messaging::EventHubs::Models::Ownership ownership{
+          consumerGroup,
+          "event-hub-name",
+          "ns.servicebus.windows.net",
+          "partition-id",
+          "owner-id"};
+      auto claimed = checkpointStore.ClaimOwnership({ownership});
+      ASSERT_EQ(1ul, claimed.size());
+      checkpointStore.UpdateCheckpoint(makeCheckpoint(103, 204));
+      ownership.ETag = Azure::ETag("randomETAG");
+      EXPECT_EQ(0ul, checkpointStore.ClaimOwnership({ownership}).size());
+      checkpointStore.FlushCheckpoints();
+      durable = checkpointStore.GetDurableCheckpoint(makeCheckpoint(0, 0));
+      ASSERT_TRUE(durable.HasValue());
+      EXPECT_EQ(203, durable.Value().SequenceNumber.Value());
+      checkpoints = checkpointStore.ListCheckpoints(
+          "ns.servicebus.windows.net", "event-hub-name", consumerGroup);
+      ASSERT_EQ(1ul, checkpoints.size());
+      EXPECT_EQ(203, checkpoints[0].SequenceNumber.Value());
+
+      // The checkpoints of the partition are recorded again once it is claimed again.
+      ASSERT_EQ(1ul, checkpointStore.ClaimOwnership(claimed).size());
+
+      // The last pending checkpoint is written when the store is destroyed.
+      checkpointStore.UpdateCheckpoint(makeCheckpoint(104, 205));
+    }
+
+    auto checkpoints = storageReader.ListCheckpoints(
+        "ns.servicebus.windows.net", "event-hub-name", consumerGroup);
+    ASSERT_EQ(1ul, checkpoints.size());
+    EXPECT_EQ(205, checkpoints[0].SequenceNumber.Value());
+    EXPECT_EQ(104, checkpoints[0].Offset.Value());
+  }
+
   namespace {
     static std::string GetSuffix(const testing::TestParamInfo<AuthType>& info)
     {
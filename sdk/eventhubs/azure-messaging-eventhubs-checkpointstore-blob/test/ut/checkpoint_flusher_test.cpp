@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/context.hpp>
+#include <azure/messaging/eventhubs/models/checkpoint_store_models.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// The next include is from a private header of the blob checkpoint store.
+// It is included to check how the store coalesces checkpoints without a storage account.
+#include <private/checkpoint_flusher.hpp>
+
+using Azure::Messaging::EventHubs::_detail::CheckpointFlusher;
+using Azure::Messaging::EventHubs::Models::Checkpoint;
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
+
+  namespace {
+    Checkpoint MakeCheckpoint(
+        std::string const& partitionId,
+        int64_t sequenceNumber,
+        std::string const& consumerGroup = "$Default")
+    {
+      return Checkpoint{
+          consumerGroup,
+          "event-hub-name",
+          "ns.servicebus.windows.net",
+          partitionId,
+          sequenceNumber * 10,
+          sequenceNumber};
+    }
+
+    // Records the checkpoints written to storage, and fails the writes while FailWrites is set.
+    struct FakeWriter final
+    {
+      std::vector<Checkpoint> Written;
+      bool FailWrites{false};
+
+      CheckpointFlusher::CheckpointWriter Writer()
+      {
+        return [this](Checkpoint const& checkpoint, Core::Context const&) {
+          if (FailWrites)
+          {
+            throw std::runtime_error("The checkpoint could not be written.");
+          }
+          Written.push_back(checkpoint);
+        };
+      }
+    };
+
+    constexpr std::chrono::hours FlushInterval{1};
+  } // namespace
+
+  TEST(CheckpointFlusherTest, WritesRightAwayWithoutInterval)
+  {
+    FakeWriter writer;
+    CheckpointFlusher flusher(writer.Writer(), Azure::DateTime::duration::zero());
+
+    flusher.Update(MakeCheckpoint("0", 1), {});
+    ASSERT_EQ(writer.Written.size(), 1U);
+    EXPECT_EQ(writer.Written[0].SequenceNumber.Value(), 1);
+    auto const durable
+        = flusher.GetDurableCheckpoint(MakeCheckpoint("0", 0).GetCheckpointBlobName());
+    ASSERT_TRUE(durable.HasValue());
+    EXPECT_EQ(durable.Value().SequenceNumber.Value(), 1);
+  }
+
+  TEST(CheckpointFlusherTest, CoalescesCheckpoints)
+  {
+    FakeWriter writer;
+    {
+      CheckpointFlusher flusher(writer.Writer(), FlushInterval);
+
+      flusher.Update(MakeCheckpoint("0", 1), {});
+      flusher.Update(MakeCheckpoint("1", 5), {});
+      flusher.Update(MakeCheckpoint("0", 2), {});
+      flusher.Update(MakeCheckpoint("0", 3), {});
+      EXPECT_TRUE(writer.Written.empty());
+      EXPECT_FALSE(
+          flusher.GetDurableCheckpoint(MakeCheckpoint("0", 0).GetCheckpointBlobName()).HasValue());
+
+      // Only the latest checkpoint of each partition is written.
+      flusher.Flush({});
+      ASSERT_EQ(writer.Written.size(), 2U);
+      EXPECT_EQ(writer.Written[0].PartitionId, "0");
+      EXPECT_EQ(writer.Written[0].SequenceNumber.Value(), 3);
+      EXPECT_EQ(writer.Written[0].Offset.Value(), 30);
+      EXPECT_EQ(writer.Written[1].PartitionId, "1");
+      EXPECT_EQ(writer.Written[1].SequenceNumber.Value(), 5);
+      auto const durable
+          = flusher.GetDurableCheckpoint(MakeCheckpoint("0", 0).GetCheckpointBlobName());
+      ASSERT_TRUE(durable.HasValue());
+      EXPECT_EQ(durable.Value().SequenceNumber.Value(), 3);
+
+      // Nothing is left to write.
+      flusher.Flush({});
+      EXPECT_EQ(writer.Written.size(), 2U);
+
+      // The pending checkpoints are written when the flusher is destroyed.
+      flusher.Update(MakeCheckpoint("1", 6), {});
+    }
+    ASSERT_EQ(writer.Written.size(), 3U);
+    EXPECT_EQ(writer.Written[2].SequenceNumber.Value(), 6);
+  }
+
+  TEST(CheckpointFlusherTest, MergePendingCheckpoints)
+  {
+    FakeWriter writer;
+    CheckpointFlusher flusher(writer.Writer(), FlushInterval);
+    flusher.Update(MakeCheckpoint("0", 7), {});
+    flusher.Update(MakeCheckpoint("2", 8), {});
+    flusher.Update(MakeCheckpoint("0", 9, "other-consumer-group"), {});
+
+    // The listed checkpoint of partition 0 is replaced, partition 1 has no pending checkpoint and
+    // partition 2 wasn't listed.
+    std::vector<Checkpoint> checkpoints{MakeCheckpoint("0", 1), MakeCheckpoint("1", 2)};
+    flusher.MergePendingCheckpoints(
+        checkpoints, MakeCheckpoint("", 0).GetCheckpointBlobPrefixName());
+    ASSERT_EQ(checkpoints.size(), 3U);
+    EXPECT_EQ(checkpoints[0].PartitionId, "0");
+    EXPECT_EQ(checkpoints[0].SequenceNumber.Value(), 7);
+    EXPECT_EQ(checkpoints[1].PartitionId, "1");
+    EXPECT_EQ(checkpoints[1].SequenceNumber.Value(), 2);
+    EXPECT_EQ(checkpoints[2].PartitionId, "2");
+    EXPECT_EQ(checkpoints[2].SequenceNumber.Value(), 8);
+    EXPECT_TRUE(writer.Written.empty());
+  }
+
+  TEST(CheckpointFlusherTest, FailedFlushKeepsCheckpoints)
+  {
+    FakeWriter writer;
+    CheckpointFlusher flusher(writer.Writer(), FlushInterval);
+    flusher.Update(MakeCheckpoint("0", 1), {});
+    flusher.Update(MakeCheckpoint("1", 1), {});
+
+    writer.FailWrites = true;
+    EXPECT_THROW(flusher.Flush({}), std::runtime_error);
+    EXPECT_TRUE(writer.Written.empty());
+    EXPECT_FALSE(
+        flusher.GetDurableCheckpoint(MakeCheckpoint("0", 0).GetCheckpointBlobName()).HasValue());
+
+    // A checkpoint recorded after the failed flush takes the place of the one which failed.
+    flusher.Update(MakeCheckpoint("1", 2), {});
+    std::vector<Checkpoint> checkpoints;
+    flusher.MergePendingCheckpoints(
+        checkpoints, MakeCheckpoint("", 0).GetCheckpointBlobPrefixName());
+    ASSERT_EQ(checkpoints.size(), 2U);
+
+    writer.FailWrites = false;
+    flusher.Flush({});
+    ASSERT_EQ(writer.Written.size(), 2U);
+    EXPECT_EQ(writer.Written[0].PartitionId, "0");
+    EXPECT_EQ(writer.Written[0].SequenceNumber.Value(), 1);
+    EXPECT_EQ(writer.Written[1].PartitionId, "1");
+    EXPECT_EQ(writer.Written[1].SequenceNumber.Value(), 2);
+  }
+
+  TEST(CheckpointFlusherTest, LostPartitionCheckpointsAreDropped)
+  {
+    FakeWriter writer;
+    {
+      CheckpointFlusher flusher(writer.Writer(), FlushInterval);
+      auto const blobName = MakeCheckpoint("0", 0).GetCheckpointBlobName();
+      flusher.Update(MakeCheckpoint("0", 1), {});
+      flusher.Update(MakeCheckpoint("1", 1), {});
+
+      // Another client owns partition 0 now, its checkpoints must not overwrite theirs.
+      flusher.PartitionLost(blobName);
+      flusher.Update(MakeCheckpoint("0", 2), {});
+      flusher.Flush({});
+      ASSERT_EQ(writer.Written.size(), 1U);
+      EXPECT_EQ(writer.Written[0].PartitionId, "1");
+
+      // A checkpoint kept after a failed write is dropped once its partition is lost.
+      flusher.PartitionClaimed(blobName);
+      flusher.Update(MakeCheckpoint("0", 3), {});
+      writer.FailWrites = true;
+      EXPECT_THROW(flusher.Flush({}), std::runtime_error);
+      flusher.PartitionLost(blobName);
+      writer.FailWrites = false;
+      flusher.Flush({});
+      EXPECT_EQ(writer.Written.size(), 1U);
+
+      // Once the partition is claimed again, its checkpoints are written.
+      flusher.PartitionClaimed(blobName);
+      flusher.Update(MakeCheckpoint("0", 4), {});
+      flusher.Update(MakeCheckpoint("1", 4), {});
+      flusher.PartitionLost(MakeCheckpoint("1", 0).GetCheckpointBlobName());
+    }
+    ASSERT_EQ(writer.Written.size(), 2U);
+    EXPECT_EQ(writer.Written[1].PartitionId, "0");
+    EXPECT_EQ(writer.Written[1].SequenceNumber.Value(), 4);
+  }
+
+}}}} // namespace Azure::Messaging::EventHubs::Test
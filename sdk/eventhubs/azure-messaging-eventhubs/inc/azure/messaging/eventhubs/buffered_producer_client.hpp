@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include "models/event_data.hpp"
+#include "producer_client.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/datetime.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Messaging { namespace EventHubs {
+  namespace _detail {
+    class BufferedProducerState;
+  } // namespace _detail
+
+  /**@brief Contains options for the BufferedProducerClient creation
+   */
+  struct BufferedProducerClientOptions final
+  {
+    /**@brief The longest time an event waits in a partially filled batch before the batch is
+     * sent. A batch is sent as soon as it is full, whichever comes first.
+     * The default value is 1 second.
+     */
+    Azure::DateTime::duration MaxWaitTime{std::chrono::seconds(1)};
+
+    /**@brief The largest number of events buffered for a partition, counting the events which
+     * have been sent but whose delivery has not been settled yet. When a partition has this many
+     * events, Enqueue blocks until some of them are settled.
+     * The default value is 1500 events.
+     */
+    std::uint32_t MaxBufferedEventsPerPartition{1500};
+
+    /**@brief Called with the events of a batch once the service has accepted the batch.
+     *
+     * @remark It is called from the thread sending the partition's events, so it should not
+     * block for long, and must not call Flush or Close.
+     */
+    std::function<
+        void(std::string const& partitionId, std::vector<Models::EventData> const& events)>
+        OnSendSucceeded;
+
+    /**@brief Called with the events of a batch which could not be sent after retrying, and the
+     * error of the last attempt.
+     *
+     * @remark It is called from the thread sending the partition's events, so it should not
+     * block for long, and must not call Flush or Close.
+     */
+    std::function<void(
+        std::string const& partitionId,
+        std::vector<Models::EventData> const& events,
+        std::exception const& error)>
+        OnSendFailed;
+  };
+
+  /**@brief Contains options for enqueuing an event in a BufferedProducerClient.
+   *
+   * @remark If both PartitionKey and PartitionId are empty, the events are spread evenly over the
+   * partitions.
+   */
+  struct EnqueueEventOptions final
+  {
+    /** @brief PartitionKey is hashed to calculate the partition assignment, with the same
+     * algorithm the service uses. Events with the same PartitionKey are sent to the same
+     * partition. Note that if you use this option then PartitionId cannot be set.
+     */
+    std::string PartitionKey;
+
+    /** @brief PartitionId is the ID of the partition to send the event to.
+     * Note that if you use this option then PartitionKey cannot be set.
+     */
+    std::string PartitionId;
+  };
+
+  /**@brief BufferedProducerClient sends individual events to an Event Hub, batching them per
+   * partition.
+   *
+   * @remark Events can be enqueued from several threads at the same time. They are assigned to a
+   * partition when they are enqueued, and each partition has a thread which packs its events in
+   * batches of up to the maximum message size. A batch is sent when it is full or when its first
+   * event has waited for BufferedProducerClientOptions::MaxWaitTime, without waiting for the
+   * previous batches of the partition to be settled, so several batches are in flight on each
+   * partition. A batch which fails is retried according to the retry options of the
+   * ProducerClient, which means that the events of a partition may not be received in the order
+   * they were enqueued when a send fails.
+   */
+  class BufferedProducerClient final {
+  public:
+    /**@brief Constructs a new BufferedProducerClient instance
+     *
+     * @param producerClient The ProducerClient used to send the batches.
+     * @param options Additional options for the buffered producer.
+     */
+    BufferedProducerClient(
+        std::shared_ptr<ProducerClient> producerClient,
+        BufferedProducerClientOptions const& options = {});
+
+    /**@brief Sends the buffered events, waits for them to be settled, and stops the client.
+     */
+    ~BufferedProducerClient();
+
+    /** Create a BufferedProducerClient from another BufferedProducerClient. */
+    BufferedProducerClient(BufferedProducerClient const& other) = delete;
+
+    /** Assign a BufferedProducerClient another BufferedProducerClient. */
+    BufferedProducerClient& operator=(BufferedProducerClient const& other) = delete;
+
+    /**@brief Enqueues an event to be sent to the Event Hub.
+     *
+     * @remark The partition IDs of the Event Hub are retrieved the first time an event is
+     * enqueued. If the partition already has
+     * BufferedProducerClientOptions::MaxBufferedEventsPerPartition events, this waits until some
+     * of them have been settled.
+     *
+     * @param eventData The event to send.
+     * @param options Optional partition key or partition ID for the event.
+     * @param context Context for the operation can be used for request cancellation.
+     */
+    void Enqueue(
+        Models::EventData eventData,
+        EnqueueEventOptions const& options = {},
+        Core::Context const& context = {});
+
+    /**@brief Gets the number of events which have been enqueued and not been settled yet.
+     */
+    size_t GetBufferedEventCount() const;
+
+    /**@brief Sends the buffered events without waiting for their batches to fill, and waits until
+     * every buffered event has been settled.
+     *
+     * @param context Context for the operation can be used for request cancellation.
+     */
+    void Flush(Core::Context const& context = {});
+
+    /**@brief Flushes the buffered events and stops the client. Events cannot be enqueued once the
+     * client is closed.
+     *
+     * @param context Context for the operation can be used for request cancellation.
+     */
+    void Close(Core::Context const& context = {});
+
+  private:
+    std::unique_ptr<_detail::BufferedProducerState> m_state;
+  };
+}}} // namespace Azure::Messaging::EventHubs
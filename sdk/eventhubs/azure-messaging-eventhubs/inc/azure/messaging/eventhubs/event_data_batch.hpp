@@ -10,8 +10,8 @@
 
 #include <mutex>
 #include <stdexcept>
-
-// cspell: words vbin
+#include <utility>
+#include <vector>
 
 namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
   class EventDataBatchFactory;
@@ -59,7 +59,10 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     std::string m_partitionId;
     std::string m_partitionKey;
     Azure::Nullable<std::uint64_t> m_maxBytes;
-    std::vector<std::vector<uint8_t>> m_marshalledMessages;
+    // The body of the batched message: each event serialized as an AMQP data section.
+    std::vector<uint8_t> m_encodedBody;
+    // The offset and size of each serialized event in m_encodedBody.
+    std::vector<std::pair<size_t, size_t>> m_eventRanges;
     // Annotation properties
     const uint32_t BatchedMessageFormat = 0x80013700;
 
@@ -74,8 +77,9 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     EventDataBatch(EventDataBatch const& other)
         // Copy constructor cannot be defaulted because of m_rwMutex.
         : m_rwMutex{}, m_partitionId{other.m_partitionId}, m_partitionKey{other.m_partitionKey},
-          m_maxBytes{other.m_maxBytes}, m_marshalledMessages{other.m_marshalledMessages},
-          m_batchEnvelope{other.m_batchEnvelope}, m_currentSize(other.m_currentSize){};
+          m_maxBytes{other.m_maxBytes}, m_encodedBody{other.m_encodedBody},
+          m_eventRanges{other.m_eventRanges}, m_batchEnvelope{other.m_batchEnvelope},
+          m_currentSize(other.m_currentSize){};
 
     /** Copy an EventDataBatch to another EventDataBatch */
     EventDataBatch& operator=(EventDataBatch const& other)
@@ -86,7 +90,8 @@ namespace Azure { namespace Messaging { namespace EventHubs {
         m_partitionId = other.m_partitionId;
         m_partitionKey = other.m_partitionKey;
         m_maxBytes = other.m_maxBytes;
-        m_marshalledMessages = other.m_marshalledMessages;
+        m_encodedBody = other.m_encodedBody;
+        m_eventRanges = other.m_eventRanges;
         m_batchEnvelope = other.m_batchEnvelope;
         m_currentSize = other.m_currentSize;
       }
@@ -136,7 +141,7 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     size_t NumberOfEvents()
     {
       std::lock_guard<std::mutex> lock(m_rwMutex);
-      return m_marshalledMessages.size();
+      return m_eventRanges.size();
     }
 
     /** @brief Serializes the EventDataBatch to a single AmqpMessage to be sent to the EventHubs
@@ -150,24 +155,13 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     bool TryAddAmqpMessage(
         std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage const> const& message);
 
-    size_t CalculateActualSizeForPayload(std::vector<uint8_t> const& payload)
-    {
-      const size_t vbin8Overhead = 5;
-      const size_t vbin32Overhead = 8;
-
-      if (payload.size() < 256)
-      {
-        return payload.size() + vbin8Overhead;
-      }
-      return payload.size() + vbin32Overhead;
-    }
-
     Azure::Core::Amqp::Models::AmqpMessage CreateBatchEnvelope(
         std::shared_ptr<Azure::Core::Amqp::Models::AmqpMessage const> const& message) const
     {
       // Create the batch envelope from the prototype message. This copies all the attributes
       // *except* the body attribute to the batch envelope.
       Azure::Core::Amqp::Models::AmqpMessage batchEnvelope{*message};
+      batchEnvelope.SetBody(std::vector<Azure::Core::Amqp::Models::AmqpBinaryData>{});
       batchEnvelope.BodyType = Azure::Core::Amqp::Models::MessageBodyType::None;
       batchEnvelope.MessageFormat = BatchedMessageFormat;
       return batchEnvelope;
@@ -179,7 +173,8 @@ namespace Azure { namespace Messaging { namespace EventHubs {
      */
     EventDataBatch(EventDataBatchOptions options = {})
         : m_partitionId{options.PartitionId}, m_partitionKey{options.PartitionKey},
-          m_maxBytes{options.MaxBytes}, m_marshalledMessages{}, m_batchEnvelope{}, m_currentSize{0}
+          m_maxBytes{options.MaxBytes}, m_encodedBody{}, m_eventRanges{}, m_batchEnvelope{},
+          m_currentSize{0}
     {
       if (!options.PartitionId.empty() && !options.PartitionKey.empty())
       {
@@ -18,6 +18,7 @@
 namespace Azure { namespace Messaging { namespace EventHubs {
   namespace _detail {
     class EventHubsPropertiesClient;
+    class BufferedProducerState;
   } // namespace _detail
 
   /**@brief Contains options for the ProducerClient creation
@@ -221,5 +222,13 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
     Azure::Core::Amqp::_internal::MessageSender GetSender(std::string const& partitionId);
     Azure::Core::Amqp::_internal::Session GetSession(std::string const& partitionId);
+
+    // Send a batch without waiting for its disposition. Used by the BufferedProducerClient.
+    void SendAsync(
+        EventDataBatch const& eventDataBatch,
+        Azure::Core::Amqp::_internal::MessageSender::MessageSendResultCallback onSendComplete,
+        Core::Context const& context = {});
+
+    friend class _detail::BufferedProducerState;
   };
 }}} // namespace Azure::Messaging::EventHubs
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/messaging/eventhubs/buffered_producer_client.hpp"
+
+#include "azure/messaging/eventhubs/event_data_batch.hpp"
+#include "private/buffered_partition_publisher.hpp"
+#include "private/partition_resolver.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
+
+  class BufferedProducerState final {
+  public:
+    BufferedProducerState(
+        std::shared_ptr<ProducerClient> producer,
+        BufferedProducerClientOptions const& options)
+        : m_producer{producer}, m_options{options}
+    {
+      if (!m_producer)
+      {
+        throw std::invalid_argument("A producer client is required.");
+      }
+    }
+
+    void Enqueue(
+        Models::EventData eventData,
+        EnqueueEventOptions const& options,
+        Core::Context const& context)
+    {
+      if (!options.PartitionId.empty() && !options.PartitionKey.empty())
+      {
+        throw std::invalid_argument("Either PartitionId or PartitionKey can be set, but not both.");
+      }
+      GetPublisher(options, context).Enqueue(std::move(eventData), options.PartitionKey, context);
+    }
+
+    size_t GetBufferedEventCount()
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      size_t count = 0;
+      for (auto& publisher : m_publishers)
+      {
+        count += publisher.second->GetBufferedEventCount();
+      }
+      return count;
+    }
+
+    void Flush(Core::Context const& context)
+    {
+      auto publishers{GetPublishers()};
+      for (auto publisher : publishers)
+      {
+        publisher->RequestFlush();
+      }
+      for (auto publisher : publishers)
+      {
+        publisher->WaitUntilSettled(context);
+      }
+    }
+
+    void Close(Core::Context const& context)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_closed = true;
+      }
+      Flush(context);
+      Stop();
+    }
+
+    // Send whatever is left and stop the publishers.
+    void Stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_closed = true;
+      }
+      for (auto publisher : GetPublishers())
+      {
+        publisher->Stop();
+      }
+    }
+
+  private:
+    std::shared_ptr<ProducerClient> m_producer;
+    BufferedProducerClientOptions m_options;
+    PartitionResolver m_resolver;
+
+    std::mutex m_lock;
+    bool m_closed{false};
+    std::vector<std::string> m_partitionIds;
+    std::map<std::string, std::unique_ptr<BufferedPartitionPublisher>> m_publishers;
+
+    BufferedPartitionPublisher::BatchSender MakeBatchSender()
+    {
+      auto producer{m_producer};
+      BufferedPartitionPublisher::BatchSender sender;
+      sender.CreateBatch = [producer](EventDataBatchOptions const& options) {
+        return producer->CreateBatch(options);
+      };
+      sender.SendAsync = [producer](
+                             EventDataBatch const& batch,
+                             Azure::Core::Amqp::_internal::MessageSender::MessageSendResultCallback
+                                 onSendComplete) { producer->SendAsync(batch, onSendComplete); };
+      sender.Send = [producer](EventDataBatch const& batch) { producer->Send(batch); };
+      return sender;
+    }
+
+    std::vector<BufferedPartitionPublisher*> GetPublishers()
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      std::vector<BufferedPartitionPublisher*> publishers;
+      for (auto& publisher : m_publishers)
+      {
+        publishers.push_back(publisher.second.get());
+      }
+      return publishers;
+    }
+
+    BufferedPartitionPublisher& GetPublisher(
+        EnqueueEventOptions const& options,
+        Core::Context const& context)
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      if (m_closed)
+      {
+        throw std::runtime_error("The buffered producer is closed.");
+      }
+      if (m_partitionIds.empty())
+      {
+        m_partitionIds = m_producer->GetEventHubProperties(context).PartitionIds;
+      }
+
+      std::string const& partitionId = !options.PartitionId.empty() ? options.PartitionId
+          : !options.PartitionKey.empty()
+          ? PartitionResolver::AssignForPartitionKey(options.PartitionKey, m_partitionIds)
+          : m_resolver.AssignRoundRobin(m_partitionIds);
+
+      auto publisher = m_publishers.find(partitionId);
+      if (publisher == m_publishers.end())
+      {
+        if (std::find(m_partitionIds.begin(), m_partitionIds.end(), partitionId)
+            == m_partitionIds.end())
+        {
+          throw std::invalid_argument("Unknown partition ID: " + partitionId);
+        }
+        publisher = m_publishers
+                        .emplace(
+                            partitionId,
+                            std::make_unique<BufferedPartitionPublisher>(
+                                MakeBatchSender(), partitionId, m_options))
+                        .first;
+      }
+      return *publisher->second;
+    }
+  };
+}}}} // namespace Azure::Messaging::EventHubs::_detail
+
+namespace Azure { namespace Messaging { namespace EventHubs {
+
+  BufferedProducerClient::BufferedProducerClient(
+      std::shared_ptr<ProducerClient> producerClient,
+      BufferedProducerClientOptions const& options)
+      : m_state{std::make_unique<_detail::BufferedProducerState>(producerClient, options)}
+  {
+  }
+
+  BufferedProducerClient::~BufferedProducerClient() { m_state->Stop(); }
+
+  void BufferedProducerClient::Enqueue(
+      Models::EventData eventData,
+      EnqueueEventOptions const& options,
+      Core::Context const& context)
+  {
+    m_state->Enqueue(std::move(eventData), options, context);
+  }
+
+  size_t BufferedProducerClient::GetBufferedEventCount() const
+  {
+    return m_state->GetBufferedEventCount();
+  }
+
+  void BufferedProducerClient::Flush(Core::Context const& context) { m_state->Flush(context); }
+
+  void BufferedProducerClient::Close(Core::Context const& context) { m_state->Close(context); }
+}}} // namespace Azure::Messaging::EventHubs
@@ -19,26 +19,31 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     return TryAddAmqpMessage(message.GetRawAmqpMessage());
   }
 
+  namespace {
+    // The serialized size of the batch envelope without its body.
+    size_t GetEnvelopeSize(Azure::Core::Amqp::Models::AmqpMessage envelope)
+    {
+      // An empty data body serializes to nothing.
+      envelope.SetBody(std::vector<Azure::Core::Amqp::Models::AmqpBinaryData>{});
+      return Azure::Core::Amqp::Models::AmqpMessage::Serialize(envelope).size();
+    }
+  } // namespace
+
   Azure::Core::Amqp::Models::AmqpMessage EventDataBatch::ToAmqpMessage() const
   {
     Azure::Core::Amqp::Models::AmqpMessage returnValue{m_batchEnvelope};
-    if (m_marshalledMessages.size() == 0)
+    if (m_eventRanges.size() == 0)
     {
       throw std::runtime_error("No messages added to the batch.");
     }
 
-    // Make sure that the partition key in the message is the current partition key.
-    if (!m_partitionKey.empty())
-    {
-      returnValue.DeliveryAnnotations.emplace(
-          _detail::PartitionKeyAnnotation, Azure::Core::Amqp::Models::AmqpValue(m_partitionKey));
-    }
-
     std::vector<Azure::Core::Amqp::Models::AmqpBinaryData> messageList;
-    for (auto const& marshalledMessage : m_marshalledMessages)
+    messageList.reserve(m_eventRanges.size());
+    for (auto const& eventRange : m_eventRanges)
     {
-      Azure::Core::Amqp::Models::AmqpBinaryData data(marshalledMessage);
-      messageList.push_back(data);
+      auto eventStart = m_encodedBody.begin() + eventRange.first;
+      messageList.emplace_back(
+          std::vector<uint8_t>(eventStart, eventStart + eventRange.second));
     }
 
     returnValue.SetBody(messageList);
@@ -63,27 +68,37 @@ namespace Azure { namespace Messaging { namespace EventHubs {
           _detail::PartitionKeyAnnotation, Azure::Core::Amqp::Models::AmqpValue(m_partitionKey));
     }
 
-    auto serializedMessage = Azure::Core::Amqp::Models::AmqpMessage::Serialize(messageToSend);
-
     std::lock_guard<std::mutex> lock(m_rwMutex);
 
-    if (m_marshalledMessages.size() == 0)
+    if (m_eventRanges.size() == 0)
     {
       // The first message is special - we use its properties and annotations on the envelope for
       // the batch message.
       m_batchEnvelope = CreateBatchEnvelope(message);
-      m_currentSize = serializedMessage.size();
+      if (!m_partitionKey.empty())
+      {
+        m_batchEnvelope.DeliveryAnnotations.emplace(
+            _detail::PartitionKeyAnnotation,
+            Azure::Core::Amqp::Models::AmqpValue(m_partitionKey));
+      }
+      m_currentSize = GetEnvelopeSize(m_batchEnvelope);
     }
-    auto actualPayloadSize = CalculateActualSizeForPayload(serializedMessage);
-    if (m_currentSize + actualPayloadSize > m_maxBytes.Value())
+
+    // Serialize the message straight into the batch body, and take it back out if it doesn't fit.
+    auto const sectionOffset = m_encodedBody.size();
+    auto const eventOffset = Azure::Core::Amqp::Models::AmqpMessage::SerializeAsDataSection(
+        messageToSend, m_encodedBody);
+    auto const sectionSize = m_encodedBody.size() - sectionOffset;
+    if (m_currentSize + sectionSize > m_maxBytes.Value())
     {
+      m_encodedBody.resize(sectionOffset);
       Log::Stream(Logger::Level::Informational)
           << "Batch is full. Cannot add more messages. "
-          << "Message size: " << actualPayloadSize << " size: " << m_currentSize
+          << "Message size: " << sectionSize << " size: " << m_currentSize
           << " Max size: " << m_maxBytes.Value() << std::endl;
       // If we don't have any messages and we can't add this one, then we can't add it at all.
       // Discard the contents of the batch.
-      if (m_marshalledMessages.size() == 0)
+      if (m_eventRanges.size() == 0)
       {
         m_currentSize = 0;
         m_batchEnvelope = nullptr;
@@ -91,8 +106,8 @@ namespace Azure { namespace Messaging { namespace EventHubs {
       return false;
     }
 
-    m_currentSize += actualPayloadSize;
-    m_marshalledMessages.push_back(serializedMessage);
+    m_currentSize += sectionSize;
+    m_eventRanges.emplace_back(eventOffset, m_encodedBody.size() - eventOffset);
     return true;
   }
 
@@ -103,4 +118,19 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail
   {
     return EventDataBatch{options};
   }
+
+  Azure::Core::Amqp::Models::AmqpMessage const& EventDataBatchFactory::GetBatchEnvelope(
+      EventDataBatch const& batch)
+  {
+    if (batch.m_eventRanges.size() == 0)
+    {
+      throw std::runtime_error("No messages added to the batch.");
+    }
+    return batch.m_batchEnvelope;
+  }
+
+  std::vector<uint8_t> const& EventDataBatchFactory::GetEncodedBody(EventDataBatch const& batch)
+  {
+    return batch.m_encodedBody;
+  }
 }}}} // namespace Azure::Messaging::EventHubs::_detail
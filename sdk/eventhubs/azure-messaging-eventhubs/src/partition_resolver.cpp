@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/partition_resolver.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
+
+  namespace {
+    inline std::uint32_t Rotate(std::uint32_t value, int bits)
+    {
+      return (value << bits) | (value >> (32 - bits));
+    }
+
+    inline std::uint32_t ReadUInt32LittleEndian(std::uint8_t const* data)
+    {
+      return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8)
+          | (static_cast<std::uint32_t>(data[2]) << 16)
+          | (static_cast<std::uint32_t>(data[3]) << 24);
+    }
+  } // namespace
+
+  void PartitionResolver::ComputeHash(
+      std::uint8_t const* data,
+      size_t size,
+      std::uint32_t seed1,
+      std::uint32_t seed2,
+      std::uint32_t& hash1,
+      std::uint32_t& hash2)
+  {
+    std::uint32_t a, b, c;
+    a = b = c = 0xdeadbeef + static_cast<std::uint32_t>(size) + seed1;
+    c += seed2;
+
+    while (size > 12)
+    {
+      a += ReadUInt32LittleEndian(data);
+      b += ReadUInt32LittleEndian(data + 4);
+      c += ReadUInt32LittleEndian(data + 8);
+
+      a -= c;
+      a ^= Rotate(c, 4);
+      c += b;
+      b -= a;
+      b ^= Rotate(a, 6);
+      a += c;
+      c -= b;
+      c ^= Rotate(b, 8);
+      b += a;
+      a -= c;
+      a ^= Rotate(c, 16);
+      c += b;
+      b -= a;
+      b ^= Rotate(a, 19);
+      a += c;
+      c -= b;
+      c ^= Rotate(b, 4);
+      b += a;
+
+      data += 12;
+      size -= 12;
+    }
+
+    // The remaining 1 to 12 bytes; each case falls through to add the bytes below it.
+    switch (size)
+    {
+      case 12:
+        c += ReadUInt32LittleEndian(data + 8);
+        b += ReadUInt32LittleEndian(data + 4);
+        a += ReadUInt32LittleEndian(data);
+        break;
+      case 11:
+        c += static_cast<std::uint32_t>(data[10]) << 16;
+        // fall through
+      case 10:
+        c += static_cast<std::uint32_t>(data[9]) << 8;
+        // fall through
+      case 9:
+        c += data[8];
+        // fall through
+      case 8:
+        b += ReadUInt32LittleEndian(data + 4);
+        a += ReadUInt32LittleEndian(data);
+        break;
+      case 7:
+        b += static_cast<std::uint32_t>(data[6]) << 16;
+        // fall through
+      case 6:
+        b += static_cast<std::uint32_t>(data[5]) << 8;
+        // fall through
+      case 5:
+        b += data[4];
+        // fall through
+      case 4:
+        a += ReadUInt32LittleEndian(data);
+        break;
+      case 3:
+        a += static_cast<std::uint32_t>(data[2]) << 16;
+        // fall through
+      case 2:
+        a += static_cast<std::uint32_t>(data[1]) << 8;
+        // fall through
+      case 1:
+        a += data[0];
+        break;
+      case 0:
+        // Nothing is left to mix in.
+        hash1 = c;
+        hash2 = b;
+        return;
+    }
+
+    c ^= b;
+    c -= Rotate(b, 14);
+    a ^= c;
+    a -= Rotate(c, 11);
+    b ^= a;
+    b -= Rotate(a, 25);
+    c ^= b;
+    c -= Rotate(b, 16);
+    a ^= c;
+    a -= Rotate(c, 4);
+    b ^= a;
+    b -= Rotate(a, 14);
+    c ^= b;
+    c -= Rotate(b, 24);
+
+    hash1 = c;
+    hash2 = b;
+  }
+
+  std::int16_t PartitionResolver::GenerateHashCode(std::string const& partitionKey)
+  {
+    std::uint32_t hash1;
+    std::uint32_t hash2;
+    ComputeHash(
+        reinterpret_cast<std::uint8_t const*>(partitionKey.data()),
+        partitionKey.size(),
+        0,
+        0,
+        hash1,
+        hash2);
+    return static_cast<std::int16_t>(hash1 ^ hash2);
+  }
+
+  std::string const& PartitionResolver::AssignForPartitionKey(
+      std::string const& partitionKey,
+      std::vector<std::string> const& partitions)
+  {
+    if (partitions.empty())
+    {
+      throw std::invalid_argument("The Event Hub has no partitions.");
+    }
+    // The remainder has the sign of the hash code, as it does for the service.
+    auto const index = std::abs(
+        static_cast<int>(GenerateHashCode(partitionKey)) % static_cast<int>(partitions.size()));
+    return partitions[static_cast<size_t>(index)];
+  }
+
+  std::string const& PartitionResolver::AssignRoundRobin(
+      std::vector<std::string> const& partitions)
+  {
+    if (partitions.empty())
+    {
+      throw std::invalid_argument("The Event Hub has no partitions.");
+    }
+    return partitions[m_nextPartition++ % partitions.size()];
+  }
+}}}} // namespace Azure::Messaging::EventHubs::_detail
@@ -0,0 +1,367 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/messaging/eventhubs/buffered_producer_client.hpp"
+#include "azure/messaging/eventhubs/event_data_batch.hpp"
+#include "eventhubs_constants.hpp"
+
+#include <azure/core/amqp/internal/message_sender.hpp>
+#include <azure/core/context.hpp>
+#include <azure/core/diagnostics/logger.hpp>
+#include <azure/core/internal/diagnostics/log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
+
+  // How often a blocked Enqueue or Flush checks whether its context was cancelled.
+  constexpr std::chrono::milliseconds CancellationCheckInterval{100};
+
+  // The events buffered for one partition, and the thread which packs them in batches and sends
+  // the batches.
+  class BufferedPartitionPublisher final {
+  public:
+    // The operations of the ProducerClient the publisher uses, so that it can be tested without
+    // an Event Hub.
+    struct BatchSender
+    {
+      std::function<EventDataBatch(EventDataBatchOptions const&)> CreateBatch;
+      std::function<void(
+          EventDataBatch const&,
+          Azure::Core::Amqp::_internal::MessageSender::MessageSendResultCallback)>
+          SendAsync;
+      std::function<void(EventDataBatch const&)> Send;
+    };
+
+    BufferedPartitionPublisher(
+        BatchSender sender,
+        std::string const& partitionId,
+        BufferedProducerClientOptions const& options)
+        : m_sender{std::move(sender)}, m_partitionId{partitionId}, m_options{options},
+          m_maxBufferedEvents{(std::max)(options.MaxBufferedEventsPerPartition, std::uint32_t{1})}
+    {
+      m_thread = std::thread([this]() { Run(); });
+    }
+
+    ~BufferedPartitionPublisher() { Stop(); }
+
+    void Enqueue(
+        Models::EventData eventData,
+        std::string const& partitionKey,
+        Core::Context const& context)
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      while (!m_stopping && m_bufferedEvents >= m_maxBufferedEvents)
+      {
+        m_changed.wait_for(lock, CancellationCheckInterval);
+        context.ThrowIfCancelled();
+      }
+      if (m_stopping)
+      {
+        throw std::runtime_error("The buffered producer is closed.");
+      }
+      m_queue.push_back(BufferedEvent{std::move(eventData), partitionKey});
+      m_bufferedEvents += 1;
+      m_changed.notify_all();
+    }
+
+    // Ask the thread to send the open batch without waiting for it to fill.
+    void RequestFlush()
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      if (m_bufferedEvents != 0)
+      {
+        m_flushRequested = true;
+        m_changed.notify_all();
+      }
+    }
+
+    void WaitUntilSettled(Core::Context const& context)
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      while (m_bufferedEvents != 0)
+      {
+        m_changed.wait_for(lock, CancellationCheckInterval);
+        context.ThrowIfCancelled();
+      }
+    }
+
+    // Send everything which is buffered, then stop the thread.
+    void Stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+        m_changed.notify_all();
+      }
+      if (m_thread.joinable())
+      {
+        m_thread.join();
+      }
+    }
+
+    size_t GetBufferedEventCount()
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      return m_bufferedEvents;
+    }
+
+  private:
+    struct BufferedEvent
+    {
+      Models::EventData Event;
+      std::string PartitionKey;
+    };
+
+    struct SentBatch
+    {
+      std::unique_ptr<EventDataBatch> Batch;
+      std::vector<Models::EventData> Events;
+      Azure::Core::Amqp::_internal::MessageSendStatus Status;
+      Azure::Core::Amqp::Models::_internal::AmqpError Error;
+    };
+
+    BatchSender m_sender;
+    std::string m_partitionId;
+    BufferedProducerClientOptions m_options;
+    size_t m_maxBufferedEvents;
+
+    // Protects everything below up to m_thread.
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    std::deque<BufferedEvent> m_queue;
+    std::vector<std::shared_ptr<SentBatch>> m_settled;
+    // Events enqueued and not settled yet, whether they are queued, batched or in flight.
+    size_t m_bufferedEvents{};
+    size_t m_inFlightBatches{};
+    bool m_flushRequested{false};
+    bool m_stopping{false};
+
+    std::thread m_thread;
+
+    // The batch being filled, which is only used by the thread.
+    std::unique_ptr<EventDataBatch> m_batch;
+    std::vector<Models::EventData> m_batchEvents;
+    std::chrono::steady_clock::time_point m_batchDeadline;
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      while (true)
+      {
+        // Settle the batches which completed first, so that blocked producers are released as
+        // soon as possible.
+        if (!m_settled.empty())
+        {
+          std::vector<std::shared_ptr<SentBatch>> settled;
+          settled.swap(m_settled);
+          lock.unlock();
+          for (auto& sent : settled)
+          {
+            CompleteBatch(*sent);
+          }
+          lock.lock();
+          continue;
+        }
+
+        if (!m_queue.empty())
+        {
+          std::deque<BufferedEvent> queue;
+          queue.swap(m_queue);
+          lock.unlock();
+          for (auto& bufferedEvent : queue)
+          {
+            AddToBatch(bufferedEvent);
+          }
+          lock.lock();
+          continue;
+        }
+
+        if (m_batch)
+        {
+          if (m_flushRequested || m_stopping
+              || std::chrono::steady_clock::now() >= m_batchDeadline)
+          {
+            lock.unlock();
+            SendBatch();
+            lock.lock();
+            continue;
+          }
+          m_changed.wait_until(lock, m_batchDeadline);
+        }
+        else if (m_stopping && m_inFlightBatches == 0)
+        {
+          break;
+        }
+        else
+        {
+          m_changed.wait(lock);
+        }
+      }
+    }
+
+    bool TryAdd(EventDataBatch& batch, BufferedEvent const& bufferedEvent)
+    {
+      if (bufferedEvent.PartitionKey.empty())
+      {
+        return batch.TryAdd(bufferedEvent.Event);
+      }
+      // The batch is sent to the partition the key resolves to, so the key is only kept on the
+      // event itself.
+      auto message{std::make_shared<Azure::Core::Amqp::Models::AmqpMessage>(
+          *bufferedEvent.Event.GetRawAmqpMessage())};
+      message->MessageAnnotations.emplace(
+          PartitionKeyAnnotation, Azure::Core::Amqp::Models::AmqpValue{bufferedEvent.PartitionKey});
+      return batch.TryAdd(message);
+    }
+
+    void AddToBatch(BufferedEvent& bufferedEvent)
+    {
+      try
+      {
+        for (;;)
+        {
+          if (!m_batch)
+          {
+            EventDataBatchOptions batchOptions;
+            batchOptions.PartitionId = m_partitionId;
+            m_batch = std::make_unique<EventDataBatch>(m_sender.CreateBatch(batchOptions));
+            m_batchDeadline = std::chrono::steady_clock::now() + m_options.MaxWaitTime;
+          }
+          if (TryAdd(*m_batch, bufferedEvent))
+          {
+            m_batchEvents.push_back(std::move(bufferedEvent.Event));
+            return;
+          }
+          if (m_batchEvents.empty())
+          {
+            m_batch.reset();
+            throw std::runtime_error("The event is larger than the maximum message size.");
+          }
+          // The batch is full: send it and add the event to a new one.
+          SendBatch();
+        }
+      }
+      catch (std::exception const& ex)
+      {
+        Settle({std::move(bufferedEvent.Event)}, &ex);
+      }
+    }
+
+    void SendBatch()
+    {
+      auto sent = std::make_shared<SentBatch>();
+      sent->Batch = std::move(m_batch);
+      sent->Events = std::move(m_batchEvents);
+      m_batchEvents.clear();
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_inFlightBatches += 1;
+      }
+
+      try
+      {
+        // The callback runs on the thread polling the connection, so the batch is completed on
+        // this publisher's thread.
+        m_sender.SendAsync(
+            *sent->Batch,
+            [this, sent](
+                Azure::Core::Amqp::_internal::MessageSendStatus status,
+                Azure::Core::Amqp::Models::_internal::AmqpError const& error) {
+              std::lock_guard<std::mutex> lock(m_lock);
+              sent->Status = status;
+              sent->Error = error;
+              m_settled.push_back(sent);
+              m_changed.notify_all();
+            });
+      }
+      catch (std::exception const& ex)
+      {
+        Azure::Core::Diagnostics::_internal::Log::Stream(
+            Azure::Core::Diagnostics::Logger::Level::Warning)
+            << "Could not send batch to partition " << m_partitionId << ": " << ex.what();
+        sent->Status = Azure::Core::Amqp::_internal::MessageSendStatus::Error;
+        CompleteBatch(*sent);
+      }
+    }
+
+    void CompleteBatch(SentBatch& sent)
+    {
+      if (sent.Status == Azure::Core::Amqp::_internal::MessageSendStatus::Ok)
+      {
+        Settle(std::move(sent.Events), nullptr);
+      }
+      else
+      {
+        // Send the batch again, synchronously, following the retry options of the producer.
+        try
+        {
+          m_sender.Send(*sent.Batch);
+          Settle(std::move(sent.Events), nullptr);
+        }
+        catch (std::exception const& ex)
+        {
+          Settle(std::move(sent.Events), &ex);
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_inFlightBatches -= 1;
+      m_changed.notify_all();
+    }
+
+    // Report the outcome of the events and release their room in the buffer.
+    void Settle(std::vector<Models::EventData> events, std::exception const* error)
+    {
+      try
+      {
+        if (error == nullptr)
+        {
+          if (m_options.OnSendSucceeded)
+          {
+            m_options.OnSendSucceeded(m_partitionId, events);
+          }
+        }
+        else
+        {
+          Azure::Core::Diagnostics::_internal::Log::Stream(
+              Azure::Core::Diagnostics::Logger::Level::Warning)
+              << "Failed to send " << events.size() << " events to partition " << m_partitionId
+              << ": " << error->what();
+          if (m_options.OnSendFailed)
+          {
+            m_options.OnSendFailed(m_partitionId, events, *error);
+          }
+        }
+      }
+      catch (std::exception const& ex)
+      {
+        Azure::Core::Diagnostics::_internal::Log::Stream(
+            Azure::Core::Diagnostics::Logger::Level::Warning)
+            << "Send handler for partition " << m_partitionId << " threw: " << ex.what();
+      }
+
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_bufferedEvents -= events.size();
+      if (m_bufferedEvents == 0)
+      {
+        m_flushRequested = false;
+      }
+      m_changed.notify_all();
+    }
+  };
+}}}} // namespace Azure::Messaging::EventHubs::_detail
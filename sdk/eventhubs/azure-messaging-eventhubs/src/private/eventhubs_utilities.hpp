@@ -73,6 +73,10 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail
   class EventDataBatchFactory final {
   public:
     static EventDataBatch CreateEventDataBatch(EventDataBatchOptions const& options);
+    // The envelope and the encoded body of the batched message, which are sent as is.
+    static Azure::Core::Amqp::Models::AmqpMessage const& GetBatchEnvelope(
+        EventDataBatch const& batch);
+    static std::vector<uint8_t> const& GetEncodedBody(EventDataBatch const& batch);
     EventDataBatchFactory() = delete;
   };
 
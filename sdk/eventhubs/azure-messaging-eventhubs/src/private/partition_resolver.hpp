@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace _detail {
+
+  /**
+   * @brief Assigns events to partitions on the client, the same way the Event Hubs service
+   * assigns them.
+   */
+  class PartitionResolver final {
+  public:
+    /**
+     * @brief Computes the two 32 bit hashes of data with Bob Jenkins' lookup3 hashlittle2, which is
+     * the hash the service uses for partition keys.
+     */
+    static void ComputeHash(
+        std::uint8_t const* data,
+        size_t size,
+        std::uint32_t seed1,
+        std::uint32_t seed2,
+        std::uint32_t& hash1,
+        std::uint32_t& hash2);
+
+    /** @brief Computes the hash code of a partition key, as the service does. */
+    static std::int16_t GenerateHashCode(std::string const& partitionKey);
+
+    /**
+     * @brief Returns the partition the service sends events with the given partition key to.
+     *
+     * @param partitionKey The partition key.
+     * @param partitions The partition IDs of the Event Hub, in the order the service returns them.
+     */
+    static std::string const& AssignForPartitionKey(
+        std::string const& partitionKey,
+        std::vector<std::string> const& partitions);
+
+    /**
+     * @brief Returns the next partition in turn, for events which have neither a partition key nor
+     * a partition ID.
+     */
+    std::string const& AssignRoundRobin(std::vector<std::string> const& partitions);
+
+  private:
+    std::atomic<std::uint32_t> m_nextPartition{0};
+  };
+}}}} // namespace Azure::Messaging::EventHubs::_detail
@@ -73,12 +73,15 @@ namespace Azure { namespace Messaging { namespace EventHubs {
 
   void ProducerClient::Send(EventDataBatch const& eventDataBatch, Core::Context const& context)
   {
-    auto message = eventDataBatch.ToAmqpMessage();
+    // The events in the batch are already encoded, send them as they are.
+    auto const& envelope = _detail::EventDataBatchFactory::GetBatchEnvelope(eventDataBatch);
+    auto const& encodedBody = _detail::EventDataBatchFactory::GetEncodedBody(eventDataBatch);
 
     Azure::Messaging::EventHubs::_detail::RetryOperation retryOp(
         m_producerClientOptions.RetryOptions);
     retryOp.Execute([&]() -> bool {
-      auto result = GetSender(eventDataBatch.GetPartitionId()).Send(message, context);
+      auto result
+          = GetSender(eventDataBatch.GetPartitionId()).Send(envelope, encodedBody, context);
       auto sendStatus = std::get<0>(result);
       if (sendStatus == Azure::Core::Amqp::_internal::MessageSendStatus::Ok)
       {
@@ -90,6 +93,19 @@ namespace Azure { namespace Messaging { namespace EventHubs {
     });
   }
 
+  void ProducerClient::SendAsync(
+      EventDataBatch const& eventDataBatch,
+      Azure::Core::Amqp::_internal::MessageSender::MessageSendResultCallback onSendComplete,
+      Core::Context const& context)
+  {
+    GetSender(eventDataBatch.GetPartitionId())
+        .SendAsync(
+            _detail::EventDataBatchFactory::GetBatchEnvelope(eventDataBatch),
+            _detail::EventDataBatchFactory::GetEncodedBody(eventDataBatch),
+            std::move(onSendComplete),
+            context);
+  }
+
   void ProducerClient::Send(Models::EventData const& eventData, Core::Context const& context)
   {
     auto batch = CreateBatch(EventDataBatchOptions{}, context);
@@ -195,6 +211,7 @@ namespace Azure { namespace Messaging { namespace EventHubs {
   Azure::Core::Amqp::_internal::MessageSender ProducerClient::GetSender(
       std::string const& partitionId)
   {
+    std::unique_lock<std::mutex> lock(m_sendersLock);
     return m_senders.at(partitionId);
   }
 
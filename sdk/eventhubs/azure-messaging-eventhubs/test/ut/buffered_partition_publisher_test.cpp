@@ -0,0 +1,361 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/context.hpp>
+#include <azure/core/operation_status.hpp>
+#include <azure/messaging/eventhubs/buffered_producer_client.hpp>
+#include <azure/messaging/eventhubs/event_data_batch.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// The next includes are from private headers of the Event Hubs package.
+// They are included to check how events are batched and sent without an Event Hub.
+#include <private/buffered_partition_publisher.hpp>
+#include <private/eventhubs_utilities.hpp>
+
+using Azure::Core::Amqp::_internal::MessageSendStatus;
+using Azure::Core::Amqp::_internal::MessageSender;
+using Azure::Messaging::EventHubs::_detail::BufferedPartitionPublisher;
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
+
+  namespace {
+    constexpr std::chrono::hours NoLinger{1};
+    constexpr std::chrono::seconds WaitTimeout{10};
+
+    // Two events with a body of this size fit in a batch of BatchMaxBytes bytes, three don't.
+    constexpr size_t EventBodySize = 100;
+    constexpr std::uint64_t BatchMaxBytes = 400;
+
+    Models::EventData MakeEvent(size_t bodySize = EventBodySize)
+    {
+      return Models::EventData{std::vector<uint8_t>(bodySize, 'e')};
+    }
+
+    size_t NumberOfEvents(EventDataBatch const& batch)
+    {
+      // NumberOfEvents isn't const, so count the events of a copy.
+      return EventDataBatch{batch}.NumberOfEvents();
+    }
+
+    // Stands in for the ProducerClient. Batches sent asynchronously are settled right away with
+    // AsyncStatus unless HoldBatches is set, in which case they wait for Settle.
+    struct FakeSender final
+    {
+      std::mutex Lock;
+      std::condition_variable Changed;
+      // The number of events of each batch sent asynchronously, and synchronously.
+      std::vector<size_t> SentBatches;
+      std::vector<size_t> RetriedBatches;
+      std::vector<MessageSender::MessageSendResultCallback> HeldBatches;
+      bool HoldBatches{false};
+      MessageSendStatus AsyncStatus{MessageSendStatus::Ok};
+      bool FailSendAsync{false};
+      bool FailSend{false};
+
+      BufferedPartitionPublisher::BatchSender Sender()
+      {
+        BufferedPartitionPublisher::BatchSender sender;
+        sender.CreateBatch = [](EventDataBatchOptions const& options) {
+          EventDataBatchOptions batchOptions{options};
+          batchOptions.MaxBytes = BatchMaxBytes;
+          return _detail::EventDataBatchFactory::CreateEventDataBatch(batchOptions);
+        };
+        sender.SendAsync = [this](
+                               EventDataBatch const& batch,
+                               MessageSender::MessageSendResultCallback onSendComplete) {
+          MessageSendStatus status;
+          {
+            std::lock_guard<std::mutex> lock(Lock);
+            if (FailSendAsync)
+            {
+              throw std::runtime_error("The link is detached.");
+            }
+            SentBatches.push_back(NumberOfEvents(batch));
+            Changed.notify_all();
+            if (HoldBatches)
+            {
+              HeldBatches.push_back(std::move(onSendComplete));
+              return;
+            }
+            status = AsyncStatus;
+          }
+          onSendComplete(status, {});
+        };
+        sender.Send = [this](EventDataBatch const& batch) {
+          std::lock_guard<std::mutex> lock(Lock);
+          if (FailSend)
+          {
+            throw std::runtime_error("The batch could not be sent.");
+          }
+          RetriedBatches.push_back(NumberOfEvents(batch));
+        };
+        return sender;
+      }
+
+      void Settle(MessageSendStatus status)
+      {
+        std::vector<MessageSender::MessageSendResultCallback> held;
+        {
+          std::lock_guard<std::mutex> lock(Lock);
+          held.swap(HeldBatches);
+        }
+        for (auto& onSendComplete : held)
+        {
+          onSendComplete(status, {});
+        }
+      }
+
+      bool WaitForBatches(size_t count)
+      {
+        std::unique_lock<std::mutex> lock(Lock);
+        return Changed.wait_for(lock, WaitTimeout, [&]() { return SentBatches.size() >= count; });
+      }
+
+      std::vector<size_t> GetSentBatches()
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        return SentBatches;
+      }
+    };
+
+    // Records the events the publisher reports as sent or failed.
+    struct SendResults final
+    {
+      std::mutex Lock;
+      std::condition_variable Changed;
+      size_t Succeeded{};
+      size_t Failed{};
+      std::vector<std::string> Errors;
+
+      BufferedProducerClientOptions Options(Azure::DateTime::duration maxWaitTime)
+      {
+        BufferedProducerClientOptions options;
+        options.MaxWaitTime = maxWaitTime;
+        options.OnSendSucceeded
+            = [this](std::string const&, std::vector<Models::EventData> const& events) {
+                std::lock_guard<std::mutex> lock(Lock);
+                Succeeded += events.size();
+                Changed.notify_all();
+              };
+        options.OnSendFailed = [this](
+                                   std::string const&,
+                                   std::vector<Models::EventData> const& events,
+                                   std::exception const& error) {
+          std::lock_guard<std::mutex> lock(Lock);
+          Failed += events.size();
+          Errors.push_back(error.what());
+          Changed.notify_all();
+        };
+        return options;
+      }
+
+      bool WaitForSettled(size_t count)
+      {
+        std::unique_lock<std::mutex> lock(Lock);
+        return Changed.wait_for(
+            lock, WaitTimeout, [&]() { return Succeeded + Failed >= count; });
+      }
+    };
+  } // namespace
+
+  TEST(BufferedPartitionPublisherTest, BatchSizeOfTheTests)
+  {
+    EventDataBatchOptions options;
+    options.MaxBytes = BatchMaxBytes;
+    auto batch{_detail::EventDataBatchFactory::CreateEventDataBatch(options)};
+    EXPECT_TRUE(batch.TryAdd(MakeEvent()));
+    EXPECT_TRUE(batch.TryAdd(MakeEvent()));
+    EXPECT_FALSE(batch.TryAdd(MakeEvent()));
+  }
+
+  TEST(BufferedPartitionPublisherTest, SendsBatchAfterMaxWaitTime)
+  {
+    FakeSender sender;
+    SendResults results;
+    BufferedPartitionPublisher publisher(
+        sender.Sender(), "0", results.Options(std::chrono::milliseconds(50)));
+
+    publisher.Enqueue(MakeEvent(), {}, {});
+    ASSERT_TRUE(sender.WaitForBatches(1));
+    ASSERT_TRUE(results.WaitForSettled(1));
+    EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{1});
+    EXPECT_EQ(results.Succeeded, 1U);
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(publisher.GetBufferedEventCount(), 0U);
+  }
+
+  TEST(BufferedPartitionPublisherTest, WaitsForMaxWaitTimeOrFlush)
+  {
+    FakeSender sender;
+    SendResults results;
+    BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+
+    publisher.Enqueue(MakeEvent(), {}, {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(sender.GetSentBatches().empty());
+    EXPECT_EQ(publisher.GetBufferedEventCount(), 1U);
+
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{1});
+    EXPECT_EQ(results.Succeeded, 1U);
+  }
+
+  TEST(BufferedPartitionPublisherTest, SendsFullBatch)
+  {
+    FakeSender sender;
+    SendResults results;
+    BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+
+    // The third event doesn't fit, so the first two are sent without waiting and the third one
+    // starts a new batch.
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.Enqueue(MakeEvent(), {}, {});
+    ASSERT_TRUE(results.WaitForSettled(2));
+    EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{2});
+
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(sender.GetSentBatches(), (std::vector<size_t>{2, 1}));
+    EXPECT_EQ(results.Succeeded, 3U);
+  }
+
+  TEST(BufferedPartitionPublisherTest, EnqueueWaitsForRoomInTheBuffer)
+  {
+    FakeSender sender;
+    sender.HoldBatches = true;
+    SendResults results;
+    auto options{results.Options(std::chrono::milliseconds(1))};
+    options.MaxBufferedEventsPerPartition = 2;
+    BufferedPartitionPublisher publisher(sender.Sender(), "0", options);
+
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.Enqueue(MakeEvent(), {}, {});
+    ASSERT_TRUE(sender.WaitForBatches(1));
+
+    // The events which are in flight still take room in the buffer.
+    EXPECT_EQ(publisher.GetBufferedEventCount(), 2U);
+    auto const context = Azure::Core::Context{}.WithDeadline(
+        std::chrono::system_clock::now() + std::chrono::milliseconds(300));
+    EXPECT_THROW(
+        publisher.Enqueue(MakeEvent(), {}, context), Azure::Core::OperationCancelledException);
+    EXPECT_EQ(publisher.GetBufferedEventCount(), 2U);
+
+    // Settling the batches makes room for the next event.
+    std::thread settler([&sender]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      sender.Settle(MessageSendStatus::Ok);
+    });
+    publisher.Enqueue(MakeEvent(), {}, {});
+    settler.join();
+    EXPECT_EQ(results.Succeeded, 2U);
+
+    sender.HoldBatches = false;
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(results.Succeeded, 3U);
+  }
+
+  TEST(BufferedPartitionPublisherTest, StopSendsBufferedEvents)
+  {
+    FakeSender sender;
+    SendResults results;
+    {
+      BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+      publisher.Enqueue(MakeEvent(), {}, {});
+      publisher.Stop();
+      EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{1});
+      EXPECT_EQ(results.Succeeded, 1U);
+      EXPECT_THROW(publisher.Enqueue(MakeEvent(), {}, {}), std::runtime_error);
+    }
+
+    // The destructor waits for the batches in flight to be settled.
+    sender.HoldBatches = true;
+    std::thread settler;
+    {
+      BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+      publisher.Enqueue(MakeEvent(), {}, {});
+      publisher.Enqueue(MakeEvent(), {}, {});
+      publisher.Enqueue(MakeEvent(), {}, {});
+      settler = std::thread([&sender]() {
+        EXPECT_TRUE(sender.WaitForBatches(3));
+        sender.Settle(MessageSendStatus::Ok);
+      });
+    }
+    settler.join();
+    EXPECT_EQ(sender.GetSentBatches(), (std::vector<size_t>{1, 2, 1}));
+    EXPECT_EQ(results.Succeeded, 4U);
+    EXPECT_EQ(results.Failed, 0U);
+  }
+
+  TEST(BufferedPartitionPublisherTest, RetriesFailedBatch)
+  {
+    FakeSender sender;
+    sender.AsyncStatus = MessageSendStatus::Error;
+    SendResults results;
+    BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+
+    // A batch which failed asynchronously is sent again synchronously.
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{2});
+    EXPECT_EQ(sender.RetriedBatches, std::vector<size_t>{2});
+    EXPECT_EQ(results.Succeeded, 2U);
+
+    // So is a batch which could not be sent asynchronously.
+    sender.FailSendAsync = true;
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(sender.RetriedBatches, (std::vector<size_t>{2, 1}));
+    EXPECT_EQ(results.Succeeded, 3U);
+
+    // The events are reported as failed when the retry fails too.
+    sender.FailSendAsync = false;
+    sender.FailSend = true;
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(results.Succeeded, 3U);
+    EXPECT_EQ(results.Failed, 1U);
+    ASSERT_EQ(results.Errors.size(), 1U);
+    EXPECT_EQ(results.Errors[0], "The batch could not be sent.");
+  }
+
+  TEST(BufferedPartitionPublisherTest, RejectsEventLargerThanBatch)
+  {
+    FakeSender sender;
+    SendResults results;
+    BufferedPartitionPublisher publisher(sender.Sender(), "0", results.Options(NoLinger));
+
+    publisher.Enqueue(MakeEvent(BatchMaxBytes), {}, {});
+    publisher.WaitUntilSettled({});
+    EXPECT_EQ(results.Failed, 1U);
+    ASSERT_EQ(results.Errors.size(), 1U);
+    EXPECT_EQ(results.Errors[0], "The event is larger than the maximum message size.");
+    EXPECT_EQ(publisher.GetBufferedEventCount(), 0U);
+
+    // The events enqueued next are sent as usual.
+    publisher.Enqueue(MakeEvent(), {}, {});
+    publisher.RequestFlush();
+    publisher.WaitUntilSettled({});
+    EXPECT_TRUE(sender.RetriedBatches.empty());
+    EXPECT_EQ(sender.GetSentBatches(), std::vector<size_t>{1});
+    EXPECT_EQ(results.Succeeded, 1U);
+  }
+}}}} // namespace Azure::Messaging::EventHubs::Test
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "../src/private/eventhubs_constants.hpp"
+#include "../src/private/eventhubs_utilities.hpp"
 #include "azure/messaging/eventhubs.hpp"
 #include "eventhubs_test_base.hpp"
 
@@ -292,4 +293,55 @@ TEST_F(EventDataTest, ReceivedEventData)
     EXPECT_FALSE(receivedEventData.EnqueuedTime);
     EXPECT_FALSE(receivedEventData.PartitionKey);
   }
-}
\ No newline at end of file
+}
+
+// Events added to a batch are serialized into a single encoded body, which is exactly the body of
+// the batched message.
+TEST_F(EventDataTest, EventDataBatchEncodedBody)
+{
+  Azure::Messaging::EventHubs::EventDataBatchOptions batchOptions;
+  batchOptions.MaxBytes = 4096;
+  batchOptions.PartitionKey = "key";
+  auto batch{Azure::Messaging::EventHubs::_detail::EventDataBatchFactory::CreateEventDataBatch(
+      batchOptions)};
+
+  std::vector<EventData> events;
+  for (size_t i = 0; i < 100; i += 1)
+  {
+    EventData eventData;
+    eventData.Body = std::vector<uint8_t>((i + 1) * 10, 'a');
+    eventData.MessageId = Azure::Core::Amqp::Models::AmqpValue(std::to_string(i));
+    if (!batch.TryAdd(eventData))
+    {
+      break;
+    }
+    events.push_back(eventData);
+  }
+  EXPECT_EQ(batch.NumberOfEvents(), events.size());
+  EXPECT_GT(events.size(), 10ul);
+  EXPECT_LT(events.size(), 100ul);
+
+  auto message = batch.ToAmqpMessage();
+  EXPECT_EQ(message.MessageFormat, 0x80013700);
+  EXPECT_EQ(
+      static_cast<std::string>(message.DeliveryAnnotations
+                                   [Azure::Messaging::EventHubs::_detail::PartitionKeyAnnotation]),
+      "key");
+  ASSERT_EQ(message.GetBodyAsBinary().size(), events.size());
+  for (size_t i = 0; i < events.size(); i += 1)
+  {
+    auto const& body = message.GetBodyAsBinary()[i];
+    auto event = AmqpMessage::Deserialize(body.data(), body.size());
+    EXPECT_EQ(event.Properties.MessageId.Value(), events[i].MessageId.Value());
+    EXPECT_EQ(event.GetBodyAsBinary()[0], AmqpBinaryData(events[i].Body));
+  }
+
+  // The serialized batch ends with the encoded body, and fits in the batch.
+  auto serialized = AmqpMessage::Serialize(message);
+  auto const& encodedBody
+      = Azure::Messaging::EventHubs::_detail::EventDataBatchFactory::GetEncodedBody(batch);
+  ASSERT_LE(encodedBody.size(), serialized.size());
+  EXPECT_TRUE(std::equal(encodedBody.rbegin(), encodedBody.rend(), serialized.rbegin()));
+  EXPECT_LE(serialized.size(), batchOptions.MaxBytes.Value());
+  EXPECT_GT(serialized.size() + events.size() * 10 + 20, batchOptions.MaxBytes.Value());
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// cspell: words hashlittle FWfAT sOdeEAsyQoEuEFPGerWO
+
+#include "eventhubs_test_base.hpp"
+#include "private/partition_resolver.hpp"
+
+#include <cstring>
+#include <map>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
+  class PartitionResolverTest : public EventHubsTestBase {
+  };
+
+  TEST_F(PartitionResolverTest, ComputeHash)
+  {
+    // Reference values from lookup3.c, which computes the hashes with hashlittle2.
+    auto const hash = [](char const* data, std::uint32_t seed1, std::uint32_t seed2) {
+      std::uint32_t hash1;
+      std::uint32_t hash2;
+      _detail::PartitionResolver::ComputeHash(
+          reinterpret_cast<std::uint8_t const*>(data),
+          std::strlen(data),
+          seed1,
+          seed2,
+          hash1,
+          hash2);
+      return std::make_pair(hash1, hash2);
+    };
+    EXPECT_EQ(std::make_pair(0xdeadbeefu, 0xdeadbeefu), hash("", 0, 0));
+    auto const text = "Four score and seven years ago";
+    EXPECT_EQ(std::make_pair(0x17770551u, 0xce7226e6u), hash(text, 0, 0));
+    EXPECT_EQ(std::make_pair(0xe3607caeu, 0xbd371de4u), hash(text, 0, 1));
+    EXPECT_EQ(std::make_pair(0xcd628161u, 0x6cbea4b3u), hash(text, 1, 0));
+  }
+
+  TEST_F(PartitionResolverTest, GenerateHashCode)
+  {
+    // Hash codes the service computes for these partition keys.
+    EXPECT_EQ(-15263, _detail::PartitionResolver::GenerateHashCode("7"));
+    EXPECT_EQ(30562, _detail::PartitionResolver::GenerateHashCode("131"));
+    EXPECT_EQ(12977, _detail::PartitionResolver::GenerateHashCode("7149583486996073602"));
+    EXPECT_EQ(-22341, _detail::PartitionResolver::GenerateHashCode("FWfAT"));
+    EXPECT_EQ(-6503, _detail::PartitionResolver::GenerateHashCode("sOdeEAsyQoEuEFPGerWO"));
+  }
+
+  TEST_F(PartitionResolverTest, AssignForPartitionKey)
+  {
+    std::vector<std::string> const partitions{"0", "1", "2", "3", "4", "5", "6", "7"};
+    // -15263 % 8 is -7.
+    EXPECT_EQ("7", _detail::PartitionResolver::AssignForPartitionKey("7", partitions));
+    // 30562 % 8 is 2.
+    EXPECT_EQ("2", _detail::PartitionResolver::AssignForPartitionKey("131", partitions));
+    EXPECT_EQ(
+        _detail::PartitionResolver::AssignForPartitionKey("FWfAT", partitions),
+        _detail::PartitionResolver::AssignForPartitionKey("FWfAT", partitions));
+
+    EXPECT_THROW(
+        _detail::PartitionResolver::AssignForPartitionKey("7", {}), std::invalid_argument);
+  }
+
+  TEST_F(PartitionResolverTest, AssignRoundRobin)
+  {
+    std::vector<std::string> const partitions{"0", "1", "2"};
+    _detail::PartitionResolver resolver;
+    std::map<std::string, int> assigned;
+    for (int i = 0; i < 30; i += 1)
+    {
+      assigned[resolver.AssignRoundRobin(partitions)] += 1;
+    }
+    EXPECT_EQ((std::map<std::string, int>{{"0", 10}, {"1", 10}, {"2", 10}}), assigned);
+  }
+}}}} // namespace Azure::Messaging::EventHubs::Test
@@ -9,7 +9,11 @@
 #include <azure/identity.hpp>
 #include <azure/messaging/eventhubs.hpp>
 
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -112,6 +116,87 @@ namespace Azure { namespace Messaging { namespace EventHubs { namespace Test {
     client->Send({{12, 13, 14, 15}, {16, 17, 18, 19}});
   }
 
+  TEST_P(ProducerClientTest, BufferedProducer_LIVEONLY_)
+  {
+    std::shared_ptr<Azure::Messaging::EventHubs::ProducerClient> client{CreateProducerClient()};
+
+    std::mutex lock;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    std::map<std::string, std::set<std::string>> partitionsByKey;
+
+    Azure::Messaging::EventHubs::BufferedProducerClientOptions options;
+    options.MaxWaitTime = std::chrono::milliseconds(100);
+    options.MaxBufferedEventsPerPartition = 50;
+    options.OnSendSucceeded
+        = [&](std::string const& partitionId,
+              std::vector<Azure::Messaging::EventHubs::Models::EventData> const& events) {
+            std::lock_guard<std::mutex> guard(lock);
+            succeeded += events.size();
+            for (auto const& event : events)
+            {
+              auto key = event.Properties.find("key");
+              if (key != event.Properties.end())
+              {
+                partitionsByKey[static_cast<std::string>(key->second)].insert(partitionId);
+              }
+            }
+          };
+    options.OnSendFailed = [&](std::string const&,
+                               std::vector<Azure::Messaging::EventHubs::Models::EventData> const&
+                                   events,
+                               std::exception const& error) {
+      std::lock_guard<std::mutex> guard(lock);
+      GTEST_LOG_(INFO) << "Send failed: " << error.what();
+      failed += events.size();
+    };
+
+    constexpr size_t threadCount = 4;
+    constexpr size_t eventsPerThread = 250;
+    {
+      Azure::Messaging::EventHubs::BufferedProducerClient producer{client, options};
+      std::vector<std::thread> threads;
+      for (size_t thread = 0; thread < threadCount; thread += 1)
+      {
+        threads.emplace_back([&producer, thread]() {
+          for (size_t i = 0; i < eventsPerThread; i += 1)
+          {
+            Azure::Messaging::EventHubs::Models::EventData event{"Buffered event"};
+            Azure::Messaging::EventHubs::EnqueueEventOptions enqueueOptions;
+            if (i % 2 == 0)
+            {
+              enqueueOptions.PartitionKey = "key-" + std::to_string(i % 10);
+              event.Properties.emplace(
+                  "key", Azure::Core::Amqp::Models::AmqpValue{enqueueOptions.PartitionKey});
+            }
+            producer.Enqueue(std::move(event), enqueueOptions);
+          }
+          GTEST_LOG_(INFO) << "Thread " << thread << " enqueued its events.";
+        });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      producer.Flush();
+      EXPECT_EQ(0u, producer.GetBufferedEventCount());
+      producer.Close();
+      EXPECT_THROW(
+          producer.Enqueue(Azure::Messaging::EventHubs::Models::EventData{"Closed"}),
+          std::runtime_error);
+    }
+
+    EXPECT_EQ(threadCount * eventsPerThread, succeeded);
+    EXPECT_EQ(0u, failed);
+    // Events with the same partition key are all sent to the same partition.
+    EXPECT_EQ(5u, partitionsByKey.size());
+    for (auto const& partitions : partitionsByKey)
+    {
+      EXPECT_EQ(1u, partitions.second.size()) << partitions.first;
+    }
+  }
+
   TEST_P(ProducerClientTest, GetEventHubProperties_LIVEONLY_)
   {
     Azure::Messaging::EventHubs::ProducerClientOptions producerOptions;
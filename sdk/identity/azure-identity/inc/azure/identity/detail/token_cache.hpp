@@ -58,12 +58,17 @@ namespace Azure { namespace Identity { namespace _detail {
     {
       Core::Credentials::AccessToken AccessToken;
       std::shared_timed_mutex ElementMutex;
+      // Set while a thread gets a new token without holding ElementMutex, so that the other threads
+      // keep using the current one. Protected by ElementMutex.
+      bool IsRefreshing = false;
     };
 
     mutable std::map<CacheKey, std::shared_ptr<CacheValue>, CacheKeyComparator> m_cache;
     mutable std::shared_timed_mutex m_cacheMutex;
 
   private:
+    bool m_serveStaleTokenWhileRefreshing;
+
     TokenCache(TokenCache const&) = delete;
     TokenCache& operator=(TokenCache const&) = delete;
 
@@ -79,7 +84,18 @@ namespace Azure { namespace Identity { namespace _detail {
         DateTime::duration minimumExpiration) const;
 
   public:
-    TokenCache() = default;
+    /**
+     * @brief Constructs the token cache.
+     *
+     * @param serveStaleTokenWhileRefreshing When `true`, a token that is not fresh anymore, but
+     * did not expire yet, is returned to the callers while one of them gets a new one, instead of
+     * blocking all of them until the new token is received.
+     *
+     */
+    explicit TokenCache(bool serveStaleTokenWhileRefreshing = false)
+        : m_serveStaleTokenWhileRefreshing(serveStaleTokenWhileRefreshing)
+    {
+    }
     ~TokenCache() = default;
 
     /**
@@ -82,10 +82,10 @@ AzureCliCredential::AzureCliCredential(
     DateTime::duration cliProcessTimeout,
     std::vector<std::string> additionallyAllowedTenants)
     : TokenCredential("AzureCliCredential"),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing),
       m_additionallyAllowedTenants(std::move(additionallyAllowedTenants)),
       m_tenantId(std::move(tenantId)), m_cliProcessTimeout(std::move(cliProcessTimeout))
 {
-  static_cast<void>(options);
 
   IdentityLog::Write(
       IdentityLog::Level::Informational,
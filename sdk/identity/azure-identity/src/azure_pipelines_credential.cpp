@@ -62,7 +62,8 @@ AzurePipelinesCredential::AzurePipelinesCredential(
     : TokenCredential("AzurePipelinesCredential"), m_serviceConnectionId(serviceConnectionId),
       m_systemAccessToken(systemAccessToken),
       m_clientCredentialCore(tenantId, options.AuthorityHost, options.AdditionallyAllowedTenants),
-      m_httpPipeline(HttpPipeline(options, "identity", PackageVersion::ToString(), {}, {}))
+      m_httpPipeline(HttpPipeline(options, "identity", PackageVersion::ToString(), {}, {})),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing)
 {
   m_oidcRequestUrl = _detail::DefaultOptionValues::GetOidcRequestUrl();
 
@@ -385,6 +385,7 @@ ClientCertificateCredential::ClientCertificateCredential(
     std::vector<std::string> additionallyAllowedTenants,
     Core::Credentials::TokenCredentialOptions const& options)
     : TokenCredential("ClientCertificateCredential"),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing),
       m_clientCredentialCore(tenantId, authorityHost, additionallyAllowedTenants),
       m_tokenCredentialImpl(std::make_unique<TokenCredentialImpl>(options)),
       m_requestBody(
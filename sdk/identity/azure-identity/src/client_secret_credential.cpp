@@ -25,6 +25,7 @@ ClientSecretCredential::ClientSecretCredential(
     std::vector<std::string> additionallyAllowedTenants,
     Core::Credentials::TokenCredentialOptions const& options)
     : TokenCredential("ClientSecretCredential"),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing),
       m_clientCredentialCore(tenantId, authorityHost, additionallyAllowedTenants),
       m_tokenCredentialImpl(std::make_unique<TokenCredentialImpl>(options)),
       m_requestBody(
@@ -39,7 +39,8 @@ namespace Azure { namespace Identity { namespace _detail {
         std::string authorityHost,
         Core::Credentials::TokenCredentialOptions const& options)
         : TokenCredentialImpl(options), m_clientId(std::move(clientId)),
-          m_authorityHost(std::move(authorityHost))
+          m_authorityHost(std::move(authorityHost)),
+          m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing)
     {
     }
 
@@ -72,7 +72,7 @@ std::shared_ptr<TokenCache::CacheValue> TokenCache::GetOrCreateValue(
       auto const item = curr->second;
       {
         std::unique_lock<std::shared_timed_mutex> lock(item->ElementMutex, std::defer_lock);
-        if (lock.try_lock() && !IsFresh(item, minimumExpiration, now))
+        if (lock.try_lock() && !item->IsRefreshing && !IsFresh(item, minimumExpiration, now))
         {
           m_cache.erase(curr);
         }
@@ -114,6 +114,36 @@ AccessToken TokenCache::GetToken(
     return item->AccessToken;
   }
 
+  if (m_serveStaleTokenWhileRefreshing
+      && item->AccessToken.ExpiresOn > DateTime(std::chrono::system_clock::now()))
+  {
+    // The current token is still valid: let the other threads use it while this one gets a new
+    // token.
+    if (item->IsRefreshing)
+    {
+      return item->AccessToken;
+    }
+    item->IsRefreshing = true;
+    itemWriteLock.unlock();
+
+    AccessToken newToken;
+    try
+    {
+      newToken = getNewToken();
+    }
+    catch (...)
+    {
+      itemWriteLock.lock();
+      item->IsRefreshing = false;
+      throw;
+    }
+
+    itemWriteLock.lock();
+    item->IsRefreshing = false;
+    item->AccessToken = newToken;
+    return newToken;
+  }
+
   auto const newToken = getNewToken();
   item->AccessToken = newToken;
   return newToken;
@@ -27,10 +27,12 @@ using Azure::Identity::_detail::TokenCredentialImpl;
 
 WorkloadIdentityCredential::WorkloadIdentityCredential(
     WorkloadIdentityCredentialOptions const& options)
-    : TokenCredential("WorkloadIdentityCredential"), m_clientCredentialCore(
-                                                         options.TenantId,
-                                                         options.AuthorityHost,
-                                                         options.AdditionallyAllowedTenants)
+    : TokenCredential("WorkloadIdentityCredential"),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing),
+      m_clientCredentialCore(
+          options.TenantId,
+          options.AuthorityHost,
+          options.AdditionallyAllowedTenants)
 {
   std::string tenantId = options.TenantId;
   std::string clientId = options.ClientId;
@@ -65,6 +67,7 @@ WorkloadIdentityCredential::WorkloadIdentityCredential(
 WorkloadIdentityCredential::WorkloadIdentityCredential(
     Core::Credentials::TokenCredentialOptions const& options)
     : TokenCredential("WorkloadIdentityCredential"),
+      m_tokenCache(options.TokenRefresh.ServeStaleTokenWhileRefreshing),
       m_clientCredentialCore("", "", std::vector<std::string>())
 {
   std::string const tenantId = _detail::DefaultOptionValues::GetTenantId();
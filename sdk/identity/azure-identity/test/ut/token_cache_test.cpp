@@ -4,7 +4,10 @@
 #include "azure/identity/client_secret_credential.hpp"
 #include "azure/identity/detail/token_cache.hpp"
 
+#include <future>
 #include <mutex>
+#include <stdexcept>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -15,6 +18,8 @@ using Azure::Identity::_detail::TokenCache;
 namespace {
 class TestableTokenCache final : public TokenCache {
 public:
+  using TokenCache::TokenCache;
+
   using TokenCache::CacheValue;
   using TokenCache::m_cache;
   using TokenCache::m_cacheMutex;
@@ -355,6 +360,66 @@ TEST(TokenCache, MinimumExpiration)
   EXPECT_EQ(token2.Token, "T2");
 }
 
+TEST(TokenCache, ServeStaleTokenWhileRefreshing)
+{
+  TestableTokenCache tokenCache(true);
+
+  DateTime const InOneHour = std::chrono::system_clock::now() + 1h;
+  DateTime const Tomorrow = std::chrono::system_clock::now() + 24h;
+
+  static_cast<void>(tokenCache.GetToken("A", {}, 2min, [=]() {
+    AccessToken result;
+    result.Token = "T1";
+    result.ExpiresOn = InOneHour;
+    return result;
+  }));
+
+  // T1 is not fresh for a minimum expiration of 2 hours, but it is still valid.
+  std::promise<void> refreshStarted;
+  std::promise<void> allowRefresh;
+  auto refresh = std::async(std::launch::async, [&]() {
+    return tokenCache.GetToken("A", {}, 2h, [&]() {
+      refreshStarted.set_value();
+      allowRefresh.get_future().wait();
+      AccessToken result;
+      result.Token = "T2";
+      result.ExpiresOn = Tomorrow;
+      return result;
+    });
+  });
+  refreshStarted.get_future().wait();
+
+  auto const staleToken = tokenCache.GetToken("A", {}, 2h, [=]() {
+    EXPECT_FALSE("getNewToken does not get invoked while another thread is refreshing the token");
+    return AccessToken();
+  });
+  EXPECT_EQ(staleToken.Token, "T1");
+
+  allowRefresh.set_value();
+  EXPECT_EQ(refresh.get().Token, "T2");
+
+  auto const newToken = tokenCache.GetToken("A", {}, 2h, [=]() {
+    EXPECT_FALSE("getNewToken does not get invoked when the existing cache value is good");
+    return AccessToken();
+  });
+  EXPECT_EQ(newToken.Token, "T2");
+
+  // A failed refresh lets the next caller try again.
+  tokenCache.m_cache[{"A", {}}]->AccessToken.ExpiresOn = InOneHour;
+  EXPECT_THROW(
+      static_cast<void>(tokenCache.GetToken(
+          "A", {}, 2h, []() -> AccessToken { throw std::runtime_error("refresh failed"); })),
+      std::runtime_error);
+  EXPECT_FALSE((tokenCache.m_cache[{"A", {}}]->IsRefreshing));
+  auto const retriedToken = tokenCache.GetToken("A", {}, 2h, [=]() {
+    AccessToken result;
+    result.Token = "T3";
+    result.ExpiresOn = Tomorrow;
+    return result;
+  });
+  EXPECT_EQ(retriedToken.Token, "T3");
+}
+
 TEST(TokenCache, MultithreadedAccess)
 {
   TestableTokenCache tokenCache;
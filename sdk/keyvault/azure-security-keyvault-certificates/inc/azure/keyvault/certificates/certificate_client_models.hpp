@@ -1306,6 +1306,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
     std::string m_certificateName;
     std::shared_ptr<CertificateClient> m_certificateClient;
     void OnNextPage(const Azure::Core::Context&);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     /**
      * @brief Construct a new Certificate Properties Single Page object.
@@ -1359,6 +1360,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
 
     std::shared_ptr<CertificateClient> m_certificateClient;
     void OnNextPage(const Azure::Core::Context&);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     IssuerPropertiesPagedResponse(
         IssuerPropertiesPagedResponse&& issuerProperties,
@@ -1397,6 +1399,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
 
     std::shared_ptr<CertificateClient> m_certificateClient;
     void OnNextPage(const Azure::Core::Context&);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     DeletedCertificatesPagedResponse(
         DeletedCertificatesPagedResponse&& deletedProperties,
@@ -40,6 +40,35 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
     }
   }
 
+  CertificatePropertiesPagedResponse::PageFetcher
+  CertificatePropertiesPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto certificateClient = m_certificateClient;
+    auto certificateName = m_certificateName;
+    auto nextPageToken = NextPageToken;
+    return [certificateClient, certificateName, nextPageToken](
+               const Azure::Core::Context& context) {
+      std::unique_ptr<CertificatePropertiesPagedResponse> page;
+      if (certificateName.empty())
+      {
+        GetPropertiesOfCertificatesOptions options;
+        options.NextPageToken = nextPageToken;
+        page = std::make_unique<CertificatePropertiesPagedResponse>(
+            certificateClient->GetPropertiesOfCertificates(options, context));
+      }
+      else
+      {
+        GetPropertiesOfCertificateVersionsOptions options;
+        options.NextPageToken = nextPageToken;
+        page = std::make_unique<CertificatePropertiesPagedResponse>(
+            certificateClient->GetPropertiesOfCertificateVersions(
+                certificateName, options, context));
+      }
+      page->CurrentPageToken = nextPageToken.Value();
+      return page;
+    };
+  }
+
   void IssuerPropertiesPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     GetPropertiesOfIssuersOptions options;
@@ -48,6 +77,20 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
     CurrentPageToken = options.NextPageToken.Value();
   }
 
+  IssuerPropertiesPagedResponse::PageFetcher IssuerPropertiesPagedResponse::OnGetNextPageFetcher()
+      const
+  {
+    auto certificateClient = m_certificateClient;
+    GetPropertiesOfIssuersOptions options;
+    options.NextPageToken = NextPageToken;
+    return [certificateClient, options](const Azure::Core::Context& context) {
+      auto page = std::make_unique<IssuerPropertiesPagedResponse>(
+          certificateClient->GetPropertiesOfIssuers(options, context));
+      page->CurrentPageToken = options.NextPageToken.Value();
+      return page;
+    };
+  }
+
   void DeletedCertificatesPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     GetDeletedCertificatesOptions options;
@@ -56,4 +99,18 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Certificat
     CurrentPageToken = options.NextPageToken.Value();
   }
 
+  DeletedCertificatesPagedResponse::PageFetcher
+  DeletedCertificatesPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto certificateClient = m_certificateClient;
+    GetDeletedCertificatesOptions options;
+    options.NextPageToken = NextPageToken;
+    return [certificateClient, options](const Azure::Core::Context& context) {
+      auto page = std::make_unique<DeletedCertificatesPagedResponse>(
+          certificateClient->GetDeletedCertificates(options, context));
+      page->CurrentPageToken = options.NextPageToken.Value();
+      return page;
+    };
+  }
+
 }}}} // namespace Azure::Security::KeyVault::Certificates
@@ -735,6 +735,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Keys {
     std::string m_keyName;
     std::shared_ptr<KeyClient> m_keyClient;
     void OnNextPage(const Azure::Core::Context&);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     /**
      * @brief Construct a new Key Properties Single Page object.
@@ -785,6 +786,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Keys {
 
     std::shared_ptr<KeyClient> m_keyClient;
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     /**
      * @brief Construct a new Key Properties Single Page object.
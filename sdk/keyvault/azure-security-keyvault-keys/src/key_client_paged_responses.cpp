@@ -140,6 +140,19 @@ void DeletedKeyPagedResponse::OnNextPage(const Azure::Core::Context& context)
   CurrentPageToken = options.NextPageToken.Value();
 }
 
+DeletedKeyPagedResponse::PageFetcher DeletedKeyPagedResponse::OnGetNextPageFetcher() const
+{
+  auto keyClient = m_keyClient;
+  GetDeletedKeysOptions options;
+  options.NextPageToken = NextPageToken;
+  return [keyClient, options](const Azure::Core::Context& context) {
+    auto page = std::make_unique<DeletedKeyPagedResponse>(
+        keyClient->GetDeletedKeys(options, context));
+    page->CurrentPageToken = options.NextPageToken.Value();
+    return page;
+  };
+}
+
 void KeyPropertiesPagedResponse::OnNextPage(const Azure::Core::Context& context)
 {
   // Notes
@@ -165,3 +178,29 @@ void KeyPropertiesPagedResponse::OnNextPage(const Azure::Core::Context& context)
     CurrentPageToken = options.NextPageToken.Value();
   }
 }
+
+KeyPropertiesPagedResponse::PageFetcher KeyPropertiesPagedResponse::OnGetNextPageFetcher() const
+{
+  auto keyClient = m_keyClient;
+  auto keyName = m_keyName;
+  auto nextPageToken = NextPageToken;
+  return [keyClient, keyName, nextPageToken](const Azure::Core::Context& context) {
+    std::unique_ptr<KeyPropertiesPagedResponse> page;
+    if (keyName.empty())
+    {
+      GetPropertiesOfKeysOptions options;
+      options.NextPageToken = nextPageToken;
+      page = std::make_unique<KeyPropertiesPagedResponse>(
+          keyClient->GetPropertiesOfKeys(options, context));
+    }
+    else
+    {
+      GetPropertiesOfKeyVersionsOptions options;
+      options.NextPageToken = nextPageToken;
+      page = std::make_unique<KeyPropertiesPagedResponse>(
+          keyClient->GetPropertiesOfKeyVersions(keyName, options, context));
+    }
+    page->CurrentPageToken = nextPageToken.Value();
+    return page;
+  };
+}
@@ -35,6 +35,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
     std::shared_ptr<SecretClient> m_secretClient;
 
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     SecretPropertiesPagedResponse(
         SecretPropertiesPagedResponse&& secretProperties,
@@ -74,6 +75,7 @@ namespace Azure { namespace Security { namespace KeyVault { namespace Secrets {
 
     std::shared_ptr<SecretClient> m_secretClient;
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     DeletedSecretPagedResponse(
         DeletedSecretPagedResponse&& deletedKeyProperties,
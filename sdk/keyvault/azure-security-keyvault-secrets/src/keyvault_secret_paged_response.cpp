@@ -32,6 +32,33 @@ void SecretPropertiesPagedResponse::OnNextPage(const Azure::Core::Context& conte
   }
 }
 
+SecretPropertiesPagedResponse::PageFetcher SecretPropertiesPagedResponse::OnGetNextPageFetcher()
+    const
+{
+  auto secretClient = m_secretClient;
+  auto secretName = m_secretName;
+  auto nextPageToken = NextPageToken;
+  return [secretClient, secretName, nextPageToken](const Azure::Core::Context& context) {
+    std::unique_ptr<SecretPropertiesPagedResponse> page;
+    if (secretName.empty())
+    {
+      GetPropertiesOfSecretsOptions options;
+      options.NextPageToken = nextPageToken;
+      page = std::make_unique<SecretPropertiesPagedResponse>(
+          secretClient->GetPropertiesOfSecrets(options, context));
+    }
+    else
+    {
+      GetPropertiesOfSecretVersionsOptions options;
+      options.NextPageToken = nextPageToken;
+      page = std::make_unique<SecretPropertiesPagedResponse>(
+          secretClient->GetPropertiesOfSecretsVersions(secretName, options, context));
+    }
+    page->CurrentPageToken = nextPageToken.Value();
+    return page;
+  };
+}
+
 void DeletedSecretPagedResponse::OnNextPage(const Azure::Core::Context& context)
 {
   // Before calling `OnNextPage` pagedResponse validates there is a next page, so we are sure
@@ -41,3 +68,16 @@ void DeletedSecretPagedResponse::OnNextPage(const Azure::Core::Context& context)
   *this = m_secretClient->GetDeletedSecrets(options, context);
   CurrentPageToken = options.NextPageToken.Value();
 }
+
+DeletedSecretPagedResponse::PageFetcher DeletedSecretPagedResponse::OnGetNextPageFetcher() const
+{
+  auto secretClient = m_secretClient;
+  GetDeletedSecretsOptions options;
+  options.NextPageToken = NextPageToken;
+  return [secretClient, options](const Azure::Core::Context& context) {
+    auto page = std::make_unique<DeletedSecretPagedResponse>(
+        secretClient->GetDeletedSecrets(options, context));
+    page->CurrentPageToken = options.NextPageToken.Value();
+    return page;
+  };
+}
@@ -8,6 +8,7 @@
 #include "azure/storage/blobs/blob_service_client.hpp"
 #include "azure/storage/blobs/deferred_response.hpp"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,28 +16,6 @@
 namespace Azure { namespace Storage { namespace Blobs {
 
   namespace _detail {
-    extern const Core::Context::Key s_serviceBatchKey;
-    extern const Core::Context::Key s_containerBatchKey;
-
-    class StringBodyStream final : public Core::IO::BodyStream {
-    public:
-      explicit StringBodyStream(std::string content) : m_content(std::move(content)) {}
-      StringBodyStream(const StringBodyStream&) = delete;
-      StringBodyStream& operator=(const StringBodyStream&) = delete;
-      StringBodyStream(StringBodyStream&& other) = default;
-      StringBodyStream& operator=(StringBodyStream&& other) = default;
-      ~StringBodyStream() override {}
-      int64_t Length() const override { return m_content.length(); }
-      void Rewind() override { m_offset = 0; }
-
-    private:
-      size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
-
-    private:
-      std::string m_content;
-      size_t m_offset = 0;
-    };
-
     enum class BatchSubrequestType
     {
       DeleteBlob,
@@ -49,9 +28,31 @@ namespace Azure { namespace Storage { namespace Blobs {
       virtual ~BatchSubrequest() = 0;
 
       BatchSubrequestType Type;
+      // Set once the response or the exception of the subrequest is available. Completed
+      // subrequests aren't sent again.
+      bool Completed = false;
     };
 
-    class BlobBatchAccessHelper;
+    /**
+     * @brief Splits the subrequests that aren't completed yet into batches the service accepts.
+     */
+    std::vector<std::vector<BatchSubrequest*>> SplitBatchSubrequests(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests);
+
+    /**
+     * @brief Submits the subrequests that aren't completed yet, split into batches the service
+     * accepts, with up to \p options.Concurrency batch requests at the same time.
+     *
+     * @param submitFunc Sends a batch request with the body and the context it's given.
+     * @throw std::invalid_argument if all the subrequests are completed.
+     */
+    Response<Models::SubmitBlobBatchResult> SubmitBatchSubrequests(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests,
+        const SubmitBlobBatchOptions& options,
+        const Core::Context& context,
+        const std::function<Response<Models::_detail::SubmitBatchResult>(
+            Core::IO::BodyStream&,
+            const Core::Context&)>& submitFunc);
 
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> ConstructBatchRequestPolicy(
         const std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>&
@@ -139,7 +140,6 @@ namespace Azure { namespace Storage { namespace Blobs {
     std::vector<std::shared_ptr<_detail::BatchSubrequest>> m_subrequests;
 
     friend class BlobServiceClient;
-    friend class _detail::BlobBatchAccessHelper;
   };
 
   /**
@@ -211,7 +211,6 @@ namespace Azure { namespace Storage { namespace Blobs {
     std::vector<std::shared_ptr<_detail::BatchSubrequest>> m_subrequests;
 
     friend class BlobContainerClient;
-    friend class _detail::BlobBatchAccessHelper;
   };
 
 }}} // namespace Azure::Storage::Blobs
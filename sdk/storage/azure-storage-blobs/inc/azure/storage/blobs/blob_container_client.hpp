@@ -229,6 +229,20 @@ namespace Azure { namespace Storage { namespace Blobs {
         const ListBlobsOptions& options = ListBlobsOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Lists the blobs in this container with several request chains running at the same
+     * time. The listing is split across the virtual directories found while listing, or across
+     * the partitions in the options, and the blobs of every chain are returned by a single
+     * enumerator. Blobs are not ordered by name.
+     *
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A ListBlobsParallelEnumerator returning the blobs in the container.
+     */
+    ListBlobsParallelEnumerator ListBlobsParallel(
+        const ListBlobsParallelOptions& options = ListBlobsParallelOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Gets the permissions for this container. The permissions indicate whether
      * container data may be accessed publicly.
@@ -320,6 +334,11 @@ namespace Azure { namespace Storage { namespace Blobs {
      * @return A SubmitBlobBatchResult.
      * @remark This function will throw only if there's something wrong with the batch request
      * (parent request).
+     * @remark A batch with more subrequests than the service accepts in a single request is split
+     * into several batch requests, and the returned response holds the raw response of the first
+     * one. When a batch request is retried, the subrequests whose responses were already received
+     * aren't sent again.
+     * @remark A batch can't be submitted again once all its subrequests have a response.
      */
     Response<Models::SubmitBlobBatchResult> SubmitBatch(
         const BlobContainerBatch& batch,
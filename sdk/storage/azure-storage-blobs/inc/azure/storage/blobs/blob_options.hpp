@@ -423,6 +423,60 @@ namespace Azure { namespace Storage { namespace Blobs {
     Models::ListBlobsIncludeFlags Include = Models::ListBlobsIncludeFlags::None;
   };
 
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Blobs::BlobContainerClient::ListBlobsParallel.
+   */
+  struct ListBlobsParallelOptions final
+  {
+    /**
+     * @brief Specifies a string that filters the results to return only blobs whose
+     * name begins with the specified prefix.
+     */
+    Azure::Nullable<std::string> Prefix;
+
+    /**
+     * @brief Blob name prefixes, appended to Prefix, that are listed at the same time. They must
+     * not overlap, or the blobs they have in common are returned more than once. If empty, the
+     * listing starts from Prefix alone.
+     */
+    std::vector<std::string> Partitions;
+
+    /**
+     * @brief The delimiter of the virtual directories. Each virtual directory found while listing
+     * is listed by a request chain of its own. An empty delimiter lists every partition flat.
+     */
+    std::string Delimiter = "/";
+
+    /**
+     * @brief The depth of the virtual directories, below the partitions, that are listed flat
+     * instead of being split into their subdirectories. 0 lists every partition flat. If not set,
+     * every virtual directory is split.
+     */
+    Azure::Nullable<int32_t> MaxFanOutDepth;
+
+    /**
+     * @brief Specifies the maximum number of blobs to return in a single page.
+     */
+    Azure::Nullable<int32_t> PageSizeHint;
+
+    /**
+     * @brief Specifies one or more datasets to include in the response.
+     */
+    Models::ListBlobsIncludeFlags Include = Models::ListBlobsIncludeFlags::None;
+
+    /**
+     * @brief The maximum number of list requests running at the same time.
+     */
+    int32_t Concurrency = 8;
+
+    /**
+     * @brief The maximum number of pages that are listed but not returned yet, including the
+     * requests in flight. This bounds the memory used by the listing.
+     */
+    int32_t MaxBufferedPages = 32;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::GetAccessPolicy.
    */
@@ -706,6 +760,16 @@ namespace Azure { namespace Storage { namespace Blobs {
        * @brief The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * @brief If set, the size of the chunks and the number of concurrent requests are tuned
+       * while the blob is downloaded, based on the measured throughput. ChunkSize is then the
+       * initial chunk size and Concurrency the maximum number of concurrent requests.
+       *
+       * @remark The concurrency and the chunk size are reduced when the requests slow down, for
+       * example because the service throttles them.
+       */
+      bool EnableAdaptiveTransfer = false;
     } TransferOptions;
   };
 
@@ -937,6 +1001,16 @@ namespace Azure { namespace Storage { namespace Blobs {
        * @brief The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * @brief If set, the size of the blocks and the number of concurrent requests are tuned
+       * while the blob is uploaded, based on the measured throughput. ChunkSize, if set, is then
+       * the initial block size and Concurrency the maximum number of concurrent requests.
+       *
+       * @remark The concurrency and the block size are reduced when the requests slow down, for
+       * example because the service throttles them.
+       */
+      bool EnableAdaptiveTransfer = false;
     } TransferOptions;
 
     /**
@@ -1550,6 +1624,51 @@ namespace Azure { namespace Storage { namespace Blobs {
     Azure::Nullable<int32_t> PageSizeHint;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::DownloadPagesTo.
+   */
+  struct DownloadPagesToOptions final
+  {
+    /**
+     * @brief Downloads only the pages in the specified range of the blob.
+     */
+    Azure::Nullable<Core::Http::HttpRange> Range;
+
+    /**
+     * @brief If set, only the pages that changed since this snapshot of the blob are downloaded,
+     * and the pages that were cleared since are zeroed. The file must contain the content of the
+     * snapshot, for example downloaded by a previous call.
+     */
+    Azure::Nullable<std::string> PreviousSnapshot;
+
+    /**
+     * @brief Same as PreviousSnapshot, but the snapshot is specified by its URL. This only works
+     * with managed disk storage accounts.
+     */
+    Azure::Nullable<std::string> PreviousSnapshotUrl;
+
+    /**
+     * @brief Optional conditions that must be met to perform this operation.
+     */
+    BlobAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = 5;
+    } TransferOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::StartCopyIncremental.
    */
@@ -1594,10 +1713,16 @@ namespace Azure { namespace Storage { namespace Blobs {
   };
 
   /**
-   * @brief Optional parameters for #Azure::Storage::Blobs::BlobServiceClient::SubmitBatch.
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobServiceClient::SubmitBatch and
+   * #Azure::Storage::Blobs::BlobContainerClient::SubmitBatch.
    */
   struct SubmitBlobBatchOptions final
   {
+    /**
+     * @brief The maximum number of batch requests sent at the same time, when the batch has more
+     * subrequests than the service accepts in a single request and is split.
+     */
+    int32_t Concurrency = 5;
   };
 
   namespace _detail {
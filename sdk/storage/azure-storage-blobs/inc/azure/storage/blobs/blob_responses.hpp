@@ -10,6 +10,7 @@
 #include <azure/core/paged_response.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -60,6 +61,38 @@ namespace Azure { namespace Storage {
         DownloadBlobDetails Details;
       };
 
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::DownloadPagesTo.
+       */
+      struct DownloadPagesToResult final
+      {
+        /**
+         * The ETag contains a value that you can use to perform operations conditionally.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * Size of the blob.
+         */
+        int64_t BlobSize = 0;
+
+        /**
+         * The range of the blob written to the file.
+         */
+        Azure::Core::Http::HttpRange ContentRange;
+
+        /**
+         * The number of bytes downloaded. The other bytes of the range were not written, or were
+         * zeroed without being downloaded.
+         */
+        int64_t DownloadedBytes = 0;
+      };
+
       using UploadBlockBlobFromResult = UploadBlockBlobResult;
 
       /**
@@ -281,6 +314,7 @@ namespace Azure { namespace Storage {
 
     private:
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
 
       std::shared_ptr<BlobServiceClient> m_blobServiceClient;
       ListBlobContainersOptions m_operationOptions;
@@ -308,6 +342,7 @@ namespace Azure { namespace Storage {
 
     private:
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
 
       std::shared_ptr<BlobServiceClient> m_blobServiceClient;
       std::shared_ptr<BlobContainerClient> m_blobContainerClient;
@@ -346,6 +381,7 @@ namespace Azure { namespace Storage {
 
     private:
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
 
       std::shared_ptr<BlobContainerClient> m_blobContainerClient;
       ListBlobsOptions m_operationOptions;
@@ -393,6 +429,7 @@ namespace Azure { namespace Storage {
 
     private:
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
 
       std::shared_ptr<BlobContainerClient> m_blobContainerClient;
       ListBlobsOptions m_operationOptions;
@@ -402,6 +439,62 @@ namespace Azure { namespace Storage {
       friend class Azure::Core::PagedResponse<ListBlobsByHierarchyPagedResponse>;
     };
 
+    namespace _detail {
+      class ListBlobsParallelState;
+    } // namespace _detail
+
+    /**
+     * @brief Response type for #Azure::Storage::Blobs::BlobContainerClient::ListBlobsParallel.
+     *
+     * @details The pages are listed in the background and returned in the order they complete, so
+     * the blobs aren't ordered by name. #GetNextPage can be called from several threads at the
+     * same time. Destroying the enumerator cancels the requests in flight.
+     */
+    class ListBlobsParallelEnumerator final {
+    public:
+      ListBlobsParallelEnumerator(const ListBlobsParallelEnumerator&) = delete;
+      ListBlobsParallelEnumerator& operator=(const ListBlobsParallelEnumerator&) = delete;
+
+      /**
+       * @brief Move constructor.
+       */
+      ListBlobsParallelEnumerator(ListBlobsParallelEnumerator&& other) noexcept = default;
+
+      /**
+       * @brief Move assignment operator. The listing of this instance, if any, is stopped.
+       */
+      ListBlobsParallelEnumerator& operator=(ListBlobsParallelEnumerator&& other) noexcept;
+
+      /**
+       * @brief Stops the listing.
+       */
+      ~ListBlobsParallelEnumerator();
+
+      /**
+       * @brief Waits for the next page of blobs.
+       *
+       * @note If a list request fails, the pages listed before are returned first, then this
+       * function throws the error.
+       *
+       * @param blobs Receives the blobs of the page.
+       * @param context Context for cancelling the wait.
+       * @return false once every blob was returned.
+       */
+      bool GetNextPage(
+          std::vector<Models::BlobItem>& blobs,
+          const Azure::Core::Context& context = Azure::Core::Context());
+
+    private:
+      ListBlobsParallelEnumerator(
+          std::shared_ptr<BlobContainerClient> blobContainerClient,
+          const ListBlobsParallelOptions& options,
+          const Azure::Core::Context& context);
+
+      std::shared_ptr<_detail::ListBlobsParallelState> m_state;
+
+      friend class BlobContainerClient;
+    };
+
     /**
      * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::GetPageRanges.
      */
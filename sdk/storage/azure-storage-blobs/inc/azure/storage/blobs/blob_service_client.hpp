@@ -262,6 +262,11 @@ namespace Azure { namespace Storage { namespace Blobs {
      * @return A SubmitBlobBatchResult.
      * @remark This function will throw only if there's something wrong with the batch request
      * (parent request).
+     * @remark A batch with more subrequests than the service accepts in a single request is split
+     * into several batch requests, and the returned response holds the raw response of the first
+     * one. When a batch request is retried, the subrequests whose responses were already received
+     * aren't sent again.
+     * @remark A batch can't be submitted again once all its subrequests have a response.
      */
     Response<Models::SubmitBlobBatchResult> SubmitBatch(
         const BlobServiceBatch& batch,
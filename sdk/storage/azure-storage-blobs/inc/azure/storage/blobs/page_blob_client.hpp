@@ -268,6 +268,26 @@ namespace Azure { namespace Storage { namespace Blobs {
         const GetPageRangesOptions& options = GetPageRangesOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Downloads the valid pages of a page blob or a range of it to a file using parallel
+     * requests.
+     *
+     * @details The valid page ranges are listed first, and only they are downloaded. The rest of
+     * the file is left sparse where the file system supports it, so downloading a mostly empty
+     * disk is much faster than with #DownloadTo. With DownloadPagesToOptions::PreviousSnapshot or
+     * DownloadPagesToOptions::PreviousSnapshotUrl, an existing copy of a previous snapshot is
+     * updated in place: only the pages that changed since are downloaded.
+     *
+     * @param fileName A file path to write the downloaded content to.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A DownloadPagesToResult describing the downloaded pages.
+     */
+    Azure::Response<Models::DownloadPagesToResult> DownloadPagesTo(
+        const std::string& fileName,
+        const DownloadPagesToOptions& options = DownloadPagesToOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Starts copying a snapshot of the sourceUri page blob to this page blob. The snapshot
      * is copied such that only the differential changes between the previously copied snapshot
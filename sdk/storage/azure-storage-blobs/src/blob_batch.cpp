@@ -10,6 +10,7 @@
 #include <azure/core/internal/http/pipeline.hpp>
 #include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 
@@ -21,34 +22,23 @@
 
 namespace Azure { namespace Storage { namespace Blobs {
 
-  const Core::Context::Key _detail::s_serviceBatchKey;
-  const Core::Context::Key _detail::s_containerBatchKey;
-
-  namespace _detail {
-
-    class BlobBatchAccessHelper final {
-    public:
-      explicit BlobBatchAccessHelper(const BlobServiceBatch& batch) : m_serviceBatch(&batch) {}
-      explicit BlobBatchAccessHelper(const BlobContainerBatch& batch) : m_containerBatch(&batch) {}
-
-      const std::vector<std::shared_ptr<BatchSubrequest>>& Subrequests() const
-      {
-        return m_serviceBatch ? m_serviceBatch->m_subrequests : m_containerBatch->m_subrequests;
-      }
-
-    private:
-      const BlobServiceBatch* m_serviceBatch = nullptr;
-      const BlobContainerBatch* m_containerBatch = nullptr;
-    };
-
-  } // namespace _detail
-
   namespace {
     const std::string LineEnding = "\r\n";
     const std::string BatchContentTypePrefix = "multipart/mixed; boundary=";
+    // The maximum number of subrequests the service accepts in a batch request.
+    constexpr size_t MaxSubrequestsPerBatch = 256;
 
     static Core::Context::Key s_subrequestKey;
     static Core::Context::Key s_subresponseKey;
+    static Core::Context::Key s_subBatchKey;
+
+    // The subrequests sent in a single batch request.
+    struct SubBatch final
+    {
+      std::vector<_detail::BatchSubrequest*> Subrequests;
+      // The subrequests in the body of the last attempt, in the order of their Content-ID.
+      std::vector<_detail::BatchSubrequest*> SentSubrequests;
+    };
 
     struct Parser final
     {
@@ -56,12 +46,6 @@ namespace Azure { namespace Storage { namespace Blobs {
           : startPos(str.data()), currPos(startPos), endPos(startPos + str.length())
       {
       }
-      explicit Parser(const std::vector<uint8_t>& str)
-          : startPos(reinterpret_cast<const char*>(str.data())),
-            currPos(reinterpret_cast<const char*>(startPos)),
-            endPos(reinterpret_cast<const char*>(startPos) + str.size())
-      {
-      }
       const char* startPos;
       const char* currPos;
       const char* endPos;
@@ -100,11 +84,6 @@ namespace Azure { namespace Storage { namespace Blobs {
         return std::search(currPos, endPos, expect.begin(), expect.end());
       }
 
-      const char* AfterNext(const std::string& expect) const
-      {
-        return (std::min)(endPos, FindNext(expect) + expect.length());
-      }
-
       std::string GetBeforeNextAndConsume(const std::string& expect)
       {
         // This moves currPos
@@ -147,6 +126,181 @@ namespace Azure { namespace Storage { namespace Blobs {
       return rawResponse;
     }
 
+    /**
+     * @brief The body of a batch request. The parts, one per subrequest, are read one after the
+     * other, so they are never copied into a single buffer.
+     */
+    class BatchRequestBodyStream final : public Core::IO::BodyStream {
+    public:
+      void SetParts(std::vector<std::string> parts)
+      {
+        m_parts = std::move(parts);
+        m_length = 0;
+        for (const auto& part : m_parts)
+        {
+          m_length += static_cast<int64_t>(part.length());
+        }
+        Rewind();
+      }
+
+      int64_t Length() const override { return m_length; }
+
+      void Rewind() override
+      {
+        m_partIndex = 0;
+        m_partOffset = 0;
+      }
+
+    private:
+      size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override
+      {
+        (void)context;
+        size_t readLength = 0;
+        while (readLength < count && m_partIndex < m_parts.size())
+        {
+          const auto& part = m_parts[m_partIndex];
+          const size_t copyLength = (std::min)(count - readLength, part.length() - m_partOffset);
+          std::memcpy(buffer + readLength, part.data() + m_partOffset, copyLength);
+          readLength += copyLength;
+          m_partOffset += copyLength;
+          if (m_partOffset == part.length())
+          {
+            ++m_partIndex;
+            m_partOffset = 0;
+          }
+        }
+        return readLength;
+      }
+
+      std::vector<std::string> m_parts;
+      int64_t m_length = 0;
+      size_t m_partIndex = 0;
+      size_t m_partOffset = 0;
+    };
+
+    /**
+     * @brief Reads the parts of a multipart body as they arrive, so that only the part being read
+     * is kept in memory.
+     */
+    class MultipartReader final {
+    public:
+      MultipartReader(
+          Core::IO::BodyStream& bodyStream,
+          const std::string& boundary,
+          const Core::Context& context)
+          : m_bodyStream(bodyStream), m_delimiter("--" + boundary), m_context(context)
+      {
+      }
+
+      /**
+       * @brief Reads the next part, with its headers, up to the next delimiter.
+       *
+       * @return false once the closing delimiter is reached.
+       */
+      bool ReadNextPart(std::string& part)
+      {
+        if (m_closed)
+        {
+          return false;
+        }
+        if (!m_started)
+        {
+          Consume(m_delimiter);
+          m_started = true;
+        }
+        if (LookAhead("--") || !Fill(1))
+        {
+          m_closed = true;
+          return false;
+        }
+        const size_t partEnd = Find(m_delimiter);
+        if (partEnd == std::string::npos)
+        {
+          throw std::runtime_error("failed to parse response body, missing multipart delimiter");
+        }
+        part.assign(m_buffer, m_offset, partEnd - m_offset);
+        m_offset = partEnd;
+        Consume(m_delimiter);
+        return true;
+      }
+
+    private:
+      static constexpr size_t ReadChunkSize = 64 * 1024;
+
+      // Reads from the stream until at least length bytes after m_offset are buffered. Returns
+      // false if the stream ends first.
+      bool Fill(size_t length)
+      {
+        while (m_buffer.length() - m_offset < length)
+        {
+          if (!ReadChunk())
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      bool ReadChunk()
+      {
+        const size_t bufferedLength = m_buffer.length();
+        m_buffer.resize(bufferedLength + ReadChunkSize);
+        const size_t readLength = m_bodyStream.Read(
+            reinterpret_cast<uint8_t*>(&m_buffer[bufferedLength]), ReadChunkSize, m_context);
+        m_buffer.resize(bufferedLength + readLength);
+        return readLength != 0;
+      }
+
+      size_t Find(const std::string& expect)
+      {
+        size_t searchOffset = m_offset;
+        while (true)
+        {
+          const size_t pos = m_buffer.find(expect, searchOffset);
+          if (pos != std::string::npos)
+          {
+            return pos;
+          }
+          if (m_buffer.length() >= expect.length())
+          {
+            searchOffset = (std::max)(searchOffset, m_buffer.length() - expect.length() + 1);
+          }
+          if (!ReadChunk())
+          {
+            return std::string::npos;
+          }
+        }
+      }
+
+      bool LookAhead(const std::string& expect)
+      {
+        return Fill(expect.length()) && m_buffer.compare(m_offset, expect.length(), expect) == 0;
+      }
+
+      void Consume(const std::string& expect)
+      {
+        if (!LookAhead(expect))
+        {
+          throw std::runtime_error(
+              "failed to parse response body at " + std::to_string(m_consumedLength + m_offset));
+        }
+        m_offset += expect.length();
+        // Drops the parts that were read.
+        m_consumedLength += m_offset;
+        m_buffer.erase(0, m_offset);
+        m_offset = 0;
+      }
+
+      Core::IO::BodyStream& m_bodyStream;
+      const std::string m_delimiter;
+      const Core::Context& m_context;
+      std::string m_buffer;
+      size_t m_offset = 0;
+      size_t m_consumedLength = 0;
+      bool m_started = false;
+      bool m_closed = false;
+    };
+
     class RemoveXMsVersionPolicy final : public Core::Http::Policies::HttpPolicy {
     public:
       ~RemoveXMsVersionPolicy() override {}
@@ -186,14 +340,14 @@ namespace Azure { namespace Storage { namespace Blobs {
 
         if (subrequestText)
         {
-          std::string requestText = request.GetMethod().ToString() + " /"
+          // Appended to the part that holds the subrequest.
+          *subrequestText += request.GetMethod().ToString() + " /"
               + request.GetUrl().GetRelativeUrl() + " HTTP/1.1" + LineEnding;
           for (const auto& header : request.GetHeaders())
           {
-            requestText += header.first + ": " + header.second + LineEnding;
+            *subrequestText += header.first + ": " + header.second + LineEnding;
           }
-          requestText += LineEnding;
-          *subrequestText = std::move(requestText);
+          *subrequestText += LineEnding;
 
           auto rawResponse = std::make_unique<Core::Http::RawResponse>(
               1, 1, Core::Http::HttpStatusCode::Accepted, "Accepted");
@@ -299,70 +453,90 @@ namespace Azure { namespace Storage { namespace Blobs {
     {
       const std::string boundary = "batch_" + Azure::Core::Uuid::CreateUuid().ToString();
 
-      auto getBatchBoundary = [&boundary, subRequestCounter = 0]() mutable {
-        std::string ret;
-        ret += "--" + boundary + LineEnding;
-        ret += "Content-Type: application/http" + LineEnding + "Content-Transfer-Encoding: binary"
-            + LineEnding + "Content-ID: " + std::to_string(subRequestCounter++) + LineEnding
-            + LineEnding;
-        return ret;
-      };
+      SubBatch* subBatch = nullptr;
+      context.TryGetValue(s_subBatchKey, subBatch);
+      AZURE_ASSERT(subBatch);
 
-      std::string requestBody;
-
-      std::unique_ptr<_detail::BlobBatchAccessHelper> batchAccessHelper;
-      {
-        const BlobServiceBatch* batch = nullptr;
-        context.TryGetValue(_detail::s_serviceBatchKey, batch);
-        if (batch)
-        {
-          batchAccessHelper = std::make_unique<_detail::BlobBatchAccessHelper>(*batch);
-        }
-      }
+      std::vector<std::string> parts;
+      subBatch->SentSubrequests.clear();
+      for (auto subrequestPtr : subBatch->Subrequests)
       {
-        const BlobContainerBatch* batch = nullptr;
-        context.TryGetValue(_detail::s_containerBatchKey, batch);
-        if (batch)
+        // Subrequests completed by a previous attempt aren't sent again.
+        if (subrequestPtr->Completed)
         {
-          batchAccessHelper = std::make_unique<_detail::BlobBatchAccessHelper>(*batch);
+          continue;
         }
-      }
-
-      for (const auto& subrequestPtr : batchAccessHelper->Subrequests())
-      {
+        std::string part = "--" + boundary + LineEnding + "Content-Type: application/http"
+            + LineEnding + "Content-Transfer-Encoding: binary" + LineEnding
+            + "Content-ID: " + std::to_string(subBatch->SentSubrequests.size()) + LineEnding
+            + LineEnding;
+        const auto subrequestContext = Core::Context().WithValue(s_subrequestKey, &part);
         if (subrequestPtr->Type == _detail::BatchSubrequestType::DeleteBlob)
         {
-          auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr.get());
-          requestBody += getBatchBoundary();
-          std::string subrequestText;
-          subrequest.Client.Delete(
-              subrequest.Options, Core::Context().WithValue(s_subrequestKey, &subrequestText));
-          requestBody += subrequestText;
+          auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr);
+          subrequest.Client.Delete(subrequest.Options, subrequestContext);
         }
         else if (subrequestPtr->Type == _detail::BatchSubrequestType::SetBlobAccessTier)
         {
-          auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr.get());
-          requestBody += getBatchBoundary();
-
-          std::string subrequestText;
-          subrequest.Client.SetAccessTier(
-              subrequest.Tier,
-              subrequest.Options,
-              Core::Context().WithValue(s_subrequestKey, &subrequestText));
-          requestBody += subrequestText;
+          auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr);
+          subrequest.Client.SetAccessTier(subrequest.Tier, subrequest.Options, subrequestContext);
         }
         else
         {
           AZURE_UNREACHABLE_CODE();
         }
+        parts.push_back(std::move(part));
+        subBatch->SentSubrequests.push_back(subrequestPtr);
       }
-      requestBody += "--" + boundary + "--" + LineEnding;
+      parts.push_back("--" + boundary + "--" + LineEnding);
 
       request.SetHeader(_internal::HttpHeaderContentType, BatchContentTypePrefix + boundary);
-      static_cast<_detail::StringBodyStream&>(*request.GetBodyStream())
-          = _detail::StringBodyStream(std::move(requestBody));
-      request.SetHeader(
-          _internal::HttpHeaderContentLength, std::to_string(request.GetBodyStream()->Length()));
+      auto& bodyStream = static_cast<BatchRequestBodyStream&>(*request.GetBodyStream());
+      bodyStream.SetParts(std::move(parts));
+      request.SetHeader(_internal::HttpHeaderContentLength, std::to_string(bodyStream.Length()));
+    }
+
+    template <class T, class Func>
+    void SetSubresponse(std::promise<Nullable<Response<T>>>& promise, Func&& getResponse)
+    {
+      try
+      {
+        promise.set_value(getResponse());
+      }
+      catch (...)
+      {
+        promise.set_exception(std::current_exception());
+      }
+    }
+
+    void CompleteSubrequest(_detail::BatchSubrequest& subrequestBase, std::string& subresponseText)
+    {
+      if (subrequestBase.Completed)
+      {
+        return;
+      }
+      subrequestBase.Completed = true;
+      const auto subresponseContext
+          = Core::Context().WithValue(s_subresponseKey, &subresponseText);
+      if (subrequestBase.Type == _detail::BatchSubrequestType::DeleteBlob)
+      {
+        auto& subrequest = static_cast<DeleteBlobSubrequest&>(subrequestBase);
+        SetSubresponse(subrequest.Promise, [&]() {
+          return subrequest.Client.Delete(subrequest.Options, subresponseContext);
+        });
+      }
+      else if (subrequestBase.Type == _detail::BatchSubrequestType::SetBlobAccessTier)
+      {
+        auto& subrequest = static_cast<SetBlobAccessTierSubrequest&>(subrequestBase);
+        SetSubresponse(subrequest.Promise, [&]() {
+          return subrequest.Client.SetAccessTier(
+              subrequest.Tier, subrequest.Options, subresponseContext);
+        });
+      }
+      else
+      {
+        AZURE_UNREACHABLE_CODE();
+      }
     }
 
     void ParseSubresponses(
@@ -375,125 +549,142 @@ namespace Azure { namespace Storage { namespace Blobs {
         return;
       }
 
+      SubBatch* subBatch = nullptr;
+      context.TryGetValue(s_subBatchKey, subBatch);
+      AZURE_ASSERT(subBatch);
+
       const std::string boundary = rawResponse->GetHeaders()
                                        .at(std::string(_internal::HttpHeaderContentType))
                                        .substr(BatchContentTypePrefix.length());
 
-      const std::vector<uint8_t>& responseBody
-          = rawResponse->ExtractBodyStream()->ReadToEnd(context);
-      Parser parser(responseBody);
-
-      std::vector<std::string> subresponses;
-      while (true)
+      // Each subrequest is completed as soon as its part is read.
+      auto bodyStream = rawResponse->ExtractBodyStream();
+      MultipartReader reader(*bodyStream, boundary, context);
+      std::string part;
+      try
       {
-        parser.Consume("--" + boundary);
-        if (parser.LookAhead("--"))
-        {
-          parser.Consume("--");
-        }
-        if (parser.IsEnd())
-        {
-          break;
-        }
-        auto contentIdPos = parser.AfterNext("Content-ID: ");
-        auto responseStartPos = parser.AfterNext(LineEnding + LineEnding);
-        auto responseEndPos = parser.FindNext("--" + boundary);
-        if (contentIdPos != parser.endPos)
+        while (reader.ReadNextPart(part))
         {
-          parser.currPos = contentIdPos;
-          auto idEndPos = parser.FindNext(LineEnding);
-          size_t id = static_cast<size_t>(std::stoi(std::string(parser.currPos, idEndPos)));
-          if (subresponses.size() < id + 1)
+          const std::string contentIdHeader = "Content-ID: ";
+          const size_t headersEnd = part.find(LineEnding + LineEnding);
+          const size_t responseStart = headersEnd == std::string::npos
+              ? part.length()
+              : headersEnd + 2 * LineEnding.length();
+          const size_t contentIdPos = part.find(contentIdHeader);
+          if (contentIdPos == std::string::npos || contentIdPos > headersEnd)
           {
-            subresponses.resize(id + 1);
+            // The batch request failed as a whole.
+            rawResponse = ParseRawResponse(part.substr(responseStart));
+            return;
+          }
+          const size_t idStart = contentIdPos + contentIdHeader.length();
+          const size_t id = static_cast<size_t>(
+              std::stoi(part.substr(idStart, part.find(LineEnding, idStart) - idStart)));
+          part.erase(0, responseStart);
+          if (id < subBatch->SentSubrequests.size())
+          {
+            CompleteSubrequest(*subBatch->SentSubrequests[id], part);
           }
-          subresponses[id] = std::string(responseStartPos, responseEndPos);
-          parser.currPos = responseEndPos;
-        }
-        else
-        {
-          rawResponse = ParseRawResponse(std::string(responseStartPos, responseEndPos));
-          parser.currPos = responseEndPos;
-          return;
         }
       }
-
-      std::unique_ptr<_detail::BlobBatchAccessHelper> batchAccessHelper;
+      catch (...)
       {
-        const BlobServiceBatch* batch = nullptr;
-        context.TryGetValue(_detail::s_serviceBatchKey, batch);
-        if (batch)
+        // The request is retried with the subrequests that aren't completed, unless there are
+        // none left.
+        if (std::any_of(
+                subBatch->SentSubrequests.begin(),
+                subBatch->SentSubrequests.end(),
+                [](const _detail::BatchSubrequest* subrequest) { return !subrequest->Completed; }))
         {
-          batchAccessHelper = std::make_unique<_detail::BlobBatchAccessHelper>(*batch);
+          throw;
         }
+        return;
       }
+
+      std::string missingSubresponse;
+      for (auto subrequest : subBatch->SentSubrequests)
       {
-        const BlobContainerBatch* batch = nullptr;
-        context.TryGetValue(_detail::s_containerBatchKey, batch);
-        if (batch)
-        {
-          batchAccessHelper = std::make_unique<_detail::BlobBatchAccessHelper>(*batch);
-        }
+        CompleteSubrequest(*subrequest, missingSubresponse);
       }
+    }
+  } // namespace
 
-      size_t subresponseCounter = 0;
-      for (const auto& subrequestPtr : batchAccessHelper->Subrequests())
+  namespace _detail {
+
+    BatchSubrequest::~BatchSubrequest() {}
+
+    std::vector<std::vector<BatchSubrequest*>> SplitBatchSubrequests(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests)
+    {
+      std::vector<std::vector<BatchSubrequest*>> subBatches;
+      for (const auto& subrequest : subrequests)
       {
-        if (subrequestPtr->Type == _detail::BatchSubrequestType::DeleteBlob)
+        if (subrequest->Completed)
         {
-          auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr.get());
-          try
-          {
-            auto response = subrequest.Client.Delete(
-                subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
-          }
-          catch (...)
-          {
-            subrequest.Promise.set_exception(std::current_exception());
-          }
+          continue;
         }
-        else if (subrequestPtr->Type == _detail::BatchSubrequestType::SetBlobAccessTier)
+        if (subBatches.empty() || subBatches.back().size() == MaxSubrequestsPerBatch)
         {
-          auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr.get());
-          try
-          {
-            auto response = subrequest.Client.SetAccessTier(
-                subrequest.Tier,
-                subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
-          }
-          catch (...)
-          {
-            subrequest.Promise.set_exception(std::current_exception());
-          }
+          subBatches.emplace_back();
         }
-        else
+        subBatches.back().push_back(subrequest.get());
+      }
+      return subBatches;
+    }
+
+    Response<Models::SubmitBlobBatchResult> SubmitBatchSubrequests(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests,
+        const SubmitBlobBatchOptions& options,
+        const Core::Context& context,
+        const std::function<Response<Models::_detail::SubmitBatchResult>(
+            Core::IO::BodyStream&,
+            const Core::Context&)>& submitFunc)
+    {
+      auto subBatches = SplitBatchSubrequests(subrequests);
+      if (subBatches.empty())
+      {
+        if (!subrequests.empty())
         {
-          AZURE_UNREACHABLE_CODE();
+          throw std::invalid_argument("The batch has already been submitted.");
         }
+        // The service rejects an empty batch, let it report the error.
+        subBatches.emplace_back();
       }
-    }
-  } // namespace
 
-  namespace _detail {
+      auto submitSubBatch = [&](size_t index) {
+        SubBatch subBatch;
+        subBatch.Subrequests = std::move(subBatches[index]);
+        BatchRequestBodyStream bodyStream;
+        auto response = submitFunc(bodyStream, context.WithValue(s_subBatchKey, &subBatch));
+        return std::move(response.RawResponse);
+      };
 
-    size_t StringBodyStream::OnRead(
-        uint8_t* buffer,
-        size_t count,
-        Azure::Core::Context const& context)
-    {
-      (void)context;
-      size_t copy_length = (std::min)(count, m_content.length() - m_offset);
-      std::memcpy(buffer, &m_content[0] + m_offset, static_cast<size_t>(copy_length));
-      m_offset += copy_length;
-      return copy_length;
+      std::unique_ptr<Core::Http::RawResponse> rawResponse;
+      if (subBatches.size() == 1)
+      {
+        rawResponse = submitSubBatch(0);
+      }
+      else
+      {
+        std::vector<std::unique_ptr<Core::Http::RawResponse>> rawResponses(subBatches.size());
+        _internal::ConcurrentTransfer(
+            0,
+            static_cast<int64_t>(subBatches.size()),
+            1,
+            options.Concurrency,
+            [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+              (void)offset;
+              (void)length;
+              (void)numChunks;
+              rawResponses[static_cast<size_t>(chunkId)]
+                  = submitSubBatch(static_cast<size_t>(chunkId));
+            });
+        rawResponse = std::move(rawResponses.front());
+      }
+      return Response<Models::SubmitBlobBatchResult>(
+          Models::SubmitBlobBatchResult(), std::move(rawResponse));
     }
 
-    BatchSubrequest::~BatchSubrequest() {}
-
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> ConstructBatchRequestPolicy(
         const std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>&
             servicePerRetryPolicies,
@@ -11,6 +11,7 @@
 #include <azure/core/azure_assert.hpp>
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/buffer_pool.hpp>
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
@@ -96,7 +97,7 @@ namespace Azure { namespace Storage { namespace Blobs {
               : _internal::StorageScope);
       perRetryPolicies.emplace_back(
           std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery));
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefresh));
     }
     perOperationPolicies.emplace_back(
         std::make_unique<_internal::StorageServiceVersionPolicy>(options.ApiVersion));
@@ -410,12 +411,29 @@ namespace Azure { namespace Storage { namespace Blobs {
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = blobRangeSize - firstChunkLength;
 
-    _internal::ConcurrentTransfer(
-        remainingOffset,
-        remainingSize,
-        options.TransferOptions.ChunkSize,
-        options.TransferOptions.Concurrency,
-        downloadChunkFunc);
+    if (options.TransferOptions.EnableAdaptiveTransfer)
+    {
+      _internal::AdaptiveTransferTuner tuner(
+          options.TransferOptions.ChunkSize,
+          (std::min)(options.TransferOptions.ChunkSize, _internal::MinAdaptiveChunkSize),
+          (std::max)(options.TransferOptions.ChunkSize, _internal::MaxAdaptiveChunkSize),
+          options.TransferOptions.Concurrency);
+      _internal::AdaptiveConcurrentTransfer(
+          remainingOffset,
+          remainingSize,
+          tuner,
+          options.TransferOptions.Concurrency,
+          downloadChunkFunc);
+    }
+    else
+    {
+      _internal::ConcurrentTransfer(
+          remainingOffset,
+          remainingSize,
+          options.TransferOptions.ChunkSize,
+          options.TransferOptions.Concurrency,
+          downloadChunkFunc);
+    }
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = blobRangeSize;
     return ret;
@@ -462,22 +480,24 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     firstChunkLength = (std::min)(firstChunkLength, blobRangeSize);
 
-    auto bodyStreamToFile = [](Azure::Core::IO::BodyStream& stream,
-                               _internal::FileWriter& fileWriter,
-                               int64_t offset,
-                               int64_t length,
-                               const Azure::Core::Context& context) {
-      constexpr size_t bufferSize = 4 * 1024 * 1024;
-      std::vector<uint8_t> buffer(bufferSize);
+    // Every chunk reuses a buffer released by a chunk downloaded before it, if any.
+    _internal::BufferPool bufferPool(4 * 1024 * 1024);
+    auto bodyStreamToFile = [&bufferPool](
+                                Azure::Core::IO::BodyStream& stream,
+                                _internal::FileWriter& fileWriter,
+                                int64_t offset,
+                                int64_t length,
+                                const Azure::Core::Context& context) {
+      auto buffer = bufferPool.Acquire();
       while (length > 0)
       {
-        size_t readSize = static_cast<size_t>(std::min<int64_t>(bufferSize, length));
-        size_t bytesRead = stream.ReadToCount(buffer.data(), readSize, context);
+        size_t readSize = static_cast<size_t>(std::min<int64_t>(buffer.Size(), length));
+        size_t bytesRead = stream.ReadToCount(buffer.Data(), readSize, context);
         if (bytesRead != readSize)
         {
           throw Azure::Core::RequestFailedException("Error when reading body stream.");
         }
-        fileWriter.Write(buffer.data(), bytesRead, offset);
+        fileWriter.Write(buffer.Data(), bytesRead, offset);
         length -= bytesRead;
         offset += bytesRead;
       }
@@ -525,12 +545,29 @@ namespace Azure { namespace Storage { namespace Blobs {
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = blobRangeSize - firstChunkLength;
 
-    _internal::ConcurrentTransfer(
-        remainingOffset,
-        remainingSize,
-        options.TransferOptions.ChunkSize,
-        options.TransferOptions.Concurrency,
-        downloadChunkFunc);
+    if (options.TransferOptions.EnableAdaptiveTransfer)
+    {
+      _internal::AdaptiveTransferTuner tuner(
+          options.TransferOptions.ChunkSize,
+          (std::min)(options.TransferOptions.ChunkSize, _internal::MinAdaptiveChunkSize),
+          (std::max)(options.TransferOptions.ChunkSize, _internal::MaxAdaptiveChunkSize),
+          options.TransferOptions.Concurrency);
+      _internal::AdaptiveConcurrentTransfer(
+          remainingOffset,
+          remainingSize,
+          tuner,
+          options.TransferOptions.Concurrency,
+          downloadChunkFunc);
+    }
+    else
+    {
+      _internal::ConcurrentTransfer(
+          remainingOffset,
+          remainingSize,
+          options.TransferOptions.ChunkSize,
+          options.TransferOptions.Concurrency,
+          downloadChunkFunc);
+    }
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = blobRangeSize;
     return ret;
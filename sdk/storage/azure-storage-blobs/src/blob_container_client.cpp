@@ -174,7 +174,7 @@ namespace Azure { namespace Storage { namespace Blobs {
               ? _internal::GetDefaultScopeForAudience(options.Audience.Value().ToString())
               : _internal::StorageScope);
       tokenAuthPolicy = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-          credential, tokenContext, options.EnableTenantDiscovery);
+          credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefresh);
       perRetryPolicies.emplace_back(tokenAuthPolicy->Clone());
     }
     perOperationPolicies.emplace_back(
@@ -420,6 +420,14 @@ namespace Azure { namespace Storage { namespace Blobs {
     return pagedResponse;
   }
 
+  ListBlobsParallelEnumerator BlobContainerClient::ListBlobsParallel(
+      const ListBlobsParallelOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return ListBlobsParallelEnumerator(
+        std::make_shared<BlobContainerClient>(*this), options, context);
+  }
+
   Azure::Response<Models::BlobContainerAccessPolicy> BlobContainerClient::GetAccessPolicy(
       const GetBlobContainerAccessPolicyOptions& options,
       const Azure::Core::Context& context) const
@@ -503,18 +511,19 @@ namespace Azure { namespace Storage { namespace Blobs {
       const SubmitBlobBatchOptions& options,
       const Core::Context& context) const
   {
-    (void)options;
-
-    _detail::BlobContainerClient::SubmitBlobContainerBatchOptions protocolLayerOptions;
-    _detail::StringBodyStream bodyStream(std::string{});
-    auto response = _detail::BlobContainerClient::SubmitBatch(
-        *m_batchRequestPipeline,
-        m_blobContainerUrl,
-        bodyStream,
-        protocolLayerOptions,
-        context.WithValue(_detail::s_containerBatchKey, &batch));
-    return Azure::Response<Models::SubmitBlobBatchResult>(
-        Models::SubmitBlobBatchResult(), std::move(response.RawResponse));
+    return _detail::SubmitBatchSubrequests(
+        batch.m_subrequests,
+        options,
+        context,
+        [this](Core::IO::BodyStream& bodyStream, const Core::Context& batchContext) {
+          _detail::BlobContainerClient::SubmitBlobContainerBatchOptions protocolLayerOptions;
+          return _detail::BlobContainerClient::SubmitBatch(
+              *m_batchRequestPipeline,
+              m_blobContainerUrl,
+              bodyStream,
+              protocolLayerOptions,
+              batchContext);
+        });
   }
 
   Azure::Response<Models::AccountInfo> BlobContainerClient::GetAccountInfo(
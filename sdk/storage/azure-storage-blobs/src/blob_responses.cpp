@@ -8,6 +8,15 @@
 #include "azure/storage/blobs/blob_service_client.hpp"
 #include "azure/storage/blobs/page_blob_client.hpp"
 
+#include <azure/storage/common/internal/thread_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
   std::unique_ptr<Azure::Core::Http::RawResponse> StartBlobCopyOperation::PollInternal(
@@ -67,6 +76,18 @@ namespace Azure { namespace Storage { namespace Blobs {
     *this = m_blobServiceClient->ListBlobContainers(m_operationOptions, context);
   }
 
+  ListBlobContainersPagedResponse::PageFetcher
+  ListBlobContainersPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_blobServiceClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListBlobContainersPagedResponse>(
+          client->ListBlobContainers(options, context));
+    };
+  }
+
   void FindBlobsByTagsPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
@@ -86,18 +107,287 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
   }
 
+  FindBlobsByTagsPagedResponse::PageFetcher
+  FindBlobsByTagsPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto serviceClient = m_blobServiceClient;
+    auto containerClient = m_blobContainerClient;
+    auto tagFilterSqlExpression = m_tagFilterSqlExpression;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [serviceClient, containerClient, tagFilterSqlExpression, options](
+               const Azure::Core::Context& context) {
+      if (serviceClient)
+      {
+        return std::make_unique<FindBlobsByTagsPagedResponse>(
+            serviceClient->FindBlobsByTags(tagFilterSqlExpression, options, context));
+      }
+      return std::make_unique<FindBlobsByTagsPagedResponse>(
+          containerClient->FindBlobsByTags(tagFilterSqlExpression, options, context));
+    };
+  }
+
   void ListBlobsPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
     *this = m_blobContainerClient->ListBlobs(m_operationOptions, context);
   }
 
+  ListBlobsPagedResponse::PageFetcher ListBlobsPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_blobContainerClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListBlobsPagedResponse>(client->ListBlobs(options, context));
+    };
+  }
+
   void ListBlobsByHierarchyPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
     *this = m_blobContainerClient->ListBlobsByHierarchy(m_delimiter, m_operationOptions, context);
   }
 
+  ListBlobsByHierarchyPagedResponse::PageFetcher
+  ListBlobsByHierarchyPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_blobContainerClient;
+    auto delimiter = m_delimiter;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, delimiter, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListBlobsByHierarchyPagedResponse>(
+          client->ListBlobsByHierarchy(delimiter, options, context));
+    };
+  }
+
+  namespace _detail {
+    class ListBlobsParallelState final
+        : public std::enable_shared_from_this<ListBlobsParallelState> {
+    public:
+      ListBlobsParallelState(
+          std::shared_ptr<Blobs::BlobContainerClient> blobContainerClient,
+          const ListBlobsParallelOptions& options,
+          const Azure::Core::Context& context)
+          : m_blobContainerClient(std::move(blobContainerClient)), m_options(options),
+            m_context(context.WithDeadline((Azure::DateTime::max)()))
+      {
+        m_options.Concurrency = (std::max)(m_options.Concurrency, 1);
+        m_options.MaxBufferedPages = (std::max)(m_options.MaxBufferedPages, 1);
+        const std::string prefix = m_options.Prefix.ValueOr(std::string());
+        if (m_options.Partitions.empty())
+        {
+          m_cursors.push_back(Cursor{prefix, Azure::Nullable<std::string>(), 0});
+        }
+        for (const auto& partition : m_options.Partitions)
+        {
+          m_cursors.push_back(Cursor{prefix + partition, Azure::Nullable<std::string>(), 0});
+        }
+      }
+
+      void Start()
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        ScheduleRequests();
+      }
+
+      void Stop()
+      {
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          m_stopped = true;
+          m_cursors.clear();
+          m_pages.clear();
+        }
+        // Abandons the requests in flight. They hold a reference to this state until they return.
+        m_context.Cancel();
+        m_stateChanged.notify_all();
+      }
+
+      bool GetNextPage(std::vector<Models::BlobItem>& blobs, const Azure::Core::Context& context)
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stateChanged.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+          return !m_pages.empty() || m_error || m_stopped
+              || (m_cursors.empty() && m_runningRequests == 0);
+        }))
+        {
+          context.ThrowIfCancelled();
+        }
+        if (!m_pages.empty())
+        {
+          blobs = std::move(m_pages.front());
+          m_pages.pop_front();
+          ScheduleRequests();
+          return true;
+        }
+        if (m_error)
+        {
+          std::rethrow_exception(m_error);
+        }
+        return false;
+      }
+
+    private:
+      // A request chain listing the blobs under a prefix.
+      struct Cursor final
+      {
+        std::string Prefix;
+        Azure::Nullable<std::string> ContinuationToken;
+        // The number of virtual directories between the partition and the prefix.
+        int32_t Depth = 0;
+      };
+
+      // Must be called with m_mutex locked.
+      void ScheduleRequests()
+      {
+        while (!m_stopped && !m_error && !m_cursors.empty()
+               && m_runningRequests < m_options.Concurrency
+               && m_runningRequests + static_cast<int32_t>(m_pages.size())
+                   < m_options.MaxBufferedPages)
+        {
+          auto cursor = std::move(m_cursors.front());
+          m_cursors.pop_front();
+          ++m_runningRequests;
+          auto self = shared_from_this();
+          // Each task makes a single request, so it never waits for another task of the pool.
+          _internal::ThreadPool::GetDefault().Submit(
+              [self, cursor]() { self->ListPage(cursor); });
+        }
+      }
+
+      void ListPage(const Cursor& cursor)
+      {
+        ListBlobsOptions listOptions;
+        if (!cursor.Prefix.empty())
+        {
+          listOptions.Prefix = cursor.Prefix;
+        }
+        listOptions.ContinuationToken = cursor.ContinuationToken;
+        listOptions.PageSizeHint = m_options.PageSizeHint;
+        listOptions.Include = m_options.Include;
+        const bool fanOut = !m_options.Delimiter.empty()
+            && (!m_options.MaxFanOutDepth.HasValue()
+                || cursor.Depth < m_options.MaxFanOutDepth.Value());
+
+        std::vector<Models::BlobItem> blobs;
+        std::vector<Cursor> nextCursors;
+        std::exception_ptr error;
+        try
+        {
+          Azure::Nullable<std::string> nextPageToken;
+          if (fanOut)
+          {
+            auto pagedResponse = m_blobContainerClient->ListBlobsByHierarchy(
+                m_options.Delimiter, listOptions, m_context);
+            blobs = std::move(pagedResponse.Blobs);
+            for (auto& blobPrefix : pagedResponse.BlobPrefixes)
+            {
+              nextCursors.push_back(
+                  Cursor{std::move(blobPrefix), Azure::Nullable<std::string>(), cursor.Depth + 1});
+            }
+            nextPageToken = std::move(pagedResponse.NextPageToken);
+          }
+          else
+          {
+            auto pagedResponse = m_blobContainerClient->ListBlobs(listOptions, m_context);
+            blobs = std::move(pagedResponse.Blobs);
+            nextPageToken = std::move(pagedResponse.NextPageToken);
+          }
+          if (nextPageToken.HasValue() && !nextPageToken.Value().empty())
+          {
+            nextCursors.push_back(Cursor{cursor.Prefix, std::move(nextPageToken), cursor.Depth});
+          }
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_runningRequests;
+        if (!m_stopped)
+        {
+          if (error)
+          {
+            if (!m_error)
+            {
+              m_error = error;
+            }
+          }
+          else
+          {
+            if (!blobs.empty())
+            {
+              m_pages.push_back(std::move(blobs));
+            }
+            // Depth first, so that the cursors waiting for a request don't pile up.
+            for (auto i = nextCursors.rbegin(); i != nextCursors.rend(); ++i)
+            {
+              m_cursors.push_front(std::move(*i));
+            }
+          }
+          ScheduleRequests();
+        }
+        m_stateChanged.notify_all();
+      }
+
+      std::shared_ptr<Blobs::BlobContainerClient> m_blobContainerClient;
+      ListBlobsParallelOptions m_options;
+      Azure::Core::Context m_context;
+      std::mutex m_mutex;
+      std::condition_variable m_stateChanged;
+      std::deque<Cursor> m_cursors;
+      std::deque<std::vector<Models::BlobItem>> m_pages;
+      int32_t m_runningRequests = 0;
+      std::exception_ptr m_error;
+      bool m_stopped = false;
+    };
+  } // namespace _detail
+
+  ListBlobsParallelEnumerator::ListBlobsParallelEnumerator(
+      std::shared_ptr<BlobContainerClient> blobContainerClient,
+      const ListBlobsParallelOptions& options,
+      const Azure::Core::Context& context)
+      : m_state(std::make_shared<_detail::ListBlobsParallelState>(
+          std::move(blobContainerClient),
+          options,
+          context))
+  {
+    m_state->Start();
+  }
+
+  ListBlobsParallelEnumerator& ListBlobsParallelEnumerator::operator=(
+      ListBlobsParallelEnumerator&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (m_state)
+      {
+        m_state->Stop();
+      }
+      m_state = std::move(other.m_state);
+    }
+    return *this;
+  }
+
+  ListBlobsParallelEnumerator::~ListBlobsParallelEnumerator()
+  {
+    if (m_state)
+    {
+      m_state->Stop();
+    }
+  }
+
+  bool ListBlobsParallelEnumerator::GetNextPage(
+      std::vector<Models::BlobItem>& blobs,
+      const Azure::Core::Context& context)
+  {
+    AZURE_ASSERT_MSG(m_state, "The enumerator was moved from.");
+    return m_state->GetNextPage(blobs, context);
+  }
+
   void GetPageRangesPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
@@ -87,7 +87,7 @@ namespace Azure { namespace Storage { namespace Blobs {
               ? _internal::GetDefaultScopeForAudience(options.Audience.Value().ToString())
               : _internal::StorageScope);
       tokenAuthPolicy = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-          credential, tokenContext, options.EnableTenantDiscovery);
+          credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefresh);
       perRetryPolicies.emplace_back(tokenAuthPolicy->Clone());
     }
     perOperationPolicies.emplace_back(
@@ -320,18 +320,19 @@ namespace Azure { namespace Storage { namespace Blobs {
       const SubmitBlobBatchOptions& options,
       const Core::Context& context) const
   {
-    (void)options;
-
-    _detail::ServiceClient::SubmitServiceBatchOptions protocolLayerOptions;
-    _detail::StringBodyStream bodyStream(std::string{});
-    auto response = _detail::ServiceClient::SubmitBatch(
-        *m_batchRequestPipeline,
-        m_serviceUrl,
-        bodyStream,
-        protocolLayerOptions,
-        context.WithValue(_detail::s_serviceBatchKey, &batch));
-    return Azure::Response<Models::SubmitBlobBatchResult>(
-        Models::SubmitBlobBatchResult(), std::move(response.RawResponse));
+    return _detail::SubmitBatchSubrequests(
+        batch.m_subrequests,
+        options,
+        context,
+        [this](Core::IO::BodyStream& bodyStream, const Core::Context& batchContext) {
+          _detail::ServiceClient::SubmitServiceBatchOptions protocolLayerOptions;
+          return _detail::ServiceClient::SubmitBatch(
+              *m_batchRequestPipeline,
+              m_serviceUrl,
+              bodyStream,
+              protocolLayerOptions,
+              batchContext);
+        });
   }
 
 }}} // namespace Azure::Storage::Blobs
@@ -174,6 +174,8 @@ namespace Azure { namespace Storage { namespace Blobs {
       return Upload(contentStream, uploadBlockBlobOptions, context);
     }
 
+    int64_t minChunkSize = (bufferSize + MaxBlockNumber - 1) / MaxBlockNumber;
+    minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
     int64_t chunkSize;
     if (options.TransferOptions.ChunkSize.HasValue())
     {
@@ -181,8 +183,6 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     else
     {
-      int64_t minChunkSize = (bufferSize + MaxBlockNumber - 1) / MaxBlockNumber;
-      minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
       chunkSize = (std::max)(DefaultStageBlockSize, minChunkSize);
     }
     if (chunkSize > MaxStageBlockSize)
@@ -209,8 +209,21 @@ namespace Azure { namespace Storage { namespace Blobs {
       }
     };
 
-    _internal::ConcurrentTransfer(
-        0, bufferSize, chunkSize, options.TransferOptions.Concurrency, uploadBlockFunc);
+    if (options.TransferOptions.EnableAdaptiveTransfer)
+    {
+      _internal::AdaptiveTransferTuner tuner(
+          chunkSize,
+          (std::max)(minChunkSize, (std::min)(chunkSize, _internal::MinAdaptiveChunkSize)),
+          (std::max)(chunkSize, _internal::MaxAdaptiveChunkSize),
+          options.TransferOptions.Concurrency);
+      _internal::AdaptiveConcurrentTransfer(
+          0, bufferSize, tuner, options.TransferOptions.Concurrency, uploadBlockFunc);
+    }
+    else
+    {
+      _internal::ConcurrentTransfer(
+          0, bufferSize, chunkSize, options.TransferOptions.Concurrency, uploadBlockFunc);
+    }
 
     for (size_t i = 0; i < blockIds.size(); ++i)
     {
@@ -284,6 +297,8 @@ namespace Azure { namespace Storage { namespace Blobs {
       }
     };
 
+    int64_t minChunkSize = (fileReader.GetFileSize() + MaxBlockNumber - 1) / MaxBlockNumber;
+    minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
     int64_t chunkSize;
     if (options.TransferOptions.ChunkSize.HasValue())
     {
@@ -291,8 +306,6 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     else
     {
-      int64_t minChunkSize = (fileReader.GetFileSize() + MaxBlockNumber - 1) / MaxBlockNumber;
-      minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
       chunkSize = (std::max)(DefaultStageBlockSize, minChunkSize);
     }
     if (chunkSize > MaxStageBlockSize)
@@ -300,12 +313,29 @@ namespace Azure { namespace Storage { namespace Blobs {
       throw Azure::Core::RequestFailedException("Block size is too big.");
     }
 
-    _internal::ConcurrentTransfer(
-        0,
-        fileReader.GetFileSize(),
-        chunkSize,
-        options.TransferOptions.Concurrency,
-        uploadBlockFunc);
+    if (options.TransferOptions.EnableAdaptiveTransfer)
+    {
+      _internal::AdaptiveTransferTuner tuner(
+          chunkSize,
+          (std::max)(minChunkSize, (std::min)(chunkSize, _internal::MinAdaptiveChunkSize)),
+          (std::max)(chunkSize, _internal::MaxAdaptiveChunkSize),
+          options.TransferOptions.Concurrency);
+      _internal::AdaptiveConcurrentTransfer(
+          0,
+          fileReader.GetFileSize(),
+          tuner,
+          options.TransferOptions.Concurrency,
+          uploadBlockFunc);
+    }
+    else
+    {
+      _internal::ConcurrentTransfer(
+          0,
+          fileReader.GetFileSize(),
+          chunkSize,
+          options.TransferOptions.Concurrency,
+          uploadBlockFunc);
+    }
 
     for (size_t i = 0; i < blockIds.size(); ++i)
     {
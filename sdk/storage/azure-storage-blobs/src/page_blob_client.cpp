@@ -4,6 +4,7 @@
 #include "azure/storage/blobs/page_blob_client.hpp"
 
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/buffer_pool.hpp>
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
@@ -11,6 +12,10 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
   PageBlobClient PageBlobClient::CreateFromConnectionString(
@@ -436,6 +441,139 @@ namespace Azure { namespace Storage { namespace Blobs {
     return pagedResponse;
   }
 
+  Azure::Response<Models::DownloadPagesToResult> PageBlobClient::DownloadPagesTo(
+      const std::string& fileName,
+      const DownloadPagesToOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    const bool isDiff
+        = options.PreviousSnapshot.HasValue() || options.PreviousSnapshotUrl.HasValue();
+
+    // List the ranges to download first. Every page after the first one must come from the same
+    // version of the blob.
+    Models::DownloadPagesToResult result;
+    std::unique_ptr<Azure::Core::Http::RawResponse> rawResponse;
+    std::vector<Core::Http::HttpRange> pageRanges;
+    std::vector<Core::Http::HttpRange> clearRanges;
+    GetPageRangesOptions listOptions;
+    listOptions.Range = options.Range;
+    listOptions.AccessConditions = options.AccessConditions;
+    auto onPage = [&](auto& page) {
+      if (!rawResponse)
+      {
+        result.ETag = page.ETag;
+        result.LastModified = page.LastModified;
+        result.BlobSize = page.BlobSize;
+        rawResponse = std::move(page.RawResponse);
+        listOptions.AccessConditions.IfMatch = result.ETag;
+      }
+      pageRanges.insert(pageRanges.end(), page.PageRanges.begin(), page.PageRanges.end());
+      listOptions.ContinuationToken = page.NextPageToken;
+      return page.NextPageToken.HasValue();
+    };
+    if (isDiff)
+    {
+      while (true)
+      {
+        auto page = options.PreviousSnapshotUrl.HasValue()
+            ? GetManagedDiskPageRangesDiff(
+                options.PreviousSnapshotUrl.Value(), listOptions, context)
+            : GetPageRangesDiff(options.PreviousSnapshot.Value(), listOptions, context);
+        clearRanges.insert(clearRanges.end(), page.ClearRanges.begin(), page.ClearRanges.end());
+        if (!onPage(page))
+        {
+          break;
+        }
+      }
+    }
+    else
+    {
+      while (true)
+      {
+        auto page = GetPageRanges(listOptions, context);
+        if (!onPage(page))
+        {
+          break;
+        }
+      }
+    }
+
+    const int64_t rangeBegin = (std::min)(
+        options.Range.HasValue() ? options.Range.Value().Offset : int64_t(0), result.BlobSize);
+    int64_t rangeEnd = result.BlobSize;
+    if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
+    {
+      rangeEnd = (std::min)(rangeEnd, rangeBegin + options.Range.Value().Length.Value());
+    }
+    result.ContentRange.Offset = rangeBegin;
+    result.ContentRange.Length = rangeEnd - rangeBegin;
+
+    // Split the ranges to download into chunks.
+    std::vector<std::pair<int64_t, int64_t>> chunks;
+    for (const auto& pageRange : pageRanges)
+    {
+      const int64_t begin = (std::max)(pageRange.Offset, rangeBegin);
+      const int64_t end = (std::min)(pageRange.Offset + pageRange.Length.Value(), rangeEnd);
+      for (int64_t offset = begin; offset < end; offset += options.TransferOptions.ChunkSize)
+      {
+        const int64_t length = (std::min)(options.TransferOptions.ChunkSize, end - offset);
+        chunks.emplace_back(offset, length);
+        result.DownloadedBytes += length;
+      }
+    }
+
+    // An existing copy of the previous snapshot is updated in place.
+    _internal::FileWriter fileWriter(fileName, !isDiff);
+    fileWriter.SetSize(rangeEnd - rangeBegin);
+    for (const auto& clearRange : clearRanges)
+    {
+      const int64_t begin = (std::max)(clearRange.Offset, rangeBegin);
+      const int64_t end = (std::min)(clearRange.Offset + clearRange.Length.Value(), rangeEnd);
+      if (begin < end)
+      {
+        fileWriter.ZeroRange(begin - rangeBegin, end - begin);
+      }
+    }
+
+    _internal::BufferPool bufferPool(4 * 1024 * 1024);
+    auto downloadChunkFunc = [&](int64_t, int64_t, int64_t chunkId, int64_t) {
+      const auto& chunk = chunks[static_cast<size_t>(chunkId)];
+      DownloadBlobOptions chunkOptions;
+      chunkOptions.Range = Core::Http::HttpRange();
+      chunkOptions.Range.Value().Offset = chunk.first;
+      chunkOptions.Range.Value().Length = chunk.second;
+      chunkOptions.AccessConditions.IfMatch = result.ETag;
+      chunkOptions.AccessConditions.LeaseId = options.AccessConditions.LeaseId;
+      auto response = Download(chunkOptions, context);
+
+      auto buffer = bufferPool.Acquire();
+      int64_t offset = chunk.first - rangeBegin;
+      int64_t length = chunk.second;
+      while (length > 0)
+      {
+        size_t readSize = static_cast<size_t>(std::min<int64_t>(buffer.Size(), length));
+        size_t bytesRead
+            = response.Value.BodyStream->ReadToCount(buffer.Data(), readSize, context);
+        if (bytesRead != readSize)
+        {
+          throw Azure::Core::RequestFailedException("Error when reading body stream.");
+        }
+        fileWriter.Write(buffer.Data(), bytesRead, offset);
+        length -= bytesRead;
+        offset += bytesRead;
+      }
+    };
+    _internal::ConcurrentTransfer(
+        0,
+        static_cast<int64_t>(chunks.size()),
+        1,
+        options.TransferOptions.Concurrency,
+        downloadChunkFunc);
+
+    return Azure::Response<Models::DownloadPagesToResult>(
+        std::move(result), std::move(rawResponse));
+  }
+
   StartBlobCopyOperation PageBlobClient::StartCopyIncremental(
       const std::string& sourceUri,
       const StartBlobCopyIncrementalOptions& options,
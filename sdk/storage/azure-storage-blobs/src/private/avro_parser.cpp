@@ -5,6 +5,7 @@
 
 #include <azure/core/azure_assert.hpp>
 #include <azure/core/internal/json/json.hpp>
+#include <azure/storage/common/internal/thread_pool.hpp>
 
 #include <algorithm>
 #include <cstring>
@@ -184,17 +185,32 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     return AvailableBytes();
   }
 
-  void AvroStreamReader::Discard()
+  void AvroStreamReader::Read(
+      std::vector<uint8_t>& buffer,
+      size_t n,
+      const Core::Context& context)
   {
-    constexpr size_t MinimumReleaseMemory = 128 * 1024;
-    if (m_pos.Offset < MinimumReleaseMemory)
+    buffer.resize(n);
+    const size_t bufferedBytes = (std::min)(n, AvailableBytes());
+    if (bufferedBytes != 0)
     {
-      return;
+      std::memcpy(buffer.data(), &m_streambuffer[m_pos.Offset], bufferedBytes);
+      m_pos.Offset += bufferedBytes;
+    }
+    if (AvailableBytes() == 0)
+    {
+      m_streambuffer.clear();
+      m_pos.Offset = 0;
+    }
+    for (size_t offset = bufferedBytes; offset < n;)
+    {
+      const size_t actualReadSize = m_stream->Read(buffer.data() + offset, n - offset, context);
+      if (actualReadSize == 0)
+      {
+        throw std::runtime_error("Unexpected EOF of Avro stream.");
+      }
+      offset += actualReadSize;
     }
-    const size_t availableBytes = AvailableBytes();
-    std::memmove(&m_streambuffer[0], &m_streambuffer[m_pos.Offset], availableBytes);
-    m_streambuffer.resize(availableBytes);
-    m_pos.Offset = 0;
   }
 
   const AvroSchema AvroSchema::StringSchema(AvroDatumType::String);
@@ -215,6 +231,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     recordSchema.m_status = std::make_shared<SharedStatus>();
     for (auto& i : fieldsSchema)
     {
+      recordSchema.m_status->m_fieldIndexes.emplace(i.first, recordSchema.m_status->m_keys.size());
       recordSchema.m_status->m_keys.push_back(i.first);
       recordSchema.m_status->m_schemas.push_back(i.second);
     }
@@ -503,7 +520,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     auto data = m_data;
 
     AvroRecord r;
-    r.m_keys = &m_schema.FieldNames();
+    r.m_fieldIndexes = &m_schema.FieldIndexes();
+    r.m_values.reserve(m_schema.FieldSchemas().size());
     for (const auto& schema : m_schema.FieldSchemas())
     {
       auto datum = AvroDatum(schema);
@@ -556,9 +574,133 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     AZURE_UNREACHABLE_CODE();
   }
 
+  AvroDatum AvroDatum::FieldAt(size_t i) const
+  {
+    AZURE_ASSERT(m_schema.Type() == AvroDatumType::Record);
+    auto data = m_data;
+    const auto& fieldSchemas = m_schema.FieldSchemas();
+    for (size_t j = 0; j < i; ++j)
+    {
+      AvroDatum(fieldSchemas[j]).Fill(data);
+    }
+    auto datum = AvroDatum(fieldSchemas.at(i));
+    datum.m_data = data;
+    return datum;
+  }
+
   AvroObjectContainerReader::AvroObjectContainerReader(Core::IO::BodyStream& stream)
-      : m_reader(std::make_unique<AvroStreamReader>(stream))
+      : m_reader(std::make_shared<AvroStreamReader>(stream)),
+        m_currentPos{&m_currentBlock.Data, 0}
+  {
+  }
+
+  AvroObjectContainerReader::~AvroObjectContainerReader()
+  {
+    if (!m_nextBlockRead)
+    {
+      return;
+    }
+    // A read that hasn't started is dropped. A running one is cancelled, and has to finish before
+    // the stream goes away.
+    std::unique_lock<std::mutex> guard(m_nextBlockRead->Mutex);
+    if (!m_nextBlockRead->Started)
+    {
+      m_nextBlockRead->Started = true;
+      return;
+    }
+    m_nextBlockRead->Context.Cancel();
+    auto& blockRead = *m_nextBlockRead;
+    blockRead.Cond.wait(guard, [&blockRead]() { return blockRead.Done; });
+  }
+
+  void AvroObjectContainerReader::ReadBlock(
+      AvroStreamReader& reader,
+      const std::string& syncMarker,
+      Block& block,
+      const Core::Context& context)
+  {
+    constexpr size_t SyncMarkerSize = 16;
+    if (reader.TryPreload(1, context) == 0)
+    {
+      block.ObjectCount = 0;
+      block.Data.clear();
+      return;
+    }
+    block.ObjectCount = reader.ParseInt(context);
+    const int64_t objectsSize = reader.ParseInt(context);
+    if (block.ObjectCount <= 0 || objectsSize < 0)
+    {
+      throw std::runtime_error("Invalid Avro block header.");
+    }
+    reader.Read(block.Data, static_cast<size_t>(objectsSize) + SyncMarkerSize, context);
+    if (std::memcmp(block.Data.data() + objectsSize, syncMarker.data(), SyncMarkerSize) != 0)
+    {
+      throw std::runtime_error("Sync marker doesn't match.");
+    }
+  }
+
+  void AvroObjectContainerReader::RunBlockRead(
+      BlockRead& blockRead,
+      const Core::Context& context)
+  {
+    {
+      std::lock_guard<std::mutex> guard(blockRead.Mutex);
+      if (blockRead.Started)
+      {
+        return;
+      }
+      blockRead.Started = true;
+    }
+    try
+    {
+      ReadBlock(*blockRead.Reader, blockRead.SyncMarker, blockRead.Result, context);
+    }
+    catch (...)
+    {
+      blockRead.Error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> guard(blockRead.Mutex);
+      blockRead.Done = true;
+    }
+    blockRead.Cond.notify_all();
+  }
+
+  void AvroObjectContainerReader::StartReadingNextBlock(
+      std::vector<uint8_t> buffer,
+      const Core::Context& context)
+  {
+    auto blockRead = std::make_shared<BlockRead>();
+    blockRead->Reader = m_reader;
+    blockRead->SyncMarker = m_syncMarker;
+    blockRead->Context = context.WithDeadline((DateTime::max)());
+    // Reuses the memory of a consumed block.
+    blockRead->Result.Data = std::move(buffer);
+    m_nextBlockRead = blockRead;
+    _internal::ThreadPool::GetDefault().Submit(
+        [blockRead]() { RunBlockRead(*blockRead, blockRead->Context); });
+  }
+
+  void AvroObjectContainerReader::FinishBlockRead(
+      BlockRead& blockRead,
+      const Core::Context& context)
   {
+    // Reads the block on this thread if no thread of the pool has picked it up yet.
+    RunBlockRead(blockRead, context);
+    std::unique_lock<std::mutex> guard(blockRead.Mutex);
+    blockRead.Cond.wait(guard, [&blockRead]() { return blockRead.Done; });
+  }
+
+  AvroObjectContainerReader::Block AvroObjectContainerReader::WaitForNextBlock(
+      const Core::Context& context)
+  {
+    auto blockRead = std::move(m_nextBlockRead);
+    FinishBlockRead(*blockRead, context);
+    if (blockRead->Error)
+    {
+      std::rethrow_exception(blockRead->Error);
+    }
+    return std::move(blockRead->Result);
   }
 
   AvroDatum AvroObjectContainerReader::NextImpl(
@@ -598,28 +740,36 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       m_syncMarker = fileHeader.Field("sync").Value<std::string>();
       m_objectSchema = std::make_unique<AvroSchema>(ParseSchemaFromJsonString(objectSchemaJson));
       schema = m_objectSchema.get();
-    }
 
-    if (m_remainingObjectInCurrentBlock == 0)
+      ReadBlock(*m_reader, m_syncMarker, m_currentBlock, context);
+      if (m_currentBlock.ObjectCount == 0)
+      {
+        throw std::runtime_error("Avro stream doesn't contain any object.");
+      }
+      m_remainingObjectInCurrentBlock = m_currentBlock.ObjectCount;
+      StartReadingNextBlock(std::vector<uint8_t>(), context);
+    }
+    else if (m_remainingObjectInCurrentBlock == 0)
     {
-      m_reader->Discard();
-      m_remainingObjectInCurrentBlock = m_reader->ParseInt(context);
-      int64_t ObjectsSize = m_reader->ParseInt(context);
-      m_reader->Preload(static_cast<size_t>(ObjectsSize), context);
+      auto nextBlock = WaitForNextBlock(context);
+      std::swap(m_currentBlock, nextBlock);
+      m_currentPos.Offset = 0;
+      m_remainingObjectInCurrentBlock = m_currentBlock.ObjectCount;
+      StartReadingNextBlock(std::move(nextBlock.Data), context);
     }
 
     auto objectDatum = AvroDatum(*m_objectSchema);
-    objectDatum.Fill(*m_reader, context);
+    objectDatum.Fill(m_currentPos);
+    if (m_currentPos.Offset > m_currentBlock.Data.size())
+    {
+      throw std::runtime_error("Avro object exceeds the size of its block.");
+    }
     if (--m_remainingObjectInCurrentBlock == 0)
     {
-      auto markerDatum = AvroDatum(SyncMarkerSchema);
-      markerDatum.Fill(*m_reader, context);
-      auto marker = markerDatum.Value<std::string>();
-      if (marker != m_syncMarker)
-      {
-        throw std::runtime_error("Sync marker doesn't match.");
-      }
-      m_eof = m_reader->TryPreload(1, context) == 0;
+      // The returned object points into the current block, so the next block isn't swapped in
+      // until the next call.
+      FinishBlockRead(*m_nextBlockRead, context);
+      m_eof = !m_nextBlockRead->Error && m_nextBlockRead->Result.ObjectCount == 0;
     }
     return objectDatum;
   }
@@ -650,8 +800,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
       }
       if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.resultData")
       {
-        auto record = datum.Value<AvroRecord>();
-        auto dataDatum = record.Field("data");
+        // Result records are the bulk of the stream, their data is referenced in place.
+        auto dataDatum = datum.FieldAt(datum.Schema().FieldIndexes().at("data"));
         m_parserBuffer = dataDatum.Value<AvroDatum::StringView>();
         return OnRead(buffer, count, context);
       }
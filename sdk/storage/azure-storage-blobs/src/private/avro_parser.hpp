@@ -7,8 +7,11 @@
 
 #include <azure/core/io/body_stream.hpp>
 
+#include <condition_variable>
+#include <exception>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 
 namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
@@ -51,8 +54,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     // available in m_streambuffer;
     size_t Preload(size_t n, const Core::Context& context);
     size_t TryPreload(size_t n, const Core::Context& context);
-    // discards data that's before m_pos
-    void Discard();
+    // Reads n bytes into buffer. Bytes that aren't buffered yet are read from m_stream directly.
+    void Read(std::vector<uint8_t>& buffer, size_t n, const Core::Context& context);
 
   private:
     size_t AvailableBytes() const { return m_streambuffer.size() - m_pos.Offset; }
@@ -88,6 +91,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     const std::vector<std::string>& FieldNames() const { return m_status->m_keys; }
     AvroSchema ItemSchema() const { return m_status->m_schemas[0]; }
     const std::vector<AvroSchema>& FieldSchemas() const { return m_status->m_schemas; }
+    // Index of each field of a record, resolved when the schema is parsed.
+    const std::map<std::string, size_t>& FieldIndexes() const { return m_status->m_fieldIndexes; }
     size_t Size() const { return static_cast<size_t>(m_status->m_size); }
 
   private:
@@ -100,6 +105,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     struct SharedStatus
     {
       std::vector<std::string> m_keys;
+      std::map<std::string, size_t> m_fieldIndexes;
       std::vector<AvroSchema> m_schemas;
       int64_t m_size = 0;
     };
@@ -110,7 +116,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
 
   class AvroRecord final {
   public:
-    bool HasField(const std::string& key) const { return FindField(key) != m_keys->size(); }
+    bool HasField(const std::string& key) const { return FindField(key) != m_values.size(); }
     const AvroDatum& Field(const std::string& key) const { return m_values.at(FindField(key)); }
     AvroDatum& Field(const std::string& key) { return m_values.at(FindField(key)); }
     const AvroDatum& FieldAt(size_t i) const { return m_values.at(i); }
@@ -119,10 +125,10 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   private:
     size_t FindField(const std::string& key) const
     {
-      auto i = find(m_keys->begin(), m_keys->end(), key);
-      return i - m_keys->begin();
+      auto i = m_fieldIndexes->find(key);
+      return i == m_fieldIndexes->end() ? m_values.size() : i->second;
     }
-    const std::vector<std::string>* m_keys = nullptr;
+    const std::map<std::string, size_t>* m_fieldIndexes = nullptr;
     std::vector<AvroDatum> m_values;
 
     friend class AvroDatum;
@@ -141,6 +147,8 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     const AvroSchema& Schema() const { return m_schema; }
 
     template <class T> T Value() const;
+    // Returns the i-th field of a record without decoding the other fields that follow it.
+    AvroDatum FieldAt(size_t i) const;
     struct StringView
     {
       const uint8_t* Data = nullptr;
@@ -152,9 +160,14 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     AvroStreamReader::ReaderPos m_data;
   };
 
+  // Objects are decoded in place from the block that holds them. The next block is read from the
+  // stream on a thread of the shared pool while the objects of the current block are consumed.
   class AvroObjectContainerReader final {
   public:
     explicit AvroObjectContainerReader(Core::IO::BodyStream& stream);
+    AvroObjectContainerReader(const AvroObjectContainerReader&) = delete;
+    AvroObjectContainerReader& operator=(const AvroObjectContainerReader&) = delete;
+    ~AvroObjectContainerReader();
 
     bool End() const { return m_eof; }
     // Calling Next() will invalidates the previous AvroDatum returned by this function and all
@@ -162,12 +175,49 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     AvroDatum Next(const Core::Context& context) { return NextImpl(m_objectSchema.get(), context); }
 
   private:
+    struct Block final
+    {
+      // Serialized objects of the block, followed by the sync marker.
+      std::vector<uint8_t> Data;
+      int64_t ObjectCount = 0;
+    };
+
+    // A block being read, either by a thread of the pool or by the thread that needs it first.
+    // It only holds shared state, so a thread of the pool can pick it up after the container
+    // reader is destroyed, and find that there is nothing left to do.
+    struct BlockRead final
+    {
+      std::shared_ptr<AvroStreamReader> Reader;
+      std::string SyncMarker;
+      // Cancelled when the container reader is destroyed while the block is being read.
+      Core::Context Context;
+      std::mutex Mutex;
+      std::condition_variable Cond;
+      bool Started = false;
+      bool Done = false;
+      Block Result;
+      std::exception_ptr Error;
+    };
+
     AvroDatum NextImpl(const AvroSchema* schema, const Core::Context& context);
+    // Reads the next block into block. The block has no objects at the end of the stream.
+    static void ReadBlock(
+        AvroStreamReader& reader,
+        const std::string& syncMarker,
+        Block& block,
+        const Core::Context& context);
+    void StartReadingNextBlock(std::vector<uint8_t> buffer, const Core::Context& context);
+    static void RunBlockRead(BlockRead& blockRead, const Core::Context& context);
+    static void FinishBlockRead(BlockRead& blockRead, const Core::Context& context);
+    Block WaitForNextBlock(const Core::Context& context);
 
   private:
-    std::unique_ptr<AvroStreamReader> m_reader;
+    std::shared_ptr<AvroStreamReader> m_reader;
     std::unique_ptr<AvroSchema> m_objectSchema;
     std::string m_syncMarker;
+    Block m_currentBlock;
+    AvroStreamReader::ReaderPos m_currentPos;
+    std::shared_ptr<BlockRead> m_nextBlockRead;
     int64_t m_remainingObjectInCurrentBlock = 0;
     bool m_eof = false;
   };
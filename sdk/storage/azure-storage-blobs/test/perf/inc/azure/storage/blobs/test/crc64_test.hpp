@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of computing the CRC64 of a buffer.
+ *
+ */
+
+#pragma once
+
+#include <azure/perf.hpp>
+#include <azure/perf/random_stream.hpp>
+#include <azure/storage/common/crypt.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief A test to measure the CRC64 used for transactional checksums, without any network
+   * access. Multiply the operations per second by the size to get the throughput.
+   *
+   */
+  class Crc64Test : public Azure::Perf::PerfTest {
+  private:
+    std::vector<uint8_t> m_buffer;
+
+  public:
+    /**
+     * @brief Construct a new Crc64Test test.
+     *
+     * @param options The test options.
+     */
+    Crc64Test(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    /**
+     * @brief The size of the buffer is defined by a mandatory parameter.
+     *
+     */
+    void Setup() override
+    {
+      long size = m_options.GetMandatoryOption<long>("Size");
+      m_buffer = Azure::Perf::RandomStream::Create(size)->ReadToEnd(
+          Azure::Core::Context::ApplicationContext);
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      Azure::Storage::Crc64Hash crc64;
+      crc64.Final(m_buffer.data(), m_buffer.size());
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {{"Size", {"--size", "-s"}, "Size of the buffer (in bytes)", 1, true}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {"Crc64", "Compute the CRC64 of a buffer.", [](Azure::Perf::TestOptions options) {
+                return std::make_unique<Azure::Storage::Blobs::Test::Crc64Test>(options);
+              }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
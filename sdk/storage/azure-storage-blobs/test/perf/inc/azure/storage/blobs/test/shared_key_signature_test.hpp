@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of signing a request with a shared key.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/http/http.hpp>
+#include <azure/core/http/policies/policy.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/common/internal/shared_key_policy.hpp>
+#include <azure/storage/common/storage_credential.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief A test to measure the SharedKey signature computed for each request authorized with a
+   * storage account key, without any network access.
+   *
+   */
+  class SharedKeySignatureTest : public Azure::Perf::PerfTest {
+  private:
+    class NoopTransportPolicy final : public Azure::Core::Http::Policies::HttpPolicy {
+    public:
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<NoopTransportPolicy>(*this);
+      }
+
+      std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+          Azure::Core::Http::Request&,
+          Azure::Core::Http::Policies::NextHttpPolicy,
+          Azure::Core::Context const&) const override
+      {
+        return nullptr;
+      }
+    };
+
+    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> m_policies;
+    std::unique_ptr<Azure::Core::Http::Request> m_request;
+
+  public:
+    /**
+     * @brief Construct a new SharedKeySignatureTest test.
+     *
+     * @param options The test options.
+     */
+    SharedKeySignatureTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    /**
+     * @brief The request is shaped like a Put Block request with a few metadata headers.
+     *
+     */
+    void Setup() override
+    {
+      auto credential = std::make_shared<StorageSharedKeyCredential>(
+          "account",
+          "Eby8vdM02xNOcqFlqUwJPLlmEtlCDXJ1OUzFT50uSRZ6IFsuFq2UVErCz4I6tq/"
+          "K1SZFPTOtr/KBHBeksoGMGw==");
+      m_policies.push_back(std::make_unique<_internal::SharedKeyPolicy>(credential));
+      m_policies.push_back(std::make_unique<NoopTransportPolicy>());
+
+      m_request = std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Put,
+          Azure::Core::Url("https://account.blob.core.windows.net/container/blob"
+                           "?comp=block&blockid=QUFBQQ%3D%3D&timeout=30"));
+      m_request->SetHeader("Content-Length", "1024");
+      m_request->SetHeader("Content-Type", "application/octet-stream");
+      m_request->SetHeader("x-ms-version", "2024-08-04");
+      m_request->SetHeader("x-ms-date", "Thu, 01 Jan 2026 00:00:00 GMT");
+      m_request->SetHeader("x-ms-client-request-id", "0f8fad5b-d9cb-469f-a165-70867728950e");
+      m_request->SetHeader("x-ms-blob-type", "BlockBlob");
+      long metadataCount = m_options.GetOptionOrDefault<long>("MetadataCount", 2);
+      for (long i = 0; i < metadataCount; ++i)
+      {
+        m_request->SetHeader("x-ms-meta-key" + std::to_string(i), "value" + std::to_string(i));
+      }
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      m_policies[0]->Send(
+          *m_request, Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies), context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"MetadataCount",
+           {"--metadata-count"},
+           "Number of metadata headers on the request. Default to 2.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "SharedKeySignature",
+          "Sign a request with a storage account key.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::SharedKeySignatureTest>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
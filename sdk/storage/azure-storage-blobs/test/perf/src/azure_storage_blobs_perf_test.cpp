@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#include "azure/storage/blobs/test/crc64_test.hpp"
 #include "azure/storage/blobs/test/download_blob_from_sas.hpp"
 #include "azure/storage/blobs/test/download_blob_pipeline_only.hpp"
 #include "azure/storage/blobs/test/download_blob_test.hpp"
@@ -12,6 +13,7 @@
 #endif
 
 #include "azure/storage/blobs/test/list_blob_test.hpp"
+#include "azure/storage/blobs/test/shared_key_signature_test.hpp"
 #include "azure/storage/blobs/test/upload_blob_test.hpp"
 
 int main(int argc, char** argv)
@@ -25,6 +27,8 @@ int main(int argc, char** argv)
         Azure::Storage::Blobs::Test::UploadBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::ListBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::DownloadBlobSas::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::Crc64Test::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::SharedKeySignatureTest::GetTestMetadata(),
 #if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
         Azure::Storage::Blobs::Test::DownloadBlobWithTransportOnly::GetTestMetadata(),
 #endif
@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/context.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// The next include is from an Azure Storage Blobs private header.
+// It is included to check how the Avro reader reads the blocks of a query response ahead.
+#include <private/avro_parser.hpp>
+
+using Azure::Storage::Blobs::_detail::AvroObjectContainerReader;
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    const std::string SyncMarker = "0123456789abcdef";
+
+    void AppendLong(std::vector<uint8_t>& data, int64_t value)
+    {
+      auto zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+      while (zigzag >= 0x80)
+      {
+        data.push_back(static_cast<uint8_t>(zigzag | 0x80));
+        zigzag >>= 7;
+      }
+      data.push_back(static_cast<uint8_t>(zigzag));
+    }
+
+    void AppendString(std::vector<uint8_t>& data, const std::string& value)
+    {
+      AppendLong(data, static_cast<int64_t>(value.size()));
+      data.insert(data.end(), value.begin(), value.end());
+    }
+
+    /**
+     * @brief Builds an Avro object container of longs. The objects are numbered from 0, and
+     * blockSizes has the number of objects of each block.
+     *
+     * @param blockOffsets Receives the offset of each block in the container.
+     */
+    std::vector<uint8_t> CreateContainer(
+        const std::vector<int64_t>& blockSizes,
+        std::vector<size_t>& blockOffsets)
+    {
+      std::vector<uint8_t> data = {'O', 'b', 'j', 1};
+      AppendLong(data, 1);
+      AppendString(data, "avro.schema");
+      AppendString(data, "\"long\"");
+      AppendLong(data, 0);
+      data.insert(data.end(), SyncMarker.begin(), SyncMarker.end());
+
+      int64_t value = 0;
+      for (auto blockSize : blockSizes)
+      {
+        blockOffsets.push_back(data.size());
+        std::vector<uint8_t> objects;
+        for (int64_t i = 0; i < blockSize; ++i)
+        {
+          AppendLong(objects, value++);
+        }
+        AppendLong(data, blockSize);
+        AppendLong(data, static_cast<int64_t>(objects.size()));
+        data.insert(data.end(), objects.begin(), objects.end());
+        data.insert(data.end(), SyncMarker.begin(), SyncMarker.end());
+      }
+      return data;
+    }
+
+    /**
+     * @brief Returns the data a few bytes at a time. Reading at PauseOffset waits until the read is
+     * cancelled, and reading at FailOffset throws.
+     */
+    class TestAvroStream final : public Core::IO::BodyStream {
+    public:
+      explicit TestAvroStream(std::vector<uint8_t> data) : m_data(std::move(data)) {}
+
+      size_t PauseOffset = (std::numeric_limits<size_t>::max)();
+      size_t FailOffset = (std::numeric_limits<size_t>::max)();
+
+      int64_t Length() const override { return static_cast<int64_t>(m_data.size()); }
+
+      bool WaitUntilPaused()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_stateChanged.wait_for(
+            lock, std::chrono::seconds(30), [this]() { return m_paused; });
+      }
+
+      bool Cancelled()
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cancelled;
+      }
+
+    private:
+      std::vector<uint8_t> m_data;
+      size_t m_offset = 0;
+      std::mutex m_mutex;
+      std::condition_variable m_stateChanged;
+      bool m_paused = false;
+      bool m_cancelled = false;
+
+      size_t OnRead(uint8_t* buffer, size_t count, const Core::Context& context) override
+      {
+        if (m_offset == FailOffset)
+        {
+          throw std::runtime_error("The connection was closed.");
+        }
+        if (m_offset == PauseOffset)
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_paused = true;
+          m_stateChanged.notify_all();
+          while (!context.IsCancelled())
+          {
+            m_stateChanged.wait_for(lock, std::chrono::milliseconds(10));
+          }
+          m_cancelled = true;
+          context.ThrowIfCancelled();
+        }
+        const auto end = (std::min)(m_data.size(), (std::min)(PauseOffset, FailOffset));
+        const size_t bytesRead = (std::min)((std::min)(count, end - m_offset), size_t(7));
+        std::memcpy(buffer, m_data.data() + m_offset, bytesRead);
+        m_offset += bytesRead;
+        return bytesRead;
+      }
+    };
+
+    std::vector<int64_t> ReadAll(AvroObjectContainerReader& reader)
+    {
+      std::vector<int64_t> values;
+      while (!reader.End())
+      {
+        values.push_back(reader.Next(Core::Context()).Value<int64_t>());
+      }
+      return values;
+    }
+  } // namespace
+
+  TEST(AvroObjectContainerReaderTest, ReadAheadKeepsObjectOrder)
+  {
+    std::vector<size_t> blockOffsets;
+    TestAvroStream stream(CreateContainer({3, 1, 70, 2, 5}, blockOffsets));
+    AvroObjectContainerReader reader(stream);
+
+    auto const values = ReadAll(reader);
+    ASSERT_EQ(values.size(), 81U);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      EXPECT_EQ(values[i], static_cast<int64_t>(i));
+    }
+  }
+
+  TEST(AvroObjectContainerReaderTest, ErrorInBlock)
+  {
+    {
+      // The sync marker of the last block is corrupted.
+      std::vector<size_t> blockOffsets;
+      auto data = CreateContainer({2, 2, 2}, blockOffsets);
+      data.back() = 'x';
+      TestAvroStream stream(std::move(data));
+      AvroObjectContainerReader reader(stream);
+
+      for (int64_t i = 0; i < 4; ++i)
+      {
+        EXPECT_EQ(reader.Next(Core::Context()).Value<int64_t>(), i);
+      }
+      EXPECT_FALSE(reader.End());
+      EXPECT_THROW(reader.Next(Core::Context()), std::runtime_error);
+    }
+    {
+      // The stream fails in the middle of the second block, while it's read ahead.
+      std::vector<size_t> blockOffsets;
+      TestAvroStream stream(CreateContainer({2, 2, 2}, blockOffsets));
+      stream.FailOffset = blockOffsets[1] + 3;
+      AvroObjectContainerReader reader(stream);
+
+      EXPECT_EQ(reader.Next(Core::Context()).Value<int64_t>(), 0);
+      EXPECT_EQ(reader.Next(Core::Context()).Value<int64_t>(), 1);
+      EXPECT_THROW(reader.Next(Core::Context()), std::runtime_error);
+    }
+  }
+
+  TEST(AvroObjectContainerReaderTest, DestroyWhileReadingAhead)
+  {
+    std::vector<size_t> blockOffsets;
+    TestAvroStream stream(CreateContainer({2, 2}, blockOffsets));
+    stream.PauseOffset = blockOffsets[1];
+    auto reader = std::make_unique<AvroObjectContainerReader>(stream);
+
+    // Reading the first object starts reading the second block ahead, which doesn't complete.
+    EXPECT_EQ(reader->Next(Core::Context()).Value<int64_t>(), 0);
+    ASSERT_TRUE(stream.WaitUntilPaused());
+
+    // Destroying the reader cancels the read, and waits for it before the stream can go away.
+    reader.reset();
+    EXPECT_TRUE(stream.Cancelled());
+  }
+
+}}} // namespace Azure::Storage::Test
@@ -78,6 +78,102 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_NO_THROW(blob3Client.GetProperties());
   }
 
+  TEST_F(BlobContainerClientTest, ContainerBatchSubmitSplit_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+
+    const size_t numBlobs = 300;
+
+    std::vector<Blobs::AppendBlobClient> blobClients;
+    for (size_t i = 0; i < numBlobs; ++i)
+    {
+      blobClients.push_back(containerClient.GetAppendBlobClient("b" + std::to_string(i)));
+      blobClients.back().Create();
+    }
+
+    auto batch = containerClient.CreateBatch();
+    std::vector<DeferredResponse<Blobs::Models::DeleteBlobResult>> deleteResponses;
+    for (const auto& blobClient : blobClients)
+    {
+      deleteResponses.push_back(batch.DeleteBlobUrl(blobClient.GetUrl()));
+    }
+    Blobs::SubmitBlobBatchOptions options;
+    options.Concurrency = 2;
+    auto submitBatchResponse = containerClient.SubmitBatch(batch, options);
+
+    for (auto& deleteResponse : deleteResponses)
+    {
+      EXPECT_TRUE(deleteResponse.GetResponse().Value.Deleted);
+    }
+    EXPECT_THROW(blobClients.front().GetProperties(), StorageException);
+    EXPECT_THROW(blobClients.back().GetProperties(), StorageException);
+  }
+
+  namespace {
+    struct TestBatchSubrequest final : public Blobs::_detail::BatchSubrequest
+    {
+      TestBatchSubrequest() : BatchSubrequest(Blobs::_detail::BatchSubrequestType::DeleteBlob) {}
+    };
+
+    std::vector<std::shared_ptr<Blobs::_detail::BatchSubrequest>> CreateTestSubrequests(
+        size_t count)
+    {
+      std::vector<std::shared_ptr<Blobs::_detail::BatchSubrequest>> subrequests;
+      for (size_t i = 0; i < count; ++i)
+      {
+        subrequests.push_back(std::make_shared<TestBatchSubrequest>());
+      }
+      return subrequests;
+    }
+  } // namespace
+
+  TEST(BlobBatchTest, SplitSubrequests)
+  {
+    EXPECT_TRUE(Blobs::_detail::SplitBatchSubrequests(CreateTestSubrequests(0)).empty());
+
+    auto subBatches = Blobs::_detail::SplitBatchSubrequests(CreateTestSubrequests(256));
+    ASSERT_EQ(subBatches.size(), 1U);
+    EXPECT_EQ(subBatches[0].size(), 256U);
+
+    // The subrequests are split in order, and the completed ones are left out.
+    auto subrequests = CreateTestSubrequests(600);
+    subrequests[0]->Completed = true;
+    subrequests[300]->Completed = true;
+    subBatches = Blobs::_detail::SplitBatchSubrequests(subrequests);
+    ASSERT_EQ(subBatches.size(), 3U);
+    EXPECT_EQ(subBatches[0].size(), 256U);
+    EXPECT_EQ(subBatches[1].size(), 256U);
+    EXPECT_EQ(subBatches[2].size(), 86U);
+    EXPECT_EQ(subBatches[0].front(), subrequests[1].get());
+    EXPECT_EQ(subBatches[0].back(), subrequests[256].get());
+    EXPECT_EQ(subBatches[1].front(), subrequests[257].get());
+    EXPECT_EQ(subBatches[1].back(), subrequests[513].get());
+    EXPECT_EQ(subBatches[2].front(), subrequests[514].get());
+    EXPECT_EQ(subBatches[2].back(), subrequests[599].get());
+  }
+
+  TEST(BlobBatchTest, ResubmitCompletedBatch)
+  {
+    auto subrequests = CreateTestSubrequests(2);
+    for (auto& subrequest : subrequests)
+    {
+      subrequest->Completed = true;
+    }
+    bool submitted = false;
+    EXPECT_THROW(
+        Blobs::_detail::SubmitBatchSubrequests(
+            subrequests,
+            Blobs::SubmitBlobBatchOptions(),
+            Core::Context(),
+            [&submitted](Core::IO::BodyStream&, const Core::Context&)
+                -> Response<Blobs::Models::_detail::SubmitBatchResult> {
+              submitted = true;
+              throw std::runtime_error("unexpected batch request");
+            }),
+        std::invalid_argument);
+    EXPECT_FALSE(submitted);
+  }
+
   TEST_F(BlobContainerClientTest, BatchSnapshotVersion_LIVEONLY_)
   {
     const std::string containerNamePrefix = LowercaseRandomString();
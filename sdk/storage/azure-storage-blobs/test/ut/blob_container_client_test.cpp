@@ -362,6 +362,77 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(items, blobs);
   }
 
+  TEST_F(BlobContainerClientTest, ListBlobsParallel)
+  {
+    auto containerClient = *m_blobContainerClient;
+
+    const std::string prefix = RandomString() + "/";
+    const std::vector<std::string> directories
+        = {"", "dir1/", "dir1/dir2/", "dir3/", "dir3/dir4/dir5/"};
+    std::set<std::string> blobs;
+    for (const auto& directory : directories)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        std::string blobName = prefix + directory + RandomString() + std::to_string(i);
+        auto blobClient = containerClient.GetBlockBlobClient(blobName);
+        auto emptyContent = Azure::Core::IO::MemoryBodyStream(nullptr, 0);
+        blobClient.Upload(emptyContent);
+        blobs.insert(blobName);
+      }
+    }
+
+    auto listBlobs = [&](const Blobs::ListBlobsParallelOptions& options) {
+      std::multiset<std::string> items;
+      auto enumerator = containerClient.ListBlobsParallel(options);
+      std::vector<Blobs::Models::BlobItem> page;
+      while (enumerator.GetNextPage(page))
+      {
+        for (const auto& blob : page)
+        {
+          items.insert(blob.Name);
+        }
+      }
+      return items;
+    };
+
+    Blobs::ListBlobsParallelOptions options;
+    options.Prefix = prefix;
+    options.PageSizeHint = 2;
+    options.Concurrency = 3;
+    options.MaxBufferedPages = 3;
+    auto items = listBlobs(options);
+    EXPECT_EQ(std::set<std::string>(items.begin(), items.end()), blobs);
+    EXPECT_EQ(items.size(), blobs.size());
+
+    options.MaxFanOutDepth = 1;
+    items = listBlobs(options);
+    EXPECT_EQ(std::set<std::string>(items.begin(), items.end()), blobs);
+    EXPECT_EQ(items.size(), blobs.size());
+
+    // The blobs at the root of the prefix aren't in any partition.
+    options.MaxFanOutDepth.Reset();
+    options.Partitions = {"dir1/", "dir3/"};
+    items = listBlobs(options);
+    std::set<std::string> partitionBlobs;
+    for (const auto& blob : blobs)
+    {
+      if (blob.find('/', prefix.length()) != std::string::npos)
+      {
+        partitionBlobs.insert(blob);
+      }
+    }
+    EXPECT_EQ(std::set<std::string>(items.begin(), items.end()), partitionBlobs);
+    EXPECT_EQ(items.size(), partitionBlobs.size());
+
+    // Stopping the listing before every page was read.
+    {
+      auto enumerator = containerClient.ListBlobsParallel(options);
+      std::vector<Blobs::Models::BlobItem> page;
+      EXPECT_TRUE(enumerator.GetNextPage(page));
+    }
+  }
+
   TEST_F(BlobContainerClientTest, ListBlobsOtherStuff)
   {
     // NOTE: This test Requires storage account with versioning enabled!
@@ -8,6 +8,7 @@
 #include <azure/storage/common/crypt.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
 
+#include <algorithm>
 #include <future>
 #include <vector>
 
@@ -268,6 +269,62 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(numItems, 1);
   }
 
+  TEST_F(PageBlobClientTest, DownloadPagesTo)
+  {
+    auto pageBlobClient = *m_pageBlobClient;
+
+    std::vector<uint8_t> blobContent(static_cast<size_t>(8_KB), '\x00');
+    pageBlobClient.Create(8_KB);
+    std::vector<uint8_t> pageContent = RandomBuffer(static_cast<size_t>(1_KB));
+    auto pageStream = Azure::Core::IO::MemoryBodyStream(pageContent.data(), pageContent.size());
+    pageBlobClient.UploadPages(2_KB, pageStream);
+    // |_|_|x|_|  |_|_|_|_|
+    std::copy(
+        pageContent.begin(), pageContent.end(), blobContent.begin() + static_cast<size_t>(2_KB));
+
+    const std::string fileName = RandomString();
+    Blobs::DownloadPagesToOptions options;
+    options.TransferOptions.ChunkSize = 512;
+    auto result = pageBlobClient.DownloadPagesTo(fileName, options);
+    EXPECT_EQ(static_cast<uint64_t>(result.Value.BlobSize), 8_KB);
+    EXPECT_EQ(result.Value.ContentRange.Offset, 0);
+    EXPECT_EQ(static_cast<uint64_t>(result.Value.ContentRange.Length.Value()), 8_KB);
+    EXPECT_EQ(static_cast<uint64_t>(result.Value.DownloadedBytes), 1_KB);
+    EXPECT_EQ(ReadFile(fileName), blobContent);
+
+    options.Range = Core::Http::HttpRange();
+    options.Range.Value().Offset = 1_KB;
+    options.Range.Value().Length = 2_KB;
+    result = pageBlobClient.DownloadPagesTo(fileName, options);
+    EXPECT_EQ(static_cast<uint64_t>(result.Value.DownloadedBytes), 1_KB);
+    EXPECT_EQ(
+        ReadFile(fileName),
+        std::vector<uint8_t>(
+            blobContent.begin() + static_cast<size_t>(1_KB),
+            blobContent.begin() + static_cast<size_t>(3_KB)));
+
+    // Update a copy of a snapshot with the pages changed since.
+    options.Range.Reset();
+    pageBlobClient.DownloadPagesTo(fileName, options);
+    auto snapshot = pageBlobClient.CreateSnapshot().Value.Snapshot;
+    pageContent = RandomBuffer(static_cast<size_t>(1_KB));
+    pageStream = Azure::Core::IO::MemoryBodyStream(pageContent.data(), pageContent.size());
+    pageBlobClient.UploadPages(6_KB, pageStream);
+    pageBlobClient.ClearPages({2_KB, 512});
+    std::copy(
+        pageContent.begin(), pageContent.end(), blobContent.begin() + static_cast<size_t>(6_KB));
+    std::fill(
+        blobContent.begin() + static_cast<size_t>(2_KB),
+        blobContent.begin() + static_cast<size_t>(2_KB + 512),
+        '\x00');
+
+    options.PreviousSnapshot = snapshot;
+    result = pageBlobClient.DownloadPagesTo(fileName, options);
+    EXPECT_EQ(static_cast<uint64_t>(result.Value.DownloadedBytes), 1_KB);
+    EXPECT_EQ(ReadFile(fileName), blobContent);
+    DeleteFile(fileName);
+  }
+
   TEST_F(PageBlobClientTest, UploadFromUri)
   {
     auto pageBlobClient = *m_pageBlobClient;
@@ -7,6 +7,7 @@
 #include <azure/core/cryptography/hash.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,28 @@ namespace Azure { namespace Storage {
     std::vector<uint8_t> HmacSha256(
         const std::vector<uint8_t>& data,
         const std::vector<uint8_t>& key);
+
+    /**
+     * @brief HMAC-SHA256 with a fixed key. The key is processed once when the object is
+     * constructed, each signature only hashes the data.
+     */
+    class HmacSha256Key final {
+    public:
+      explicit HmacSha256Key(const std::vector<uint8_t>& key);
+      HmacSha256Key(const HmacSha256Key&) = delete;
+      HmacSha256Key& operator=(const HmacSha256Key&) = delete;
+      ~HmacSha256Key();
+
+      /**
+       * @brief Computes the HMAC of data. Can be called from several threads at the same time.
+       */
+      std::vector<uint8_t> Sign(const uint8_t* data, size_t length) const;
+
+    private:
+      struct Impl;
+      std::unique_ptr<Impl> m_impl;
+    };
+
     std::string UrlEncodeQueryParameter(const std::string& value);
     std::string UrlEncodePath(const std::string& value);
   } // namespace _internal
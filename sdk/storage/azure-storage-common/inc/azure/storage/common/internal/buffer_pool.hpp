@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  /**
+   * @brief Hands out fixed-size buffers and keeps the released ones so they can be reused.
+   *
+   * @details Used by concurrent transfers so that a buffer is allocated once per thread rather
+   * than once per chunk. The memory of the buffers is not initialized.
+   */
+  class BufferPool final {
+  public:
+    /**
+     * @brief A buffer acquired from a #BufferPool. It goes back to the pool when destroyed.
+     */
+    class Buffer final {
+    public:
+      Buffer(Buffer&&) = default;
+      Buffer& operator=(Buffer&&) = delete;
+      Buffer(const Buffer&) = delete;
+      Buffer& operator=(const Buffer&) = delete;
+
+      ~Buffer()
+      {
+        if (m_data)
+        {
+          m_pool.Release(std::move(m_data));
+        }
+      }
+
+      uint8_t* Data() const { return m_data.get(); }
+      size_t Size() const { return m_pool.m_bufferSize; }
+
+    private:
+      Buffer(BufferPool& pool, std::unique_ptr<uint8_t[]> data)
+          : m_pool(pool), m_data(std::move(data))
+      {
+      }
+
+      BufferPool& m_pool;
+      std::unique_ptr<uint8_t[]> m_data;
+
+      friend class BufferPool;
+    };
+
+    /**
+     * @brief Constructs a buffer pool.
+     *
+     * @param bufferSize The size of every buffer in the pool.
+     */
+    explicit BufferPool(size_t bufferSize) : m_bufferSize(bufferSize) {}
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Gets a released buffer, or allocates a new one if none is available.
+     *
+     * @remark Every buffer must be destroyed before the pool.
+     */
+    Buffer Acquire()
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_buffers.empty())
+        {
+          auto data = std::move(m_buffers.back());
+          m_buffers.pop_back();
+          return Buffer(*this, std::move(data));
+        }
+      }
+      return Buffer(*this, std::unique_ptr<uint8_t[]>(new uint8_t[m_bufferSize]));
+    }
+
+  private:
+    void Release(std::unique_ptr<uint8_t[]> data)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_buffers.push_back(std::move(data));
+    }
+
+    const size_t m_bufferSize;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<uint8_t[]>> m_buffers;
+  };
+
+}}} // namespace Azure::Storage::_internal
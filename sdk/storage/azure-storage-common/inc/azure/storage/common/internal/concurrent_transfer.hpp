@@ -3,34 +3,61 @@
 
 #pragma once
 
+#include "azure/storage/common/internal/thread_pool.hpp"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
 #include <functional>
-#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
+  /**
+   * @brief Transfers [offset, offset + length) in chunks, running up to \p concurrency chunks at
+   * the same time.
+   *
+   * @details The calling thread transfers chunks too. The other chunks are transferred by helpers
+   * running on \p threadPool, so the number of threads doesn't grow with the number of transfers
+   * running at the same time. Helpers that only get a thread after every chunk was taken don't
+   * delay the transfer.
+   */
   inline void ConcurrentTransfer(
       int64_t offset,
       int64_t length,
       int64_t chunkSize,
       int concurrency,
       // offset, length, chunk ID, number of chunks
-      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc)
+      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc,
+      ThreadPool& threadPool = ThreadPool::GetDefault())
   {
-    std::atomic<int> numWorkingThreads{concurrency};
-    std::atomic<int> nextChunkId{0};
+    // Shared with the helpers, which can start after this function returned.
+    struct TransferState final
+    {
+      std::mutex Mutex;
+      std::condition_variable HelperExited;
+      int RunningHelpers = 0;
+      bool Closed = false;
+    };
+    auto state = std::make_shared<TransferState>();
+
+    std::atomic<int64_t> nextChunkId{0};
     std::atomic<bool> failed{false};
+    std::exception_ptr firstError;
 
     const auto numChunks = (length + chunkSize - 1) / chunkSize;
 
     auto threadFunc = [&]() {
       while (true)
       {
-        int chunkId = nextChunkId.fetch_add(1);
+        int64_t chunkId = nextChunkId.fetch_add(1);
         if (chunkId >= numChunks || failed)
         {
           break;
@@ -41,28 +68,310 @@ namespace Azure { namespace Storage { namespace _internal {
         {
           transferFunc(chunkOffset, chunkLength, chunkId, numChunks);
         }
-        catch (const std::exception&)
+        catch (...)
         {
           if (failed.exchange(true) == false)
           {
-            numWorkingThreads.fetch_sub(1);
-            throw;
+            firstError = std::current_exception();
           }
+          break;
+        }
+      }
+    };
+
+    // The helpers only touch the variables above while they are counted as running, and this
+    // function doesn't return until none of them is.
+    std::function<void()> helperFunc = [state, &threadFunc]() {
+      {
+        std::lock_guard<std::mutex> guard(state->Mutex);
+        if (state->Closed)
+        {
+          return;
         }
+        ++state->RunningHelpers;
       }
-      numWorkingThreads.fetch_sub(1);
+      threadFunc();
+      std::lock_guard<std::mutex> guard(state->Mutex);
+      --state->RunningHelpers;
+      state->HelperExited.notify_all();
     };
 
-    std::vector<std::future<void>> threadHandles;
     for (int i = 0; i < std::min<int64_t>(concurrency, numChunks) - 1; ++i)
     {
-      threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
+      threadPool.Submit(helperFunc);
     }
     threadFunc();
-    for (auto& handle : threadHandles)
     {
-      handle.get();
+      std::unique_lock<std::mutex> lock(state->Mutex);
+      state->Closed = true;
+      state->HelperExited.wait(lock, [&state]() { return state->RunningHelpers == 0; });
+    }
+
+    if (firstError)
+    {
+      std::rethrow_exception(firstError);
+    }
+  }
+
+  /**
+   * @brief Tunes the chunk size and the number of concurrent requests of a transfer from the
+   * throughput measured while it runs.
+   *
+   * @details The transfer runs in rounds of #Concurrency chunks. When a round is noticeably faster
+   * than the previous one, the chunk size is doubled and one more request is allowed. When it is
+   * noticeably slower, or when a single chunk is several times slower than usual, which is what a
+   * throttled request that was retried after a 503 looks like, both are halved.
+   */
+  class AdaptiveTransferTuner final {
+  public:
+    /**
+     * @brief Constructs a tuner.
+     *
+     * @param initialChunkSize The chunk size to start with.
+     * @param minChunkSize The smallest chunk size the tuner can pick.
+     * @param maxChunkSize The largest chunk size the tuner can pick.
+     * @param maxConcurrency The largest number of concurrent requests the tuner can pick.
+     */
+    AdaptiveTransferTuner(
+        int64_t initialChunkSize,
+        int64_t minChunkSize,
+        int64_t maxChunkSize,
+        int maxConcurrency)
+        : m_minChunkSize(minChunkSize), m_maxChunkSize((std::max)(minChunkSize, maxChunkSize)),
+          m_maxConcurrency((std::max)(maxConcurrency, 1)),
+          m_chunkSize((std::min)((std::max)(initialChunkSize, m_minChunkSize), m_maxChunkSize)),
+          m_concurrency((m_maxConcurrency + 1) / 2)
+    {
+    }
+
+    /**
+     * @brief The size of the next chunk to transfer.
+     */
+    int64_t ChunkSize() const { return m_chunkSize; }
+
+    /**
+     * @brief The number of chunks that should be transferred at the same time.
+     */
+    int Concurrency() const { return m_concurrency; }
+
+    /**
+     * @brief Records that a chunk of \p length bytes was transferred in \p elapsed.
+     */
+    void OnChunkCompleted(int64_t length, std::chrono::steady_clock::duration elapsed)
+    {
+      const double seconds = (std::max)(
+          std::chrono::duration<double>(elapsed).count(), std::numeric_limits<double>::min());
+      const double chunkThroughput = static_cast<double>(length) / seconds;
+      if (m_averageChunkThroughput > 0.0
+          && chunkThroughput * StallRatio < m_averageChunkThroughput)
+      {
+        BackOff();
+        return;
+      }
+      m_averageChunkThroughput = m_averageChunkThroughput > 0.0
+          ? m_averageChunkThroughput * 0.75 + chunkThroughput * 0.25
+          : chunkThroughput;
+
+      m_roundBytes += static_cast<double>(length);
+      m_roundSeconds += seconds;
+      if (++m_roundChunks < m_concurrency)
+      {
+        return;
+      }
+
+      // Every chunk of the round ran next to Concurrency() - 1 others.
+      const double roundThroughput = m_roundBytes / m_roundSeconds * m_concurrency;
+      const double previousThroughput = m_previousRoundThroughput;
+      ResetRound();
+      m_previousRoundThroughput = roundThroughput;
+      if (previousThroughput <= 0.0 || roundThroughput > previousThroughput * GrowthRatio)
+      {
+        m_chunkSize = (std::min)(m_chunkSize * 2, m_maxChunkSize);
+        m_concurrency = (std::min)(m_concurrency + 1, m_maxConcurrency);
+      }
+      else if (roundThroughput < previousThroughput * ShrinkRatio)
+      {
+        BackOff();
+      }
+    }
+
+  private:
+    static constexpr double GrowthRatio = 1.1;
+    static constexpr double ShrinkRatio = 0.8;
+    static constexpr double StallRatio = 4.0;
+
+    void BackOff()
+    {
+      m_chunkSize = (std::max)(m_chunkSize / 2, m_minChunkSize);
+      m_concurrency = (std::max)(m_concurrency / 2, 1);
+      m_averageChunkThroughput = 0.0;
+      m_previousRoundThroughput = 0.0;
+      ResetRound();
+    }
+
+    void ResetRound()
+    {
+      m_roundBytes = 0.0;
+      m_roundSeconds = 0.0;
+      m_roundChunks = 0;
+    }
+
+    const int64_t m_minChunkSize;
+    const int64_t m_maxChunkSize;
+    const int m_maxConcurrency;
+    int64_t m_chunkSize;
+    int m_concurrency;
+    double m_averageChunkThroughput = 0.0;
+    double m_previousRoundThroughput = 0.0;
+    double m_roundBytes = 0.0;
+    double m_roundSeconds = 0.0;
+    int m_roundChunks = 0;
+  };
+
+  /**
+   * @brief Same as #ConcurrentTransfer, but the size of the chunks and the number of chunks
+   * transferred at the same time are picked by \p tuner while the transfer runs.
+   *
+   * @details \p transferFunc gets the number of chunks only for the last chunk, which has the
+   * largest chunk ID. For the other chunks, the number of chunks is not known yet and it gets -1.
+   * Helpers are submitted to \p threadPool when the tuner raises the concurrency and return when
+   * it lowers it, so the transfer doesn't hold threads of the pool it doesn't use.
+   *
+   * @return The number of chunks.
+   */
+  inline int64_t AdaptiveConcurrentTransfer(
+      int64_t offset,
+      int64_t length,
+      AdaptiveTransferTuner& tuner,
+      int maxConcurrency,
+      // offset, length, chunk ID, number of chunks
+      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc,
+      ThreadPool& threadPool = ThreadPool::GetDefault())
+  {
+    struct TransferState final
+    {
+      std::mutex Mutex;
+      std::condition_variable StateChanged;
+      int RunningHelpers = 0;
+      bool Closed = false;
+    };
+    auto state = std::make_shared<TransferState>();
+
+    // Protected by state->Mutex.
+    int64_t nextOffset = offset;
+    int64_t nextChunkId = 0;
+    int runningChunks = 0;
+    // The calling thread and the helpers that were submitted and haven't returned yet.
+    int workers = 1;
+    bool failed = false;
+    std::exception_ptr firstError;
+
+    const int64_t endOffset = offset + length;
+
+    auto concurrency = [&]() { return (std::min)(tuner.Concurrency(), maxConcurrency); };
+
+    std::function<void()> helperFunc;
+
+    // Must be called while holding state->Mutex.
+    auto submitHelpers = [&]() {
+      while (!failed && nextOffset < endOffset && workers < concurrency())
+      {
+        ++workers;
+        threadPool.Submit(helperFunc);
+      }
+    };
+
+    auto threadFunc = [&](bool isHelper) {
+      std::unique_lock<std::mutex> lock(state->Mutex);
+      while (true)
+      {
+        // A helper that isn't needed anymore returns, the calling thread waits for a free slot.
+        auto const surplusHelper = [&]() { return isHelper && workers > concurrency(); };
+        state->StateChanged.wait(lock, [&]() {
+          return failed || nextOffset >= endOffset || runningChunks < concurrency()
+              || surplusHelper();
+        });
+        if (failed || nextOffset >= endOffset || surplusHelper())
+        {
+          break;
+        }
+        const int64_t chunkOffset = nextOffset;
+        const int64_t chunkLength = (std::min)(tuner.ChunkSize(), endOffset - chunkOffset);
+        const int64_t chunkId = nextChunkId++;
+        nextOffset += chunkLength;
+        const int64_t numChunks = nextOffset >= endOffset ? nextChunkId : -1;
+        ++runningChunks;
+        lock.unlock();
+
+        const auto startTime = std::chrono::steady_clock::now();
+        std::exception_ptr error;
+        try
+        {
+          transferFunc(chunkOffset, chunkLength, chunkId, numChunks);
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+        lock.lock();
+        --runningChunks;
+        if (error)
+        {
+          if (!failed)
+          {
+            failed = true;
+            firstError = error;
+          }
+        }
+        else
+        {
+          tuner.OnChunkCompleted(chunkLength, elapsed);
+          submitHelpers();
+        }
+        state->StateChanged.notify_all();
+      }
+      if (isHelper)
+      {
+        --workers;
+        state->StateChanged.notify_all();
+      }
+    };
+
+    // The helpers only touch the variables above while they are counted as running, and this
+    // function doesn't return until none of them is.
+    helperFunc = [state, &threadFunc]() {
+      {
+        std::lock_guard<std::mutex> guard(state->Mutex);
+        if (state->Closed)
+        {
+          return;
+        }
+        ++state->RunningHelpers;
+      }
+      threadFunc(true);
+      std::lock_guard<std::mutex> guard(state->Mutex);
+      --state->RunningHelpers;
+      state->StateChanged.notify_all();
+    };
+
+    {
+      std::lock_guard<std::mutex> guard(state->Mutex);
+      submitHelpers();
+    }
+    threadFunc(false);
+    {
+      std::unique_lock<std::mutex> lock(state->Mutex);
+      state->Closed = true;
+      state->StateChanged.wait(lock, [&state]() { return state->RunningHelpers == 0; });
+    }
+
+    if (firstError)
+    {
+      std::rethrow_exception(firstError);
     }
+    return nextChunkId;
   }
 
 }}} // namespace Azure::Storage::_internal
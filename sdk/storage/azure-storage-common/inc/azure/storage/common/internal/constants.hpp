@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Azure { namespace Storage { namespace _internal {
   constexpr static const char* BlobServicePackageName = "storage-blobs";
   constexpr static const char* DatalakeServicePackageName = "storage-files-datalake";
@@ -23,4 +26,7 @@ namespace Azure { namespace Storage { namespace _internal {
   constexpr static const char* HttpHeaderContentRange = "content-range";
 
   constexpr int ReliableStreamRetryCount = 3;
+  constexpr size_t DefaultTransferThreadPoolSize = 64;
+  constexpr int64_t MinAdaptiveChunkSize = 1 * 1024 * 1024;
+  constexpr int64_t MaxAdaptiveChunkSize = 64 * 1024 * 1024;
 }}} // namespace Azure::Storage::_internal
@@ -33,7 +33,9 @@ namespace Azure { namespace Storage { namespace _internal {
 
   class FileWriter final {
   public:
-    FileWriter(const std::string& filename);
+    // Opens the file for writing, creating it if it doesn't exist. The existing content is
+    // discarded unless truncate is false.
+    FileWriter(const std::string& filename, bool truncate = true);
 
     ~FileWriter();
 
@@ -41,6 +43,14 @@ namespace Azure { namespace Storage { namespace _internal {
 
     void Write(const uint8_t* buffer, size_t length, int64_t offset);
 
+    // Changes the size of the file. The bytes added at the end read as zeros and, where the file
+    // system supports sparse files, don't take disk space until they are written.
+    void SetSize(int64_t size);
+
+    // Sets [offset, offset + length) to zeros. Where the file system supports it, the range is
+    // deallocated instead of written.
+    void ZeroRange(int64_t offset, int64_t length);
+
   private:
     FileHandle m_handle;
   };
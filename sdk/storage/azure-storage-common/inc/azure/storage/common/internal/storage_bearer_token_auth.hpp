@@ -19,12 +19,17 @@ namespace Azure { namespace Storage { namespace _internal {
      * @param credential An #Azure::Core::TokenCredential to use with this policy.
      * @param tokenRequestContext A context to get the token in.
      * @param enableTenantDiscovery Enables tenant discovery through the authorization challenge.
+     * @param tokenRefreshOptions How the token is renewed.
      */
     explicit StorageBearerTokenAuthenticationPolicy(
         std::shared_ptr<const Azure::Core::Credentials::TokenCredential> credential,
         Azure::Core::Credentials::TokenRequestContext tokenRequestContext,
-        bool enableTenantDiscovery)
-        : BearerTokenAuthenticationPolicy(std::move(credential), tokenRequestContext),
+        bool enableTenantDiscovery,
+        Azure::Core::Http::Policies::TokenRefreshOptions tokenRefreshOptions = {})
+        : BearerTokenAuthenticationPolicy(
+            std::move(credential),
+            tokenRequestContext,
+            std::move(tokenRefreshOptions)),
           m_scopes(tokenRequestContext.Scopes), m_safeTenantId(tokenRequestContext.TenantId),
           m_enableTenantDiscovery(enableTenantDiscovery)
     {
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  /**
+   * @brief A pool with a bounded number of threads that run submitted tasks in order.
+   *
+   * @details Threads are created on demand, when a task is submitted and every thread is busy, up
+   * to the maximum number of threads. Once created, a thread is kept until the pool is destroyed so
+   * later tasks don't pay for creating it again.
+   */
+  class ThreadPool final {
+  public:
+    /**
+     * @brief Constructs a thread pool.
+     *
+     * @param maxThreads The maximum number of threads running tasks at the same time. Must be
+     * greater than zero.
+     */
+    explicit ThreadPool(size_t maxThreads);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Waits for the tasks that are already running and joins the threads. Tasks that
+     * haven't started are discarded.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Queues a task to be run by one of the threads of the pool.
+     *
+     * @remark A task must not wait for another task submitted to the same pool, it could be
+     * queued behind it.
+     */
+    void Submit(std::function<void()> task);
+
+    /**
+     * @brief The maximum number of threads running tasks at the same time.
+     */
+    size_t MaxThreads() const { return m_maxThreads; }
+
+    /**
+     * @brief Gets the pool shared by every concurrent transfer of the application.
+     *
+     * @details The shared pool caps the number of threads doing transfers in the process, no
+     * matter how many transfers run at the same time.
+     */
+    static ThreadPool& GetDefault();
+
+  private:
+    void WorkerThread();
+
+    const size_t m_maxThreads;
+    std::mutex m_mutex;
+    std::condition_variable m_taskQueued;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::thread> m_threads;
+    size_t m_idleThreads = 0;
+    bool m_stop = false;
+  };
+
+}}} // namespace Azure::Storage::_internal
@@ -21,7 +21,8 @@ namespace Azure { namespace Storage {
 
   namespace _internal {
     class SharedKeyPolicy;
-  }
+    class HmacSha256Key;
+  } // namespace _internal
 
   /**
    * @brief A StorageSharedKeyCredential is a credential backed by a storage account's name and
@@ -51,6 +52,7 @@ namespace Azure { namespace Storage {
     {
       std::lock_guard<std::mutex> guard(m_mutex);
       m_accountKey = std::move(accountKey);
+      m_signingKey.reset();
     }
 
     /**
@@ -70,9 +72,13 @@ namespace Azure { namespace Storage {
       std::lock_guard<std::mutex> guard(m_mutex);
       return m_accountKey;
     }
+    // The decoded account key, ready to sign with. Built the first time it's needed after the key
+    // is set.
+    std::shared_ptr<const _internal::HmacSha256Key> GetSigningKey() const;
 
     mutable std::mutex m_mutex;
     std::string m_accountKey;
+    mutable std::shared_ptr<const _internal::HmacSha256Key> m_signingKey;
   };
 
   namespace _internal {
@@ -26,9 +26,21 @@
 #include <azure/core/http/http.hpp>
 
 #include <algorithm>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define AZ_STORAGE_CRC64_PCLMUL
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif
+
 namespace Azure { namespace Storage {
 
   namespace _internal {
@@ -148,13 +160,19 @@ namespace Azure { namespace Storage {
       ~AlgorithmProviderInstance() { BCryptCloseAlgorithmProvider(Handle, 0); }
     };
 
+    const AlgorithmProviderInstance& GetHmacSha256AlgorithmProvider()
+    {
+      static AlgorithmProviderInstance AlgorithmProvider(AlgorithmType::HmacSha256);
+      return AlgorithmProvider;
+    }
+
     std::vector<uint8_t> HmacSha256(
         const std::vector<uint8_t>& data,
         const std::vector<uint8_t>& key)
     {
       AZURE_ASSERT_MSG(data.size() <= (std::numeric_limits<ULONG>::max)(), "Data size is too big.");
 
-      static AlgorithmProviderInstance AlgorithmProvider(AlgorithmType::HmacSha256);
+      const auto& AlgorithmProvider = GetHmacSha256AlgorithmProvider();
 
       std::string context;
       context.resize(AlgorithmProvider.ContextSize);
@@ -196,6 +214,91 @@ namespace Azure { namespace Storage {
 
       return hash;
     }
+
+    struct HmacSha256Key::Impl final
+    {
+      // Hash object created with the key, duplicated for each signature.
+      std::string Context;
+      BCRYPT_HASH_HANDLE Handle = nullptr;
+      std::mutex Mutex;
+
+      ~Impl()
+      {
+        if (Handle)
+        {
+          BCryptDestroyHash(Handle);
+        }
+      }
+    };
+
+    HmacSha256Key::HmacSha256Key(const std::vector<uint8_t>& key)
+        : m_impl(std::make_unique<Impl>())
+    {
+      const auto& AlgorithmProvider = GetHmacSha256AlgorithmProvider();
+      m_impl->Context.resize(AlgorithmProvider.ContextSize);
+      NTSTATUS status = BCryptCreateHash(
+          AlgorithmProvider.Handle,
+          &m_impl->Handle,
+          reinterpret_cast<PUCHAR>(&m_impl->Context[0]),
+          static_cast<ULONG>(m_impl->Context.size()),
+          reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(key.data())),
+          static_cast<ULONG>(key.size()),
+          0);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        throw std::runtime_error("BCryptCreateHash failed.");
+      }
+    }
+
+    std::vector<uint8_t> HmacSha256Key::Sign(const uint8_t* data, size_t length) const
+    {
+      AZURE_ASSERT_MSG(length <= (std::numeric_limits<ULONG>::max)(), "Data size is too big.");
+
+      const auto& AlgorithmProvider = GetHmacSha256AlgorithmProvider();
+
+      // The duplicated hash object lives in a buffer reused by the signatures of the thread.
+      thread_local std::string context;
+      context.resize(AlgorithmProvider.ContextSize);
+
+      BCRYPT_HASH_HANDLE hashHandle;
+      NTSTATUS status;
+      {
+        std::lock_guard<std::mutex> guard(m_impl->Mutex);
+        status = BCryptDuplicateHash(
+            m_impl->Handle,
+            &hashHandle,
+            reinterpret_cast<PUCHAR>(&context[0]),
+            static_cast<ULONG>(context.size()),
+            0);
+      }
+      if (!BCRYPT_SUCCESS(status))
+      {
+        throw std::runtime_error("BCryptDuplicateHash failed.");
+      }
+
+      status = BCryptHashData(
+          hashHandle,
+          reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(data)),
+          static_cast<ULONG>(length),
+          0);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        BCryptDestroyHash(hashHandle);
+        throw std::runtime_error("BCryptHashData failed.");
+      }
+
+      std::vector<uint8_t> hash;
+      hash.resize(AlgorithmProvider.HashLength);
+      status = BCryptFinishHash(
+          hashHandle, reinterpret_cast<PUCHAR>(&hash[0]), static_cast<ULONG>(hash.size()), 0);
+      BCryptDestroyHash(hashHandle);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        throw std::runtime_error("BCryptFinishHash failed.");
+      }
+
+      return hash;
+    }
   } // namespace _internal
 
 #elif defined(AZ_PLATFORM_POSIX)
@@ -220,10 +323,100 @@ namespace Azure { namespace Storage {
       return std::vector<uint8_t>(std::begin(hash), std::begin(hash) + hashLength);
     }
 
+    namespace {
+      constexpr size_t Sha256BlockSize = 64;
+
+      struct DigestContext final
+      {
+        DigestContext() : Context(EVP_MD_CTX_new())
+        {
+          if (Context == nullptr)
+          {
+            throw std::runtime_error("Crypto error while creating EVP context.");
+          }
+        }
+        DigestContext(const DigestContext&) = delete;
+        DigestContext& operator=(const DigestContext&) = delete;
+        ~DigestContext() { EVP_MD_CTX_free(Context); }
+
+        EVP_MD_CTX* Context;
+      };
+    } // namespace
+
+    struct HmacSha256Key::Impl final
+    {
+      // SHA-256 states after hashing the inner and the outer padded keys, see RFC 2104.
+      DigestContext Inner;
+      DigestContext Outer;
+    };
+
+    HmacSha256Key::HmacSha256Key(const std::vector<uint8_t>& key)
+        : m_impl(std::make_unique<Impl>())
+    {
+      std::vector<uint8_t> blockKey(key);
+      if (blockKey.size() > Sha256BlockSize)
+      {
+        blockKey.resize(EVP_MAX_MD_SIZE);
+        unsigned int digestLength = 0;
+        if (EVP_Digest(
+                key.data(), key.size(), blockKey.data(), &digestLength, EVP_sha256(), nullptr)
+            != 1)
+        {
+          throw std::runtime_error("Crypto error while hashing the key.");
+        }
+        blockKey.resize(digestLength);
+      }
+      blockKey.resize(Sha256BlockSize, 0);
+
+      auto initPaddedKeyDigest = [&blockKey](EVP_MD_CTX* context, uint8_t pad) {
+        uint8_t paddedKey[Sha256BlockSize];
+        for (size_t i = 0; i < Sha256BlockSize; ++i)
+        {
+          paddedKey[i] = blockKey[i] ^ pad;
+        }
+        if (EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1
+            || EVP_DigestUpdate(context, paddedKey, Sha256BlockSize) != 1)
+        {
+          throw std::runtime_error("Crypto error while hashing the key.");
+        }
+      };
+      initPaddedKeyDigest(m_impl->Inner.Context, 0x36);
+      initPaddedKeyDigest(m_impl->Outer.Context, 0x5c);
+    }
+
+    std::vector<uint8_t> HmacSha256Key::Sign(const uint8_t* data, size_t length) const
+    {
+      // Reused by the signatures of the thread, the keyed states are copied into it.
+      thread_local DigestContext scratch;
+
+      uint8_t innerHash[EVP_MAX_MD_SIZE];
+      unsigned int innerHashLength = 0;
+      if (EVP_MD_CTX_copy_ex(scratch.Context, m_impl->Inner.Context) != 1
+          || EVP_DigestUpdate(scratch.Context, data, length) != 1
+          || EVP_DigestFinal_ex(scratch.Context, innerHash, &innerHashLength) != 1)
+      {
+        throw std::runtime_error("Crypto error while computing HMAC-SHA256.");
+      }
+
+      uint8_t hash[EVP_MAX_MD_SIZE];
+      unsigned int hashLength = 0;
+      if (EVP_MD_CTX_copy_ex(scratch.Context, m_impl->Outer.Context) != 1
+          || EVP_DigestUpdate(scratch.Context, innerHash, innerHashLength) != 1
+          || EVP_DigestFinal_ex(scratch.Context, hash, &hashLength) != 1)
+      {
+        throw std::runtime_error("Crypto error while computing HMAC-SHA256.");
+      }
+      return std::vector<uint8_t>(std::begin(hash), std::begin(hash) + hashLength);
+    }
+
   } // namespace _internal
 
 #endif
 
+  namespace _internal {
+    HmacSha256Key::~HmacSha256Key() = default;
+  } // namespace _internal
+
   static constexpr uint64_t Crc64Poly = 0x9A6C9329AC4BC9B5ULL;
   static constexpr uint64_t Crc64MU1[] = {
       0x0000000000000000ULL, 0x7f6ef0c830358979ULL, 0xfedde190606b12f2ULL, 0x81b31158505e9b8bULL,
@@ -855,12 +1048,8 @@ namespace Azure { namespace Storage {
     return vr[0] ^ vr[1];
   }
 
-  void Crc64Hash::OnAppend(const uint8_t* data, size_t length)
+  static uint64_t Crc64Update(uint64_t uCrc, const uint8_t* data, size_t length)
   {
-    m_length += length;
-
-    uint64_t uCrc = m_context ^ ~0ULL;
-
     uint64_t pData = 0;
 
     size_t uStop = length - (length % 32);
@@ -1000,6 +1189,133 @@ namespace Azure { namespace Storage {
     {
       uCrc = (uCrc >> 8) ^ Crc64MU1[(uCrc ^ data[pData]) & 0xff];
     }
+    return uCrc;
+  }
+
+#if defined(AZ_STORAGE_CRC64_PCLMUL)
+  // x^n mod P, bit-reflected like the CRC register: bit i is the coefficient of x^(63-i).
+  static constexpr uint64_t Crc64XPowMod(uint32_t n)
+  {
+    uint64_t r = 1ULL << 63;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      r = (r >> 1) ^ (Crc64Poly & (0ULL - (r & 1)));
+    }
+    return r;
+  }
+
+  static bool IsPclmulSupported()
+  {
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    const unsigned int ecx = static_cast<unsigned int>(cpuInfo[2]);
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    {
+      return false;
+    }
+#endif
+    return (ecx & (1U << 1)) != 0;
+  }
+
+#if !defined(_MSC_VER)
+  __attribute__((target("pclmul")))
+#endif
+  static inline __m128i
+  Crc64Fold(__m128i x, __m128i k)
+  {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+  }
+
+  /*
+   * Folds the data 128 bits at a time with carry-less multiplications, four blocks in parallel, as
+   * described in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" by
+   * Intel. The last block is reduced by the table driven implementation.
+   *
+   * The low 64 bits of a block hold the higher degree terms of the message. Shifting a block by d
+   * bits multiplies them by x^(d+64) mod P and the high 64 bits by x^d mod P. The reflected
+   * carry-less product carries an extra factor of x, which the constants compensate for.
+   */
+#if !defined(_MSC_VER)
+  __attribute__((target("pclmul")))
+#endif
+  static uint64_t
+  Crc64UpdatePclmul(uint64_t uCrc, const uint8_t* data, size_t length)
+  {
+    static constexpr uint64_t Fold128Low = Crc64XPowMod(128 + 63);
+    static constexpr uint64_t Fold128High = Crc64XPowMod(128 - 1);
+    static constexpr uint64_t Fold256Low = Crc64XPowMod(256 + 63);
+    static constexpr uint64_t Fold256High = Crc64XPowMod(256 - 1);
+    static constexpr uint64_t Fold384Low = Crc64XPowMod(384 + 63);
+    static constexpr uint64_t Fold384High = Crc64XPowMod(384 - 1);
+    static constexpr uint64_t Fold512Low = Crc64XPowMod(512 + 63);
+    static constexpr uint64_t Fold512High = Crc64XPowMod(512 - 1);
+
+    auto load = [](const uint8_t* p) {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    };
+    const __m128i k128 = _mm_set_epi64x(
+        static_cast<int64_t>(Fold128High), static_cast<int64_t>(Fold128Low));
+
+    __m128i x0 = _mm_xor_si128(load(data), _mm_cvtsi64_si128(static_cast<int64_t>(uCrc)));
+    __m128i x1 = load(data + 16);
+    __m128i x2 = load(data + 32);
+    __m128i x3 = load(data + 48);
+    data += 64;
+    length -= 64;
+
+    const __m128i k512 = _mm_set_epi64x(
+        static_cast<int64_t>(Fold512High), static_cast<int64_t>(Fold512Low));
+    while (length >= 64)
+    {
+      x0 = _mm_xor_si128(Crc64Fold(x0, k512), load(data));
+      x1 = _mm_xor_si128(Crc64Fold(x1, k512), load(data + 16));
+      x2 = _mm_xor_si128(Crc64Fold(x2, k512), load(data + 32));
+      x3 = _mm_xor_si128(Crc64Fold(x3, k512), load(data + 48));
+      data += 64;
+      length -= 64;
+    }
+
+    const __m128i k384 = _mm_set_epi64x(
+        static_cast<int64_t>(Fold384High), static_cast<int64_t>(Fold384Low));
+    const __m128i k256 = _mm_set_epi64x(
+        static_cast<int64_t>(Fold256High), static_cast<int64_t>(Fold256Low));
+    __m128i x = _mm_xor_si128(
+        _mm_xor_si128(Crc64Fold(x0, k384), Crc64Fold(x1, k256)),
+        _mm_xor_si128(Crc64Fold(x2, k128), x3));
+
+    while (length >= 16)
+    {
+      x = _mm_xor_si128(Crc64Fold(x, k128), load(data));
+      data += 16;
+      length -= 16;
+    }
+
+    uint8_t lastBlock[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lastBlock), x);
+    uCrc = Crc64Update(0, lastBlock, sizeof(lastBlock));
+    return Crc64Update(uCrc, data, length);
+  }
+#endif
+
+  void Crc64Hash::OnAppend(const uint8_t* data, size_t length)
+  {
+    m_length += length;
+
+    uint64_t uCrc = m_context ^ ~0ULL;
+#if defined(AZ_STORAGE_CRC64_PCLMUL)
+    static const bool isPclmulSupported = IsPclmulSupported();
+    if (isPclmulSupported && length >= 64)
+    {
+      uCrc = Crc64UpdatePclmul(uCrc, data, length);
+    }
+    else
+#endif
+    {
+      uCrc = Crc64Update(uCrc, data, length);
+    }
     m_context = uCrc ^ ~0ULL;
   }
 
@@ -9,6 +9,10 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <linux/falloc.h>
+#endif
+
 #include <sys/stat.h>
 #include <sys/types.h>
 #endif
@@ -21,13 +25,32 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#include <winioctl.h>
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
+  namespace {
+    void WriteZeros(FileWriter& fileWriter, int64_t offset, int64_t length)
+    {
+      const std::vector<uint8_t> zeros(
+          static_cast<size_t>((std::min)(length, static_cast<int64_t>(64 * 1024))));
+      while (length > 0)
+      {
+        const size_t writeSize = static_cast<size_t>((std::min)(length, int64_t(zeros.size())));
+        fileWriter.Write(zeros.data(), writeSize, offset);
+        offset += writeSize;
+        length -= writeSize;
+      }
+    }
+  } // namespace
+
 #if defined(AZ_PLATFORM_WINDOWS)
   FileReader::FileReader(const std::string& filename)
   {
@@ -88,7 +111,7 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { CloseHandle(static_cast<HANDLE>(m_handle)); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
     int sizeNeeded = MultiByteToWideChar(
         CP_UTF8,
@@ -123,12 +146,16 @@ namespace Azure { namespace Storage { namespace _internal {
         GENERIC_WRITE,
         FILE_SHARE_READ | FILE_SHARE_WRITE,
         nullptr,
-        CREATE_ALWAYS,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
         FILE_ATTRIBUTE_NORMAL,
         NULL);
 #else
     fileHandle = CreateFile2(
-        filenameW.data(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, CREATE_ALWAYS, NULL);
+        filenameW.data(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+        NULL);
 #endif
     if (fileHandle == INVALID_HANDLE_VALUE)
     {
@@ -163,6 +190,63 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  void FileWriter::SetSize(int64_t size)
+  {
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+    // Without the sparse attribute, NTFS allocates and zeroes the whole file.
+    DWORD bytesReturned;
+    DeviceIoControl(
+        static_cast<HANDLE>(m_handle),
+        FSCTL_SET_SPARSE,
+        nullptr,
+        0,
+        nullptr,
+        0,
+        &bytesReturned,
+        nullptr);
+#endif
+
+    FILE_END_OF_FILE_INFO endOfFileInfo;
+    endOfFileInfo.EndOfFile.QuadPart = size;
+    if (!SetFileInformationByHandle(
+            static_cast<HANDLE>(m_handle),
+            FileEndOfFileInfo,
+            &endOfFileInfo,
+            sizeof(endOfFileInfo)))
+    {
+      throw std::runtime_error("Failed to set size of file.");
+    }
+  }
+
+  void FileWriter::ZeroRange(int64_t offset, int64_t length)
+  {
+    if (length <= 0)
+    {
+      return;
+    }
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+    FILE_ZERO_DATA_INFORMATION zeroDataInfo;
+    zeroDataInfo.FileOffset.QuadPart = offset;
+    zeroDataInfo.BeyondFinalZero.QuadPart = offset + length;
+    DWORD bytesReturned;
+    if (DeviceIoControl(
+            static_cast<HANDLE>(m_handle),
+            FSCTL_SET_ZERO_DATA,
+            &zeroDataInfo,
+            sizeof(zeroDataInfo),
+            nullptr,
+            0,
+            &bytesReturned,
+            nullptr))
+    {
+      return;
+    }
+#endif
+    WriteZeros(*this, offset, length);
+  }
 #elif defined(AZ_PLATFORM_POSIX)
   FileReader::FileReader(const std::string& filename)
   {
@@ -181,10 +265,12 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { close(m_handle); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
     m_handle = open(
-        filename.data(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        filename.data(),
+        O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0),
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
     if (m_handle == -1)
     {
       throw std::runtime_error("Failed to open file.");
@@ -205,6 +291,36 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  void FileWriter::SetSize(int64_t size)
+  {
+    if (size > static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        || ftruncate(m_handle, static_cast<off_t>(size)) != 0)
+    {
+      throw std::runtime_error("Failed to set size of file.");
+    }
+  }
+
+  void FileWriter::ZeroRange(int64_t offset, int64_t length)
+  {
+    if (length <= 0)
+    {
+      return;
+    }
+#if defined(FALLOC_FL_PUNCH_HOLE) && defined(FALLOC_FL_KEEP_SIZE)
+    if (offset + length <= static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        && fallocate(
+               m_handle,
+               FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+               static_cast<off_t>(offset),
+               static_cast<off_t>(length))
+            == 0)
+    {
+      return;
+    }
+#endif
+    WriteZeros(*this, offset, length);
+  }
 #endif
 
 }}} // namespace Azure::Storage::_internal
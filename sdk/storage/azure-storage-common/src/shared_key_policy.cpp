@@ -9,6 +9,9 @@
 #include <azure/core/internal/strings.hpp>
 
 #include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
 
 namespace {
 /*
@@ -88,82 +91,99 @@ bool comparator(const std::string& lhs, const std::string& rhs)
   }
   return false;
 }
+
+// Buffers reused by the requests signed on the same thread, so that canonicalizing a request
+// doesn't allocate once they have grown to fit.
+struct SignatureBuffers final
+{
+  std::string StringToSign;
+  std::vector<std::pair<const std::string*, const std::string*>> Headers;
+  std::vector<std::pair<std::string, std::string>> QueryParameters;
+};
 } // namespace
 
 namespace Azure { namespace Storage { namespace _internal {
 
   std::string SharedKeyPolicy::GetSignature(const Core::Http::Request& request) const
   {
-    std::string string_to_sign;
-    string_to_sign += request.GetMethod().ToString() + "\n";
+    thread_local SignatureBuffers buffers;
+    std::string& stringToSign = buffers.StringToSign;
+    stringToSign.clear();
+    stringToSign += request.GetMethod().ToString();
+    stringToSign += '\n';
 
-    const auto& headers = request.GetHeaders();
-    for (std::string headerName :
-         {"Content-Encoding",
-          "Content-Language",
-          "Content-Length",
-          "Content-MD5",
-          "Content-Type",
-          "Date",
-          "If-Modified-Since",
-          "If-Match",
-          "If-None-Match",
-          "If-Unmodified-Since",
-          "Range"})
+    const auto headers = request.GetHeaders();
+    static const std::array<std::string, 11> StandardHeaders
+        = {"Content-Encoding",
+           "Content-Language",
+           "Content-Length",
+           "Content-MD5",
+           "Content-Type",
+           "Date",
+           "If-Modified-Since",
+           "If-Match",
+           "If-None-Match",
+           "If-Unmodified-Since",
+           "Range"};
+    for (const auto& headerName : StandardHeaders)
     {
       auto ite = headers.find(headerName);
-      if (ite != headers.end())
+      if (ite != headers.end() && !(ite->second == "0" && headerName == "Content-Length"))
       {
-        if (headerName == "Content-Length" && ite->second == "0")
-        {
-          // do nothing
-        }
-        else
-        {
-          string_to_sign += ite->second;
-        }
+        stringToSign += ite->second;
       }
-      string_to_sign += "\n";
+      stringToSign += '\n';
     }
 
-    // canonicalized headers
-    const std::string prefix = "x-ms-";
-    std::vector<std::pair<std::string, std::string>> ordered_kv;
-    for (auto ite = headers.lower_bound(prefix);
-         ite != headers.end() && ite->first.substr(0, prefix.length()) == prefix;
+    // canonicalized headers, the request keeps header names in lowercase
+    static const std::string Prefix = "x-ms-";
+    auto& orderedHeaders = buffers.Headers;
+    orderedHeaders.clear();
+    for (auto ite = headers.lower_bound(Prefix);
+         ite != headers.end() && ite->first.compare(0, Prefix.length(), Prefix) == 0;
          ++ite)
     {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(ite->first);
-      ordered_kv.emplace_back(std::make_pair(std::move(key), ite->second));
+      orderedHeaders.emplace_back(&ite->first, &ite->second);
     }
-    std::sort(ordered_kv.begin(), ordered_kv.end(), [](const auto& lhs, const auto& rhs) {
-      return comparator(lhs.first, rhs.first);
+    std::sort(orderedHeaders.begin(), orderedHeaders.end(), [](const auto& lhs, const auto& rhs) {
+      return comparator(*lhs.first, *rhs.first);
     });
-    for (const auto& p : ordered_kv)
+    for (const auto& p : orderedHeaders)
     {
-      string_to_sign += p.first + ":" + p.second + "\n";
+      stringToSign += *p.first;
+      stringToSign += ':';
+      stringToSign += *p.second;
+      stringToSign += '\n';
     }
-    ordered_kv.clear();
 
     // canonicalized resource
-    string_to_sign += "/" + m_credential->AccountName + "/" + request.GetUrl().GetPath() + "\n";
+    stringToSign += '/';
+    stringToSign += m_credential->AccountName;
+    stringToSign += '/';
+    stringToSign += request.GetUrl().GetPath();
+    stringToSign += '\n';
+    auto& orderedQueryParameters = buffers.QueryParameters;
+    orderedQueryParameters.clear();
     for (const auto& query : request.GetUrl().GetQueryParameters())
     {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(query.first);
-      ordered_kv.emplace_back(
-          std::make_pair(Azure::Core::Url::Decode(key), Azure::Core::Url::Decode(query.second)));
+      orderedQueryParameters.emplace_back(
+          Azure::Core::Url::Decode(
+              Azure::Core::_internal::StringExtensions::ToLower(query.first)),
+          Azure::Core::Url::Decode(query.second));
     }
-    std::sort(ordered_kv.begin(), ordered_kv.end());
-    for (const auto& p : ordered_kv)
+    std::sort(orderedQueryParameters.begin(), orderedQueryParameters.end());
+    for (const auto& p : orderedQueryParameters)
     {
-      string_to_sign += p.first + ":" + p.second + "\n";
+      stringToSign += p.first;
+      stringToSign += ':';
+      stringToSign += p.second;
+      stringToSign += '\n';
     }
 
     // remove last linebreak
-    string_to_sign.pop_back();
+    stringToSign.pop_back();
 
-    return Azure::Core::Convert::Base64Encode(_internal::HmacSha256(
-        std::vector<uint8_t>(string_to_sign.begin(), string_to_sign.end()),
-        Azure::Core::Convert::Base64Decode(m_credential->GetAccountKey())));
+    return Azure::Core::Convert::Base64Encode(m_credential->GetSigningKey()->Sign(
+        reinterpret_cast<const uint8_t*>(stringToSign.data()), stringToSign.length()));
   }
 }}} // namespace Azure::Storage::_internal
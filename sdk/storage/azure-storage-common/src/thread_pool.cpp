@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/internal/thread_pool.hpp"
+
+#include "azure/storage/common/internal/constants.hpp"
+
+#include <stdexcept>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  ThreadPool::ThreadPool(size_t maxThreads) : m_maxThreads(maxThreads)
+  {
+    if (maxThreads == 0)
+    {
+      throw std::invalid_argument("The maximum number of threads must be greater than zero.");
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_taskQueued.notify_all();
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  void ThreadPool::Submit(std::function<void()> task)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+    if (m_idleThreads < m_tasks.size() && m_threads.size() < m_maxThreads)
+    {
+      m_threads.emplace_back([this]() { WorkerThread(); });
+    }
+    lock.unlock();
+    m_taskQueued.notify_one();
+  }
+
+  void ThreadPool::WorkerThread()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      ++m_idleThreads;
+      m_taskQueued.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      --m_idleThreads;
+      if (m_stop)
+      {
+        return;
+      }
+
+      auto task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      lock.unlock();
+      // Tasks report their own errors, an exception escaping from a task would terminate the
+      // process anyway.
+      task();
+      lock.lock();
+    }
+  }
+
+  ThreadPool& ThreadPool::GetDefault()
+  {
+    static ThreadPool defaultPool(DefaultTransferThreadPoolSize);
+    return defaultPool;
+  }
+
+}}} // namespace Azure::Storage::_internal
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "test_base.hpp"
+
+#include <azure/storage/common/internal/buffer_pool.hpp>
+
+#include <utility>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  TEST(BufferPoolTest, ReusesReleasedBuffers)
+  {
+    _internal::BufferPool bufferPool(1024);
+    uint8_t* firstData = nullptr;
+    {
+      auto buffer = bufferPool.Acquire();
+      EXPECT_EQ(buffer.Size(), 1024U);
+      firstData = buffer.Data();
+      buffer.Data()[1023] = 1;
+    }
+    auto buffer1 = bufferPool.Acquire();
+    EXPECT_EQ(buffer1.Data(), firstData);
+
+    // A buffer is never handed out twice at the same time.
+    auto buffer2 = bufferPool.Acquire();
+    EXPECT_NE(buffer2.Data(), buffer1.Data());
+
+    // Moving a buffer doesn't release it.
+    auto movedBuffer = std::move(buffer2);
+    auto buffer3 = bufferPool.Acquire();
+    EXPECT_NE(buffer3.Data(), movedBuffer.Data());
+    EXPECT_NE(buffer3.Data(), buffer1.Data());
+  }
+
+}}} // namespace Azure::Storage::Test
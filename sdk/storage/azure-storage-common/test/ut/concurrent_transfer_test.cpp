@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "test_base.hpp"
+
+#include <azure/storage/common/internal/concurrent_transfer.hpp>
+#include <azure/storage/common/internal/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    constexpr int64_t KiB = 1024;
+    constexpr int64_t MiB = 1024 * KiB;
+  } // namespace
+
+  TEST(ConcurrentTransferTest, TransfersEveryChunkOnce)
+  {
+    const int64_t offset = 100;
+    const int64_t length = 1000;
+    const int64_t chunkSize = 64;
+    const int64_t numChunks = (length + chunkSize - 1) / chunkSize;
+
+    std::mutex mutex;
+    std::vector<int> transferredBytes(static_cast<size_t>(length), 0);
+    _internal::ConcurrentTransfer(
+        offset,
+        length,
+        chunkSize,
+        4,
+        [&](int64_t chunkOffset, int64_t chunkLength, int64_t chunkId, int64_t chunks) {
+          EXPECT_EQ(chunks, numChunks);
+          EXPECT_EQ(chunkOffset, offset + chunkId * chunkSize);
+          std::lock_guard<std::mutex> guard(mutex);
+          for (int64_t i = chunkOffset; i < chunkOffset + chunkLength; ++i)
+          {
+            ++transferredBytes[static_cast<size_t>(i - offset)];
+          }
+        });
+    EXPECT_TRUE(std::all_of(
+        transferredBytes.begin(), transferredBytes.end(), [](int count) { return count == 1; }));
+  }
+
+  TEST(ConcurrentTransferTest, RethrowsFirstError)
+  {
+    std::atomic<int> transferredChunks{0};
+    EXPECT_THROW(
+        _internal::ConcurrentTransfer(
+            0,
+            100,
+            1,
+            4,
+            [&](int64_t, int64_t, int64_t chunkId, int64_t) {
+              if (chunkId == 10)
+              {
+                throw std::runtime_error("failed");
+              }
+              ++transferredChunks;
+            }),
+        std::runtime_error);
+    // The transfer stops at the first error.
+    EXPECT_LT(transferredChunks.load(), 99);
+  }
+
+  TEST(ConcurrentTransferTest, SharesBoundedThreadPool)
+  {
+    _internal::ThreadPool threadPool(2);
+    std::atomic<int> runningChunks{0};
+    std::atomic<int> maxRunningChunks{0};
+    auto transferFunc = [&](int64_t, int64_t, int64_t, int64_t) {
+      int running = ++runningChunks;
+      int maxRunning = maxRunningChunks.load();
+      while (running > maxRunning && !maxRunningChunks.compare_exchange_weak(maxRunning, running))
+      {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --runningChunks;
+    };
+
+    // Each transfer can run its chunks on the calling thread and on the two threads of the pool.
+    std::vector<std::thread> transfers;
+    for (int i = 0; i < 4; ++i)
+    {
+      transfers.emplace_back([&]() {
+        _internal::ConcurrentTransfer(0, 20, 1, 8, transferFunc, threadPool);
+      });
+    }
+    for (auto& transfer : transfers)
+    {
+      transfer.join();
+    }
+    EXPECT_LE(maxRunningChunks.load(), 4 + 2);
+  }
+
+  TEST(ConcurrentTransferTest, ThreadPoolRunsEveryTask)
+  {
+    std::atomic<int> completedTasks{0};
+    {
+      _internal::ThreadPool threadPool(3);
+      EXPECT_EQ(threadPool.MaxThreads(), 3U);
+      std::mutex mutex;
+      std::condition_variable allCompleted;
+      for (int i = 0; i < 100; ++i)
+      {
+        threadPool.Submit([&]() {
+          std::lock_guard<std::mutex> guard(mutex);
+          if (++completedTasks == 100)
+          {
+            allCompleted.notify_one();
+          }
+        });
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      allCompleted.wait(lock, [&]() { return completedTasks.load() == 100; });
+    }
+    EXPECT_EQ(completedTasks.load(), 100);
+    EXPECT_THROW(_internal::ThreadPool(0), std::invalid_argument);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveTransferTunerGrowsWhileThroughputImproves)
+  {
+    _internal::AdaptiveTransferTuner tuner(4 * MiB, MiB, 16 * MiB, 4);
+    EXPECT_EQ(tuner.ChunkSize(), 4 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 2);
+
+    // The first round sets the baseline and probes a larger configuration.
+    tuner.OnChunkCompleted(4 * MiB, std::chrono::milliseconds(100));
+    tuner.OnChunkCompleted(4 * MiB, std::chrono::milliseconds(100));
+    EXPECT_EQ(tuner.ChunkSize(), 8 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 3);
+
+    // The larger configuration is faster, keep growing up to the limits.
+    for (int i = 0; i < 3; ++i)
+    {
+      tuner.OnChunkCompleted(8 * MiB, std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(tuner.ChunkSize(), 16 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 4);
+    for (int i = 0; i < 4; ++i)
+    {
+      tuner.OnChunkCompleted(16 * MiB, std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(tuner.ChunkSize(), 16 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 4);
+
+    // No improvement, keep the same configuration.
+    for (int i = 0; i < 4; ++i)
+    {
+      tuner.OnChunkCompleted(16 * MiB, std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(tuner.ChunkSize(), 16 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 4);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveTransferTunerBacksOffWhenThrottled)
+  {
+    _internal::AdaptiveTransferTuner tuner(8 * MiB, MiB, 16 * MiB, 8);
+    EXPECT_EQ(tuner.Concurrency(), 4);
+    tuner.OnChunkCompleted(8 * MiB, std::chrono::milliseconds(100));
+
+    // A chunk much slower than the others, like a request retried after a 503.
+    tuner.OnChunkCompleted(8 * MiB, std::chrono::seconds(2));
+    EXPECT_EQ(tuner.ChunkSize(), 4 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 2);
+
+    tuner.OnChunkCompleted(4 * MiB, std::chrono::milliseconds(100));
+    tuner.OnChunkCompleted(4 * MiB, std::chrono::seconds(2));
+    EXPECT_EQ(tuner.ChunkSize(), 2 * MiB);
+    EXPECT_EQ(tuner.Concurrency(), 1);
+
+    // Never below the minimums.
+    _internal::AdaptiveTransferTuner minimalTuner(MiB, MiB, MiB, 1);
+    minimalTuner.OnChunkCompleted(MiB, std::chrono::milliseconds(100));
+    minimalTuner.OnChunkCompleted(MiB, std::chrono::seconds(2));
+    EXPECT_EQ(minimalTuner.ChunkSize(), MiB);
+    EXPECT_EQ(minimalTuner.Concurrency(), 1);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveTransferTransfersEveryChunkOnce)
+  {
+    const int64_t offset = 100;
+    const int64_t length = 10 * MiB + 123;
+    _internal::AdaptiveTransferTuner tuner(64 * KiB, 16 * KiB, MiB, 4);
+
+    std::mutex mutex;
+    std::vector<std::pair<int64_t, int64_t>> chunks;
+    int64_t lastChunkCount = 0;
+    std::atomic<int> runningChunks{0};
+    std::atomic<int> maxRunningChunks{0};
+    const int64_t numChunks = _internal::AdaptiveConcurrentTransfer(
+        offset,
+        length,
+        tuner,
+        4,
+        [&](int64_t chunkOffset, int64_t chunkLength, int64_t chunkId, int64_t chunkCount) {
+          int running = ++runningChunks;
+          int maxRunning = maxRunningChunks.load();
+          while (running > maxRunning
+                 && !maxRunningChunks.compare_exchange_weak(maxRunning, running))
+          {
+          }
+          std::lock_guard<std::mutex> guard(mutex);
+          if (chunks.size() <= static_cast<size_t>(chunkId))
+          {
+            chunks.resize(static_cast<size_t>(chunkId) + 1);
+          }
+          chunks[static_cast<size_t>(chunkId)] = std::make_pair(chunkOffset, chunkLength);
+          if (chunkCount != -1)
+          {
+            EXPECT_EQ(lastChunkCount, 0);
+            lastChunkCount = chunkCount;
+            EXPECT_EQ(chunkOffset + chunkLength, offset + length);
+          }
+          --runningChunks;
+        });
+
+    EXPECT_EQ(numChunks, lastChunkCount);
+    ASSERT_EQ(chunks.size(), static_cast<size_t>(numChunks));
+    int64_t expectedOffset = offset;
+    for (const auto& chunk : chunks)
+    {
+      EXPECT_EQ(chunk.first, expectedOffset);
+      EXPECT_GT(chunk.second, 0);
+      EXPECT_LE(chunk.second, MiB);
+      expectedOffset += chunk.second;
+    }
+    EXPECT_EQ(expectedOffset, offset + length);
+    EXPECT_LE(maxRunningChunks.load(), 4);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveTransferRethrowsFirstError)
+  {
+    _internal::AdaptiveTransferTuner tuner(1, 1, 1, 4);
+    EXPECT_THROW(
+        _internal::AdaptiveConcurrentTransfer(
+            0,
+            100,
+            tuner,
+            4,
+            [&](int64_t, int64_t, int64_t chunkId, int64_t) {
+              if (chunkId == 10)
+              {
+                throw std::runtime_error("failed");
+              }
+            }),
+        std::runtime_error);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveTransferOnlyHoldsThreadsItUses)
+  {
+    // The tuner starts with one chunk at a time, so the only thread of the pool stays free for
+    // other tasks.
+    _internal::ThreadPool threadPool(1);
+    _internal::AdaptiveTransferTuner tuner(MiB, MiB, MiB, 2);
+    ASSERT_EQ(tuner.Concurrency(), 1);
+
+    std::mutex mutex;
+    std::condition_variable taskRan;
+    bool ran = false;
+    _internal::AdaptiveConcurrentTransfer(
+        0,
+        4 * MiB,
+        tuner,
+        2,
+        [&](int64_t, int64_t, int64_t chunkId, int64_t) {
+          if (chunkId != 0)
+          {
+            return;
+          }
+          threadPool.Submit([&]() {
+            std::lock_guard<std::mutex> guard(mutex);
+            ran = true;
+            taskRan.notify_all();
+          });
+          std::unique_lock<std::mutex> lock(mutex);
+          EXPECT_TRUE(taskRan.wait_for(lock, std::chrono::seconds(30), [&]() { return ran; }));
+        },
+        threadPool);
+  }
+
+}}} // namespace Azure::Storage::Test
@@ -31,6 +31,25 @@ namespace Azure { namespace Storage { namespace Test {
         "+SBESxQVhI53mSEdZJcCBpdBkaqwzfPaVYZMAf5LP3c=");
   }
 
+  TEST_F(CryptFunctionsTest, HmacSha256Key)
+  {
+    std::string key = "8CwtGFF1mGR4bPEP9eZ0x1fxKiQ3Ca5N";
+    _internal::HmacSha256Key hmacKey(std::vector<uint8_t>(key.begin(), key.end()));
+    auto sign = [&hmacKey](const std::string& data) {
+      return Azure::Core::Convert::Base64Encode(
+          hmacKey.Sign(reinterpret_cast<const uint8_t*>(data.data()), data.length()));
+    };
+    EXPECT_EQ(sign(""), "fFy2T+EuCvAgouw/vB/RAJ75z7jwTj+uiURebkFKF5M=");
+    EXPECT_EQ(sign("Hello Azure!"), "+SBESxQVhI53mSEdZJcCBpdBkaqwzfPaVYZMAf5LP3c=");
+    EXPECT_EQ(sign("Hello Azure!"), "+SBESxQVhI53mSEdZJcCBpdBkaqwzfPaVYZMAf5LP3c=");
+
+    // Keys longer than the block size of SHA-256 are hashed first.
+    const auto longKey = RandomBuffer(100);
+    const auto data = RandomBuffer(1000);
+    _internal::HmacSha256Key longHmacKey(longKey);
+    EXPECT_EQ(longHmacKey.Sign(data.data(), data.size()), _internal::HmacSha256(data, longKey));
+  }
+
   static std::vector<uint8_t> ComputeHash(const std::string& data)
   {
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data());
@@ -114,6 +133,42 @@ namespace Azure { namespace Storage { namespace Test {
         crc64Single.Final(reinterpret_cast<const uint8_t*>(allData.data()), allData.size()));
   }
 
+  TEST_F(CryptFunctionsTest, Crc64Hash_MatchesBitwiseReference)
+  {
+    // Bit by bit CRC-64 with the same polynomial, to cross-check the table driven and the
+    // hardware accelerated implementations at every length and alignment.
+    auto referenceCrc64 = [](const uint8_t* data, size_t length) {
+      uint64_t crc = ~0ULL;
+      for (size_t i = 0; i < length; ++i)
+      {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+          crc = (crc >> 1) ^ (0x9A6C9329AC4BC9B5ULL & (0ULL - (crc & 1)));
+        }
+      }
+      crc ^= ~0ULL;
+      std::vector<uint8_t> binary(sizeof(crc));
+      for (size_t i = 0; i < sizeof(crc); ++i)
+      {
+        binary[i] = static_cast<uint8_t>(crc >> (8 * i));
+      }
+      return binary;
+    };
+
+    auto data = RandomBuffer(2048);
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+      for (size_t length = 0; length + offset <= data.size(); length += (length < 300 ? 1 : 97))
+      {
+        Crc64Hash instance;
+        EXPECT_EQ(
+            instance.Final(data.data() + offset, length),
+            referenceCrc64(data.data() + offset, length));
+      }
+    }
+  }
+
   TEST_F(CryptFunctionsTest, Crc64Hash_CtorDtor)
   {
     {
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "test_base.hpp"
+
+#include <azure/storage/common/internal/file_io.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  class FileIoTest : public StorageTest {
+  };
+
+  TEST_F(FileIoTest, SetSizeAndZeroRange)
+  {
+    const std::string fileName = RandomString();
+    std::vector<uint8_t> expectedContent(3 * 1024 * 1024, 'a');
+    {
+      _internal::FileWriter fileWriter(fileName);
+      fileWriter.Write(expectedContent.data(), expectedContent.size(), 0);
+    }
+
+    {
+      // Reopening without truncation keeps the content.
+      _internal::FileWriter fileWriter(fileName, false);
+      fileWriter.SetSize(4 * 1024 * 1024);
+      fileWriter.ZeroRange(4096, 1024 * 1024);
+      fileWriter.ZeroRange(1024 * 1024 + 8192, 100);
+    }
+    expectedContent.resize(4 * 1024 * 1024, '\x00');
+    std::fill(expectedContent.begin() + 4096, expectedContent.begin() + 4096 + 1024 * 1024, '\x00');
+    std::fill(
+        expectedContent.begin() + 1024 * 1024 + 8192,
+        expectedContent.begin() + 1024 * 1024 + 8192 + 100,
+        '\x00');
+    EXPECT_EQ(ReadFile(fileName), expectedContent);
+
+    {
+      _internal::FileWriter fileWriter(fileName, false);
+      fileWriter.SetSize(1000);
+    }
+    expectedContent.resize(1000);
+    EXPECT_EQ(ReadFile(fileName), expectedContent);
+
+    {
+      _internal::FileWriter fileWriter(fileName);
+    }
+    EXPECT_TRUE(ReadFile(fileName).empty());
+    DeleteFile(fileName);
+  }
+
+}}} // namespace Azure::Storage::Test
@@ -12,6 +12,7 @@
 #include <azure/core/response.hpp>
 #include <azure/storage/common/storage_credential.hpp>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -232,6 +233,86 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
         const ListPathsOptions& options = ListPathsOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Sets POSIX access control rights on this directory and every path below it. The
+     * subdirectories are processed in parallel.
+     *
+     * @param acls Sets POSIX access control rights on files and directories. Each access control
+     * entry (ACE) consists of a scope, a type, a user or group identifier, and permissions.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return RecursiveParallelOperationResult containing summary stats of the operation.
+     * @remark This request is sent to dfs endpoint.
+     */
+    Models::RecursiveParallelOperationResult SetAccessControlListRecursiveParallel(
+        const std::vector<Models::Acl>& acls,
+        const RecursiveParallelOperationOptions& options = RecursiveParallelOperationOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Updates POSIX access control rights on this directory and every path below it. The
+     * subdirectories are processed in parallel.
+     *
+     * @param acls Updates POSIX access control rights on files and directories. Each access
+     * control entry (ACE) consists of a scope, a type, a user or group identifier, and
+     * permissions.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return RecursiveParallelOperationResult containing summary stats of the operation.
+     * @remark This request is sent to dfs endpoint.
+     */
+    Models::RecursiveParallelOperationResult UpdateAccessControlListRecursiveParallel(
+        const std::vector<Models::Acl>& acls,
+        const RecursiveParallelOperationOptions& options = RecursiveParallelOperationOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Removes POSIX access control rights on this directory and every path below it. The
+     * subdirectories are processed in parallel.
+     *
+     * @param acls Removes POSIX access control rights on files and directories. Each access
+     * control entry (ACE) consists of a scope, a type, a user or group identifier, and
+     * permissions.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return RecursiveParallelOperationResult containing summary stats of the operation.
+     * @remark This request is sent to dfs endpoint.
+     */
+    Models::RecursiveParallelOperationResult RemoveAccessControlListRecursiveParallel(
+        const std::vector<Models::Acl>& acls,
+        const RecursiveParallelOperationOptions& options = RecursiveParallelOperationOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Deletes the directory and all its subdirectories and files. The subdirectories are
+     * deleted in parallel, and each directory is deleted once it's empty.
+     *
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return RecursiveParallelOperationResult containing summary stats of the operation.
+     * @remark This request is sent to dfs endpoint.
+     */
+    Models::RecursiveParallelOperationResult DeleteRecursiveParallel(
+        const RecursiveParallelOperationOptions& options = RecursiveParallelOperationOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Calls a function for every path below this directory, for example to set the
+     * metadata or the HTTP headers of each path. The function is called from several threads at
+     * the same time. A path is counted as failed if the function throws.
+     *
+     * @param pathHandler The function called for each path.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations, passed to the function.
+     * @return RecursiveParallelOperationResult containing summary stats of the operation.
+     * @remark This request is sent to dfs endpoint.
+     */
+    Models::RecursiveParallelOperationResult ForEachPathParallel(
+        const std::function<void(const Models::PathItem&, const Azure::Core::Context&)>&
+            pathHandler,
+        const RecursiveParallelOperationOptions& options = RecursiveParallelOperationOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
   private:
     explicit DataLakeDirectoryClient(
         Azure::Core::Url directoryUrl,
@@ -246,6 +327,9 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     {
     }
 
+    // The path of this directory relative to the file system, without leading or trailing '/'.
+    std::string GetPathInFileSystem() const;
+
     Azure::Response<Models::DeleteDirectoryResult> Delete(
         bool recursive,
         const DeleteDirectoryOptions& options = DeleteDirectoryOptions(),
@@ -11,6 +11,7 @@
 #include <azure/storage/common/access_conditions.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     using FileQueryArrowFieldType = Blobs::Models::BlobQueryArrowFieldType;
     using EncryptionAlgorithmType = Blobs::Models::EncryptionAlgorithmType;
 
+    struct RecursiveParallelOperationResult;
+
     /**
      * @brief An access control object.
      */
@@ -922,6 +925,53 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
 
   using RemovePathAccessControlListRecursiveOptions = SetPathAccessControlListRecursiveOptions;
 
+  /**
+   * @brief Optional parameters for the operations of #DataLakeDirectoryClient that walk a
+   * directory tree in parallel, like
+   * #DataLakeDirectoryClient::SetAccessControlListRecursiveParallel.
+   */
+  struct RecursiveParallelOperationOptions final
+  {
+    /**
+     * @brief The maximum number of requests running at the same time.
+     */
+    int32_t Concurrency = 16;
+
+    /**
+     * @brief The number of directory levels, starting with the directory itself, that are listed
+     * by the client so that their subdirectories are processed in parallel. The directories below
+     * are processed by the service, a request chain for each. 0 processes the whole tree with a
+     * single request chain.
+     */
+    int32_t MaxFanOutDepth = 2;
+
+    /**
+     * @brief The maximum number of paths listed, or processed by the service, in a single
+     * request.
+     */
+    Azure::Nullable<int32_t> PageSizeHint;
+
+    /**
+     * @brief If true, the paths that failed are reported and the operation goes on with the
+     * others. If false, the operation stops at the first failure and returns a continuation token.
+     */
+    bool ContinueOnFailure = false;
+
+    /**
+     * @brief A continuation token returned by a previous call of the same operation on the same
+     * directory, to resume it.
+     */
+    Azure::Nullable<std::string> ContinuationToken;
+
+    /**
+     * @brief Callback for progress handling, called when the continuation token changed, at most
+     * once a second and once more when the operation stops. The result contains the paths
+     * processed so far and a continuation token that resumes the operation from this point. The
+     * callback is called one call at a time, while the operation goes on.
+     */
+    std::function<void(const Models::RecursiveParallelOperationResult&)> ProgressHandler;
+  };
+
   using CreateFileOptions = CreatePathOptions;
   using CreateDirectoryOptions = CreatePathOptions;
 
@@ -488,6 +488,42 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
       std::vector<Acl> Acls;
     };
 
+    /**
+     * @brief The result of an operation of
+     * #Azure::Storage::Files::DataLake::DataLakeDirectoryClient that walks a directory tree in
+     * parallel. When the operation is resumed, the counts go on from the previous call, and the
+     * paths processed again are counted again.
+     */
+    struct RecursiveParallelOperationResult final
+    {
+      /**
+       * Number of directories processed successfully. A subtree deleted by a single request
+       * counts as one directory.
+       */
+      int64_t NumberOfSuccessfulDirectories = 0;
+
+      /**
+       * Number of files processed successfully.
+       */
+      int64_t NumberOfSuccessfulFiles = 0;
+
+      /**
+       * Number of paths that failed.
+       */
+      int64_t NumberOfFailures = 0;
+
+      /**
+       * The paths that failed, with the error of each. Failures of a previous call that was
+       * resumed are only counted.
+       */
+      std::vector<AclFailedEntry> FailedEntries;
+
+      /**
+       * A token to resume the operation with, if it stopped before processing every path.
+       */
+      Azure::Nullable<std::string> ContinuationToken;
+    };
+
     /**
      * @brief The information returned when setting the path's HTTP headers.
      */
@@ -817,6 +853,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
 
   private:
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     std::shared_ptr<DataLakeServiceClient> m_dataLakeServiceClient;
     ListFileSystemsOptions m_operationOptions;
@@ -838,6 +875,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
 
   private:
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     std::shared_ptr<DataLakeFileSystemClient> m_fileSystemClient;
     std::shared_ptr<DataLakeDirectoryClient> m_directoryClient;
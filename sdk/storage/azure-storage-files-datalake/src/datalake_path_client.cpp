@@ -101,7 +101,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
               : _internal::StorageScope);
       perRetryPolicies.emplace_back(
           std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery));
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefresh));
     }
     perOperationPolicies.emplace_back(
         std::make_unique<_internal::StorageServiceVersionPolicy>(options.ApiVersion));
@@ -479,7 +479,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
         *m_pipeline, m_pathUrl, protocolLayerOptions, context);
 
     SetPathAccessControlListRecursivePagedResponse pagedResponse;
-    pagedResponse.NumberOfSuccessfulFiles = response.Value.NumberOfSuccessfulDirectories;
+    pagedResponse.NumberOfSuccessfulDirectories = response.Value.NumberOfSuccessfulDirectories;
     pagedResponse.NumberOfSuccessfulFiles = response.Value.NumberOfSuccessfulFiles;
     pagedResponse.NumberOfFailures = response.Value.NumberOfFailures;
     pagedResponse.FailedEntries = std::move(response.Value.FailedEntries);
@@ -0,0 +1,928 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/files/datalake/datalake_directory_client.hpp"
+#include "azure/storage/files/datalake/datalake_file_client.hpp"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/internal/json/json.hpp>
+#include <azure/storage/common/internal/thread_pool.hpp>
+#include <azure/storage/common/storage_exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace Azure { namespace Storage { namespace Files { namespace DataLake {
+
+  namespace _detail {
+
+    constexpr int32_t MaxAccessControlListUpdateAttempts = 10;
+    // The continuation token is as large as the work left, so it isn't built for every change.
+    constexpr std::chrono::seconds ProgressReportInterval(1);
+
+    enum class RecursiveParallelOperation
+    {
+      SetAccessControlList,
+      UpdateAccessControlList,
+      RemoveAccessControlList,
+      Delete,
+      ForEachPath,
+    };
+
+    /*
+     * Walks a directory tree with a pool of tasks. The directories above MaxFanOutDepth are listed
+     * a page at a time, and the paths of each page are processed in parallel. The directories at
+     * MaxFanOutDepth are processed by the service, with a request chain for each.
+     *
+     * The work left is a set of items, which is what a continuation token saves. The paths of a
+     * page aren't saved one by one: the page stays in the set until all of them are processed,
+     * and a resumed operation lists the page again and processes all its paths.
+     */
+    class RecursiveParallelOperationState final
+        : public std::enable_shared_from_this<RecursiveParallelOperationState> {
+    public:
+      RecursiveParallelOperationState(
+          DataLakeDirectoryClient rootClient,
+          std::string rootPath,
+          RecursiveParallelOperation operation,
+          std::vector<Models::Acl> acls,
+          std::function<void(const Models::PathItem&, const Azure::Core::Context&)> pathHandler,
+          const RecursiveParallelOperationOptions& options,
+          const Azure::Core::Context& context)
+          : m_rootClient(std::move(rootClient)), m_rootPath(std::move(rootPath)),
+            m_operation(operation), m_acls(std::move(acls)),
+            m_pathHandler(std::move(pathHandler)), m_options(options), m_context(context)
+      {
+        m_options.Concurrency = (std::max)(m_options.Concurrency, 1);
+        m_options.MaxFanOutDepth = (std::max)(m_options.MaxFanOutDepth, 0);
+        if (m_options.ContinuationToken.HasValue())
+        {
+          RestoreItems(m_options.ContinuationToken.Value());
+        }
+        else
+        {
+          AddInitialItems();
+        }
+      }
+
+      Models::RecursiveParallelOperationResult Run()
+      {
+        // A pool of its own, so that a path handler can use the default pool.
+        _internal::ThreadPool threadPool(static_cast<size_t>(m_options.Concurrency));
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadPool = &threadPool;
+        for (auto i = m_waitingDeletes.begin(); i != m_waitingDeletes.end();)
+        {
+          if (m_liveItemsUnder.count(i->first) == 0)
+          {
+            m_readyWork.push_back(MakeItemWork(i->second, m_items.at(i->second)));
+            i = m_waitingDeletes.erase(i);
+          }
+          else
+          {
+            ++i;
+          }
+        }
+        ScheduleWork();
+        m_stateChanged.wait(lock, [this]() {
+          return m_runningWork == 0 && (m_stopped || m_readyWork.empty());
+        });
+        m_threadPool = nullptr;
+        lock.unlock();
+        ReportProgress(true);
+        lock.lock();
+        if (m_error)
+        {
+          std::rethrow_exception(m_error);
+        }
+        return GetResult();
+      }
+
+    private:
+      enum class ItemKind : char
+      {
+        // Lists a page of a directory.
+        List = 'l',
+        // A page whose paths are being processed.
+        Page = 'p',
+        // A directory processed by the service.
+        Subtree = 's',
+        // A directory deleted once the items under it are done.
+        DeleteDirectory = 'd',
+        // The access control list of the root directory itself.
+        RootDirectory = 'r',
+      };
+
+      struct Item final
+      {
+        ItemKind Kind = ItemKind::List;
+        // Relative to the root directory, empty for the root directory itself.
+        std::string Path;
+        int32_t Depth = 0;
+        Azure::Nullable<std::string> ContinuationToken;
+        bool Recursive = false;
+        int64_t PendingPaths = 0;
+      };
+
+      struct Work final
+      {
+        // The item to process, or the page the path belongs to.
+        uint64_t ItemId = 0;
+        Item ItemValue;
+        bool IsPath = false;
+        Models::PathItem Path;
+      };
+
+      static Work MakeItemWork(uint64_t itemId, const Item& item)
+      {
+        Work work;
+        work.ItemId = itemId;
+        work.ItemValue = item;
+        return work;
+      }
+
+      void AddInitialItems()
+      {
+        const bool fanOut = m_options.MaxFanOutDepth > 0;
+        Item item;
+        switch (m_operation)
+        {
+          case RecursiveParallelOperation::SetAccessControlList:
+          case RecursiveParallelOperation::UpdateAccessControlList:
+          case RecursiveParallelOperation::RemoveAccessControlList:
+            if (fanOut)
+            {
+              item.Kind = ItemKind::RootDirectory;
+              AddItem(item, false);
+              item.Kind = ItemKind::List;
+            }
+            else
+            {
+              item.Kind = ItemKind::Subtree;
+            }
+            break;
+          case RecursiveParallelOperation::Delete:
+            if (fanOut)
+            {
+              item.Kind = ItemKind::DeleteDirectory;
+              AddItem(item, false);
+              item.Kind = ItemKind::List;
+            }
+            else
+            {
+              item.Kind = ItemKind::Subtree;
+            }
+            break;
+          case RecursiveParallelOperation::ForEachPath:
+            item.Kind = ItemKind::List;
+            item.Recursive = !fanOut;
+            break;
+        }
+        AddItem(item, false);
+      }
+
+      // Must be called with m_mutex locked, or before the tasks start.
+      void AddItem(Item item, bool urgent)
+      {
+        const uint64_t id = ++m_lastItemId;
+        UpdateLiveItemsUnder(item, 1);
+        if (item.Kind == ItemKind::DeleteDirectory)
+        {
+          m_waitingDeletes[item.Path] = id;
+        }
+        else if (item.Kind != ItemKind::Page)
+        {
+          Work work = MakeItemWork(id, item);
+          if (urgent)
+          {
+            m_readyWork.push_front(std::move(work));
+          }
+          else
+          {
+            m_readyWork.push_back(std::move(work));
+          }
+        }
+        m_items.emplace(id, std::move(item));
+      }
+
+      // Must be called with m_mutex locked.
+      void RemoveItem(uint64_t id)
+      {
+        auto ite = m_items.find(id);
+        Item item = std::move(ite->second);
+        m_items.erase(ite);
+        for (const auto& path : UpdateLiveItemsUnder(item, -1))
+        {
+          auto waitingDelete = m_waitingDeletes.find(path);
+          if (waitingDelete != m_waitingDeletes.end())
+          {
+            const uint64_t deleteId = waitingDelete->second;
+            m_readyWork.push_front(MakeItemWork(deleteId, m_items.at(deleteId)));
+            m_waitingDeletes.erase(waitingDelete);
+          }
+        }
+        OnProgress();
+      }
+
+      // Counts the items under each directory, so that a directory is deleted once the count
+      // drops to zero. A directory waiting to be deleted isn't counted under itself. Returns the
+      // directories whose count dropped to zero.
+      std::vector<std::string> UpdateLiveItemsUnder(const Item& item, int64_t delta)
+      {
+        std::vector<std::string> emptiedPaths;
+        std::string path = item.Path;
+        bool self = item.Kind != ItemKind::DeleteDirectory;
+        while (true)
+        {
+          if (self)
+          {
+            auto& count = m_liveItemsUnder[path];
+            count += delta;
+            if (count == 0)
+            {
+              m_liveItemsUnder.erase(path);
+              emptiedPaths.push_back(path);
+            }
+          }
+          if (path.empty())
+          {
+            break;
+          }
+          auto pos = path.rfind('/');
+          path.resize(pos == std::string::npos ? 0 : pos);
+          self = true;
+        }
+        return emptiedPaths;
+      }
+
+      // Must be called with m_mutex locked.
+      void ScheduleWork()
+      {
+        while (!m_stopped && !m_readyWork.empty() && m_runningWork < m_options.Concurrency)
+        {
+          auto work = std::move(m_readyWork.front());
+          m_readyWork.pop_front();
+          ++m_runningWork;
+          auto self = shared_from_this();
+          m_threadPool->Submit([self, work]() { self->DoWork(work); });
+        }
+      }
+
+      void DoWork(const Work& work)
+      {
+        try
+        {
+          if (work.IsPath)
+          {
+            ProcessPath(work);
+          }
+          else
+          {
+            switch (work.ItemValue.Kind)
+            {
+              case ItemKind::List:
+              case ItemKind::Page:
+                ListPage(work);
+                break;
+              case ItemKind::Subtree:
+                ProcessSubtree(work);
+                break;
+              case ItemKind::DeleteDirectory:
+                GetDirectoryClient(work.ItemValue.Path).DeleteEmptyIfExists({}, m_context);
+                OnItemDone(work.ItemId, 1, 0);
+                break;
+              case ItemKind::RootDirectory:
+                ApplyAccessControlList(m_rootClient, true);
+                OnItemDone(work.ItemId, 1, 0);
+                break;
+            }
+          }
+        }
+        catch (const Azure::Core::OperationCancelledException&)
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          m_stopped = true;
+          if (!m_error)
+          {
+            m_error = std::current_exception();
+          }
+        }
+        catch (const std::exception& e)
+        {
+          const bool isDirectory = work.IsPath ? work.Path.IsDirectory : true;
+          const std::string name = work.IsPath ? work.Path.Name : GetFullPath(work.ItemValue.Path);
+          OnFailure(work, name, isDirectory, e.what());
+        }
+        catch (...)
+        {
+          const bool isDirectory = work.IsPath ? work.Path.IsDirectory : true;
+          const std::string name = work.IsPath ? work.Path.Name : GetFullPath(work.ItemValue.Path);
+          OnFailure(work, name, isDirectory, "Unknown error.");
+        }
+
+        // Before the work is done, so that the handler isn't called after Run() returned.
+        ReportProgress(false);
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_runningWork;
+        ScheduleWork();
+        m_stateChanged.notify_all();
+      }
+
+      void ProcessPath(const Work& work)
+      {
+        const auto& path = work.Path;
+        const std::string relativePath = GetRelativePath(path.Name);
+        switch (m_operation)
+        {
+          case RecursiveParallelOperation::SetAccessControlList:
+          case RecursiveParallelOperation::UpdateAccessControlList:
+          case RecursiveParallelOperation::RemoveAccessControlList:
+            if (path.IsDirectory)
+            {
+              ApplyAccessControlList(GetDirectoryClient(relativePath), true);
+            }
+            else
+            {
+              ApplyAccessControlList(m_rootClient.GetFileClient(relativePath), false);
+            }
+            break;
+          case RecursiveParallelOperation::Delete:
+            m_rootClient.GetFileClient(relativePath).DeleteIfExists({}, m_context);
+            break;
+          case RecursiveParallelOperation::ForEachPath:
+            m_pathHandler(path, m_context);
+            break;
+        }
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        ++(path.IsDirectory ? m_result.NumberOfSuccessfulDirectories
+                            : m_result.NumberOfSuccessfulFiles);
+        OnPathDone(work.ItemId);
+      }
+
+      void ListPage(const Work& work)
+      {
+        const Item& item = work.ItemValue;
+        const bool resumedPage = item.Kind == ItemKind::Page;
+        ListPathsOptions listOptions;
+        listOptions.PageSizeHint = m_options.PageSizeHint;
+        listOptions.ContinuationToken = item.ContinuationToken;
+        auto response = GetDirectoryClient(item.Path).ListPaths(
+            item.Recursive, listOptions, m_context);
+
+        std::vector<Models::PathItem> paths;
+        std::vector<Item> children;
+        const int32_t childDepth = item.Depth + 1;
+        const bool fanOut = childDepth < m_options.MaxFanOutDepth;
+        for (auto& path : response.Paths)
+        {
+          const bool isDirectory = path.IsDirectory;
+          Item child;
+          child.Path = GetRelativePath(path.Name);
+          child.Depth = childDepth;
+          switch (m_operation)
+          {
+            case RecursiveParallelOperation::SetAccessControlList:
+            case RecursiveParallelOperation::UpdateAccessControlList:
+            case RecursiveParallelOperation::RemoveAccessControlList:
+              if (!isDirectory || fanOut)
+              {
+                paths.push_back(std::move(path));
+              }
+              if (isDirectory)
+              {
+                child.Kind = fanOut ? ItemKind::List : ItemKind::Subtree;
+                children.push_back(std::move(child));
+              }
+              break;
+            case RecursiveParallelOperation::Delete:
+              if (!isDirectory)
+              {
+                paths.push_back(std::move(path));
+              }
+              else if (fanOut)
+              {
+                child.Kind = ItemKind::DeleteDirectory;
+                children.push_back(child);
+                child.Kind = ItemKind::List;
+                children.push_back(std::move(child));
+              }
+              else
+              {
+                child.Kind = ItemKind::Subtree;
+                children.push_back(std::move(child));
+              }
+              break;
+            case RecursiveParallelOperation::ForEachPath:
+              paths.push_back(std::move(path));
+              if (isDirectory && !item.Recursive)
+              {
+                child.Kind = ItemKind::List;
+                child.Recursive = !fanOut;
+                children.push_back(std::move(child));
+              }
+              break;
+          }
+        }
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        // The new items are added before this one is removed, so that the directories above
+        // aren't deleted in between.
+        if (!paths.empty())
+        {
+          Item page = item;
+          page.Kind = ItemKind::Page;
+          page.PendingPaths = static_cast<int64_t>(paths.size());
+          AddItem(page, false);
+          const uint64_t pageId = m_lastItemId;
+          // Depth first, so that the work waiting to start doesn't pile up.
+          for (auto i = paths.rbegin(); i != paths.rend(); ++i)
+          {
+            Work pathWork;
+            pathWork.ItemId = pageId;
+            pathWork.IsPath = true;
+            pathWork.Path = std::move(*i);
+            m_readyWork.push_front(std::move(pathWork));
+          }
+        }
+        if (!resumedPage)
+        {
+          if (response.NextPageToken.HasValue() && !response.NextPageToken.Value().empty())
+          {
+            Item nextPage = item;
+            nextPage.ContinuationToken = response.NextPageToken;
+            AddItem(std::move(nextPage), false);
+          }
+          for (auto& child : children)
+          {
+            AddItem(std::move(child), true);
+          }
+        }
+        RemoveItem(work.ItemId);
+      }
+
+      void ProcessSubtree(const Work& work)
+      {
+        const Item& item = work.ItemValue;
+        auto directoryClient = GetDirectoryClient(item.Path);
+        if (m_operation == RecursiveParallelOperation::Delete)
+        {
+          directoryClient.DeleteRecursiveIfExists({}, m_context);
+          OnItemDone(work.ItemId, 1, 0);
+          return;
+        }
+
+        SetPathAccessControlListRecursiveOptions aclOptions;
+        aclOptions.ContinuationToken = item.ContinuationToken;
+        aclOptions.PageSizeHint = m_options.PageSizeHint;
+        aclOptions.ContinueOnFailure = m_options.ContinueOnFailure;
+        auto response = m_operation == RecursiveParallelOperation::SetAccessControlList
+            ? directoryClient.SetAccessControlListRecursive(m_acls, aclOptions, m_context)
+            : m_operation == RecursiveParallelOperation::UpdateAccessControlList
+            ? directoryClient.UpdateAccessControlListRecursive(m_acls, aclOptions, m_context)
+            : directoryClient.RemoveAccessControlListRecursive(m_acls, aclOptions, m_context);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_result.NumberOfSuccessfulDirectories += response.NumberOfSuccessfulDirectories;
+        m_result.NumberOfSuccessfulFiles += response.NumberOfSuccessfulFiles;
+        m_result.NumberOfFailures += response.NumberOfFailures;
+        for (auto& failedEntry : response.FailedEntries)
+        {
+          m_result.FailedEntries.push_back(std::move(failedEntry));
+        }
+        if (response.NumberOfFailures != 0 && !m_options.ContinueOnFailure)
+        {
+          // The item is kept as it was, so that a resumed operation tries the page again.
+          m_stopped = true;
+          OnProgress();
+        }
+        else if (response.NextPageToken.HasValue() && !response.NextPageToken.Value().empty())
+        {
+          auto& subtreeItem = m_items.at(work.ItemId);
+          subtreeItem.ContinuationToken = response.NextPageToken;
+          m_readyWork.push_back(MakeItemWork(work.ItemId, subtreeItem));
+          OnProgress();
+        }
+        else
+        {
+          RemoveItem(work.ItemId);
+        }
+      }
+
+      void ApplyAccessControlList(const DataLakePathClient& pathClient, bool isDirectory)
+      {
+        if (m_operation == RecursiveParallelOperation::SetAccessControlList)
+        {
+          pathClient.SetAccessControlList(FilterAcls(m_acls, isDirectory), {}, m_context);
+          return;
+        }
+        // Read, merge and write, until nobody changed the access control list in between. A path
+        // whose access control list keeps changing fails after MaxAccessControlListUpdateAttempts.
+        for (int32_t attempt = 1;; ++attempt)
+        {
+          auto response = pathClient.GetAccessControlList({}, m_context);
+          std::vector<Models::Acl> acls = std::move(response.Value.Acls);
+          for (const auto& acl : FilterAcls(m_acls, isDirectory))
+          {
+            auto existing = std::find_if(acls.begin(), acls.end(), [&acl](const Models::Acl& a) {
+              return a.Scope == acl.Scope && a.Type == acl.Type && a.Id == acl.Id;
+            });
+            if (m_operation == RecursiveParallelOperation::RemoveAccessControlList)
+            {
+              if (existing != acls.end())
+              {
+                acls.erase(existing);
+              }
+            }
+            else if (existing != acls.end())
+            {
+              existing->Permissions = acl.Permissions;
+            }
+            else
+            {
+              acls.push_back(acl);
+            }
+          }
+          SetPathAccessControlListOptions setOptions;
+          const auto& headers = response.RawResponse->GetHeaders();
+          auto eTag = headers.find("ETag");
+          if (eTag != headers.end())
+          {
+            setOptions.AccessConditions.IfMatch = Azure::ETag(eTag->second);
+          }
+          try
+          {
+            pathClient.SetAccessControlList(std::move(acls), setOptions, m_context);
+            return;
+          }
+          catch (const StorageException& e)
+          {
+            if (e.StatusCode != Azure::Core::Http::HttpStatusCode::PreconditionFailed
+                || attempt >= MaxAccessControlListUpdateAttempts)
+            {
+              throw;
+            }
+          }
+        }
+      }
+
+      // The default entries only apply to directories.
+      static std::vector<Models::Acl> FilterAcls(
+          const std::vector<Models::Acl>& acls,
+          bool isDirectory)
+      {
+        std::vector<Models::Acl> filteredAcls;
+        for (const auto& acl : acls)
+        {
+          if (isDirectory || acl.Scope != "default")
+          {
+            filteredAcls.push_back(acl);
+          }
+        }
+        return filteredAcls;
+      }
+
+      void OnItemDone(
+          uint64_t itemId,
+          int64_t numberOfSuccessfulDirectories,
+          int64_t numberOfSuccessfulFiles)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_result.NumberOfSuccessfulDirectories += numberOfSuccessfulDirectories;
+        m_result.NumberOfSuccessfulFiles += numberOfSuccessfulFiles;
+        RemoveItem(itemId);
+      }
+
+      // Must be called with m_mutex locked.
+      void OnPathDone(uint64_t pageId)
+      {
+        if (--m_items.at(pageId).PendingPaths == 0)
+        {
+          RemoveItem(pageId);
+        }
+      }
+
+      void OnFailure(
+          const Work& work,
+          const std::string& name,
+          bool isDirectory,
+          const std::string& errorMessage)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        ++m_result.NumberOfFailures;
+        Models::AclFailedEntry failedEntry;
+        failedEntry.Name = name;
+        failedEntry.Type = isDirectory ? "DIRECTORY" : "FILE";
+        failedEntry.ErrorMessage = errorMessage;
+        m_result.FailedEntries.push_back(std::move(failedEntry));
+        if (!m_options.ContinueOnFailure)
+        {
+          // The item is kept, so that a resumed operation tries again.
+          m_stopped = true;
+          OnProgress();
+        }
+        else if (work.IsPath)
+        {
+          OnPathDone(work.ItemId);
+        }
+        else
+        {
+          RemoveItem(work.ItemId);
+        }
+      }
+
+      // Must be called with m_mutex locked.
+      void OnProgress() { m_progressPending = true; }
+
+      // Must be called with m_mutex unlocked. Calls the progress handler if the result changed,
+      // at most once per ProgressReportInterval unless final is true.
+      void ReportProgress(bool final)
+      {
+        if (!m_options.ProgressHandler)
+        {
+          return;
+        }
+        // The results are built and handed to the handler in the same order. A worker doesn't
+        // wait for another one which is reporting, the change is reported later.
+        std::unique_lock<std::mutex> handlerLock(m_progressHandlerMutex, std::defer_lock);
+        if (final)
+        {
+          handlerLock.lock();
+        }
+        else if (!handlerLock.try_lock())
+        {
+          return;
+        }
+
+        Models::RecursiveParallelOperationResult result;
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          const auto now = std::chrono::steady_clock::now();
+          if (!m_progressPending
+              || (!final && now - m_lastProgressReport < ProgressReportInterval))
+          {
+            return;
+          }
+          m_progressPending = false;
+          m_lastProgressReport = now;
+          result = GetResult();
+        }
+        m_options.ProgressHandler(result);
+      }
+
+      // Must be called with m_mutex locked.
+      Models::RecursiveParallelOperationResult GetResult() const
+      {
+        Models::RecursiveParallelOperationResult result = m_result;
+        if (!m_items.empty())
+        {
+          result.ContinuationToken = SaveItems();
+        }
+        return result;
+      }
+
+      std::string SaveItems() const
+      {
+        Core::Json::_internal::json items = Core::Json::_internal::json::array();
+        for (const auto& i : m_items)
+        {
+          const Item& item = i.second;
+          Core::Json::_internal::json itemJson;
+          itemJson["k"] = std::string(1, static_cast<char>(item.Kind));
+          itemJson["p"] = item.Path;
+          itemJson["d"] = item.Depth;
+          if (item.ContinuationToken.HasValue())
+          {
+            itemJson["t"] = item.ContinuationToken.Value();
+          }
+          itemJson["r"] = item.Recursive;
+          items.push_back(std::move(itemJson));
+        }
+        Core::Json::_internal::json token;
+        token["v"] = 1;
+        token["op"] = static_cast<int32_t>(m_operation);
+        token["root"] = m_rootPath;
+        token["dirs"] = m_result.NumberOfSuccessfulDirectories;
+        token["files"] = m_result.NumberOfSuccessfulFiles;
+        token["failures"] = m_result.NumberOfFailures;
+        token["items"] = std::move(items);
+        const std::string tokenString = token.dump();
+        return Azure::Core::Convert::Base64Encode(
+            std::vector<uint8_t>(tokenString.begin(), tokenString.end()));
+      }
+
+      void RestoreItems(const std::string& continuationToken)
+      {
+        Core::Json::_internal::json token;
+        try
+        {
+          const auto tokenBytes = Azure::Core::Convert::Base64Decode(continuationToken);
+          token = Core::Json::_internal::json::parse(tokenBytes.begin(), tokenBytes.end());
+          if (token.at("v").get<int32_t>() != 1
+              || token.at("op").get<int32_t>() != static_cast<int32_t>(m_operation)
+              || token.at("root").get<std::string>() != m_rootPath)
+          {
+            throw std::invalid_argument("mismatch");
+          }
+          m_result.NumberOfSuccessfulDirectories = token.at("dirs").get<int64_t>();
+          m_result.NumberOfSuccessfulFiles = token.at("files").get<int64_t>();
+          m_result.NumberOfFailures = token.at("failures").get<int64_t>();
+          for (const auto& itemJson : token.at("items"))
+          {
+            Item item;
+            item.Kind = static_cast<ItemKind>(itemJson.at("k").get<std::string>().at(0));
+            item.Path = itemJson.at("p").get<std::string>();
+            item.Depth = itemJson.at("d").get<int32_t>();
+            if (itemJson.count("t") != 0)
+            {
+              item.ContinuationToken = itemJson.at("t").get<std::string>();
+            }
+            item.Recursive = itemJson.at("r").get<bool>();
+            // A page is listed again to process its paths.
+            const bool isPage = item.Kind == ItemKind::Page;
+            AddItem(std::move(item), false);
+            if (isPage)
+            {
+              m_readyWork.push_back(MakeItemWork(m_lastItemId, m_items.at(m_lastItemId)));
+            }
+          }
+        }
+        catch (const std::exception&)
+        {
+          throw std::invalid_argument(
+              "The continuation token isn't from the same operation on the same directory.");
+        }
+      }
+
+      DataLakeDirectoryClient GetDirectoryClient(const std::string& relativePath) const
+      {
+        return relativePath.empty() ? m_rootClient
+                                    : m_rootClient.GetSubdirectoryClient(relativePath);
+      }
+
+      // The paths listed are relative to the file system.
+      std::string GetRelativePath(const std::string& fullPath) const
+      {
+        if (m_rootPath.empty())
+        {
+          return fullPath;
+        }
+        if (fullPath.size() > m_rootPath.size() && fullPath[m_rootPath.size()] == '/'
+            && fullPath.compare(0, m_rootPath.size(), m_rootPath) == 0)
+        {
+          return fullPath.substr(m_rootPath.size() + 1);
+        }
+        return fullPath;
+      }
+
+      std::string GetFullPath(const std::string& relativePath) const
+      {
+        if (m_rootPath.empty() || relativePath.empty())
+        {
+          return m_rootPath.empty() ? relativePath : m_rootPath;
+        }
+        return m_rootPath + "/" + relativePath;
+      }
+
+      const DataLakeDirectoryClient m_rootClient;
+      const std::string m_rootPath;
+      const RecursiveParallelOperation m_operation;
+      const std::vector<Models::Acl> m_acls;
+      const std::function<void(const Models::PathItem&, const Azure::Core::Context&)>
+          m_pathHandler;
+      RecursiveParallelOperationOptions m_options;
+      const Azure::Core::Context m_context;
+
+      std::mutex m_mutex;
+      std::condition_variable m_stateChanged;
+      _internal::ThreadPool* m_threadPool = nullptr;
+      // The work left, in the order it was found.
+      std::map<uint64_t, Item> m_items;
+      uint64_t m_lastItemId = 0;
+      std::map<std::string, int64_t> m_liveItemsUnder;
+      std::map<std::string, uint64_t> m_waitingDeletes;
+      std::deque<Work> m_readyWork;
+      int32_t m_runningWork = 0;
+      Models::RecursiveParallelOperationResult m_result;
+      std::exception_ptr m_error;
+      bool m_stopped = false;
+      bool m_progressPending = false;
+      std::chrono::steady_clock::time_point m_lastProgressReport;
+
+      // Held while the progress handler is called.
+      std::mutex m_progressHandlerMutex;
+    };
+
+  } // namespace _detail
+
+  std::string DataLakeDirectoryClient::GetPathInFileSystem() const
+  {
+    const std::string currentPath = m_pathUrl.GetPath();
+    std::string directoryPath;
+    if (m_clientConfiguration.FileSystemUrl.HasValue())
+    {
+      directoryPath
+          = currentPath.substr(m_clientConfiguration.FileSystemUrl.Value().GetPath().length());
+    }
+    else
+    {
+      const auto firstSlashPos = currentPath.find('/');
+      directoryPath = firstSlashPos == std::string::npos ? std::string()
+                                                         : currentPath.substr(firstSlashPos);
+    }
+    directoryPath = Azure::Core::Url::Decode(directoryPath);
+    const auto begin = directoryPath.find_first_not_of('/');
+    const auto end = directoryPath.find_last_not_of('/');
+    return begin == std::string::npos ? std::string()
+                                      : directoryPath.substr(begin, end - begin + 1);
+  }
+
+  Models::RecursiveParallelOperationResult
+  DataLakeDirectoryClient::SetAccessControlListRecursiveParallel(
+      const std::vector<Models::Acl>& acls,
+      const RecursiveParallelOperationOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return std::make_shared<_detail::RecursiveParallelOperationState>(
+               *this,
+               GetPathInFileSystem(),
+               _detail::RecursiveParallelOperation::SetAccessControlList,
+               acls,
+               nullptr,
+               options,
+               context)
+        ->Run();
+  }
+
+  Models::RecursiveParallelOperationResult
+  DataLakeDirectoryClient::UpdateAccessControlListRecursiveParallel(
+      const std::vector<Models::Acl>& acls,
+      const RecursiveParallelOperationOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return std::make_shared<_detail::RecursiveParallelOperationState>(
+               *this,
+               GetPathInFileSystem(),
+               _detail::RecursiveParallelOperation::UpdateAccessControlList,
+               acls,
+               nullptr,
+               options,
+               context)
+        ->Run();
+  }
+
+  Models::RecursiveParallelOperationResult
+  DataLakeDirectoryClient::RemoveAccessControlListRecursiveParallel(
+      const std::vector<Models::Acl>& acls,
+      const RecursiveParallelOperationOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return std::make_shared<_detail::RecursiveParallelOperationState>(
+               *this,
+               GetPathInFileSystem(),
+               _detail::RecursiveParallelOperation::RemoveAccessControlList,
+               acls,
+               nullptr,
+               options,
+               context)
+        ->Run();
+  }
+
+  Models::RecursiveParallelOperationResult DataLakeDirectoryClient::DeleteRecursiveParallel(
+      const RecursiveParallelOperationOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return std::make_shared<_detail::RecursiveParallelOperationState>(
+               *this,
+               GetPathInFileSystem(),
+               _detail::RecursiveParallelOperation::Delete,
+               std::vector<Models::Acl>(),
+               nullptr,
+               options,
+               context)
+        ->Run();
+  }
+
+  Models::RecursiveParallelOperationResult DataLakeDirectoryClient::ForEachPathParallel(
+      const std::function<void(const Models::PathItem&, const Azure::Core::Context&)>&
+          pathHandler,
+      const RecursiveParallelOperationOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return std::make_shared<_detail::RecursiveParallelOperationState>(
+               *this,
+               GetPathInFileSystem(),
+               _detail::RecursiveParallelOperation::ForEachPath,
+               std::vector<Models::Acl>(),
+               pathHandler,
+               options,
+               context)
+        ->Run();
+  }
+
+}}}} // namespace Azure::Storage::Files::DataLake
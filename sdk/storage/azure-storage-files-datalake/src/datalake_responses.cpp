@@ -89,6 +89,18 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     *this = m_dataLakeServiceClient->ListFileSystems(m_operationOptions, context);
   }
 
+  ListFileSystemsPagedResponse::PageFetcher
+  ListFileSystemsPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_dataLakeServiceClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListFileSystemsPagedResponse>(
+          client->ListFileSystems(options, context));
+    };
+  }
+
   void ListPathsPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
@@ -106,6 +118,25 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     }
   }
 
+  ListPathsPagedResponse::PageFetcher ListPathsPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto fileSystemClient = m_fileSystemClient;
+    auto directoryClient = m_directoryClient;
+    auto recursive = m_recursive;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [fileSystemClient, directoryClient, recursive, options](
+               const Azure::Core::Context& context) {
+      if (fileSystemClient)
+      {
+        return std::make_unique<ListPathsPagedResponse>(
+            fileSystemClient->ListPaths(recursive, options, context));
+      }
+      return std::make_unique<ListPathsPagedResponse>(
+          directoryClient->ListPaths(recursive, options, context));
+    };
+  }
+
   void ListDeletedPathsPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
@@ -97,7 +97,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
               : _internal::StorageScope);
       perRetryPolicies.emplace_back(
           std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery));
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefresh));
     }
     perOperationPolicies.emplace_back(
         std::make_unique<_internal::StorageServiceVersionPolicy>(options.ApiVersion));
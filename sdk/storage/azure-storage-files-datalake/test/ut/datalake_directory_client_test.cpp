@@ -3,10 +3,16 @@
 
 #include "datalake_directory_client_test.hpp"
 
+#include <azure/core/internal/json/json.hpp>
+#include <azure/core/uuid.hpp>
 #include <azure/identity/client_secret_credential.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
 #include <thread>
 
 namespace Azure { namespace Storage { namespace Test {
@@ -765,6 +771,349 @@ namespace Azure { namespace Storage { namespace Test {
     }
   }
 
+  TEST_F(DataLakeDirectoryClientTest, RecursiveParallelOperations_LIVEONLY_)
+  {
+    auto rootDirectoryClient = m_directoryClient->GetSubdirectoryClient(RandomString());
+    std::set<std::string> paths;
+    for (int i = 0; i < 3; ++i)
+    {
+      const std::string directoryName = RandomString();
+      for (int j = 0; j < 2; ++j)
+      {
+        const std::string subdirectoryName = directoryName + "/" + RandomString();
+        for (int k = 0; k < 3; ++k)
+        {
+          const std::string fileName = subdirectoryName + "/" + RandomString();
+          rootDirectoryClient.GetFileClient(fileName).Create();
+          paths.insert(fileName);
+        }
+        paths.insert(subdirectoryName);
+      }
+      paths.insert(directoryName);
+    }
+
+    Files::DataLake::RecursiveParallelOperationOptions options;
+    options.MaxFanOutDepth = 2;
+    options.PageSizeHint = 2;
+    int numProgressCalls = 0;
+    options.ProgressHandler
+        = [&numProgressCalls](const Files::DataLake::Models::RecursiveParallelOperationResult&) {
+            ++numProgressCalls;
+          };
+
+    // Set Acls recursive.
+    auto acls = GetAclsForTesting();
+    auto result = rootDirectoryClient.SetAccessControlListRecursiveParallel(acls, options);
+    EXPECT_EQ(result.NumberOfSuccessfulDirectories, 10);
+    EXPECT_EQ(result.NumberOfSuccessfulFiles, 18);
+    EXPECT_EQ(result.NumberOfFailures, 0);
+    EXPECT_FALSE(result.ContinuationToken.HasValue());
+    EXPECT_GT(numProgressCalls, 0);
+    for (const auto& path : paths)
+    {
+      auto pathAcls
+          = rootDirectoryClient.GetSubdirectoryClient(path).GetAccessControlList().Value.Acls;
+      for (const auto& acl : acls)
+      {
+        if (acl.Scope == "default")
+        {
+          continue;
+        }
+        EXPECT_NE(
+            std::find_if(
+                pathAcls.begin(),
+                pathAcls.end(),
+                [&acl](const Files::DataLake::Models::Acl& targetAcl) {
+                  return targetAcl.Type == acl.Type && targetAcl.Id == acl.Id
+                      && targetAcl.Scope == acl.Scope
+                      && targetAcl.Permissions == acl.Permissions;
+                }),
+            pathAcls.end());
+      }
+    }
+
+    // Visit every path.
+    std::mutex pathsMutex;
+    std::set<std::string> visitedPaths;
+    options.ProgressHandler = nullptr;
+    result = rootDirectoryClient.ForEachPathParallel(
+        [&](const Files::DataLake::Models::PathItem& path, const Azure::Core::Context&) {
+          std::lock_guard<std::mutex> guard(pathsMutex);
+          visitedPaths.insert(path.Name);
+        },
+        options);
+    EXPECT_EQ(result.NumberOfSuccessfulDirectories, 9);
+    EXPECT_EQ(result.NumberOfSuccessfulFiles, 18);
+    EXPECT_EQ(visitedPaths.size(), paths.size());
+
+    // Delete.
+    result = rootDirectoryClient.DeleteRecursiveParallel(options);
+    EXPECT_EQ(result.NumberOfFailures, 0);
+    EXPECT_FALSE(result.ContinuationToken.HasValue());
+    EXPECT_THROW(rootDirectoryClient.GetProperties(), StorageException);
+  }
+
+  namespace {
+    // Serves the requests of the recursive parallel operations from a directory tree in memory.
+    class RecursiveOperationTransportPolicy final : public Core::Http::Policies::HttpPolicy {
+    public:
+      struct State final
+      {
+        // The paths of the tree, relative to the file system, and whether they are directories.
+        std::map<std::string, bool> Paths;
+        std::mutex Mutex;
+        int32_t SetAccessControlRequests = 0;
+      };
+
+      explicit RecursiveOperationTransportPolicy(std::shared_ptr<State> state)
+          : m_state(std::move(state))
+      {
+      }
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<RecursiveOperationTransportPolicy>(*this);
+      }
+
+      std::unique_ptr<Core::Http::RawResponse> Send(
+          Core::Http::Request& request,
+          Core::Http::Policies::NextHttpPolicy,
+          Core::Context const&) const override
+      {
+        auto queryParameters = request.GetUrl().GetQueryParameters();
+        for (auto& queryParameter : queryParameters)
+        {
+          queryParameter.second = Core::Url::Decode(queryParameter.second);
+        }
+        std::lock_guard<std::mutex> guard(m_state->Mutex);
+        if (queryParameters["resource"] == "filesystem")
+        {
+          return ListPaths(queryParameters);
+        }
+        if (queryParameters["action"] == "getAccessControl")
+        {
+          auto response = CreateResponse(Core::Http::HttpStatusCode::Ok, "OK");
+          response->SetHeader("x-ms-owner", "$superuser");
+          response->SetHeader("x-ms-group", "$superuser");
+          response->SetHeader("x-ms-permissions", "rwxr-x---");
+          response->SetHeader("x-ms-acl", "user::rwx,group::r-x,other::---");
+          response->SetHeader("ETag", "\"0x8D000000000000" + std::to_string(m_etag++) + "\"");
+          return response;
+        }
+        if (queryParameters["action"] == "setAccessControl")
+        {
+          // Someone else always changes the access control list in between.
+          ++m_state->SetAccessControlRequests;
+          auto response = CreateResponse(
+              Core::Http::HttpStatusCode::PreconditionFailed, "Condition Not Met");
+          response->SetHeader("x-ms-error-code", "ConditionNotMet");
+          return response;
+        }
+        return CreateResponse(Core::Http::HttpStatusCode::BadRequest, "Bad Request");
+      }
+
+    private:
+      std::shared_ptr<State> m_state;
+      mutable int32_t m_etag = 0;
+
+      static std::unique_ptr<Core::Http::RawResponse> CreateResponse(
+          Core::Http::HttpStatusCode statusCode,
+          const std::string& reasonPhrase)
+      {
+        auto response
+            = std::make_unique<Core::Http::RawResponse>(1, 1, statusCode, reasonPhrase);
+        response->SetHeader("x-ms-request-id", Core::Uuid::CreateUuid().ToString());
+        return response;
+      }
+
+      // Lists the paths under the directory a page at a time. The continuation token is the index
+      // of the first path of the page.
+      std::unique_ptr<Core::Http::RawResponse> ListPaths(
+          std::map<std::string, std::string>& queryParameters) const
+      {
+        const std::string prefix = queryParameters["directory"] + "/";
+        const bool recursive = queryParameters["recursive"] == "true";
+        std::vector<std::pair<std::string, bool>> paths;
+        for (const auto& path : m_state->Paths)
+        {
+          if (path.first.compare(0, prefix.size(), prefix) == 0
+              && (recursive || path.first.find('/', prefix.size()) == std::string::npos))
+          {
+            paths.push_back(path);
+          }
+        }
+        const size_t first = queryParameters["continuation"].empty()
+            ? 0
+            : std::stoul(queryParameters["continuation"]);
+        const size_t last = (std::min)(
+            paths.size(),
+            first
+                + (queryParameters["maxResults"].empty()
+                       ? paths.size()
+                       : std::stoul(queryParameters["maxResults"])));
+
+        Core::Json::_internal::json pathsJson = Core::Json::_internal::json::array();
+        for (size_t i = first; i < last; ++i)
+        {
+          Core::Json::_internal::json pathJson;
+          pathJson["name"] = paths[i].first;
+          pathJson["isDirectory"] = paths[i].second ? "true" : "false";
+          pathJson["lastModified"] = "Thu, 23 Aug 2001 07:00:00 GMT";
+          pathJson["contentLength"] = "0";
+          pathJson["owner"] = "$superuser";
+          pathJson["group"] = "$superuser";
+          pathJson["permissions"] = "rwxr-x---";
+          pathsJson.push_back(std::move(pathJson));
+        }
+        Core::Json::_internal::json bodyJson;
+        bodyJson["paths"] = std::move(pathsJson);
+        const std::string body = bodyJson.dump();
+
+        auto response = CreateResponse(Core::Http::HttpStatusCode::Ok, "OK");
+        response->SetBody(std::vector<uint8_t>(body.begin(), body.end()));
+        if (last < paths.size())
+        {
+          response->SetHeader("x-ms-continuation", std::to_string(last));
+        }
+        return response;
+      }
+    };
+
+    Files::DataLake::DataLakeDirectoryClient CreateRecursiveOperationTestClient(
+        std::shared_ptr<RecursiveOperationTransportPolicy::State> state)
+    {
+      Files::DataLake::DataLakeClientOptions clientOptions;
+      clientOptions.PerRetryPolicies.emplace_back(
+          std::make_unique<RecursiveOperationTransportPolicy>(std::move(state)));
+      return Files::DataLake::DataLakeDirectoryClient(
+          "https://account.dfs.core.windows.net/fs/dir", clientOptions);
+    }
+  } // namespace
+
+  TEST(DataLakeRecursiveParallelTest, ResumeFromContinuationToken)
+  {
+    auto state = std::make_shared<RecursiveOperationTransportPolicy::State>();
+    state->Paths = {
+        {"dir/a", true},
+        {"dir/a/f1", false},
+        {"dir/a/f2", false},
+        {"dir/b", false},
+        {"dir/c", true},
+        {"dir/c/d", true},
+        {"dir/c/d/f4", false},
+        {"dir/c/f3", false},
+    };
+    auto directoryClient = CreateRecursiveOperationTestClient(state);
+
+    Files::DataLake::RecursiveParallelOperationOptions options;
+    options.Concurrency = 1;
+    options.MaxFanOutDepth = 1;
+    options.PageSizeHint = 2;
+
+    std::mutex mutex;
+    std::set<std::string> visitedPaths;
+    bool failOnF3 = true;
+    auto pathHandler = [&](const Files::DataLake::Models::PathItem& path, const Core::Context&) {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (failOnF3 && path.Name == "dir/c/f3")
+      {
+        throw std::runtime_error("Handler failure.");
+      }
+      EXPECT_TRUE(visitedPaths.insert(path.Name).second) << path.Name << " was visited twice";
+    };
+
+    auto result = directoryClient.ForEachPathParallel(pathHandler, options);
+    EXPECT_EQ(result.NumberOfFailures, 1);
+    ASSERT_EQ(result.FailedEntries.size(), 1U);
+    EXPECT_EQ(result.FailedEntries[0].Name, "dir/c/f3");
+    ASSERT_TRUE(result.ContinuationToken.HasValue());
+    EXPECT_LT(visitedPaths.size(), state->Paths.size());
+    const auto numberOfSuccessfulPaths
+        = result.NumberOfSuccessfulDirectories + result.NumberOfSuccessfulFiles;
+    EXPECT_EQ(numberOfSuccessfulPaths, static_cast<int64_t>(visitedPaths.size()));
+
+    // The token only resumes the same operation on the same directory.
+    auto otherOptions = options;
+    otherOptions.ContinuationToken = result.ContinuationToken;
+    EXPECT_THROW(directoryClient.DeleteRecursiveParallel(otherOptions), std::invalid_argument);
+    EXPECT_THROW(
+        directoryClient.GetSubdirectoryClient("a").ForEachPathParallel(pathHandler, otherOptions),
+        std::invalid_argument);
+    otherOptions.ContinuationToken = "invalid";
+    EXPECT_THROW(
+        directoryClient.ForEachPathParallel(pathHandler, otherOptions), std::invalid_argument);
+
+    // The resumed operation visits the paths left, and keeps counting from the token.
+    failOnF3 = false;
+    options.ContinuationToken = result.ContinuationToken;
+    result = directoryClient.ForEachPathParallel(pathHandler, options);
+    EXPECT_FALSE(result.ContinuationToken.HasValue());
+    EXPECT_EQ(result.NumberOfFailures, 1);
+    EXPECT_EQ(result.NumberOfSuccessfulDirectories, 3);
+    EXPECT_EQ(result.NumberOfSuccessfulFiles, 5);
+    EXPECT_EQ(visitedPaths.size(), state->Paths.size());
+  }
+
+  TEST(DataLakeRecursiveParallelTest, ProgressReportsTheLastResult)
+  {
+    auto state = std::make_shared<RecursiveOperationTransportPolicy::State>();
+    for (int i = 0; i < 50; ++i)
+    {
+      state->Paths.emplace("dir/f" + std::to_string(i), false);
+    }
+    auto directoryClient = CreateRecursiveOperationTestClient(state);
+
+    Files::DataLake::RecursiveParallelOperationOptions options;
+    options.Concurrency = 4;
+    options.PageSizeHint = 5;
+    options.ContinueOnFailure = false;
+    int numProgressCalls = 0;
+    Files::DataLake::Models::RecursiveParallelOperationResult lastProgress;
+    options.ProgressHandler
+        = [&](const Files::DataLake::Models::RecursiveParallelOperationResult& progress) {
+            ++numProgressCalls;
+            lastProgress = progress;
+          };
+
+    // The changes are reported at most once a second, and the result the operation stops with is
+    // always reported.
+    auto result = directoryClient.ForEachPathParallel(
+        [](const Files::DataLake::Models::PathItem& path, const Core::Context&) {
+          if (path.Name == "dir/f42")
+          {
+            throw std::runtime_error("Handler failure.");
+          }
+        },
+        options);
+    ASSERT_TRUE(result.ContinuationToken.HasValue());
+    EXPECT_GE(numProgressCalls, 1);
+    EXPECT_LT(numProgressCalls, 50);
+    EXPECT_EQ(lastProgress.ContinuationToken.ValueOr(""), result.ContinuationToken.Value());
+    EXPECT_EQ(lastProgress.NumberOfSuccessfulFiles, result.NumberOfSuccessfulFiles);
+    EXPECT_EQ(lastProgress.NumberOfFailures, 1);
+  }
+
+  TEST(DataLakeRecursiveParallelTest, UpdateAccessControlListRetriesAreLimited)
+  {
+    auto state = std::make_shared<RecursiveOperationTransportPolicy::State>();
+    auto directoryClient = CreateRecursiveOperationTestClient(state);
+
+    Files::DataLake::RecursiveParallelOperationOptions options;
+    options.Concurrency = 1;
+    options.MaxFanOutDepth = 1;
+    std::vector<Files::DataLake::Models::Acl> acls
+        = Files::DataLake::Models::Acl::DeserializeAcls("user::rwx");
+
+    // The access control list of the root directory keeps changing, so the update gives up.
+    auto result = directoryClient.UpdateAccessControlListRecursiveParallel(acls, options);
+    EXPECT_EQ(result.NumberOfFailures, 1);
+    ASSERT_EQ(result.FailedEntries.size(), 1U);
+    EXPECT_EQ(result.FailedEntries[0].Name, "dir");
+    EXPECT_TRUE(result.ContinuationToken.HasValue());
+    EXPECT_GT(state->SetAccessControlRequests, 1);
+    EXPECT_LT(state->SetAccessControlRequests, 100);
+  }
+
   TEST_F(DataLakeDirectoryClientTest, ListPaths_LIVEONLY_)
   {
     std::set<std::string> paths;
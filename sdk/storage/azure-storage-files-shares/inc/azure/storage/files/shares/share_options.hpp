@@ -870,6 +870,20 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
      */
     Azure::Nullable<Core::Http::HttpRange> Range;
 
+    /**
+     * If true, the valid ranges of the file are listed first and only they are downloaded. The
+     * other bytes are zeros. When downloading to a file, they are left sparse where the file system
+     * supports it, which makes downloading files with large empty regions much faster.
+     */
+    bool DownloadValidRangesOnly = false;
+
+    /**
+     * If set, only the ranges that changed since this share snapshot are downloaded, and the
+     * ranges that were cleared since are zeroed. The destination must contain the content of the
+     * file in that snapshot, for example downloaded by a previous call, and is updated in place.
+     */
+    Azure::Nullable<std::string> PreviousShareSnapshot;
+
     /**
      * @brief Options for parallel transfer.
      */
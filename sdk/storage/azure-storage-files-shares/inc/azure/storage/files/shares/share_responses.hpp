@@ -379,6 +379,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
   private:
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     std::shared_ptr<ShareServiceClient> m_shareServiceClient;
     ListSharesOptions m_operationOptions;
@@ -429,6 +430,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
   private:
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     std::shared_ptr<ShareDirectoryClient> m_shareDirectoryClient;
     ListFilesAndDirectoriesOptions m_operationOptions;
@@ -84,7 +84,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
               : _internal::StorageScope);
       perRetryPolicies.emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy>(
-              credential, tokenContext));
+              credential, tokenContext, options.TokenRefresh));
     }
     perOperationPolicies.emplace_back(
         std::make_unique<_internal::StorageServiceVersionPolicy>(newOptions.ApiVersion));
@@ -11,6 +11,7 @@
 #include <azure/core/internal/io/null_body_stream.hpp>
 #include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/buffer_pool.hpp>
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
@@ -21,6 +22,12 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
   ShareFileClient ShareFileClient::CreateFromConnectionString(
@@ -91,7 +98,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
               : _internal::StorageScope);
       perRetryPolicies.emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy>(
-              credential, tokenContext));
+              credential, tokenContext, options.TokenRefresh));
     }
     perOperationPolicies.emplace_back(
         std::make_unique<_internal::StorageServiceVersionPolicy>(newOptions.ApiVersion));
@@ -772,12 +779,148 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     return pagedResponse;
   }
 
+  namespace {
+    // Downloads the valid ranges of the file, or the ranges changed since
+    // options.PreviousShareSnapshot, instead of every byte of it.
+    Azure::Response<Models::DownloadFileToResult> DownloadRangesTo(
+        const ShareFileClient& fileClient,
+        const DownloadFileToOptions& options,
+        // Called with the size of the downloaded range before anything is written.
+        const std::function<void(int64_t)>& setSize,
+        // offset, length
+        const std::function<void(int64_t, int64_t)>& zeroRange,
+        // body stream, offset, length
+        const std::function<void(Azure::Core::IO::BodyStream&, int64_t, int64_t)>& writeRange,
+        const Azure::Core::Context& context)
+    {
+      auto properties = fileClient.GetProperties(GetFilePropertiesOptions(), context);
+      const Azure::ETag etag = properties.Value.ETag;
+
+      GetFileRangeListOptions rangeListOptions;
+      rangeListOptions.Range = options.Range;
+      auto rangeList = options.PreviousShareSnapshot.HasValue()
+          ? fileClient.GetRangeListDiff(
+              options.PreviousShareSnapshot.Value(), rangeListOptions, context)
+          : fileClient.GetRangeList(rangeListOptions, context);
+      if (rangeList.Value.ETag != etag)
+      {
+        throw Azure::Core::RequestFailedException("File was modified in the middle of download.");
+      }
+
+      const int64_t fileSize = properties.Value.FileSize;
+      const int64_t rangeBegin = (std::min)(
+          options.Range.HasValue() ? options.Range.Value().Offset : int64_t(0), fileSize);
+      int64_t rangeEnd = fileSize;
+      if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
+      {
+        rangeEnd = (std::min)(rangeEnd, rangeBegin + options.Range.Value().Length.Value());
+      }
+
+      setSize(rangeEnd - rangeBegin);
+      for (const auto& clearRange : rangeList.Value.ClearRanges)
+      {
+        const int64_t begin = (std::max)(clearRange.Offset, rangeBegin);
+        const int64_t end = (std::min)(clearRange.Offset + clearRange.Length.Value(), rangeEnd);
+        if (begin < end)
+        {
+          zeroRange(begin - rangeBegin, end - begin);
+        }
+      }
+
+      std::vector<std::pair<int64_t, int64_t>> chunks;
+      for (const auto& range : rangeList.Value.Ranges)
+      {
+        const int64_t begin = (std::max)(range.Offset, rangeBegin);
+        const int64_t end = (std::min)(range.Offset + range.Length.Value(), rangeEnd);
+        for (int64_t offset = begin; offset < end; offset += options.TransferOptions.ChunkSize)
+        {
+          chunks.emplace_back(offset, (std::min)(options.TransferOptions.ChunkSize, end - offset));
+        }
+      }
+
+      auto downloadChunkFunc = [&](int64_t, int64_t, int64_t chunkId, int64_t) {
+        const auto& chunk = chunks[static_cast<size_t>(chunkId)];
+        DownloadFileOptions chunkOptions;
+        chunkOptions.Range = Core::Http::HttpRange();
+        chunkOptions.Range.Value().Offset = chunk.first;
+        chunkOptions.Range.Value().Length = chunk.second;
+        auto response = fileClient.Download(chunkOptions, context);
+        if (response.Value.Details.ETag != etag)
+        {
+          throw Azure::Core::RequestFailedException(
+              "File was modified in the middle of download.");
+        }
+        writeRange(*(response.Value.BodyStream), chunk.first - rangeBegin, chunk.second);
+      };
+      _internal::ConcurrentTransfer(
+          0,
+          static_cast<int64_t>(chunks.size()),
+          1,
+          options.TransferOptions.Concurrency,
+          downloadChunkFunc);
+
+      Models::DownloadFileToResult ret;
+      ret.FileSize = fileSize;
+      ret.ContentRange.Offset = rangeBegin;
+      ret.ContentRange.Length = rangeEnd - rangeBegin;
+      ret.HttpHeaders = std::move(properties.Value.HttpHeaders);
+      ret.Details.ETag = std::move(properties.Value.ETag);
+      ret.Details.LastModified = std::move(properties.Value.LastModified);
+      ret.Details.Metadata = std::move(properties.Value.Metadata);
+      ret.Details.CopyId = std::move(properties.Value.CopyId);
+      ret.Details.CopySource = std::move(properties.Value.CopySource);
+      ret.Details.CopyStatus = std::move(properties.Value.CopyStatus);
+      ret.Details.CopyStatusDescription = std::move(properties.Value.CopyStatusDescription);
+      ret.Details.CopyProgress = std::move(properties.Value.CopyProgress);
+      ret.Details.CopyCompletedOn = std::move(properties.Value.CopyCompletedOn);
+      ret.Details.IsServerEncrypted = properties.Value.IsServerEncrypted;
+      ret.Details.SmbProperties = std::move(properties.Value.SmbProperties);
+      ret.Details.LeaseDuration = std::move(properties.Value.LeaseDuration);
+      ret.Details.LeaseState = std::move(properties.Value.LeaseState);
+      ret.Details.LeaseStatus = std::move(properties.Value.LeaseStatus);
+      return Azure::Response<Models::DownloadFileToResult>(
+          std::move(ret), std::move(properties.RawResponse));
+    }
+  } // namespace
+
   Azure::Response<Models::DownloadFileToResult> ShareFileClient::DownloadTo(
       uint8_t* buffer,
       size_t bufferSize,
       const DownloadFileToOptions& options,
       const Azure::Core::Context& context) const
   {
+    if (options.DownloadValidRangesOnly || options.PreviousShareSnapshot.HasValue())
+    {
+      return DownloadRangesTo(
+          *this,
+          options,
+          [&](int64_t fileRangeSize) {
+            if (static_cast<uint64_t>(fileRangeSize) > (std::numeric_limits<size_t>::max)()
+                || static_cast<size_t>(fileRangeSize) > bufferSize)
+            {
+              throw Azure::Core::RequestFailedException(
+                  "Buffer is not big enough, file range size is " + std::to_string(fileRangeSize)
+                  + ".");
+            }
+            if (!options.PreviousShareSnapshot.HasValue())
+            {
+              std::fill(buffer, buffer + fileRangeSize, uint8_t(0));
+            }
+          },
+          [&](int64_t offset, int64_t length) {
+            std::fill(buffer + offset, buffer + offset + length, uint8_t(0));
+          },
+          [&](Azure::Core::IO::BodyStream& stream, int64_t offset, int64_t length) {
+            int64_t bytesRead
+                = stream.ReadToCount(buffer + offset, static_cast<size_t>(length), context);
+            if (bytesRead != length)
+            {
+              throw Azure::Core::RequestFailedException("Error when reading body stream.");
+            }
+          },
+          context);
+    }
+
     // Just start downloading using an initial chunk. If it's a small file, we'll get the whole
     // thing in one shot. If it's a large file, we'll get its full size in Content-Range and can
     // keep downloading it in chunks.
@@ -889,6 +1032,44 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
       const DownloadFileToOptions& options,
       const Azure::Core::Context& context) const
   {
+    // Every chunk reuses a buffer released by a chunk downloaded before it, if any.
+    _internal::BufferPool bufferPool(4 * 1024 * 1024);
+    auto bodyStreamToFile = [&bufferPool](
+                                Azure::Core::IO::BodyStream& stream,
+                                _internal::FileWriter& fileWriter,
+                                int64_t offset,
+                                int64_t length,
+                                const Azure::Core::Context& context) {
+      auto buffer = bufferPool.Acquire();
+      while (length > 0)
+      {
+        size_t readSize = static_cast<size_t>(std::min<int64_t>(buffer.Size(), length));
+        size_t bytesRead = stream.ReadToCount(buffer.Data(), readSize, context);
+        if (bytesRead != readSize)
+        {
+          throw Azure::Core::RequestFailedException("Error when reading body stream.");
+        }
+        fileWriter.Write(buffer.Data(), bytesRead, offset);
+        length -= bytesRead;
+        offset += bytesRead;
+      }
+    };
+
+    if (options.DownloadValidRangesOnly || options.PreviousShareSnapshot.HasValue())
+    {
+      // An existing copy of the previous snapshot is updated in place.
+      _internal::FileWriter fileWriter(fileName, !options.PreviousShareSnapshot.HasValue());
+      return DownloadRangesTo(
+          *this,
+          options,
+          [&](int64_t fileRangeSize) { fileWriter.SetSize(fileRangeSize); },
+          [&](int64_t offset, int64_t length) { fileWriter.ZeroRange(offset, length); },
+          [&](Azure::Core::IO::BodyStream& stream, int64_t offset, int64_t length) {
+            bodyStreamToFile(stream, fileWriter, offset, length, context);
+          },
+          context);
+    }
+
     // Just start downloading using an initial chunk. If it's a small file, we'll get the whole
     // thing in one shot. If it's a large file, we'll get its full size in Content-Range and can
     // keep downloading it in chunks.
@@ -927,27 +1108,6 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     }
     firstChunkLength = (std::min)(firstChunkLength, fileRangeSize);
 
-    auto bodyStreamToFile = [](Azure::Core::IO::BodyStream& stream,
-                               _internal::FileWriter& fileWriter,
-                               int64_t offset,
-                               int64_t length,
-                               const Azure::Core::Context& context) {
-      constexpr size_t bufferSize = 4 * 1024 * 1024;
-      std::vector<uint8_t> buffer(bufferSize);
-      while (length > 0)
-      {
-        size_t readSize = static_cast<size_t>(std::min<int64_t>(bufferSize, length));
-        size_t bytesRead = stream.ReadToCount(buffer.data(), readSize, context);
-        if (bytesRead != readSize)
-        {
-          throw Azure::Core::RequestFailedException("Error when reading body stream.");
-        }
-        fileWriter.Write(buffer.data(), bytesRead, offset);
-        length -= bytesRead;
-        offset += bytesRead;
-      }
-    };
-
     _internal::FileWriter fileWriter(fileName);
     bodyStreamToFile(*(firstChunk.Value.BodyStream), fileWriter, 0, firstChunkLength, context);
     firstChunk.Value.BodyStream.reset();
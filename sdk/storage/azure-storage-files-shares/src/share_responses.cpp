@@ -115,12 +115,34 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     *this = m_shareServiceClient->ListShares(m_operationOptions, context);
   }
 
+  ListSharesPagedResponse::PageFetcher ListSharesPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_shareServiceClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListSharesPagedResponse>(client->ListShares(options, context));
+    };
+  }
+
   void ListFilesAndDirectoriesPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
     *this = m_shareDirectoryClient->ListFilesAndDirectories(m_operationOptions, context);
   }
 
+  ListFilesAndDirectoriesPagedResponse::PageFetcher
+  ListFilesAndDirectoriesPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_shareDirectoryClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListFilesAndDirectoriesPagedResponse>(
+          client->ListFilesAndDirectories(options, context));
+    };
+  }
+
   void ListFileHandlesPagedResponse::OnNextPage(const Azure::Core::Context& context)
   {
     m_operationOptions.ContinuationToken = NextPageToken;
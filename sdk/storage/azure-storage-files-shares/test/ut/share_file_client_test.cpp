@@ -989,6 +989,48 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(1536, result.ClearRanges[1].Length.Value());
   }
 
+  TEST_F(FileShareFileClientTest, DownloadValidRangesOnly)
+  {
+    size_t fileSize = 1024 * 10;
+    std::vector<uint8_t> fileContent(fileSize, '\x00');
+    std::vector<uint8_t> rangeContent = RandomBuffer(1024);
+    auto memBodyStream = Core::IO::MemoryBodyStream(rangeContent);
+    auto fileClient = m_shareClient->GetRootDirectoryClient().GetFileClient(RandomString());
+    fileClient.Create(fileSize);
+    EXPECT_NO_THROW(fileClient.UploadRange(2048, memBodyStream));
+    std::copy(rangeContent.begin(), rangeContent.end(), fileContent.begin() + 2048);
+
+    const std::string tempFilename = RandomString();
+    Files::Shares::DownloadFileToOptions options;
+    options.DownloadValidRangesOnly = true;
+    options.TransferOptions.ChunkSize = 512;
+    auto result = fileClient.DownloadTo(tempFilename, options);
+    EXPECT_EQ(result.Value.FileSize, static_cast<int64_t>(fileSize));
+    EXPECT_EQ(result.Value.ContentRange.Length.Value(), static_cast<int64_t>(fileSize));
+    EXPECT_EQ(ReadFile(tempFilename), fileContent);
+
+    std::vector<uint8_t> downloadContent(fileSize, '\xff');
+    EXPECT_NO_THROW(fileClient.DownloadTo(downloadContent.data(), fileSize, options));
+    EXPECT_EQ(downloadContent, fileContent);
+
+    // Update the copies of a snapshot with the ranges changed since.
+    auto snapshot = m_shareClient->CreateSnapshot().Value.Snapshot;
+    rangeContent = RandomBuffer(512);
+    memBodyStream = Core::IO::MemoryBodyStream(rangeContent);
+    EXPECT_NO_THROW(fileClient.UploadRange(8192, memBodyStream));
+    EXPECT_NO_THROW(fileClient.ClearRange(2048, 512));
+    std::copy(rangeContent.begin(), rangeContent.end(), fileContent.begin() + 8192);
+    std::fill(fileContent.begin() + 2048, fileContent.begin() + 2048 + 512, '\x00');
+
+    options.DownloadValidRangesOnly = false;
+    options.PreviousShareSnapshot = snapshot;
+    EXPECT_NO_THROW(fileClient.DownloadTo(tempFilename, options));
+    EXPECT_EQ(ReadFile(tempFilename), fileContent);
+    EXPECT_NO_THROW(fileClient.DownloadTo(downloadContent.data(), fileSize, options));
+    EXPECT_EQ(downloadContent, fileContent);
+    DeleteFile(tempFilename);
+  }
+
   TEST_F(FileShareFileClientTest, StorageExceptionAdditionalInfo)
   {
     auto options = InitStorageClientOptions<Azure::Storage::Files::Shares::ShareClientOptions>();
@@ -11,6 +11,7 @@
 #include "azure/storage/queues/dll_import_export.hpp"
 #include "azure/storage/queues/queue_client.hpp"
 #include "azure/storage/queues/queue_options.hpp"
+#include "azure/storage/queues/queue_processor.hpp"
 #include "azure/storage/queues/queue_responses.hpp"
 #include "azure/storage/queues/queue_sas_builder.hpp"
 #include "azure/storage/queues/queue_service_client.hpp"
@@ -15,6 +15,8 @@
 #include <azure/storage/common/storage_common.hpp>
 
 #include <chrono>
+#include <exception>
+#include <functional>
 #include <string>
 
 namespace Azure { namespace Storage { namespace Queues {
@@ -317,4 +319,72 @@ namespace Azure { namespace Storage { namespace Queues {
   {
   };
 
+  /**
+   * @brief An error reported by #Azure::Storage::Queues::QueueProcessor.
+   */
+  struct QueueProcessorError final
+  {
+    /**
+     * @brief The operation that failed, one of "ReceiveMessages", "Handler", "UpdateMessage" or
+     * "DeleteMessage".
+     */
+    std::string Operation;
+
+    /**
+     * @brief The message the operation was run for. Not set for "ReceiveMessages".
+     */
+    Azure::Nullable<Models::QueueMessage> Message;
+
+    /**
+     * @brief The exception thrown by the operation.
+     */
+    std::exception_ptr Exception;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Queues::QueueProcessor.
+   */
+  struct QueueProcessorOptions final
+  {
+    /**
+     * @brief The number of ReceiveMessages requests running at the same time.
+     */
+    int32_t ReceiveConcurrency = 8;
+
+    /**
+     * @brief The maximum number of messages that are received but not handed to the handler yet.
+     * Messages are received as soon as there's room for them in this buffer.
+     */
+    int32_t MaxPrefetchedMessages = 512;
+
+    /**
+     * @brief The number of messages handled at the same time.
+     */
+    int32_t HandlerConcurrency = 16;
+
+    /**
+     * @brief The number of DeleteMessage and UpdateMessage requests running at the same time.
+     */
+    int32_t RequestConcurrency = 64;
+
+    /**
+     * @brief How long the received messages are invisible to other consumers. The visibility of a
+     * message is renewed when half of it has elapsed, until the message is deleted or released.
+     * Must be at least one second.
+     */
+    std::chrono::seconds VisibilityTimeout = std::chrono::seconds(30);
+
+    /**
+     * @brief The longest wait between two ReceiveMessages requests while the queue is empty. The
+     * wait starts at 100 milliseconds and doubles each time a request returns no message.
+     */
+    std::chrono::milliseconds MaxPollingInterval = std::chrono::seconds(10);
+
+    /**
+     * @brief Callback for error handling, called from the threads of the processor. If you don't
+     * specify one, the errors are ignored. Exceptions thrown by the callback are ignored.
+     */
+    std::function<void(QueueProcessorError)> ErrorHandler;
+  };
+
 }}} // namespace Azure::Storage::Queues
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+/**
+ * @file
+ * @brief Defines Queue processor.
+ *
+ */
+
+#pragma once
+
+#include "azure/storage/queues/queue_client.hpp"
+#include "azure/storage/queues/queue_options.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace Azure { namespace Storage { namespace Queues {
+
+  namespace _detail {
+    class QueueProcessorState;
+  } // namespace _detail
+
+  /**
+   * @brief The QueueProcessor receives the messages of a queue and hands them to a handler.
+   *
+   * @details Messages are received ahead of the handler, up to
+   * #Azure::Storage::Queues::QueueProcessorOptions::MaxPrefetchedMessages, and several messages
+   * are handled at the same time. The visibility of the messages is renewed while they wait or are
+   * handled. A message is deleted once the handler returns. If the handler throws, the message is
+   * made visible again right away, so it's received again with a greater DequeueCount.
+   */
+  class QueueProcessor final {
+  public:
+    /**
+     * @brief A function called for each message. The context is cancelled if the message is lost,
+     * that is when its visibility can't be renewed.
+     */
+    using MessageHandler
+        = std::function<void(const Models::QueueMessage&, const Azure::Core::Context&)>;
+
+    /**
+     * @brief Initializes a new instance of QueueProcessor. Messages aren't received until #Start
+     * is called.
+     *
+     * @param queueClient The client of the queue to receive the messages from.
+     * @param handler The function called for each message, from several threads at the same time.
+     * @param options Optional parameters of the processor.
+     */
+    explicit QueueProcessor(
+        QueueClient queueClient,
+        MessageHandler handler,
+        const QueueProcessorOptions& options = QueueProcessorOptions());
+
+    QueueProcessor(const QueueProcessor&) = delete;
+    QueueProcessor& operator=(const QueueProcessor&) = delete;
+
+    /**
+     * @brief Stops the processor.
+     */
+    ~QueueProcessor();
+
+    /**
+     * @brief Starts receiving and handling messages. Does nothing if the processor is running.
+     */
+    void Start();
+
+    /**
+     * @brief Stops receiving messages and waits for the messages being handled. The messages that
+     * were received but not handled yet are made visible again. Does nothing if the processor
+     * isn't running.
+     *
+     * @remark Must not be called from the handler.
+     */
+    void Stop();
+
+  private:
+    std::unique_ptr<_detail::QueueProcessorState> m_state;
+  };
+
+}}} // namespace Azure::Storage::Queues
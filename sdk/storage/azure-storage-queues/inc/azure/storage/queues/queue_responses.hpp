@@ -42,6 +42,7 @@ namespace Azure { namespace Storage { namespace Queues {
 
   private:
     void OnNextPage(const Azure::Core::Context& context);
+    PageFetcher OnGetNextPageFetcher() const override;
 
     std::shared_ptr<QueueServiceClient> m_queueServiceClient;
     ListQueuesOptions m_operationOptions;
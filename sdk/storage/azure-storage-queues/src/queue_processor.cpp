@@ -0,0 +1,491 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/queues/queue_processor.hpp"
+
+#include <azure/storage/common/internal/thread_pool.hpp>
+#include <azure/storage/common/storage_exception.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Queues {
+
+  namespace {
+    // The most messages a ReceiveMessages request can return.
+    constexpr int64_t MaxMessagesPerReceive = 32;
+    constexpr std::chrono::milliseconds MinPollingInterval(100);
+    constexpr std::chrono::seconds RenewalRetryInterval(1);
+  } // namespace
+
+  namespace _detail {
+
+    class QueueProcessorState final {
+    public:
+      QueueProcessorState(
+          Queues::QueueClient queueClient,
+          QueueProcessor::MessageHandler handler,
+          const QueueProcessorOptions& options)
+          : m_queueClient(std::move(queueClient)), m_handler(std::move(handler)),
+            m_options(options), m_handlerPool(static_cast<size_t>(options.HandlerConcurrency)),
+            m_requestPool(static_cast<size_t>(options.RequestConcurrency))
+      {
+      }
+
+      void Start();
+      void Stop();
+
+    private:
+      using Clock = std::chrono::steady_clock;
+
+      // The visibility of a message is renewed when half of it has elapsed.
+      std::chrono::milliseconds RenewalInterval() const
+      {
+        return std::chrono::milliseconds(m_options.VisibilityTimeout) / 2;
+      }
+
+      struct TrackedMessage final
+      {
+        explicit TrackedMessage(Models::QueueMessage message)
+            : Message(std::move(message)), PopReceipt(Message.PopReceipt)
+        {
+        }
+
+        // Handed to the handler, so it isn't updated when the visibility is renewed.
+        const Models::QueueMessage Message;
+        Azure::Core::Context Context;
+
+        // Held during the requests on the message, so that a renewal doesn't race with the delete.
+        std::mutex Mutex;
+        std::string PopReceipt;
+        Clock::time_point VisibleUntil;
+        bool Finished = false;
+        bool Lost = false;
+
+        // Guarded by QueueProcessorState::m_mutex.
+        bool RenewalScheduled = false;
+        std::multimap<Clock::time_point, std::shared_ptr<TrackedMessage>>::iterator Renewal;
+      };
+
+      void ReceiveMessages();
+      void ScheduleRenewals();
+      void HandleMessage(const std::shared_ptr<TrackedMessage>& message);
+      void DeleteMessage(const std::shared_ptr<TrackedMessage>& message);
+      void ReleaseMessage(const std::shared_ptr<TrackedMessage>& message);
+      void RenewMessage(const std::shared_ptr<TrackedMessage>& message);
+      void SubmitRequest(std::function<void()> request);
+      // Must be called with m_mutex locked.
+      void ScheduleRenewal(
+          const std::shared_ptr<TrackedMessage>& message,
+          Clock::time_point renewAt);
+      void UnscheduleRenewal(const std::shared_ptr<TrackedMessage>& message);
+      void ReportError(
+          const char* operation,
+          const Models::QueueMessage* message,
+          std::exception_ptr exception);
+
+      const Queues::QueueClient m_queueClient;
+      const QueueProcessor::MessageHandler m_handler;
+      const QueueProcessorOptions m_options;
+
+      std::mutex m_startStopMutex;
+      std::vector<std::thread> m_receivers;
+      std::thread m_scheduler;
+      Azure::Core::Context m_receiveContext;
+
+      std::mutex m_mutex;
+      std::condition_variable m_receiveCondition;
+      std::condition_variable m_renewalCondition;
+      std::condition_variable m_drainedCondition;
+      bool m_stopping = false;
+      bool m_schedulerStopping = false;
+      // Messages received or being received that no handler picked up yet.
+      int64_t m_prefetchedMessages = 0;
+      // Messages received whose handler didn't return yet.
+      int64_t m_unfinishedMessages = 0;
+      int64_t m_pendingRequests = 0;
+      std::multimap<Clock::time_point, std::shared_ptr<TrackedMessage>> m_renewals;
+
+      // Declared last so that their threads are joined before the members above are destroyed.
+      _internal::ThreadPool m_handlerPool;
+      _internal::ThreadPool m_requestPool;
+    };
+
+    void QueueProcessorState::Start()
+    {
+      std::lock_guard<std::mutex> startStopGuard(m_startStopMutex);
+      if (m_scheduler.joinable())
+      {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stopping = false;
+        m_schedulerStopping = false;
+      }
+      m_receiveContext = Azure::Core::Context();
+      m_scheduler = std::thread([this]() { ScheduleRenewals(); });
+      for (int32_t i = 0; i < m_options.ReceiveConcurrency; ++i)
+      {
+        m_receivers.emplace_back([this]() { ReceiveMessages(); });
+      }
+    }
+
+    void QueueProcessorState::Stop()
+    {
+      std::lock_guard<std::mutex> startStopGuard(m_startStopMutex);
+      if (!m_scheduler.joinable())
+      {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stopping = true;
+      }
+      m_receiveContext.Cancel();
+      m_receiveCondition.notify_all();
+      for (auto& receiver : m_receivers)
+      {
+        receiver.join();
+      }
+      m_receivers.clear();
+
+      // The messages that no handler picked up yet are released by their handler task. The
+      // visibility of the others is still renewed until they are deleted or released.
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_drainedCondition.wait(
+            lock, [this]() { return m_unfinishedMessages == 0 && m_pendingRequests == 0; });
+        m_schedulerStopping = true;
+      }
+      m_renewalCondition.notify_all();
+      m_scheduler.join();
+    }
+
+    void QueueProcessorState::ReceiveMessages()
+    {
+      auto pollingInterval = std::chrono::milliseconds(0);
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true)
+      {
+        m_receiveCondition.wait(lock, [this]() {
+          return m_stopping || m_prefetchedMessages < m_options.MaxPrefetchedMessages;
+        });
+        if (m_stopping)
+        {
+          return;
+        }
+        const int64_t maxMessages = (std::min)(
+            MaxMessagesPerReceive, m_options.MaxPrefetchedMessages - m_prefetchedMessages);
+        m_prefetchedMessages += maxMessages;
+        lock.unlock();
+
+        std::vector<Models::QueueMessage> messages;
+        bool failed = false;
+        // The visibility timeout starts when the service receives the request.
+        const auto sentOn = Clock::now();
+        try
+        {
+          ReceiveMessagesOptions receiveOptions;
+          receiveOptions.MaxMessages = maxMessages;
+          receiveOptions.VisibilityTimeout = m_options.VisibilityTimeout;
+          messages = std::move(
+              m_queueClient.ReceiveMessages(receiveOptions, m_receiveContext).Value.Messages);
+        }
+        catch (...)
+        {
+          failed = true;
+          if (!m_receiveContext.IsCancelled())
+          {
+            ReportError("ReceiveMessages", nullptr, std::current_exception());
+          }
+        }
+
+        lock.lock();
+        m_prefetchedMessages -= maxMessages - static_cast<int64_t>(messages.size());
+        m_unfinishedMessages += static_cast<int64_t>(messages.size());
+        for (auto& message : messages)
+        {
+          auto trackedMessage = std::make_shared<TrackedMessage>(std::move(message));
+          trackedMessage->VisibleUntil = sentOn + m_options.VisibilityTimeout;
+          ScheduleRenewal(trackedMessage, sentOn + RenewalInterval());
+          m_handlerPool.Submit([this, trackedMessage]() { HandleMessage(trackedMessage); });
+        }
+        if (m_prefetchedMessages < m_options.MaxPrefetchedMessages)
+        {
+          m_receiveCondition.notify_one();
+        }
+
+        // Poll less and less often while the queue is empty, and as fast as possible again once
+        // it isn't.
+        if (failed || messages.empty())
+        {
+          pollingInterval = (std::min)(
+              (std::max)(pollingInterval * 2, std::chrono::milliseconds(MinPollingInterval)),
+              m_options.MaxPollingInterval);
+          m_receiveCondition.wait_for(lock, pollingInterval, [this]() { return m_stopping; });
+        }
+        else
+        {
+          pollingInterval = std::chrono::milliseconds(0);
+        }
+      }
+    }
+
+    void QueueProcessorState::ScheduleRenewals()
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (!m_schedulerStopping)
+      {
+        const auto now = Clock::now();
+        while (!m_renewals.empty() && m_renewals.begin()->first <= now)
+        {
+          auto message = std::move(m_renewals.begin()->second);
+          m_renewals.erase(m_renewals.begin());
+          message->RenewalScheduled = false;
+          ++m_pendingRequests;
+          m_requestPool.Submit([this, message]() { RenewMessage(message); });
+        }
+        if (m_renewals.empty())
+        {
+          m_renewalCondition.wait(lock);
+        }
+        else
+        {
+          // Copied, the renewal can be unscheduled while waiting.
+          const auto nextRenewal = m_renewals.begin()->first;
+          m_renewalCondition.wait_until(lock, nextRenewal);
+        }
+      }
+    }
+
+    void QueueProcessorState::HandleMessage(const std::shared_ptr<TrackedMessage>& message)
+    {
+      bool stopping;
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_prefetchedMessages;
+        stopping = m_stopping;
+      }
+      m_receiveCondition.notify_one();
+
+      // A message whose visibility couldn't be renewed while it was waiting isn't handled.
+      bool succeeded = false;
+      if (!stopping && !message->Context.IsCancelled())
+      {
+        try
+        {
+          m_handler(message->Message, message->Context);
+          succeeded = true;
+        }
+        catch (...)
+        {
+          ReportError("Handler", &message->Message, std::current_exception());
+        }
+      }
+      if (succeeded)
+      {
+        SubmitRequest([this, message]() { DeleteMessage(message); });
+      }
+      else
+      {
+        SubmitRequest([this, message]() { ReleaseMessage(message); });
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_unfinishedMessages;
+      }
+      m_drainedCondition.notify_all();
+    }
+
+    void QueueProcessorState::DeleteMessage(const std::shared_ptr<TrackedMessage>& message)
+    {
+      std::lock_guard<std::mutex> guard(message->Mutex);
+      message->Finished = true;
+      UnscheduleRenewal(message);
+      if (message->Lost)
+      {
+        return;
+      }
+      try
+      {
+        m_queueClient.DeleteMessage(message->Message.MessageId, message->PopReceipt);
+      }
+      catch (...)
+      {
+        ReportError("DeleteMessage", &message->Message, std::current_exception());
+      }
+    }
+
+    void QueueProcessorState::ReleaseMessage(const std::shared_ptr<TrackedMessage>& message)
+    {
+      std::lock_guard<std::mutex> guard(message->Mutex);
+      message->Finished = true;
+      UnscheduleRenewal(message);
+      if (message->Lost)
+      {
+        return;
+      }
+      try
+      {
+        m_queueClient.UpdateMessage(
+            message->Message.MessageId, message->PopReceipt, std::chrono::seconds(0));
+      }
+      catch (...)
+      {
+        ReportError("UpdateMessage", &message->Message, std::current_exception());
+      }
+    }
+
+    void QueueProcessorState::RenewMessage(const std::shared_ptr<TrackedMessage>& message)
+    {
+      {
+        std::lock_guard<std::mutex> guard(message->Mutex);
+        if (!message->Finished && !message->Lost)
+        {
+          const auto sentOn = Clock::now();
+          try
+          {
+            auto result = m_queueClient.UpdateMessage(
+                message->Message.MessageId, message->PopReceipt, m_options.VisibilityTimeout);
+            message->PopReceipt = std::move(result.Value.PopReceipt);
+            message->VisibleUntil = sentOn + m_options.VisibilityTimeout;
+            std::lock_guard<std::mutex> stateGuard(m_mutex);
+            ScheduleRenewal(message, sentOn + RenewalInterval());
+          }
+          catch (...)
+          {
+            ReportError("UpdateMessage", &message->Message, std::current_exception());
+            // Errors returned by the service for the message, like a pop receipt that doesn't
+            // match, won't go away by trying again.
+            bool retriable = true;
+            try
+            {
+              throw;
+            }
+            catch (const StorageException& e)
+            {
+              retriable = static_cast<int>(e.StatusCode) >= 500;
+            }
+            catch (...)
+            {
+            }
+            const auto retryOn = Clock::now() + RenewalRetryInterval;
+            if (retriable && retryOn < message->VisibleUntil)
+            {
+              std::lock_guard<std::mutex> stateGuard(m_mutex);
+              ScheduleRenewal(message, retryOn);
+            }
+            else
+            {
+              message->Lost = true;
+              message->Context.Cancel();
+            }
+          }
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_pendingRequests;
+      }
+      m_drainedCondition.notify_all();
+    }
+
+    void QueueProcessorState::SubmitRequest(std::function<void()> request)
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        ++m_pendingRequests;
+      }
+      m_requestPool.Submit([this, request = std::move(request)]() {
+        request();
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          --m_pendingRequests;
+        }
+        m_drainedCondition.notify_all();
+      });
+    }
+
+    void QueueProcessorState::ScheduleRenewal(
+        const std::shared_ptr<TrackedMessage>& message,
+        Clock::time_point renewAt)
+    {
+      const bool first = m_renewals.empty() || renewAt < m_renewals.begin()->first;
+      message->Renewal = m_renewals.emplace(renewAt, message);
+      message->RenewalScheduled = true;
+      if (first)
+      {
+        m_renewalCondition.notify_one();
+      }
+    }
+
+    void QueueProcessorState::UnscheduleRenewal(const std::shared_ptr<TrackedMessage>& message)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (message->RenewalScheduled)
+      {
+        m_renewals.erase(message->Renewal);
+        message->RenewalScheduled = false;
+      }
+    }
+
+    void QueueProcessorState::ReportError(
+        const char* operation,
+        const Models::QueueMessage* message,
+        std::exception_ptr exception)
+    {
+      if (!m_options.ErrorHandler)
+      {
+        return;
+      }
+      QueueProcessorError error;
+      error.Operation = operation;
+      if (message)
+      {
+        error.Message = *message;
+      }
+      error.Exception = std::move(exception);
+      try
+      {
+        m_options.ErrorHandler(std::move(error));
+      }
+      catch (...)
+      {
+      }
+    }
+
+  } // namespace _detail
+
+  QueueProcessor::QueueProcessor(
+      QueueClient queueClient,
+      MessageHandler handler,
+      const QueueProcessorOptions& options)
+  {
+    if (options.ReceiveConcurrency <= 0 || options.MaxPrefetchedMessages <= 0
+        || options.HandlerConcurrency <= 0 || options.RequestConcurrency <= 0)
+    {
+      throw std::invalid_argument("The concurrency and buffer size must be greater than zero.");
+    }
+    if (options.VisibilityTimeout < std::chrono::seconds(1))
+    {
+      throw std::invalid_argument("The visibility timeout must be at least one second.");
+    }
+    m_state = std::make_unique<_detail::QueueProcessorState>(
+        std::move(queueClient), std::move(handler), options);
+  }
+
+  QueueProcessor::~QueueProcessor() { Stop(); }
+
+  void QueueProcessor::Start() { m_state->Start(); }
+
+  void QueueProcessor::Stop() { m_state->Stop(); }
+
+}}} // namespace Azure::Storage::Queues
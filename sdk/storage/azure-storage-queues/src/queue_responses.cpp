@@ -13,4 +13,14 @@ namespace Azure { namespace Storage { namespace Queues {
     *this = m_queueServiceClient->ListQueues(m_operationOptions, context);
   }
 
+  ListQueuesPagedResponse::PageFetcher ListQueuesPagedResponse::OnGetNextPageFetcher() const
+  {
+    auto client = m_queueServiceClient;
+    auto options = m_operationOptions;
+    options.ContinuationToken = NextPageToken;
+    return [client, options](const Azure::Core::Context& context) {
+      return std::make_unique<ListQueuesPagedResponse>(client->ListQueues(options, context));
+    };
+  }
+
 }}} // namespace Azure::Storage::Queues
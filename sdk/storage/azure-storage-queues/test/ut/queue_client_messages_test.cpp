@@ -3,7 +3,10 @@
 
 #include "queue_client_test.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
+#include <set>
 #include <thread>
 
 namespace Azure { namespace Storage { namespace Test {
@@ -242,4 +245,63 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_EQ(peekedMessage.MessageText, message);
   }
 
+  TEST_F(QueueClientTest, QueueProcessor_LIVEONLY_)
+  {
+    auto queueClient = *m_queueClient;
+
+    const size_t numMessages = 50;
+    for (size_t i = 0; i < numMessages; ++i)
+    {
+      queueClient.EnqueueMessage(std::to_string(i));
+    }
+
+    std::mutex mutex;
+    std::set<std::string> handledMessages;
+    std::atomic<int> numFailures{0};
+    std::atomic<int> numErrors{0};
+    Queues::QueueProcessorOptions options;
+    options.VisibilityTimeout = std::chrono::seconds(2);
+    options.MaxPollingInterval = std::chrono::milliseconds(500);
+    options.ErrorHandler = [&](Queues::QueueProcessorError error) {
+      EXPECT_EQ(error.Operation, "Handler");
+      ++numErrors;
+    };
+    Queues::QueueProcessor processor(
+        queueClient,
+        [&](const Queues::Models::QueueMessage& message, const Azure::Core::Context& context) {
+          if (message.MessageText == "0" && message.DequeueCount == 1)
+          {
+            ++numFailures;
+            throw std::runtime_error("handler failed");
+          }
+          if (message.MessageText == "1")
+          {
+            // Outlives the visibility timeout, so that the visibility is renewed.
+            std::this_thread::sleep_for(std::chrono::seconds(3));
+            EXPECT_FALSE(context.IsCancelled());
+          }
+          std::lock_guard<std::mutex> guard(mutex);
+          EXPECT_TRUE(handledMessages.insert(message.MessageText).second);
+        },
+        options);
+    processor.Start();
+    for (int i = 0; i < 60; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (handledMessages.size() == numMessages)
+        {
+          break;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    processor.Stop();
+
+    EXPECT_EQ(handledMessages.size(), numMessages);
+    EXPECT_EQ(numFailures.load(), 1);
+    EXPECT_EQ(numErrors.load(), 1);
+    EXPECT_TRUE(queueClient.PeekMessages().Value.Messages.empty());
+  }
+
 }}} // namespace Azure::Storage::Test
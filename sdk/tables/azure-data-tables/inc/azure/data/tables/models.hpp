@@ -125,6 +125,7 @@ namespace Azure { namespace Data { namespace Tables {
       friend class Azure::Core::PagedResponse<QueryTablesPagedResponse>;
       std::shared_ptr<TableServiceClient> m_tableServiceClient;
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
     };
 
     /**
@@ -796,6 +797,7 @@ namespace Azure { namespace Data { namespace Tables {
       friend class Azure::Core::PagedResponse<QueryEntitiesPagedResponse>;
 
       void OnNextPage(const Azure::Core::Context& context);
+      PageFetcher OnGetNextPageFetcher() const override;
     };
 
     /**
@@ -500,6 +500,18 @@ void Models::QueryTablesPagedResponse::OnNextPage(const Azure::Core::Context& co
   *this = m_tableServiceClient->QueryTables(m_operationOptions, context);
 }
 
+Models::QueryTablesPagedResponse::PageFetcher
+Models::QueryTablesPagedResponse::OnGetNextPageFetcher() const
+{
+  auto client = m_tableServiceClient;
+  auto options = m_operationOptions;
+  options.ContinuationToken = NextPageToken;
+  return [client, options](const Azure::Core::Context& context) {
+    return std::make_unique<Models::QueryTablesPagedResponse>(
+        client->QueryTables(options, context));
+  };
+}
+
 Models::QueryTablesPagedResponse TableServiceClient::QueryTables(
     Models::QueryTablesOptions const& options,
     Azure::Core::Context const& context) const
@@ -825,6 +837,19 @@ void Models::QueryEntitiesPagedResponse::OnNextPage(const Azure::Core::Context&
   *this = m_tableClient->QueryEntities(m_operationOptions, context);
 }
 
+Models::QueryEntitiesPagedResponse::PageFetcher
+Models::QueryEntitiesPagedResponse::OnGetNextPageFetcher() const
+{
+  auto client = m_tableClient;
+  auto options = m_operationOptions;
+  options.NextPartitionKey = NextPartitionKey;
+  options.NextRowKey = NextRowKey;
+  return [client, options](const Azure::Core::Context& context) {
+    return std::make_unique<Models::QueryEntitiesPagedResponse>(
+        client->QueryEntities(options, context));
+  };
+}
+
 Azure::Response<Models::TableEntity> TableClient::GetEntity(
     const std::string& partitionKey,
     const std::string& rowKey,